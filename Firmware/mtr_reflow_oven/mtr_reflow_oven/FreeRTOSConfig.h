@@ -76,12 +76,17 @@
 #define configAPPLICATION_ALLOCATED_HEAP        0
 
 /* Hook function related definitions. */
-#define configCHECK_FOR_STACK_OVERFLOW          0
+#define configCHECK_FOR_STACK_OVERFLOW          2  /* vApplicationStackOverflowHook() in main */
 #define configUSE_MALLOC_FAILED_HOOK            0
 #define configUSE_DAEMON_TASK_STARTUP_HOOK      0
 
 /* Run time and task stats gathering related definitions. */
-#define configGENERATE_RUN_TIME_STATS           0
+/* Counted in microseconds from the 64-bit system timer (no wrap), read by
+system/sys_stats.cpp for the per-task CPU load */
+#define configGENERATE_RUN_TIME_STATS           1
+#define configRUN_TIME_COUNTER_TYPE             uint64_t
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#define portGET_RUN_TIME_COUNTER_VALUE()        time_us_64()
 #define configUSE_TRACE_FACILITY                1
 #define configUSE_STATS_FORMATTING_FUNCTIONS    0
 
@@ -102,19 +107,23 @@
 #define configMAX_API_CALL_INTERRUPT_PRIORITY   [dependent on processor and application]
 */
 
-#if FREE_RTOS_KERNEL_SMP // set by the RP2040 SMP port of FreeRTOS
-/* SMP port only */
-#define configNUMBER_OF_CORES                   1
+/* SMP: both RP2040 cores run tasks. Control tasks (alerts, sensors, PID) are
+pinned to core 0, LVGL and the display flush to core 1, see main(). Tasks of
+different priorities run at the same time, so shared data needs a real lock
+or the oven_state.h latches, never "a higher priority task cannot be
+interrupted". */
+#define configNUMBER_OF_CORES                   2
 #define configTICK_CORE                         0
-#define configRUN_MULTIPLE_PRIORITIES           0
+#define configRUN_MULTIPLE_PRIORITIES           1
+#define configUSE_CORE_AFFINITY                 1
 #define configUSE_PASSIVE_IDLE_HOOK             0
-#endif
 
 /* RP2040 specific */
 #define configSUPPORT_PICO_SYNC_INTEROP         1
 #define configSUPPORT_PICO_TIME_INTEROP         1
 
 #include <assert.h>
+#include "hardware/timer.h" /* time_us_64() for the run time counter */
 /* Define to trap errors during development. */
 #define configASSERT(x)                         assert(x)
 
@@ -21,6 +21,7 @@
 
 // --- Status LEDs ---
 #define GPIO_WS_LED    9  // WS2812B Data
+#define WS_LED_COUNT   2  // LEDs on the chain
 
 // --- MCP9600 Alerts (Sensor 1) ---
 #define GPIO_T1_ALT4   10
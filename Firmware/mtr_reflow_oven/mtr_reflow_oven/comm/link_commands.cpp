@@ -0,0 +1,220 @@
+#include <stdio.h>
+#include <cmath>
+#include <cstring>
+#include <strings.h>
+#include "link_commands.h"
+#include "link_proto.h"
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "ff.h"
+#include "spi_bus.h"
+#include "../control/oven_control.h"
+#include "../storage/profile_store.h"
+#include "../ui/ui_screens.h"
+
+extern SemaphoreHandle_t mtx_LVGL;
+extern bool sd_mounted;
+
+// Defined in mtr_reflow_oven.cpp
+extern bool load_profile(const char* path);
+extern void save_system_config();
+
+#define LINK_LOCK_MS        200
+#define LINK_MAX_TARGET_C   260.0f  // Same limit as the MANUAL screen
+#define LINK_MAX_PID_GAIN   1000.0f // Same bounds as system.json (control/profile_parser.cpp)
+#define LINK_UPLOAD_DIR     PROFILE_DIR
+#define LINK_UPLOAD_TMP_NAME "upload.tmp"
+#define LINK_UPLOAD_TMP     PROFILE_DIR "/" LINK_UPLOAD_TMP_NAME
+
+// --- Profile Upload ---
+static FIL upload_file;
+static bool upload_open = false;
+static uint32_t upload_size = 0;
+static uint32_t upload_received = 0;
+static char upload_path[48];
+
+static bool take_bus() {
+    return spi_bus_acquire(SPI_DEV_SD, LINK_LOCK_MS);
+}
+
+static void give_bus() {
+    spi_bus_release(SPI_DEV_SD);
+}
+
+// Caller holds the bus
+static void upload_abort() {
+    if (!upload_open) return;
+    f_close(&upload_file);
+    f_unlink(LINK_UPLOAD_TMP);
+    upload_open = false;
+}
+
+// A plain file name in /profiles. FatFs also takes '\' as a separator and
+// ".." (FF_FS_RPATH), and "0:" as a drive: allow only [A-Za-z0-9._-].
+// Only .json files are listed (profile_store.cpp), and the temporary file
+// would be renamed onto itself.
+static bool upload_name_ok(const char* name) {
+    if (name[0] == 0 || name[0] == '.') return false;
+    size_t len = 0;
+    for (const char* c = name; *c; c++, len++) {
+        bool ok = (*c >= 'a' && *c <= 'z') || (*c >= 'A' && *c <= 'Z') || (*c >= '0' && *c <= '9') ||
+                  *c == '.' || *c == '_' || *c == '-';
+        if (!ok) return false;
+    }
+    if (strcasecmp(name, LINK_UPLOAD_TMP_NAME) == 0) return false;
+    return len > 5 && strcasecmp(name + len - 5, ".json") == 0;
+}
+
+static uint8_t cmd_upload_begin(const LinkFrame* f) {
+    LinkUploadBegin cmd;
+    if (f->len != sizeof(cmd)) return LINK_ERR_LENGTH;
+    memcpy(&cmd, f->body, sizeof(cmd));
+    cmd.name[sizeof(cmd.name) - 1] = 0;
+    if (!upload_name_ok(cmd.name)) return LINK_ERR_RANGE;
+    if (cmd.size == 0 || cmd.size > LINK_UPLOAD_MAX_SIZE) return LINK_ERR_RANGE;
+    if (!sd_mounted) return LINK_ERR_IO;
+
+    if (!take_bus()) return LINK_ERR_BUSY;
+    upload_abort(); // A new BEGIN restarts an unfinished upload
+    FRESULT fr = f_open(&upload_file, LINK_UPLOAD_TMP, FA_WRITE | FA_CREATE_ALWAYS);
+    give_bus();
+    if (fr != FR_OK) return LINK_ERR_IO;
+
+    upload_open = true;
+    upload_size = cmd.size;
+    upload_received = 0;
+    snprintf(upload_path, sizeof(upload_path), LINK_UPLOAD_DIR "/%s", cmd.name);
+    printf("[Link] Upload %s, %u bytes\n", upload_path, (unsigned)upload_size);
+    return LINK_OK;
+}
+
+static uint8_t cmd_upload_data(const LinkFrame* f) {
+    LinkUploadData hdr;
+    if (!upload_open) return LINK_ERR_STATE;
+    if (f->len <= sizeof(hdr)) return LINK_ERR_LENGTH;
+    memcpy(&hdr, f->body, sizeof(hdr));
+    UINT len = f->len - sizeof(hdr);
+    if (hdr.offset != upload_received) return LINK_ERR_STATE; // Lost or repeated chunk
+    if (upload_received + len > upload_size) return LINK_ERR_RANGE;
+
+    if (!take_bus()) return LINK_ERR_BUSY;
+    UINT written = 0;
+    FRESULT fr = f_write(&upload_file, f->body + sizeof(hdr), len, &written);
+    if (fr != FR_OK || written != len) upload_abort();
+    give_bus();
+    if (!upload_open) return LINK_ERR_IO;
+
+    upload_received += len;
+    return LINK_OK;
+}
+
+static uint8_t cmd_upload_end() {
+    if (!upload_open) return LINK_ERR_STATE;
+    if (upload_received != upload_size) return LINK_ERR_LENGTH;
+
+    if (!take_bus()) return LINK_ERR_BUSY;
+    FRESULT fr = f_close(&upload_file);
+    upload_open = false;
+    if (fr == FR_OK) {
+        f_unlink(upload_path); // FR_NO_FILE for a new profile
+        fr = f_rename(LINK_UPLOAD_TMP, upload_path);
+    }
+    if (fr != FR_OK) f_unlink(LINK_UPLOAD_TMP);
+    give_bus();
+    if (fr == FR_OK) profile_store_invalidate(); // Compiled and listed on the next SD poll
+
+    printf("[Link] Upload %s %s\n", upload_path, fr == FR_OK ? "done" : "failed");
+    return fr == FR_OK ? LINK_OK : LINK_ERR_IO;
+}
+
+// --- Oven Commands ---
+
+static uint8_t cmd_start_stop() {
+    if (xSemaphoreTake(mtx_OvenState, pdMS_TO_TICKS(LINK_LOCK_MS)) != pdTRUE) return LINK_ERR_BUSY;
+    oven_cmd_start_stop();
+    xSemaphoreGive(mtx_OvenState);
+    return LINK_OK;
+}
+
+static uint8_t cmd_load_profile(const LinkFrame* f) {
+    char path[64];
+    if (f->len == 0 || f->len >= sizeof(path)) return LINK_ERR_LENGTH;
+    memcpy(path, f->body, f->len);
+    path[f->len] = 0;
+
+    // Not under a running profile
+    OvenStateEnum state = oven_state_mode().state;
+    if (state == STATE_PRE_CHECK || state == STATE_RUNNING) return LINK_ERR_STATE;
+
+    // Like the PROFILE screen: mtx_LVGL, then the chart is redrawn
+    if (xSemaphoreTake(mtx_LVGL, pdMS_TO_TICKS(LINK_LOCK_MS)) != pdTRUE) return LINK_ERR_BUSY;
+    bool ok = load_profile(path);
+    if (ok) ui_refresh_dashboard_chart();
+    xSemaphoreGive(mtx_LVGL);
+    return ok ? LINK_OK : LINK_ERR_IO;
+}
+
+// Manual mode target, as the MANUAL screen does it
+static uint8_t cmd_set_setpoint(const LinkFrame* f) {
+    LinkSetpointCmd cmd;
+    if (f->len != sizeof(cmd)) return LINK_ERR_LENGTH;
+    memcpy(&cmd, f->body, sizeof(cmd));
+    if (!std::isfinite(cmd.target_c) || cmd.target_c < 0.0f || cmd.target_c > LINK_MAX_TARGET_C) {
+        return LINK_ERR_RANGE;
+    }
+
+    if (xSemaphoreTake(mtx_OvenState, pdMS_TO_TICKS(LINK_LOCK_MS)) != pdTRUE) return LINK_ERR_BUSY;
+    uint8_t status = LINK_OK;
+    OvenMode mode = oven_state_mode();
+    if (mode.state == STATE_IDLE || mode.state == STATE_MANUAL) {
+        mode.state = (cmd.target_c > 0.0f) ? STATE_MANUAL : STATE_IDLE;
+        mode.target_temp = cmd.target_c;
+        oven_state_publish_mode(&mode);
+    } else {
+        status = LINK_ERR_STATE;
+    }
+    xSemaphoreGive(mtx_OvenState);
+    return status;
+}
+
+static bool pid_gain_ok(float gain) {
+    return std::isfinite(gain) && gain >= 0.0f && gain <= LINK_MAX_PID_GAIN;
+}
+
+// Live gains: vPIDLoopTask reads them each sample
+static uint8_t cmd_set_pid(const LinkFrame* f) {
+    LinkPidCmd cmd;
+    if (f->len != sizeof(cmd)) return LINK_ERR_LENGTH;
+    memcpy(&cmd, f->body, sizeof(cmd));
+    if (cmd.channel != 1 && cmd.channel != 2) return LINK_ERR_RANGE;
+    if (!pid_gain_ok(cmd.kp) || !pid_gain_ok(cmd.ki) || !pid_gain_ok(cmd.kd)) return LINK_ERR_RANGE;
+
+    // sysConfig writers hold mtx_LVGL (SETTINGS screen)
+    if (xSemaphoreTake(mtx_LVGL, pdMS_TO_TICKS(LINK_LOCK_MS)) != pdTRUE) return LINK_ERR_BUSY;
+    if (cmd.channel == 1) {
+        sysConfig.pid_ssr1_kp = cmd.kp;
+        sysConfig.pid_ssr1_ki = cmd.ki;
+        sysConfig.pid_ssr1_kd = cmd.kd;
+    } else {
+        sysConfig.pid_ssr2_kp = cmd.kp;
+        sysConfig.pid_ssr2_ki = cmd.ki;
+        sysConfig.pid_ssr2_kd = cmd.kd;
+    }
+    if (cmd.save) save_system_config();
+    xSemaphoreGive(mtx_LVGL);
+    printf("[Link] SSR%u PID kp %.2f ki %.4f kd %.2f\n", cmd.channel, cmd.kp, cmd.ki, cmd.kd);
+    return LINK_OK;
+}
+
+uint8_t link_commands_handle(const LinkFrame* frame) {
+    switch (frame->type) {
+        case LINK_CMD_START_STOP:   return cmd_start_stop();
+        case LINK_CMD_LOAD_PROFILE: return cmd_load_profile(frame);
+        case LINK_CMD_SET_SETPOINT: return cmd_set_setpoint(frame);
+        case LINK_CMD_SET_PID:      return cmd_set_pid(frame);
+        case LINK_CMD_UPLOAD_BEGIN: return cmd_upload_begin(frame);
+        case LINK_CMD_UPLOAD_DATA:  return cmd_upload_data(frame);
+        case LINK_CMD_UPLOAD_END:   return cmd_upload_end();
+        default:                    return LINK_ERR_UNKNOWN;
+    }
+}
@@ -0,0 +1,13 @@
+#ifndef LINK_COMMANDS_H
+#define LINK_COMMANDS_H
+
+#include <stdint.h>
+#include "link_frame.h"
+
+// Firmware side of the USB link commands (link_proto.h): the same
+// primitives as the UI (oven_cmd_start_stop(), load_profile(), the manual
+// and settings screens) under the same locks. Runs on the link task,
+// handler of link_service_start_task().
+uint8_t link_commands_handle(const LinkFrame* frame);
+
+#endif // LINK_COMMANDS_H
@@ -0,0 +1,103 @@
+#include "link_frame.h"
+#include <cstring>
+
+static_assert(LINK_RAW_MAX <= 254, "A frame must fit a single COBS block");
+
+// CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF), a nibble at a time:
+// 16-entry table, no multiply, cheap on the M0+
+static const uint16_t crc_nibble[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+};
+
+uint16_t link_crc16(const uint8_t* data, size_t len) {
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < len; i++) {
+        crc = (uint16_t)((crc << 4) ^ crc_nibble[(crc >> 12) ^ (data[i] >> 4)]);
+        crc = (uint16_t)((crc << 4) ^ crc_nibble[(crc >> 12) ^ (data[i] & 0x0F)]);
+    }
+    return crc;
+}
+
+size_t link_frame_seal(uint8_t* wire, uint8_t type, uint8_t seq, size_t body_len) {
+    size_t raw_len = 2 + body_len + 2;
+    uint8_t* raw = wire + 2;
+    raw[0] = type;
+    raw[1] = seq;
+    uint16_t crc = link_crc16(raw, 2 + body_len);
+    raw[2 + body_len] = (uint8_t)(crc & 0xFF);
+    raw[3 + body_len] = (uint8_t)(crc >> 8);
+
+    // COBS in place: each zero becomes the distance to the next one, the
+    // code byte in front (wire[1]) the distance to the first
+    uint8_t* block = wire + 1;
+    size_t code_at = 0;
+    for (size_t i = 1; i <= raw_len; i++) {
+        if (block[i] == 0) {
+            block[code_at] = (uint8_t)(i - code_at);
+            code_at = i;
+        }
+    }
+    block[code_at] = (uint8_t)(raw_len + 1 - code_at);
+
+    wire[0] = 0x00;
+    wire[raw_len + 2] = 0x00;
+    return raw_len + 3;
+}
+
+size_t link_frame_encode(uint8_t* wire, uint8_t type, uint8_t seq, const void* body, size_t body_len) {
+    if (body_len > LINK_MAX_BODY) return 0;
+    if (body_len) memcpy(wire + LINK_WIRE_BODY, body, body_len);
+    return link_frame_seal(wire, type, seq, body_len);
+}
+
+void link_decoder_init(LinkDecoder* dec) {
+    memset(dec, 0, sizeof(*dec));
+}
+
+enum DecodeResult { DECODE_OK, DECODE_FRAMING, DECODE_CRC };
+
+// COBS block(s) in raw -> frame + 2, so the body lands 4-byte aligned
+static DecodeResult decode_frame(LinkDecoder* dec, LinkFrame* out) {
+    uint8_t* dst = dec->frame + 2;
+    size_t in = 0;
+    size_t n = 0;
+    while (in < dec->fill) {
+        uint8_t code = dec->raw[in++];
+        if (code == 0 || in + code - 1 > dec->fill) return DECODE_FRAMING;
+        for (uint8_t i = 1; i < code; i++) dst[n++] = dec->raw[in++];
+        if (code < 0xFF && in < dec->fill) dst[n++] = 0;
+    }
+    if (n < 4) return DECODE_FRAMING;
+
+    uint16_t crc = (uint16_t)(dst[n - 2] | (dst[n - 1] << 8));
+    if (link_crc16(dst, n - 2) != crc) return DECODE_CRC;
+    out->type = dst[0];
+    out->seq = dst[1];
+    out->body = dec->frame + LINK_WIRE_BODY;
+    out->len = (uint16_t)(n - 4);
+    return DECODE_OK;
+}
+
+bool link_decoder_push(LinkDecoder* dec, uint8_t byte, LinkFrame* out) {
+    if (byte != 0x00) {
+        if (dec->fill < sizeof(dec->raw)) dec->raw[dec->fill++] = byte;
+        else dec->overflow = true;
+        return false;
+    }
+
+    // Delimiter: back-to-back ones (frame start after frame end) are empty
+    bool valid = false;
+    if (dec->overflow) {
+        dec->framing_errors++;
+    } else if (dec->fill > 0) {
+        switch (decode_frame(dec, out)) {
+            case DECODE_OK: dec->frames++; valid = true; break;
+            case DECODE_FRAMING: dec->framing_errors++; break;
+            case DECODE_CRC: dec->crc_errors++; break;
+        }
+    }
+    dec->fill = 0;
+    dec->overflow = false;
+    return valid;
+}
@@ -0,0 +1,63 @@
+#ifndef LINK_FRAME_H
+#define LINK_FRAME_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// Framing of the USB link (link_service.h), shared by the firmware and the
+// host tools (sim/link_host.h).
+//
+// Frame on the wire, little-endian:
+//
+//   0x00 | COBS( type | seq | body... | crc16 ) | 0x00
+//
+// COBS removes every 0x00 from the frame so 0x00 only ever marks frame
+// boundaries: a receiver resynchronises on the next delimiter after noise
+// or a lost byte. The leading delimiter separates frames from printf text
+// sharing the same USB serial port; such text decodes as a bad frame and is
+// dropped. crc16 is CRC-16/CCITT-FALSE over type, seq and body.
+//
+// Bodies are at most LINK_MAX_BODY bytes so a frame is a single COBS block
+// (<= 254 bytes): it can be encoded in place, the code byte living in a
+// slot reserved in front of the data (link_frame_seal()).
+
+#define LINK_MAX_BODY       240
+#define LINK_RAW_MAX        (2 + LINK_MAX_BODY + 2)     // type, seq, body, crc
+#define LINK_WIRE_MAX       (LINK_RAW_MAX + 3)          // + COBS code + 2 delimiters
+#define LINK_WIRE_BODY      4                           // Body offset in a wire buffer
+
+typedef struct {
+    uint8_t type;           // LINK_MSG_* / LINK_CMD_* (link_proto.h)
+    uint8_t seq;            // Per-direction counter, wraps
+    const uint8_t* body;    // 4-byte aligned, valid until the next link_decoder_push()
+    uint16_t len;
+} LinkFrame;
+
+uint16_t link_crc16(const uint8_t* data, size_t len);
+
+// --- Encoding ---
+// wire holds the body at wire + LINK_WIRE_BODY already: adds the header,
+// CRC, COBS and delimiters around it in place. Returns the wire length.
+size_t link_frame_seal(uint8_t* wire, uint8_t type, uint8_t seq, size_t body_len);
+
+// Copying variant: wire must hold LINK_WIRE_MAX bytes. 0 if body is too long.
+size_t link_frame_encode(uint8_t* wire, uint8_t type, uint8_t seq, const void* body, size_t body_len);
+
+// --- Decoding (byte stream) ---
+typedef struct {
+    uint8_t raw[LINK_WIRE_MAX];     // Encoded bytes since the last delimiter
+    uint16_t fill;
+    bool overflow;                  // Too long for a frame, skip to the next delimiter
+    alignas(4) uint8_t frame[LINK_WIRE_MAX + 2]; // Decoded, body at frame + LINK_WIRE_BODY
+    uint32_t frames;                // Valid frames
+    uint32_t crc_errors;
+    uint32_t framing_errors;        // Bad COBS, too short or too long (includes text)
+} LinkDecoder;
+
+void link_decoder_init(LinkDecoder* dec);
+
+// Feed one received byte. true when it completed a valid frame (*out).
+bool link_decoder_push(LinkDecoder* dec, uint8_t byte, LinkFrame* out);
+
+#endif // LINK_FRAME_H
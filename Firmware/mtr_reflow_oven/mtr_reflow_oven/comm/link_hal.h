@@ -0,0 +1,23 @@
+#ifndef LINK_HAL_H
+#define LINK_HAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// Byte transport under the USB link (link_service.cpp).
+// Target: link_hal_rp2040.cpp (USB CDC through pico stdio, shared with printf).
+// Host: sim/link_hal_sim.cpp (in-memory loopback for sim/link_loopback).
+
+// rx_ready is called when bytes arrive, from interrupt context on target.
+// May be left uncalled: the link task also polls every LINK_POLL_MS.
+void link_hal_init(void (*rx_ready)(void));
+
+// Received bytes, never blocks. Returns the count (0 if none).
+size_t link_hal_read(uint8_t* buf, size_t max);
+
+// One whole frame, not interleaved with other output.
+// false if it was dropped (no host connected).
+bool link_hal_write(const uint8_t* data, size_t len);
+
+#endif // LINK_HAL_H
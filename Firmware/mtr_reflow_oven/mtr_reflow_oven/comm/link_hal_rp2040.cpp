@@ -0,0 +1,39 @@
+#include "link_hal.h"
+#include "pico/stdlib.h"
+#include "pico/stdio.h"
+#include "pico/stdio_usb.h"
+
+// The link shares the USB CDC port with printf (pico_stdio_usb).
+// stdio_put_string() writes a frame under the stdio mutex, so a frame is
+// never split by a printf from another task, and without CR/LF translation
+// (a 0x0A in a frame must stay 0x0A). Output is discarded while no host
+// has the port open.
+
+static void (*rx_ready_cb)(void) = NULL;
+
+// From the USB IRQ (TinyUSB task run by pico_stdio_usb)
+static void chars_available(void* param) {
+    (void)param;
+    if (rx_ready_cb) rx_ready_cb();
+}
+
+void link_hal_init(void (*rx_ready)(void)) {
+    rx_ready_cb = rx_ready;
+    stdio_set_chars_available_callback(chars_available, NULL);
+}
+
+size_t link_hal_read(uint8_t* buf, size_t max) {
+    size_t n = 0;
+    while (n < max) {
+        int c = getchar_timeout_us(0);
+        if (c < 0) break; // PICO_ERROR_TIMEOUT: nothing left
+        buf[n++] = (uint8_t)c;
+    }
+    return n;
+}
+
+bool link_hal_write(const uint8_t* data, size_t len) {
+    if (!stdio_usb_connected()) return false;
+    stdio_put_string((const char*)data, (int)len, false, false);
+    return true;
+}
@@ -0,0 +1,87 @@
+#ifndef LINK_PROTO_H
+#define LINK_PROTO_H
+
+#include <stdint.h>
+
+// Messages of the USB link (framing: link_frame.h). Bodies are plain
+// little-endian structs, identical on the RP2040 and x86 hosts. Copy them
+// out of a LinkFrame with memcpy: a body may be shorter than the struct
+// in a future version, never longer.
+//
+// Every command is answered by a LINK_MSG_ACK carrying its type and seq
+// (PING by a PONG), in the order received.
+
+#define LINK_PROTO_VERSION      1
+
+// --- Device -> host ---
+#define LINK_MSG_TELEMETRY      0x01    // RunLogRecord (control/run_log.h), per sensor sample
+#define LINK_MSG_ACK            0x02    // LinkAck
+#define LINK_MSG_PONG           0x03    // LinkPong
+
+// --- Host -> device ---
+#define LINK_CMD_PING           0x80    // No body
+#define LINK_CMD_STREAM         0x81    // LinkStreamCmd
+#define LINK_CMD_START_STOP     0x82    // No body, the dashboard START/STOP button
+#define LINK_CMD_LOAD_PROFILE   0x83    // Path on the SD card, not terminated
+#define LINK_CMD_SET_SETPOINT   0x84    // LinkSetpointCmd
+#define LINK_CMD_SET_PID        0x85    // LinkPidCmd
+#define LINK_CMD_UPLOAD_BEGIN   0x86    // LinkUploadBegin
+#define LINK_CMD_UPLOAD_DATA    0x87    // LinkUploadData, then the bytes
+#define LINK_CMD_UPLOAD_END     0x88    // No body: commit the file
+
+// --- LinkAck.status ---
+#define LINK_OK                 0
+#define LINK_ERR_UNKNOWN        1       // Unknown command
+#define LINK_ERR_LENGTH         2       // Body too short or too long
+#define LINK_ERR_STATE          3       // Not allowed in the current oven state
+#define LINK_ERR_RANGE          4       // Value out of range
+#define LINK_ERR_BUSY           5       // Lock not available, retry
+#define LINK_ERR_IO             6       // SD card missing or FatFs error
+
+typedef struct {
+    uint8_t cmd;            // Command answered
+    uint8_t seq;            // Its seq
+    uint8_t status;         // LINK_OK / LINK_ERR_*
+    uint8_t reserved;
+} LinkAck;
+
+typedef struct {
+    uint16_t version;       // LINK_PROTO_VERSION
+    uint16_t max_body;      // LINK_MAX_BODY
+    uint32_t uptime_ms;
+} LinkPong;
+
+typedef struct {
+    uint8_t enable;
+    uint8_t decimate;       // One LINK_MSG_TELEMETRY every N samples (0 = 1)
+} LinkStreamCmd;
+
+// MANUAL mode target, from IDLE or MANUAL only. 0 = heater off (IDLE).
+typedef struct {
+    float target_c;
+} LinkSetpointCmd;
+
+typedef struct {
+    uint8_t channel;        // SSR 1 or 2
+    uint8_t save;           // Also write /config/system.json
+    uint8_t reserved[2];
+    float kp;               // 0..1000 each, as in system.json; 0 turns the term off
+    float ki;
+    float kd;
+} LinkPidCmd;
+
+// Upload a profile to /profiles/<name>: written to a temporary file, which
+// replaces the profile only once UPLOAD_END sees all the bytes
+typedef struct {
+    uint32_t size;
+    char name[32];          // File name only, [A-Za-z0-9._-], no leading '.', ending in .json (e.g. "sac305.json"), NUL padded
+} LinkUploadBegin;
+
+typedef struct {
+    uint32_t offset;        // Must follow the previous chunk
+} LinkUploadData;
+
+#define LINK_UPLOAD_CHUNK       (LINK_MAX_BODY - sizeof(LinkUploadData))
+#define LINK_UPLOAD_MAX_SIZE    (32 * 1024)
+
+#endif // LINK_PROTO_H
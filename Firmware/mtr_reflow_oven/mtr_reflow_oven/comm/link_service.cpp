@@ -0,0 +1,180 @@
+#include "link_service.h"
+#include "link_hal.h"
+#include "queue.h"
+#include "run_log.h"
+#include "oven_hal.h"
+#include <cstring>
+
+static_assert(sizeof(RunLogRecord) <= LINK_MAX_BODY, "Telemetry must fit a frame");
+
+struct LinkTxBuf {
+    alignas(4) uint8_t wire[LINK_WIRE_MAX];  // Body at LINK_WIRE_BODY, sealed in place
+    uint8_t type;
+    uint16_t len;                           // Body length
+};
+
+static LinkTxBuf tx_pool[LINK_TX_BUFFERS];
+static QueueHandle_t q_TxFree = NULL;       // Pool indices (uint8_t)
+static QueueHandle_t q_TxReady = NULL;      // Queued for sending, in order
+static TaskHandle_t hLinkTask = NULL;
+static link_cmd_handler_t cmd_handler = NULL;
+
+static LinkDecoder rx_decoder;              // Link task only
+static uint8_t tx_seq = 0;                  // Link task only
+static uint32_t tx_frames = 0;
+static uint32_t tx_bytes = 0;
+static uint32_t tx_failed = 0;
+static volatile uint32_t tx_dropped = 0;    // Any task, under a critical section
+
+static volatile bool streaming = false;
+static volatile uint8_t stream_decimate = 1;
+static uint8_t stream_count = 0;            // vPIDLoopTask only
+
+static LinkTxBuf* take_buffer() {
+    uint8_t idx;
+    if (!q_TxFree || xQueueReceive(q_TxFree, &idx, 0) != pdTRUE) return NULL;
+    return &tx_pool[idx];
+}
+
+LinkTxBuf* link_tx_acquire() {
+    LinkTxBuf* buf = take_buffer();
+    if (!buf) {
+        taskENTER_CRITICAL();
+        tx_dropped = tx_dropped + 1;
+        taskEXIT_CRITICAL();
+    }
+    return buf;
+}
+
+uint8_t* link_tx_body(LinkTxBuf* buf) {
+    return buf->wire + LINK_WIRE_BODY;
+}
+
+void link_tx_send(LinkTxBuf* buf, uint8_t type, size_t body_len) {
+    buf->type = type;
+    buf->len = (uint16_t)body_len;
+    uint8_t idx = (uint8_t)(buf - tx_pool);
+    xQueueSend(q_TxReady, &idx, 0); // Never full: it can hold the whole pool
+    xTaskNotifyGive(hLinkTask);
+}
+
+bool link_streaming() {
+    return streaming;
+}
+
+void link_send_telemetry(uint32_t t_ms, const OvenTemps* temps, const OvenMode* mode, const OvenOutputs* outputs,
+                         uint16_t flags) {
+    if (!streaming) return;
+    if (++stream_count < stream_decimate) return;
+    stream_count = 0;
+
+    LinkTxBuf* buf = link_tx_acquire();
+    if (!buf) return;
+    run_log_pack((RunLogRecord*)link_tx_body(buf), t_ms, temps, mode, outputs, flags);
+    link_tx_send(buf, LINK_MSG_TELEMETRY, sizeof(RunLogRecord));
+}
+
+LinkStats link_stats() {
+    LinkStats s;
+    s.rx_frames = rx_decoder.frames;
+    s.rx_crc_errors = rx_decoder.crc_errors;
+    s.rx_framing_errors = rx_decoder.framing_errors;
+    s.tx_frames = tx_frames;
+    s.tx_bytes = tx_bytes;
+    s.tx_dropped = tx_dropped;
+    s.tx_failed = tx_failed;
+    return s;
+}
+
+// --- Link Task ---
+
+// Seal and write every queued buffer, then hand it back to the pool
+static void flush_tx() {
+    uint8_t idx;
+    while (xQueueReceive(q_TxReady, &idx, 0) == pdTRUE) {
+        LinkTxBuf* buf = &tx_pool[idx];
+        size_t len = link_frame_seal(buf->wire, buf->type, tx_seq++, buf->len);
+        if (link_hal_write(buf->wire, len)) {
+            tx_frames++;
+            tx_bytes += len;
+        } else {
+            tx_failed++;
+        }
+        xQueueSend(q_TxFree, &idx, 0);
+    }
+}
+
+// Replies are not dropped: the link task frees a buffer itself if needed
+static void reply(uint8_t type, const void* body, size_t len) {
+    LinkTxBuf* buf = take_buffer();
+    if (!buf) {
+        flush_tx();
+        buf = take_buffer();
+        if (!buf) return; // Producers took them all meanwhile
+    }
+    memcpy(link_tx_body(buf), body, len);
+    link_tx_send(buf, type, len);
+}
+
+static uint8_t handle_stream(const LinkFrame* f) {
+    LinkStreamCmd cmd;
+    if (f->len < sizeof(cmd)) return LINK_ERR_LENGTH;
+    memcpy(&cmd, f->body, sizeof(cmd));
+    stream_decimate = cmd.decimate ? cmd.decimate : 1;
+    streaming = cmd.enable != 0;
+    return LINK_OK;
+}
+
+static void dispatch(const LinkFrame* f) {
+    if (f->type == LINK_CMD_PING) {
+        LinkPong pong = { LINK_PROTO_VERSION, LINK_MAX_BODY, millis() };
+        reply(LINK_MSG_PONG, &pong, sizeof(pong));
+        return;
+    }
+
+    uint8_t status;
+    if (f->type == LINK_CMD_STREAM) status = handle_stream(f);
+    else if (f->type < 0x80) status = LINK_ERR_UNKNOWN; // Device -> host type echoed back
+    else status = cmd_handler ? cmd_handler(f) : LINK_ERR_UNKNOWN;
+
+    LinkAck ack = { f->type, f->seq, status, 0 };
+    reply(LINK_MSG_ACK, &ack, sizeof(ack));
+}
+
+static void link_rx_ready() {
+    if (!hLinkTask) return;
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(hLinkTask, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+static void vLinkTask(void *pvParameters) {
+    (void)pvParameters;
+    uint8_t chunk[64];
+
+    for (;;) {
+        // Woken by received bytes or queued TX, polled otherwise
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(LINK_POLL_MS));
+
+        size_t n;
+        while ((n = link_hal_read(chunk, sizeof(chunk))) > 0) {
+            for (size_t i = 0; i < n; i++) {
+                LinkFrame frame;
+                if (link_decoder_push(&rx_decoder, chunk[i], &frame)) dispatch(&frame);
+            }
+        }
+        flush_tx();
+    }
+}
+
+TaskHandle_t link_service_start_task(link_cmd_handler_t handler) {
+    cmd_handler = handler;
+    link_decoder_init(&rx_decoder);
+    q_TxReady = xQueueCreate(LINK_TX_BUFFERS, sizeof(uint8_t));
+    q_TxFree = xQueueCreate(LINK_TX_BUFFERS, sizeof(uint8_t));
+    for (uint8_t i = 0; i < LINK_TX_BUFFERS; i++) xQueueSend(q_TxFree, &i, 0);
+
+    xTaskCreate(vLinkTask, "USB_Link", 1024, NULL, 2, &hLinkTask);
+    link_hal_init(link_rx_ready);
+    return hLinkTask;
+}
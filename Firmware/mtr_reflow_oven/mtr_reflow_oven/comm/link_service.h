@@ -0,0 +1,66 @@
+#ifndef LINK_SERVICE_H
+#define LINK_SERVICE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "link_frame.h"
+#include "link_proto.h"
+#include "oven_state.h"
+
+// USB link: binary telemetry and commands over the USB serial port
+// (framing: link_frame.h, messages: link_proto.h, host side: sim/link_host.h).
+//
+// The USB_Link task owns the transport. It decodes received frames,
+// answers PING and STREAM itself, passes every other command to the
+// handler given at start and replies with an ACK.
+//
+// Transmission is zero-copy: a producer takes a buffer from a fixed pool,
+// writes the body in place and queues the buffer's index. The link task
+// adds header, CRC and COBS in place and hands that same buffer to the
+// transport. Producers never block: with every buffer in flight (host not
+// reading) the message is dropped and counted.
+
+#define LINK_TX_BUFFERS     8
+#define LINK_POLL_MS        20      // Receive poll when no rx_ready callback comes
+
+typedef struct LinkTxBuf LinkTxBuf;
+
+// Called on the link task for each command. Returns LinkAck.status.
+typedef uint8_t (*link_cmd_handler_t)(const LinkFrame* frame);
+
+// Priority 2. Returns the task so main() can pin it.
+TaskHandle_t link_service_start_task(link_cmd_handler_t handler);
+
+// --- Zero-copy TX (any task) ---
+// NULL if every buffer is in flight (counted in tx_dropped)
+LinkTxBuf* link_tx_acquire();
+
+// LINK_MAX_BODY bytes, 4-byte aligned
+uint8_t* link_tx_body(LinkTxBuf* buf);
+
+// Queue for transmission, the buffer goes back to the pool once sent
+void link_tx_send(LinkTxBuf* buf, uint8_t type, size_t body_len);
+
+// --- Telemetry (vPIDLoopTask) ---
+// Host asked for LINK_MSG_TELEMETRY (LINK_CMD_STREAM)
+bool link_streaming();
+
+// One sample as a RunLogRecord, honouring the stream decimation
+void link_send_telemetry(uint32_t t_ms, const OvenTemps* temps, const OvenMode* mode, const OvenOutputs* outputs,
+                         uint16_t flags);
+
+typedef struct {
+    uint32_t rx_frames;
+    uint32_t rx_crc_errors;
+    uint32_t rx_framing_errors;     // Includes printf text echoed by a terminal
+    uint32_t tx_frames;
+    uint32_t tx_bytes;
+    uint32_t tx_dropped;            // No free buffer
+    uint32_t tx_failed;             // Transport refused (no host)
+} LinkStats;
+
+LinkStats link_stats();
+
+#endif // LINK_SERVICE_H
@@ -0,0 +1,126 @@
+#include <cmath>
+#include <cstring>
+#include "autotune.h"
+
+static const float RELAY_MAX = 100.0f;
+static const float BIAS_MARGIN = 20.0f; // Keeps both relay levels clear of 0 and 100 %
+static const float PI_F = 3.14159265f;
+
+void autotune_start(Autotune* at, float setpoint, float temp, uint32_t now_ms) {
+    memset(at, 0, sizeof(*at));
+    at->phase = AUTOTUNE_HEATING;
+    at->setpoint = setpoint;
+    at->bias = RELAY_MAX / 2;
+    at->d = RELAY_MAX / 2;
+    at->high = true;
+    at->start_ms = now_ms;
+    at->high_since_ms = now_ms;
+    at->low_since_ms = now_ms;
+    at->start_temp = temp;
+    at->max_temp = temp;
+    at->min_temp = temp;
+}
+
+void autotune_abort(Autotune* at, const char* reason) {
+    if (at->phase == AUTOTUNE_HEATING || at->phase == AUTOTUNE_RELAY) {
+        at->phase = AUTOTUNE_FAILED;
+        at->error = reason;
+    }
+}
+
+static bool close_to(float a, float b) {
+    return fabsf(a - b) <= AUTOTUNE_TOLERANCE * fabsf(b);
+}
+
+// Relay back on: one full cycle, from the last switch-on to now
+static void end_cycle(Autotune* at, uint32_t now_ms) {
+    uint32_t low_ms = now_ms - at->low_since_ms;
+    uint32_t period_ms = at->high_ms + low_ms;
+    float swing = (at->max_temp - at->min_temp) / 2.0f;
+
+    if (at->phase == AUTOTUNE_HEATING) {
+        // First cycle started from cold: says nothing about the bias
+        at->phase = AUTOTUNE_RELAY;
+        return;
+    }
+    if (swing > 0.0f && period_ms > 0) {
+        at->prev_ku = at->ku;
+        at->prev_tu_s = at->tu_s;
+        at->ku = 4.0f * at->d / (PI_F * swing);
+        at->tu_s = period_ms / 1000.0f;
+        at->cycles++;
+    }
+
+    // Even out the two halves for the next cycle
+    at->bias += at->d * ((float)at->high_ms - (float)low_ms) / (float)period_ms;
+    if (at->bias < BIAS_MARGIN) at->bias = BIAS_MARGIN;
+    if (at->bias > RELAY_MAX - BIAS_MARGIN) at->bias = RELAY_MAX - BIAS_MARGIN;
+    at->d = (at->bias > RELAY_MAX / 2) ? RELAY_MAX - at->bias : at->bias;
+
+    if (at->cycles >= AUTOTUNE_MIN_CYCLES && close_to(at->ku, at->prev_ku) && close_to(at->tu_s, at->prev_tu_s)) {
+        // Ziegler-Nichols: Kp = 0.6 Ku, Ti = Tu / 2, Td = Tu / 8
+        at->kp = 0.6f * at->ku;
+        at->ki = at->kp / (at->tu_s / 2.0f);
+        at->kd = at->kp * at->tu_s / 8.0f;
+        at->phase = AUTOTUNE_DONE;
+    } else if (at->cycles >= AUTOTUNE_MAX_CYCLES) {
+        at->phase = AUTOTUNE_FAILED;
+        at->error = "no steady oscillation";
+    }
+}
+
+float autotune_step(Autotune* at, float temp, uint32_t now_ms) {
+    if (at->phase != AUTOTUNE_HEATING && at->phase != AUTOTUNE_RELAY) return 0.0f;
+
+    if (temp > AUTOTUNE_MAX_TEMP_C) {
+        at->phase = AUTOTUNE_FAILED;
+        at->error = "over temperature";
+        return 0.0f;
+    }
+    if (now_ms - at->start_ms > AUTOTUNE_TIMEOUT_MS) {
+        at->phase = AUTOTUNE_FAILED;
+        at->error = "timeout";
+        return 0.0f;
+    }
+
+    if (temp > at->max_temp) at->max_temp = temp;
+    if (temp < at->min_temp) at->min_temp = temp;
+
+    if (at->high && temp > at->setpoint + AUTOTUNE_HYSTERESIS_C) {
+        at->high = false;
+        at->high_ms = now_ms - at->high_since_ms;
+        at->low_since_ms = now_ms;
+        at->max_temp = temp;
+    } else if (!at->high && temp < at->setpoint - AUTOTUNE_HYSTERESIS_C) {
+        end_cycle(at, now_ms);
+        at->high = true;
+        at->high_since_ms = now_ms;
+        at->min_temp = temp;
+        if (at->phase != AUTOTUNE_RELAY) return 0.0f;
+    }
+
+    return at->high ? at->bias + at->d : at->bias - at->d;
+}
+
+uint8_t autotune_progress(const Autotune* at) {
+    switch (at->phase) {
+        case AUTOTUNE_HEATING: {
+            // Up to the setpoint, then down through it: 0-20 %
+            float span = at->setpoint - at->start_temp;
+            float done = (span > 0.0f) ? (at->max_temp - at->start_temp) / span : 1.0f;
+            if (done > 1.0f) done = 1.0f;
+            if (done < 0.0f) done = 0.0f;
+            return (uint8_t)(done * 20.0f);
+        }
+        case AUTOTUNE_RELAY: {
+            // The cycle count at which it can first converge reads as 95 %
+            uint32_t target = AUTOTUNE_MIN_CYCLES + 1;
+            uint32_t c = (at->cycles < target) ? at->cycles : target;
+            return (uint8_t)(20 + (75 * c) / target);
+        }
+        case AUTOTUNE_DONE:
+            return 100;
+        default:
+            return 0;
+    }
+}
@@ -0,0 +1,76 @@
+#ifndef AUTOTUNE_H
+#define AUTOTUNE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Relay auto-tune (Astrom-Hagglund) of one SSR's PID gains.
+//
+// The SSR is switched between bias + d and bias - d each time T1 crosses
+// the setpoint (with hysteresis), which makes the oven oscillate around
+// it. From the swing a and the period Tu of one cycle, the ultimate gain
+// is Ku = 4d / (pi * a). The bias starts at 50 % and is moved after each
+// cycle to even out the heating and cooling halves: the oven cools far
+// slower than it heats, a fixed 0/100 % relay would give a lopsided cycle.
+//
+// Tuning is done once two cycles in a row agree on Ku and Tu, and the
+// gains come from the classic Ziegler-Nichols rule: on the simulated
+// plant the softer variants leave a profile 10-17 C short of its peak,
+// the setpoint ramps needing all the gain they can get. The relay is
+// cut and the run failed above AUTOTUNE_MAX_TEMP_C, clear of the 260 C
+// fault limit of the alert task.
+//
+// The state machine (control/oven_control.cpp) steps it at 10 Hz.
+
+#define AUTOTUNE_SETPOINT_C     150.0f  // Soak temperature, where profiles spend the most time
+#define AUTOTUNE_HYSTERESIS_C   1.0f
+#define AUTOTUNE_MAX_TEMP_C     240.0f
+#define AUTOTUNE_MIN_CYCLES     3       // Cycles with an adjusted bias before it can converge
+#define AUTOTUNE_MAX_CYCLES     12
+#define AUTOTUNE_TOLERANCE      0.05f   // Ku and Tu of the last two cycles within 5 %
+#define AUTOTUNE_TIMEOUT_MS     (60u * 60u * 1000u)
+
+typedef enum {
+    AUTOTUNE_IDLE,
+    AUTOTUNE_HEATING,       // Full power up to the setpoint
+    AUTOTUNE_RELAY,         // Oscillating, cycles counted
+    AUTOTUNE_DONE,          // Ku/Tu and gains valid
+    AUTOTUNE_FAILED         // error says why, output 0
+} AutotunePhase;
+
+typedef struct {
+    AutotunePhase phase;
+    float setpoint;
+    float bias;             // Relay output is bias +/- d (%)
+    float d;
+    bool high;              // Relay on bias + d
+    uint32_t start_ms;
+    uint32_t high_since_ms;
+    uint32_t low_since_ms;
+    uint32_t high_ms;       // Length of the last high half-cycle
+    float start_temp;
+    float max_temp;         // Peak since the relay went low
+    float min_temp;         // Trough since it went high
+    uint32_t cycles;        // Complete cycles
+    float ku;               // Last cycle
+    float tu_s;
+    float prev_ku;
+    float prev_tu_s;
+    float kp;               // Per-second gains (DONE)
+    float ki;
+    float kd;
+    const char* error;
+} Autotune;
+
+void autotune_start(Autotune* at, float setpoint, float temp, uint32_t now_ms);
+
+// One step: T1 in, SSR power (%) out
+float autotune_step(Autotune* at, float temp, uint32_t now_ms);
+
+// Stopped from outside (STOP, fault): FAILED with this reason
+void autotune_abort(Autotune* at, const char* reason);
+
+// 0-100, for the UI
+uint8_t autotune_progress(const Autotune* at);
+
+#endif // AUTOTUNE_H
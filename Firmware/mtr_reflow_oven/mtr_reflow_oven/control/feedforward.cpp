@@ -0,0 +1,16 @@
+#include <cmath>
+#include "feedforward.h"
+
+bool fopdt_valid(const FopdtModel* m) {
+    return m->gain_c_per_pct > 0.0f && m->tau_s > 0.0f && m->dead_s >= 0.0f;
+}
+
+float fopdt_feedforward(const FopdtModel* m, float ahead_temp, float ahead_rate_c_per_s, float ambient_c) {
+    return (ahead_temp - ambient_c + m->tau_s * ahead_rate_c_per_s) / m->gain_c_per_pct;
+}
+
+float fopdt_step(const FopdtModel* m, float temp, float u_delayed, float ambient_c, float dt_s) {
+    // Exact for u held over the step
+    float steady = ambient_c + m->gain_c_per_pct * u_delayed;
+    return steady + (temp - steady) * expf(-dt_s / m->tau_s);
+}
@@ -0,0 +1,43 @@
+#ifndef FEEDFORWARD_H
+#define FEEDFORWARD_H
+
+#include <stdbool.h>
+
+// Feed-forward for profile tracking (profiles with "control": {"mode":
+// "feedforward"}, CONTROL_FEEDFORWARD).
+//
+// The oven is modelled as first order plus dead time (FOPDT), from the
+// heater command u (%) to the T1 reading:
+//
+//   tau * T'(t) = K * u(t - dead) - (T(t) - T_amb)
+//
+// Inverting it gives the power that keeps T on the setpoint r:
+//
+//   u(t) = (r(t + dead) - T_amb + tau * r'(t + dead)) / K
+//
+// The state machine evaluates the profile dead_s ahead (OvenMode
+// lookahead_temp/lookahead_rate) and the PID loop adds this power to its
+// own output, leaving the PID only the model error to correct. K, tau and
+// dead come from system.json ("model"), fitted from a run log by
+// sim/fopdt_fit.
+
+typedef struct {
+    float gain_c_per_pct;   // K: steady rise above ambient per % of heater power
+    float tau_s;            // Time constant
+    float dead_s;           // Dead time (element and probe lags)
+} FopdtModel;
+
+// Setpoint slope for the feed-forward, taken over this much of the profile
+#define FEEDFORWARD_RATE_MS 1000
+
+// A model the feed-forward can be computed from
+bool fopdt_valid(const FopdtModel* m);
+
+// Heater power (%) that holds T on a setpoint of ahead_temp rising at
+// ahead_rate, dead_s from now. Not clamped: negative on fast cooling.
+float fopdt_feedforward(const FopdtModel* m, float ahead_temp, float ahead_rate_c_per_s, float ambient_c);
+
+// Model response: T after dt_s with u_delayed (the command dead_s ago) held
+float fopdt_step(const FopdtModel* m, float temp, float u_delayed, float ambient_c, float dt_s);
+
+#endif // FEEDFORWARD_H
@@ -0,0 +1,53 @@
+#include <cstring>
+#include "hw_alert.h"
+
+void hw_alert_reset(HwAlert* a) {
+    memset((void*)a, 0, sizeof(*a));
+}
+
+void hw_alert_trip(HwAlert* a, int channel, uint32_t edge_us, uint32_t cutoff_us) {
+    a->sources = a->sources | ((channel == 2) ? HW_ALERT_T2 : HW_ALERT_T1);
+    a->edge_us = edge_us;
+    a->cutoff_us = cutoff_us;
+    a->last_cutoff_us = cutoff_us - edge_us;
+    if (a->last_cutoff_us > a->max_cutoff_us) a->max_cutoff_us = a->last_cutoff_us;
+    a->trips = a->trips + 1; // Last: the trip is complete when it shows
+}
+
+bool hw_alert_pending(const HwAlert* a) {
+    return a->latched != a->trips;
+}
+
+void hw_alert_latch(HwAlert* a, uint32_t now_us) {
+    a->latched = a->trips;
+    a->last_latch_us = now_us - a->edge_us;
+    if (a->last_latch_us > a->max_latch_us) a->max_latch_us = a->last_latch_us;
+}
+
+bool hw_alert_clear(HwAlert* a, bool asserted) {
+    uint32_t trips = a->trips;
+    if (trips == a->cleared) return true;
+    if (asserted || a->latched != trips) return false;
+    // A trip after the snapshot keeps trips ahead of cleared: still tripped
+    a->sources = 0;
+    a->cleared = trips;
+    return true;
+}
+
+bool hw_alert_tripped(const HwAlert* a) {
+    return a->trips != a->cleared;
+}
+
+HwAlertState hw_alert_state(const HwAlert* a) {
+    uint32_t trips = a->trips;
+    if (trips == a->cleared) return HW_ALERT_ARMED;
+    return (a->latched == trips) ? HW_ALERT_LATCHED : HW_ALERT_TRIPPED;
+}
+
+const char* hw_alert_state_name(HwAlertState state) {
+    switch (state) {
+        case HW_ALERT_TRIPPED: return "tripped";
+        case HW_ALERT_LATCHED: return "latched";
+        default:               return "armed";
+    }
+}
@@ -0,0 +1,67 @@
+#ifndef HW_ALERT_H
+#define HW_ALERT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Hardware over-temperature cutoff: the MCP9600 alert 1 outputs
+// (GPIO_T1_ALT1 / GPIO_T2_ALT1) programmed as comparators at
+// HW_ALERT_LIMIT_C, released HW_ALERT_HYST_C below it.
+//
+//   ARMED    -> TRIPPED  alert ISR: both SSRs already off, alert task notified
+//   TRIPPED  -> LATCHED  alert task: STATE_FAULT published
+//   LATCHED  -> ARMED    fault acknowledged (START/STOP), refused while an
+//                        alert output is still asserted
+//
+// The state is three counters, each with a single writer (trips: the ISR,
+// latched: the alert task, cleared: the acknowledging task), so the ISR on
+// one core and an acknowledgement on the other never lose a trip. The SSR
+// slots stay off while hw_alert_tripped().
+
+#define HW_ALERT_LIMIT_C    260.0f  // Same hard limit as the software check
+#define HW_ALERT_HYST_C     10      // Released below 250 C
+#define HW_ALERT_T1         0x01    // HwAlert.sources
+#define HW_ALERT_T2         0x02
+
+typedef enum {
+    HW_ALERT_ARMED,
+    HW_ALERT_TRIPPED,
+    HW_ALERT_LATCHED
+} HwAlertState;
+
+typedef struct {
+    volatile uint32_t trips;        // Asserting edges (ISR)
+    volatile uint32_t latched;      // Trips seen by the state machine (alert task)
+    volatile uint32_t cleared;      // Trips acknowledged
+    volatile uint8_t sources;       // HW_ALERT_T1/T2 since the last acknowledgement
+    volatile uint32_t edge_us;      // Last trip: interrupt taken...
+    volatile uint32_t cutoff_us;    // ...SSRs off
+    // Latencies from the interrupt, us
+    volatile uint32_t last_cutoff_us, max_cutoff_us;    // SSRs off
+    uint32_t last_latch_us, max_latch_us;               // STATE_FAULT published
+} HwAlert;
+
+void hw_alert_reset(HwAlert* a);
+
+// Alert ISR, after both SSRs were switched off: channel 1 or 2, time the
+// interrupt was taken and time the SSRs went off
+void hw_alert_trip(HwAlert* a, int channel, uint32_t edge_us, uint32_t cutoff_us);
+
+// Alert task: a trip not yet in the state machine?
+bool hw_alert_pending(const HwAlert* a);
+
+// Alert task, once STATE_FAULT is published for it
+void hw_alert_latch(HwAlert* a, uint32_t now_us);
+
+// Fault acknowledgement: false (and nothing cleared) while an alert output
+// is asserted or a trip has not reached the state machine yet. true when
+// there was nothing to clear.
+bool hw_alert_clear(HwAlert* a, bool asserted);
+
+// SSRs held off
+bool hw_alert_tripped(const HwAlert* a);
+
+HwAlertState hw_alert_state(const HwAlert* a);
+const char* hw_alert_state_name(HwAlertState state);
+
+#endif // HW_ALERT_H
@@ -0,0 +1,53 @@
+#ifndef I2C_BUS_H
+#define I2C_BUS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+// Asynchronous transaction engine for the sensor bus (I2C_PORT).
+// Target: i2c_bus_rp2040.cpp (IRQ-driven, no CPU on the wire).
+// Host: sim/i2c_bus_sim.cpp (MCP9600 register model on the plant).
+//
+// Transactions are queued and run back to back by the I2C IRQ. The
+// engine serialises the bus: no mutex is needed around it. Completion
+// sets result and done_us and notifies the submitting task
+// (xTaskNotifyGive on its default notification slot).
+
+#define I2C_BUS_QUEUE_LEN   8
+#define I2C_BUS_MAX_XFER    16   // tx_len + rx_len, the controller FIFO depth
+#define I2C_BUS_PENDING     (-100)
+#define I2C_BUS_ERR_NACK    (-1)  // Address or data not acknowledged
+#define I2C_BUS_ERR_TIMEOUT (-2)  // No completion, engine reset
+
+typedef struct {
+    uint8_t addr;
+    const uint8_t* tx;      // Written first (e.g. register pointer)
+    uint8_t tx_len;
+    uint8_t* rx;            // Then read after a repeated start
+    uint8_t rx_len;
+    TaskHandle_t notify;    // Task notified on completion (may be NULL)
+    volatile int result;    // I2C_BUS_PENDING, bytes transferred or I2C_BUS_ERR_*
+    volatile uint32_t done_us; // Completion time (sample timestamp)
+} I2cTransaction;
+
+// After i2c_init() of the port: claims the IRQ
+void i2c_bus_init(void);
+
+// Queue a transaction. The struct must stay alive until it completes.
+// false if the queue is full or the transaction is too long.
+bool i2c_bus_submit(I2cTransaction* t);
+
+// Submit and wait (blocked, not spinning) for completion.
+// Returns t->result. Must be called from a task.
+int i2c_bus_transfer(I2cTransaction* t, uint32_t timeout_ms);
+
+// Completed / failed transactions since boot
+uint32_t i2c_bus_completed(void);
+uint32_t i2c_bus_errors(void);
+
+// Microsecond time base used for done_us
+uint32_t i2c_bus_time_us(void);
+
+#endif // I2C_BUS_H
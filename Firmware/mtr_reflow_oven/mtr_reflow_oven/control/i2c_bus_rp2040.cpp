@@ -0,0 +1,167 @@
+#include "i2c_bus.h"
+#include "hardware/i2c.h"
+#include "hardware/irq.h"
+#include "pico/time.h"
+#include "../board_config.h"
+
+// The DW_apb_i2c controller takes the whole transaction as command words:
+// write bytes, then read commands (RESTART on the first, STOP on the last).
+// Transactions fit in the 16-entry TX FIFO, so they are loaded in one go
+// and the IRQ only collects RX bytes and reacts to STOP_DET / TX_ABRT.
+
+#define I2C_BUS_IRQ (I2C0_IRQ + i2c_hw_index(I2C_PORT))
+
+static I2cTransaction* queue[I2C_BUS_QUEUE_LEN];
+static volatile uint32_t q_head = 0;     // Next free slot
+static volatile uint32_t q_tail = 0;     // Current transaction
+static volatile bool busy = false;
+static volatile bool aborted = false;
+static volatile uint8_t rx_pos = 0;
+static volatile uint32_t completed = 0;
+static volatile uint32_t errors = 0;
+
+static void start_transaction(I2cTransaction* t) {
+    i2c_hw_t* hw = i2c_get_hw(I2C_PORT);
+    hw->enable = 0;
+    hw->tar = t->addr;
+    hw->enable = I2C_IC_ENABLE_ENABLE_BITS;
+
+    aborted = false;
+    rx_pos = 0;
+    for (uint8_t i = 0; i < t->tx_len; i++) {
+        bool last = (i + 1 == t->tx_len) && t->rx_len == 0;
+        hw->data_cmd = t->tx[i] | (last ? I2C_IC_DATA_CMD_STOP_BITS : 0);
+    }
+    for (uint8_t i = 0; i < t->rx_len; i++) {
+        uint32_t cmd = I2C_IC_DATA_CMD_CMD_BITS;
+        if (i == 0 && t->tx_len > 0) cmd |= I2C_IC_DATA_CMD_RESTART_BITS;
+        if (i + 1 == t->rx_len) cmd |= I2C_IC_DATA_CMD_STOP_BITS;
+        hw->data_cmd = cmd;
+    }
+    hw->rx_tl = 0; // RX_FULL on every byte
+    hw->intr_mask = I2C_IC_INTR_MASK_M_RX_FULL_BITS | I2C_IC_INTR_MASK_M_STOP_DET_BITS | I2C_IC_INTR_MASK_M_TX_ABRT_BITS;
+}
+
+// Completes the current transaction and starts the next one (IRQ or critical section)
+static void finish_current(int result, BaseType_t* woken) {
+    I2cTransaction* t = queue[q_tail % I2C_BUS_QUEUE_LEN];
+    t->done_us = time_us_32();
+    t->result = result;
+    if (result < 0) errors = errors + 1;
+    else completed = completed + 1;
+    q_tail = q_tail + 1;
+
+    if (q_tail != q_head) {
+        start_transaction(queue[q_tail % I2C_BUS_QUEUE_LEN]);
+    } else {
+        busy = false;
+        i2c_get_hw(I2C_PORT)->intr_mask = 0;
+    }
+    if (t->notify) vTaskNotifyGiveFromISR(t->notify, woken);
+}
+
+static void __isr i2c_bus_isr(void) {
+    i2c_hw_t* hw = i2c_get_hw(I2C_PORT);
+    UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+    BaseType_t woken = pdFALSE;
+
+    if (busy) {
+        I2cTransaction* t = queue[q_tail % I2C_BUS_QUEUE_LEN];
+        uint32_t stat = hw->intr_stat;
+
+        if (stat & I2C_IC_INTR_STAT_R_TX_ABRT_BITS) {
+            (void)hw->clr_tx_abrt; // Controller flushes the FIFO and sends STOP
+            aborted = true;
+        }
+        while (hw->rxflr) {
+            uint8_t b = (uint8_t)hw->data_cmd;
+            if (rx_pos < t->rx_len) t->rx[rx_pos++] = b;
+        }
+        if (stat & I2C_IC_INTR_STAT_R_STOP_DET_BITS) {
+            (void)hw->clr_stop_det;
+            bool ok = !aborted && rx_pos == t->rx_len;
+            finish_current(ok ? (int)(t->tx_len + t->rx_len) : I2C_BUS_ERR_NACK, &woken);
+        }
+    } else {
+        (void)hw->clr_intr;
+        hw->intr_mask = 0;
+    }
+
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+    portYIELD_FROM_ISR(woken);
+}
+
+void i2c_bus_init(void) {
+    i2c_hw_t* hw = i2c_get_hw(I2C_PORT);
+    hw->intr_mask = 0;
+    (void)hw->clr_intr;
+    irq_set_exclusive_handler(I2C_BUS_IRQ, i2c_bus_isr);
+    irq_set_enabled(I2C_BUS_IRQ, true);
+}
+
+bool i2c_bus_submit(I2cTransaction* t) {
+    if (t->tx_len + t->rx_len == 0 || t->tx_len + t->rx_len > I2C_BUS_MAX_XFER) return false;
+    t->result = I2C_BUS_PENDING;
+
+    taskENTER_CRITICAL();
+    if (q_head - q_tail >= I2C_BUS_QUEUE_LEN) {
+        taskEXIT_CRITICAL();
+        return false;
+    }
+    queue[q_head % I2C_BUS_QUEUE_LEN] = t;
+    q_head = q_head + 1;
+    if (!busy) {
+        busy = true;
+        start_transaction(t);
+    }
+    taskEXIT_CRITICAL();
+    return true;
+}
+
+int i2c_bus_transfer(I2cTransaction* t, uint32_t timeout_ms) {
+    t->notify = xTaskGetCurrentTaskHandle();
+    ulTaskNotifyTake(pdTRUE, 0); // Drop a stale completion
+    if (!i2c_bus_submit(t)) return I2C_BUS_ERR_TIMEOUT;
+
+    TickType_t deadline = xTaskGetTickCount() + pdMS_TO_TICKS(timeout_ms);
+    while (t->result == I2C_BUS_PENDING) {
+        TickType_t now = xTaskGetTickCount();
+        if ((int32_t)(deadline - now) <= 0) break;
+        ulTaskNotifyTake(pdTRUE, deadline - now);
+    }
+
+    if (t->result == I2C_BUS_PENDING) {
+        // Wedged bus (slave holding SDA...): fail everything queued, so no
+        // caller is left with a transaction the IRQ could still write to
+        TaskHandle_t to_notify[I2C_BUS_QUEUE_LEN];
+        int n = 0;
+        taskENTER_CRITICAL();
+        i2c_hw_t* hw = i2c_get_hw(I2C_PORT);
+        hw->intr_mask = 0;
+        hw->enable = 0;
+        while (q_tail != q_head) {
+            I2cTransaction* q = queue[q_tail % I2C_BUS_QUEUE_LEN];
+            q->done_us = time_us_32();
+            q->result = I2C_BUS_ERR_TIMEOUT;
+            errors = errors + 1;
+            if (q != t && q->notify) to_notify[n++] = q->notify;
+            q_tail = q_tail + 1;
+        }
+        busy = false;
+        taskEXIT_CRITICAL();
+        for (int i = 0; i < n; i++) xTaskNotifyGive(to_notify[i]);
+    }
+    return t->result;
+}
+
+uint32_t i2c_bus_completed(void) {
+    return completed;
+}
+
+uint32_t i2c_bus_errors(void) {
+    return errors;
+}
+
+uint32_t i2c_bus_time_us(void) {
+    return time_us_32();
+}
@@ -0,0 +1,421 @@
+#include "json_stream.h"
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+enum {
+    EXP_VALUE,              // Root value, after ':' or ',' in an array
+    EXP_VALUE_OR_END,       // After '['
+    EXP_KEY_OR_END,         // After '{'
+    EXP_KEY,                // After ',' in an object
+    EXP_COLON,
+    EXP_COMMA_OR_END,       // After a value in a container
+    EXP_NOTHING             // After the root value
+};
+
+enum {
+    LEX_NONE,
+    LEX_STRING,
+    LEX_ESCAPE,             // After '\'
+    LEX_UNICODE,            // \uXXXX digits
+    LEX_NUMBER,
+    LEX_LITERAL             // true / false / null
+};
+
+#define JSON_NUMBER_MAX 24  // Longest number token accepted
+
+void json_stream_init(JsonStream* js, json_event_cb cb, void* ctx) {
+    memset(js, 0, sizeof(*js));
+    js->cb = cb;
+    js->ctx = ctx;
+    js->expect = EXP_VALUE;
+    js->line = 1;
+    js->column = 1;
+}
+
+void json_stream_fail(JsonStream* js, const char* fmt, ...) {
+    if (js->failed) return; // Keep the first error
+    js->failed = true;
+    js->error.line = js->tok_line;
+    js->error.column = js->tok_column;
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(js->error.message, sizeof(js->error.message), fmt, args);
+    va_end(args);
+}
+
+// --- Position ---
+
+bool json_stream_at(const JsonStream* js, const char* path) {
+    const char* p = path;
+    for (uint8_t level = 0; level < js->depth; level++) {
+        if (js->container[level] == '[') {
+            if (p[0] != '[' || p[1] != ']') return false;
+            p += 2;
+        } else {
+            if (level > 0 && *p++ != '.') return false;
+            const char* k = js->key[level];
+            while (*k && *p == *k) { p++; k++; }
+            if (*k) return false;
+            if (*p != 0 && *p != '.' && *p != '[') return false;
+        }
+    }
+    return *p == 0;
+}
+
+void json_stream_path(const JsonStream* js, char* out, size_t size) {
+    size_t n = 0;
+    out[0] = 0;
+    for (uint8_t level = 0; level < js->depth && n < size; level++) {
+        if (js->container[level] == '[') {
+            n += snprintf(out + n, size - n, "[%ld]", (long)js->index[level]);
+        } else {
+            n += snprintf(out + n, size - n, "%s%s", level ? "." : "", js->key[level]);
+        }
+    }
+}
+
+int json_stream_index(const JsonStream* js) {
+    for (int level = js->depth - 1; level >= 0; level--) {
+        if (js->container[level] == '[') return js->index[level];
+    }
+    return -1;
+}
+
+// --- Values ---
+
+static bool emit(JsonStream* js, const JsonEvent* ev) {
+    if (!js->cb(js, ev, js->ctx)) {
+        json_stream_fail(js, "rejected"); // Callback returned false without a reason
+        return false;
+    }
+    return true;
+}
+
+static void value_done(JsonStream* js) {
+    js->expect = js->depth ? EXP_COMMA_OR_END : EXP_NOTHING;
+    if (!js->depth) js->done = true;
+}
+
+static bool emit_scalar(JsonStream* js, JsonEventType type) {
+    JsonEvent ev = {};
+    ev.type = type;
+    if (type == JSON_EV_STRING) {
+        ev.str = js->buf;
+        ev.str_len = js->len;
+        ev.truncated = js->truncated;
+    }
+    if (type == JSON_EV_BOOL) ev.boolean = (js->lit[0] == 't');
+    if (!emit(js, &ev)) return false;
+    value_done(js);
+    return true;
+}
+
+// JSON number grammar, mantissa kept to 9 digits: enough for a float
+static bool parse_number(const char* s, float* out) {
+    const char* p = s;
+    bool neg = (*p == '-');
+    if (neg) p++;
+    if (*p < '0' || *p > '9') return false;
+    if (p[0] == '0' && p[1] >= '0' && p[1] <= '9') return false; // Leading zero
+
+    uint32_t mant = 0;
+    int exp10 = 0;
+    for (; *p >= '0' && *p <= '9'; p++) {
+        if (mant < 100000000u) mant = mant * 10 + (*p - '0');
+        else exp10++;
+    }
+    if (*p == '.') {
+        p++;
+        if (*p < '0' || *p > '9') return false;
+        for (; *p >= '0' && *p <= '9'; p++) {
+            if (mant < 100000000u) {
+                mant = mant * 10 + (*p - '0');
+                exp10--;
+            }
+        }
+    }
+    if (*p == 'e' || *p == 'E') {
+        p++;
+        int sign = 1;
+        if (*p == '+' || *p == '-') sign = (*p++ == '-') ? -1 : 1;
+        if (*p < '0' || *p > '9') return false;
+        int e = 0;
+        for (; *p >= '0' && *p <= '9'; p++) {
+            if (e < 100) e = e * 10 + (*p - '0');
+        }
+        exp10 += sign * e;
+    }
+    if (*p != 0) return false;
+
+    // One rounding for |exp10| <= 10 (powers of ten exact in a float)
+    float scale = 1.0f;
+    int n = exp10 < 0 ? -exp10 : exp10;
+    if (n > 45) n = 45;
+    while (n--) scale *= 10.0f;
+    float v = (exp10 < 0) ? (float)mant / scale : (float)mant * scale;
+    *out = neg ? -v : v;
+    return true;
+}
+
+static bool finish_number(JsonStream* js) {
+    js->buf[js->len] = 0;
+    JsonEvent ev = {};
+    ev.type = JSON_EV_NUMBER;
+    if (js->truncated || !parse_number(js->buf, &ev.number)) {
+        json_stream_fail(js, "invalid number '%s'", js->buf);
+        return false;
+    }
+    js->lex = LEX_NONE;
+    if (!emit(js, &ev)) return false;
+    value_done(js);
+    return true;
+}
+
+static bool finish_string(JsonStream* js) {
+    js->buf[js->len] = 0;
+    js->lex = LEX_NONE;
+    if (!js->lex_key) return emit_scalar(js, JSON_EV_STRING);
+
+    if (js->truncated) {
+        json_stream_fail(js, "key '%s...' longer than %d", js->buf, JSON_STREAM_KEY_MAX - 1);
+        return false;
+    }
+    memcpy(js->key[js->depth - 1], js->buf, js->len + 1);
+    js->expect = EXP_COLON;
+    return true;
+}
+
+static void string_put(JsonStream* js, char c) {
+    size_t max = js->lex_key ? JSON_STREAM_KEY_MAX - 1 : JSON_STREAM_STR_MAX - 1;
+    if (js->len < max) js->buf[js->len++] = c;
+    else js->truncated = true;
+}
+
+// \uXXXX as UTF-8 (surrogate pairs are not combined)
+static void string_put_code(JsonStream* js, uint16_t code) {
+    if (code < 0x80) {
+        string_put(js, (char)code);
+    } else if (code < 0x800) {
+        string_put(js, (char)(0xC0 | (code >> 6)));
+        string_put(js, (char)(0x80 | (code & 0x3F)));
+    } else {
+        string_put(js, (char)(0xE0 | (code >> 12)));
+        string_put(js, (char)(0x80 | ((code >> 6) & 0x3F)));
+        string_put(js, (char)(0x80 | (code & 0x3F)));
+    }
+}
+
+// --- Containers ---
+
+static bool open_container(JsonStream* js, char c) {
+    if (js->depth >= JSON_STREAM_MAX_DEPTH) {
+        json_stream_fail(js, "nested deeper than %d", JSON_STREAM_MAX_DEPTH);
+        return false;
+    }
+    JsonEvent ev = {};
+    ev.type = (c == '{') ? JSON_EV_OBJECT_BEGIN : JSON_EV_ARRAY_BEGIN;
+    if (!emit(js, &ev)) return false;
+
+    js->container[js->depth] = c;
+    js->key[js->depth][0] = 0;
+    js->index[js->depth] = -1;
+    js->depth++;
+    js->expect = (c == '{') ? EXP_KEY_OR_END : EXP_VALUE_OR_END;
+    return true;
+}
+
+static bool close_container(JsonStream* js, char c) {
+    char open = (c == '}') ? '{' : '[';
+    if (!js->depth || js->container[js->depth - 1] != open) {
+        json_stream_fail(js, "unexpected '%c'", c);
+        return false;
+    }
+    js->depth--;
+    JsonEvent ev = {};
+    ev.type = (c == '}') ? JSON_EV_OBJECT_END : JSON_EV_ARRAY_END;
+    if (!emit(js, &ev)) return false;
+    value_done(js);
+    return true;
+}
+
+// --- Grammar ---
+
+static bool start_value(JsonStream* js, char c) {
+    if (js->depth && js->container[js->depth - 1] == '[') js->index[js->depth - 1]++;
+
+    if (c == '{' || c == '[') return open_container(js, c);
+    if (c == '"') {
+        js->lex = LEX_STRING;
+        js->lex_key = false;
+        js->len = 0;
+        js->truncated = false;
+        return true;
+    }
+    if (c == '-' || (c >= '0' && c <= '9')) {
+        js->lex = LEX_NUMBER;
+        js->len = 0;
+        js->truncated = false;
+        js->buf[js->len++] = c;
+        return true;
+    }
+    if (c == 't' || c == 'f' || c == 'n') {
+        js->lex = LEX_LITERAL;
+        js->lit = (c == 't') ? "true" : (c == 'f') ? "false" : "null";
+        js->lit_pos = 1;
+        return true;
+    }
+    json_stream_fail(js, "unexpected '%c', expected a value", c);
+    return false;
+}
+
+static bool structural(JsonStream* js, char c) {
+    if (c == ' ' || c == '\t' || c == '\r' || c == '\n') return true;
+    js->tok_line = js->line;
+    js->tok_column = js->column;
+
+    switch (js->expect) {
+        case EXP_VALUE_OR_END:
+            if (c == ']') return close_container(js, c);
+            return start_value(js, c);
+        case EXP_VALUE:
+            return start_value(js, c);
+        case EXP_KEY_OR_END:
+            if (c == '}') return close_container(js, c);
+            // Fall through
+        case EXP_KEY:
+            if (c != '"') {
+                json_stream_fail(js, "unexpected '%c', expected a key", c);
+                return false;
+            }
+            js->lex = LEX_STRING;
+            js->lex_key = true;
+            js->len = 0;
+            js->truncated = false;
+            return true;
+        case EXP_COLON:
+            if (c != ':') {
+                json_stream_fail(js, "expected ':' after \"%s\"", js->key[js->depth - 1]);
+                return false;
+            }
+            js->expect = EXP_VALUE;
+            return true;
+        case EXP_COMMA_OR_END:
+            if (c == '}' || c == ']') return close_container(js, c);
+            if (c != ',') {
+                json_stream_fail(js, "unexpected '%c', expected ',' or end", c);
+                return false;
+            }
+            js->expect = (js->container[js->depth - 1] == '{') ? EXP_KEY : EXP_VALUE;
+            return true;
+        default:
+            json_stream_fail(js, "unexpected '%c' after the document", c);
+            return false;
+    }
+}
+
+static bool lexeme(JsonStream* js, char c) {
+    switch (js->lex) {
+        case LEX_STRING:
+            if (c == '"') return finish_string(js);
+            if (c == '\\') {
+                js->lex = LEX_ESCAPE;
+                return true;
+            }
+            if ((uint8_t)c < 0x20) {
+                json_stream_fail(js, "control character in string");
+                return false;
+            }
+            string_put(js, c);
+            return true;
+
+        case LEX_ESCAPE: {
+            const char* from = "\"\\/bfnrt";
+            const char* to = "\"\\/\b\f\n\r\t";
+            const char* hit = (c != 0) ? strchr(from, c) : NULL;
+            if (hit) {
+                string_put(js, to[hit - from]);
+                js->lex = LEX_STRING;
+                return true;
+            }
+            if (c == 'u') {
+                js->lex = LEX_UNICODE;
+                js->esc_code = 0;
+                js->esc_digits = 0;
+                return true;
+            }
+            json_stream_fail(js, "invalid escape '\\%c'", c);
+            return false;
+        }
+
+        case LEX_UNICODE: {
+            int d = (c >= '0' && c <= '9') ? c - '0' : (c >= 'a' && c <= 'f') ? c - 'a' + 10 :
+                    (c >= 'A' && c <= 'F') ? c - 'A' + 10 : -1;
+            if (d < 0) {
+                json_stream_fail(js, "invalid \\u escape");
+                return false;
+            }
+            js->esc_code = (uint16_t)((js->esc_code << 4) | d);
+            if (++js->esc_digits == 4) {
+                string_put_code(js, js->esc_code);
+                js->lex = LEX_STRING;
+            }
+            return true;
+        }
+
+        case LEX_LITERAL:
+            if (c != js->lit[js->lit_pos]) {
+                json_stream_fail(js, "invalid literal, expected '%s'", js->lit);
+                return false;
+            }
+            if (js->lit[++js->lit_pos] == 0) {
+                js->lex = LEX_NONE;
+                return emit_scalar(js, js->lit[0] == 'n' ? JSON_EV_NULL : JSON_EV_BOOL);
+            }
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+bool json_stream_feed(JsonStream* js, const char* data, size_t len) {
+    for (size_t i = 0; i < len && !js->failed; i++) {
+        char c = data[i];
+
+        // A number ends at the first byte that cannot continue it
+        if (js->lex == LEX_NUMBER) {
+            if ((c >= '0' && c <= '9') || c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-') {
+                if (js->len < JSON_NUMBER_MAX) js->buf[js->len++] = c;
+                else js->truncated = true;
+                js->column++;
+                continue;
+            }
+            if (!finish_number(js)) break;
+        }
+
+        if (js->lex == LEX_NONE) structural(js, c);
+        else lexeme(js, c);
+
+        if (c == '\n') {
+            js->line++;
+            js->column = 1;
+        } else {
+            js->column++;
+        }
+    }
+    return !js->failed;
+}
+
+bool json_stream_finish(JsonStream* js) {
+    if (js->failed) return false;
+    if (js->lex == LEX_NUMBER && !finish_number(js)) return false;
+    if (!js->done) {
+        js->tok_line = js->line;
+        js->tok_column = js->column;
+        if (js->depth) json_stream_fail(js, "unexpected end, %d container(s) open", js->depth);
+        else json_stream_fail(js, "empty document");
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,110 @@
+#ifndef JSON_STREAM_H
+#define JSON_STREAM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// Streaming (SAX-style) JSON parser: text is fed in chunks of any size and
+// each value is reported to a callback as soon as it is complete. Nothing
+// is allocated: the whole state, key path and string buffer included, is
+// the JsonStream struct (on the caller's stack), so the footprint does not
+// depend on the document.
+//
+// Limits, reported as errors: JSON_STREAM_MAX_DEPTH nested containers,
+// keys of JSON_STREAM_KEY_MAX - 1 bytes. String values longer than
+// JSON_STREAM_STR_MAX - 1 bytes are truncated (JsonEvent.truncated).
+// Numbers are parsed to float without strtod/double.
+//
+// Errors carry the line and column (1-based, bytes) of the offending
+// token. The callback rejects a document (schema error) by calling
+// json_stream_fail() and returning false.
+
+#define JSON_STREAM_MAX_DEPTH   6
+#define JSON_STREAM_KEY_MAX     24
+#define JSON_STREAM_STR_MAX     48
+
+typedef enum {
+    JSON_EV_OBJECT_BEGIN,
+    JSON_EV_OBJECT_END,
+    JSON_EV_ARRAY_BEGIN,
+    JSON_EV_ARRAY_END,
+    JSON_EV_STRING,
+    JSON_EV_NUMBER,
+    JSON_EV_BOOL,
+    JSON_EV_NULL
+} JsonEventType;
+
+typedef struct {
+    JsonEventType type;
+    const char* str;        // JSON_EV_STRING, NUL-terminated (UTF-8)
+    uint16_t str_len;
+    bool truncated;
+    float number;           // JSON_EV_NUMBER
+    bool boolean;           // JSON_EV_BOOL
+} JsonEvent;
+
+typedef struct {
+    uint32_t line;
+    uint32_t column;
+    char message[64];
+    bool io;                // The source or destination failed, not the document
+} JsonError;
+
+struct JsonStream;
+typedef bool (*json_event_cb)(struct JsonStream* js, const JsonEvent* ev, void* ctx);
+
+typedef struct JsonStream {
+    json_event_cb cb;
+    void* ctx;
+
+    // Open containers. The event's position is the innermost level: the
+    // member key in an object, the element index in an array.
+    uint8_t depth;
+    char container[JSON_STREAM_MAX_DEPTH];      // '{' or '['
+    char key[JSON_STREAM_MAX_DEPTH][JSON_STREAM_KEY_MAX];
+    int32_t index[JSON_STREAM_MAX_DEPTH];
+
+    // Grammar and token state
+    uint8_t expect;
+    uint8_t lex;
+    bool lex_key;           // Current string is a member key
+    uint8_t lit_pos;
+    const char* lit;
+    char buf[JSON_STREAM_STR_MAX];
+    uint16_t len;
+    bool truncated;
+    uint16_t esc_code;
+    uint8_t esc_digits;
+
+    uint32_t line;
+    uint32_t column;
+    uint32_t tok_line;
+    uint32_t tok_column;
+    bool done;              // Root value complete
+    bool failed;
+    JsonError error;
+} JsonStream;
+
+void json_stream_init(JsonStream* js, json_event_cb cb, void* ctx);
+
+// Next chunk of the document. false once an error occurred (js->error).
+bool json_stream_feed(JsonStream* js, const char* data, size_t len);
+
+// End of the input: false if the document is incomplete or failed
+bool json_stream_finish(JsonStream* js);
+
+// Called from the callback: records a schema error at the current token
+void json_stream_fail(JsonStream* js, const char* fmt, ...);
+
+// Does the current event sit at path? Members are separated by '.', array
+// elements written "[]", e.g. "pid_params.ssr1.kp" or "segments[].type".
+bool json_stream_at(const JsonStream* js, const char* path);
+
+// Current position as text ("segments[3].slope") for error messages
+void json_stream_path(const JsonStream* js, char* out, size_t size);
+
+// Index of the innermost array element (-1 if not in an array)
+int json_stream_index(const JsonStream* js);
+
+#endif // JSON_STREAM_H
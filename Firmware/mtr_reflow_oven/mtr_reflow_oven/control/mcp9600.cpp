@@ -0,0 +1,156 @@
+#include "mcp9600.h"
+#include "i2c_bus.h"
+#include <cmath>
+
+static const float MCP9600_LSB_C = 0.0625f;
+static const uint32_t MCP9600_XFER_TIMEOUT_MS = 10;
+
+static float decode_temp(const uint8_t* b) {
+    return (int16_t)((b[0] << 8) | b[1]) * MCP9600_LSB_C;
+}
+
+// Register pointer write, repeated start, read
+static bool read_regs(uint8_t addr, uint8_t reg, uint8_t* dst, size_t len, uint32_t* time_us = NULL) {
+    I2cTransaction t = {};
+    t.addr = addr;
+    t.tx = &reg;
+    t.tx_len = 1;
+    t.rx = dst;
+    t.rx_len = (uint8_t)len;
+    if (i2c_bus_transfer(&t, MCP9600_XFER_TIMEOUT_MS) != (int)(len + 1)) return false;
+    if (time_us) *time_us = t.done_us;
+    return true;
+}
+
+static bool write_reg(uint8_t addr, uint8_t reg, uint8_t value) {
+    uint8_t buf[2] = { reg, value };
+    I2cTransaction t = {};
+    t.addr = addr;
+    t.tx = buf;
+    t.tx_len = 2;
+    return i2c_bus_transfer(&t, MCP9600_XFER_TIMEOUT_MS) == 2;
+}
+
+static bool write_reg16(uint8_t addr, uint8_t reg, uint16_t value) {
+    uint8_t buf[3] = { reg, (uint8_t)(value >> 8), (uint8_t)value };
+    I2cTransaction t = {};
+    t.addr = addr;
+    t.tx = buf;
+    t.tx_len = 3;
+    return i2c_bus_transfer(&t, MCP9600_XFER_TIMEOUT_MS) == 3;
+}
+
+static uint8_t tc_type_bits(char tc_type) {
+    switch (tc_type) {
+        case 'J': case 'j': return 1;
+        case 'T': case 't': return 2;
+        case 'N': case 'n': return 3;
+        case 'S': case 's': return 4;
+        case 'E': case 'e': return 5;
+        case 'B': case 'b': return 6;
+        case 'R': case 'r': return 7;
+        default:            return 0; // K
+    }
+}
+
+static uint8_t adc_res_bits(uint8_t adc_bits) {
+    switch (adc_bits) {
+        case 18: return 0;
+        case 14: return 2;
+        case 12: return 3;
+        default: return 1; // 16 bits
+    }
+}
+
+bool mcp9600_init(Mcp9600* dev, uint8_t addr, char tc_type, uint8_t filter, uint8_t adc_bits) {
+    dev->addr = addr;
+    dev->present = false;
+    dev->burst_ok = false;
+    dev->adc_bits = adc_bits;
+
+    uint8_t id[2];
+    if (!read_regs(addr, MCP9600_REG_DEVICE_ID, id, 2)) return false;
+    if (id[0] != MCP9600_ID_MCP9600 && id[0] != MCP9600_ID_MCP9601) return false;
+    dev->device_id = id[0];
+
+    uint8_t sensor_cfg = (uint8_t)((tc_type_bits(tc_type) << 4) | (filter & 0x07));
+    uint8_t device_cfg = (uint8_t)(adc_res_bits(adc_bits) << 5); // CJ 0.0625, burst 1, normal mode
+    if (!write_reg(addr, MCP9600_REG_SENSOR_CFG, sensor_cfg)) return false;
+    if (!write_reg(addr, MCP9600_REG_DEVICE_CFG, device_cfg)) return false;
+
+    // Burst read relies on the register pointer advancing over TH/TD/TC.
+    // Check it once against a single-register read of TC and fall back to
+    // one read per register if the part does not do it.
+    uint8_t burst[6];
+    uint8_t cold[2];
+    if (!read_regs(addr, MCP9600_REG_HOT, burst, 6)) return false;
+    if (!read_regs(addr, MCP9600_REG_COLD, cold, 2)) return false;
+    dev->burst_ok = fabsf(decode_temp(&burst[4]) - decode_temp(cold)) < 1.0f &&
+                    !(burst[4] == burst[0] && burst[5] == burst[1] && burst[2] == burst[0] && burst[3] == burst[1]);
+
+    dev->present = true;
+    return true;
+}
+
+bool mcp9600_set_alert(Mcp9600* dev, uint8_t alert, float limit_c, uint8_t hyst_c) {
+    if (alert < 1 || alert > 4) return false;
+    uint8_t n = (uint8_t)(alert - 1);
+    // Same format as TH, the two low bits (below 0.25 degC) unused
+    uint16_t limit = (uint16_t)((int16_t)lroundf(limit_c / MCP9600_LSB_C) & ~3);
+    uint8_t cfg = MCP9600_ALERT_ENABLE | MCP9600_ALERT_RISING; // Comparator, active low, TH
+
+    // Output off while the limit changes
+    if (!write_reg(dev->addr, MCP9600_REG_ALERT_CFG + n, 0)) return false;
+    if (!write_reg(dev->addr, MCP9600_REG_ALERT_HYST + n, hyst_c)) return false;
+    if (!write_reg16(dev->addr, MCP9600_REG_ALERT_LIMIT + n, limit)) return false;
+    if (!write_reg(dev->addr, MCP9600_REG_ALERT_CFG + n, cfg)) return false;
+
+    uint8_t back_cfg, back_hyst, back_limit[2];
+    if (!read_regs(dev->addr, MCP9600_REG_ALERT_CFG + n, &back_cfg, 1)) return false;
+    if (!read_regs(dev->addr, MCP9600_REG_ALERT_HYST + n, &back_hyst, 1)) return false;
+    if (!read_regs(dev->addr, MCP9600_REG_ALERT_LIMIT + n, back_limit, 2)) return false;
+    return (back_cfg & 0x1F) == cfg && back_hyst == hyst_c &&
+           (uint16_t)((back_limit[0] << 8) | back_limit[1]) == limit;
+}
+
+uint32_t mcp9600_conversion_ms(uint8_t adc_bits) {
+    switch (adc_bits) {
+        case 18: return 320;
+        case 14: return 20;
+        case 12: return 5;
+        default: return 80;
+    }
+}
+
+bool mcp9600_read_status(Mcp9600* dev, uint8_t* status) {
+    return read_regs(dev->addr, MCP9600_REG_STATUS, status, 1);
+}
+
+bool mcp9600_read(Mcp9600* dev, uint8_t status, Mcp9600Reading* out) {
+    uint8_t b[6];
+    uint32_t t_us = 0;
+    if (dev->burst_ok) {
+        if (!read_regs(dev->addr, MCP9600_REG_HOT, b, 6, &t_us)) return false;
+    } else {
+        if (!read_regs(dev->addr, MCP9600_REG_HOT, &b[0], 2, &t_us)) return false;
+        if (!read_regs(dev->addr, MCP9600_REG_DELTA, &b[2], 2)) return false;
+        if (!read_regs(dev->addr, MCP9600_REG_COLD, &b[4], 2)) return false;
+    }
+    // Re-arm the data-ready flag (alert status bits are read-only)
+    if (status & MCP9600_STATUS_TH_UPDATE) write_reg(dev->addr, MCP9600_REG_STATUS, 0);
+
+    out->hot = decode_temp(&b[0]);
+    out->delta = decode_temp(&b[2]);
+    out->cold = decode_temp(&b[4]);
+    out->status = status;
+    out->time_us = t_us;
+    return true;
+}
+
+bool mcp9600_is_open(const Mcp9600Reading* r) {
+    return (r->status & MCP9600_STATUS_OPEN) != 0;
+}
+
+bool mcp9600_is_short(const Mcp9600Reading* r) {
+    return (r->status & MCP9600_STATUS_SHORT) != 0;
+}
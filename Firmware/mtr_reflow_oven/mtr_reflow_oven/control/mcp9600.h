@@ -0,0 +1,87 @@
+#ifndef MCP9600_H
+#define MCP9600_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// MCP9600/MCP9601 thermocouple EMF-to-temperature converter.
+// Register access goes through the I2C transaction engine (i2c_bus.h): the
+// calling task blocks on a task notification while the IRQ moves the bytes.
+//
+// The part converts continuously and raises STATUS.TH_UPDATE when a new
+// hot-junction value is ready. The sensor task sleeps for one conversion
+// time, polls the flag, reads and clears it: the conversion rate (ADC
+// resolution) sets the sample rate.
+
+// --- Registers ---
+#define MCP9600_REG_HOT         0x00  // Hot junction TH, 0.0625 degC/LSB
+#define MCP9600_REG_DELTA       0x01  // TH - TC
+#define MCP9600_REG_COLD        0x02  // Cold junction TC
+#define MCP9600_REG_RAW_ADC     0x03
+#define MCP9600_REG_STATUS      0x04
+#define MCP9600_REG_SENSOR_CFG  0x05  // TC type [6:4], filter [2:0]
+#define MCP9600_REG_DEVICE_CFG  0x06  // CJ res [7], ADC res [6:5], burst [4:2], mode [1:0]
+#define MCP9600_REG_ALERT_CFG   0x08  // Alert 1..4 configuration (0x08-0x0B)
+#define MCP9600_REG_ALERT_HYST  0x0C  // Alert 1..4 hysteresis, 1 degC/LSB (0x0C-0x0F)
+#define MCP9600_REG_ALERT_LIMIT 0x10  // Alert 1..4 limit, 0.25 degC in [15:2] (0x10-0x13)
+#define MCP9600_REG_DEVICE_ID   0x20  // ID byte then revision
+
+#define MCP9600_ID_MCP9600      0x40
+#define MCP9600_ID_MCP9601      0x41
+
+// --- STATUS bits ---
+#define MCP9600_STATUS_BURST_DONE   0x80
+#define MCP9600_STATUS_TH_UPDATE    0x40
+#define MCP9600_STATUS_SHORT        0x20  // MCP9601 only (reads 0 on MCP9600)
+#define MCP9600_STATUS_OPEN         0x10  // Input range exceeded / open circuit (MCP9601)
+#define MCP9600_STATUS_ALERTS       0x0F  // Alert 4..1 outputs
+
+// --- Alert configuration bits ---
+#define MCP9600_ALERT_ENABLE        0x01  // Output driven (open drain)
+#define MCP9600_ALERT_INTERRUPT     0x02  // Else comparator: follows the temperature, with hysteresis
+#define MCP9600_ALERT_ACTIVE_HIGH   0x04
+#define MCP9600_ALERT_RISING        0x08  // Asserts as the temperature rises through the limit
+#define MCP9600_ALERT_COLD          0x10  // Monitors TC, else TH
+#define MCP9600_ALERT_INT_CLEAR     0x80
+
+typedef struct {
+    uint8_t addr;
+    uint8_t device_id;      // MCP9600_ID_*
+    uint8_t adc_bits;
+    bool present;
+    bool burst_ok;          // TH/TD/TC come back from one read
+} Mcp9600;
+
+typedef struct {
+    float hot;              // degC
+    float delta;
+    float cold;
+    uint8_t status;         // MCP9600_STATUS_*
+    uint32_t time_us;       // Completion of the burst read (i2c_bus_time_us)
+} Mcp9600Reading;
+
+// Thermocouple type letter (K, J, T, N, S, E, B, R), IIR filter 0 (off)-7,
+// ADC resolution 12/14/16/18 bits (conversion 5/20/80/320 ms).
+// Returns false (dev->present = false) if nothing answers at addr.
+bool mcp9600_init(Mcp9600* dev, uint8_t addr, char tc_type, uint8_t filter, uint8_t adc_bits);
+
+// Alert 1-4 as an active-low comparator on the hot junction: asserted
+// from limit_c up, released once back under limit_c - hyst_c. Read back
+// and checked. false on a bus error or a mismatch.
+bool mcp9600_set_alert(Mcp9600* dev, uint8_t alert, float limit_c, uint8_t hyst_c);
+
+// Conversion time for an ADC resolution (= sample period)
+uint32_t mcp9600_conversion_ms(uint8_t adc_bits);
+
+// STATUS register. false on a bus error.
+bool mcp9600_read_status(Mcp9600* dev, uint8_t* status);
+
+// Hot, delta and cold junction (status from the last poll is passed in),
+// then clears TH_UPDATE for the next conversion. false on a bus error.
+bool mcp9600_read(Mcp9600* dev, uint8_t status, Mcp9600Reading* out);
+
+// Open/short decoding of a reading
+bool mcp9600_is_open(const Mcp9600Reading* r);
+bool mcp9600_is_short(const Mcp9600Reading* r);
+
+#endif // MCP9600_H
@@ -0,0 +1,695 @@
+#include <stdio.h>
+#include <cmath>
+#include "oven_control.h"
+#include "oven_hal.h"
+#include "run_log.h"
+#include "feedforward.h"
+#include "pid.h"
+#include "zone_control.h"
+#include "sensor_fusion.h"
+#include "hw_alert.h"
+#include "ssr_output.h"
+#include "mcp9600.h"
+#include "i2c_bus.h"
+#include "../board_config.h"
+#include "../comm/link_service.h"
+
+// --- Global Objects ---
+// Oven state lives in oven_state.cpp (lock-free channels)
+ReflowProfile currentProfile; // Global Profile Object
+ProfileTimeline currentTimeline;
+
+SystemConfig sysConfig;
+
+// --- Mutexes & Queues ---
+SemaphoreHandle_t mtx_OvenState = NULL; // Serialises mode-channel writers
+
+QueueHandle_t q_SensorData = NULL;
+
+// Hardware over-temperature trips (control/hw_alert.h)
+static HwAlert hw_alert;
+
+// --- Task Handles ---
+TaskHandle_t hAlertTask = NULL;
+TaskHandle_t hSensorTask = NULL;
+TaskHandle_t hPIDTask = NULL;
+
+void oven_control_init() {
+    mtx_OvenState = xSemaphoreCreateMutex();
+    
+    q_SensorData = xQueueCreate(5, sizeof(SensorData));
+    
+    // Default State Init
+    oven_state_init();
+    run_log_init();
+    hw_alert_reset(&hw_alert);
+    
+    // Config defaults until system.json is read
+    sysConfig.buzzer_volume = 100;
+    sysConfig.ssr1_window_ms = SSR_OUTPUT_DEFAULT_WINDOW_MS;
+    sysConfig.ssr2_window_ms = SSR_OUTPUT_DEFAULT_WINDOW_MS;
+    sysConfig.mains_hz = 0;
+    sysConfig.tc_type = 'K';
+    sysConfig.tc_filter = 1;
+    sysConfig.adc_bits = 16;
+    sysConfig.pid_ssr1_kp = sysConfig.pid_ssr2_kp = PID_DEFAULT_KP;
+    sysConfig.pid_ssr1_ki = sysConfig.pid_ssr2_ki = PID_DEFAULT_KI;
+    sysConfig.pid_ssr1_kd = sysConfig.pid_ssr2_kd = PID_DEFAULT_KD;
+    sysConfig.pid_i_limit_pct = PID_DEFAULT_I_LIMIT_PCT;
+    sysConfig.pid_d_filter_s = PID_DEFAULT_D_FILTER_S;
+    sysConfig.pid_slew_pct_s = PID_DEFAULT_SLEW_PCT_S;
+    sysConfig.zone_mode = ZONE_SHARED;
+    sysConfig.zone_ratio = ZONE_DEFAULT_RATIO;
+    sysConfig.zone_split_pct = ZONE_DEFAULT_SPLIT_PCT;
+    sysConfig.zone_trim_pct = ZONE_DEFAULT_TRIM_PCT;
+}
+
+// MCP9600 alert output asserted: the heaters go off here, in the
+// interrupt, whatever the tasks are doing. The alert task latches the fault.
+static void alert_isr(int channel, uint32_t edge_us) {
+    hal_ssr_set(1, false);
+    hal_ssr_set(2, false);
+    hw_alert_trip(&hw_alert, channel, edge_us, hal_time_us());
+    // Again, now that the trip is visible: a slot on the other core may
+    // have checked before it and written "on" after the writes above
+    hal_ssr_set(1, false);
+    hal_ssr_set(2, false);
+    
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(hAlertTask, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+void oven_control_start_tasks() {
+    xTaskCreate(vSensorPollerTask, "Sensors", 1024, NULL, 2, &hSensorTask); 
+    xTaskCreate(vPIDLoopTask, "PID", 1024, NULL, 2, &hPIDTask);
+    xTaskCreate(vAlertHandlingTask, "Alerts", 512, NULL, 5, &hAlertTask);
+    
+    // SSR outputs run from hardware alarms, not a task (control/ssr_output.cpp)
+    ssr_output_start();
+    
+    // MCP9600 alert pins, armed once the sensor task programs the limits
+    hal_alert_irq_start(alert_isr);
+}
+
+bool oven_alert_tripped() {
+    return hw_alert_tripped(&hw_alert);
+}
+
+HwAlert oven_hw_alert() {
+    return hw_alert;
+}
+
+#define ALERT_CHECK_MS  100   // Software checks, 10 Hz
+
+// STATE_FAULT, once (mtx_OvenState taken for the write only)
+static bool alert_raise_fault(const char* what) {
+    if (xSemaphoreTake(mtx_OvenState, pdMS_TO_TICKS(10)) != pdTRUE) return false;
+    OvenMode mode = oven_state_mode();
+    bool was_faulted = mode.fault_active;
+    mode.state = STATE_FAULT;
+    mode.fault_active = true;
+    oven_state_publish_mode(&mode);
+    xSemaphoreGive(mtx_OvenState);
+    if (!was_faulted) printf("!!! %s !!!\n", what);
+    return true;
+}
+
+void vAlertHandlingTask(void *pvParameters) {
+    (void)pvParameters;
+    TickType_t last_check = xTaskGetTickCount();
+    
+    for (;;) {
+        // Woken by the alert ISR (SSRs already off), or for the next check
+        TickType_t period = pdMS_TO_TICKS(ALERT_CHECK_MS);
+        TickType_t elapsed = xTaskGetTickCount() - last_check;
+        ulTaskNotifyTake(pdTRUE, (elapsed < period) ? period - elapsed : 0);
+        
+        // Hardware trip: into the state machine. Retried at the next wake
+        // if the lock is busy, the slots keep the SSRs off meanwhile.
+        if (hw_alert_pending(&hw_alert) && alert_raise_fault("HARDWARE OVERTEMP FAULT")) {
+            hw_alert_latch(&hw_alert, hal_time_us());
+            printf("[Alert] %s%s%s alert: SSRs off %lu us after the IRQ, fault latched after %lu us\n",
+                   (hw_alert.sources & HW_ALERT_T1) ? "T1" : "", (hw_alert.sources == (HW_ALERT_T1 | HW_ALERT_T2)) ? "+" : "",
+                   (hw_alert.sources & HW_ALERT_T2) ? "T2" : "",
+                   (unsigned long)hw_alert.last_cutoff_us, (unsigned long)hw_alert.last_latch_us);
+        }
+        
+        if (xTaskGetTickCount() - last_check < period) continue;
+        last_check += period;
+        
+        // Fused temperatures (control/sensor_fusion.h): no fault on a
+        // single bad reading, T2 counts too when connected
+        OvenTemps temps = oven_state_temps();
+        bool overtemp = temps.t1 > HW_ALERT_LIMIT_C || (temps.t2_connected && temps.t2 > HW_ALERT_LIMIT_C);
+        bool cross = (temps.flags & SENSOR_CROSS_FAULT) && oven_state_is_heating(oven_state_mode().state);
+        
+        // Software Limit Check, behind the hardware one
+        // The SSR output stage stops the elements at its next slot once it
+        // sees STATE_FAULT.
+        if ((overtemp || cross) && !oven_state_mode().fault_active) {
+            alert_raise_fault(overtemp ? "OVERTEMP FAULT" : "T1/T2 DISAGREE FAULT");
+        }
+    }
+}
+
+// --- Sensors ---
+#define SENSOR_READY_MARGIN_MS  2     // Wake this long before the conversion should end
+#define SENSOR_READY_POLL_MS    1     // Then poll STATUS.TH_UPDATE at this rate
+#define SENSOR_RETRY_MS         200   // T1 missing or bus error
+#define SENSOR_DISCOVER_MS      5000  // Probe for a (re)connected sensor
+#define SENSOR_T1_FAIL_LIMIT    3     // Failed T1 reads in a row before it is re-probed
+
+// --- PID ---
+#define PID_REF_PERIOD_S        0.2f  // Step the configured gains were tuned for
+#define PID_LATE_PCT            150   // Late: dt above 150 % of the sample period
+#define PID_SAMPLE_TIMEOUT_MS   500
+
+static Mcp9600 sensor_t1;
+static Mcp9600 sensor_t2;
+static SensorFusion fusion;
+
+static void sensors_discover(Mcp9600* dev, uint8_t addr) {
+    char type = sysConfig.tc_type ? sysConfig.tc_type : 'K';
+    if (mcp9600_init(dev, addr, type, (uint8_t)sysConfig.tc_filter, (uint8_t)sysConfig.adc_bits)) {
+        printf("[Sensors] MCP960%d at 0x%02X, type %c, %s read\n", dev->device_id == MCP9600_ID_MCP9601 ? 1 : 0,
+               addr, type, dev->burst_ok ? "burst" : "per-register");
+        // Hardware cutoff (control/hw_alert.h), again after a reconnection
+        if (!mcp9600_set_alert(dev, 1, HW_ALERT_LIMIT_C, HW_ALERT_HYST_C)) {
+            printf("[Sensors] 0x%02X: alert 1 not programmed, software limit only\n", addr);
+        }
+    }
+}
+
+// Reads one sensor and sets its SensorData flags (bits shifted by 4 for T2).
+// The reading is only meaningful when the VALID flag ends up set.
+static bool sensors_read(Mcp9600* dev, uint8_t status, SensorData* d, Mcp9600Reading* r, int shift, int alert_shift) {
+    if (!mcp9600_read(dev, status, r)) {
+        d->flags |= SENSOR_T1_BUS_ERR << shift;
+        return false;
+    }
+    d->flags |= (uint32_t)(r->status & MCP9600_STATUS_ALERTS) << alert_shift;
+    if (mcp9600_is_open(r)) d->flags |= SENSOR_T1_OPEN << shift;
+    if (mcp9600_is_short(r)) d->flags |= SENSOR_T1_SHORT << shift;
+    if (!(d->flags & ((SENSOR_T1_OPEN | SENSOR_T1_SHORT) << shift))) d->flags |= SENSOR_T1_VALID << shift;
+    return true;
+}
+
+// T2, when fitted: status and burst read into d
+static void sensors_read_t2(SensorData* d) {
+    if (!sensor_t2.present) return;
+    Mcp9600Reading r;
+    uint8_t status2 = 0;
+    d->flags |= SENSOR_T2_PRESENT;
+    if (mcp9600_read_status(&sensor_t2, &status2) &&
+        sensors_read(&sensor_t2, status2, d, &r, 4, SENSOR_ALERTS_SHIFT + 4)) {
+        d->t2 = r.hot;
+        d->delta2 = r.delta;
+    } else {
+        d->flags |= SENSOR_T2_BUS_ERR;
+        sensor_t2.present = false; // Unplugged
+    }
+}
+
+// Fused (control/sensor_fusion.h), numbered sample out to q_SensorData
+// (newest kept) and the published temperatures
+static void sensors_publish(SensorData* d, OvenTemps* temps) {
+    static uint32_t seq = 0;
+    FusionConfig fc;
+    fc.t1_offset = sysConfig.t1_offset;
+    fc.t2_offset = sysConfig.t2_offset;
+    fc.max_slope = currentProfile.max_slope;
+    fc.cross_check = sysConfig.enable_sensor2_check;
+    sensor_fusion_step(&fusion, &fc, d);
+    
+    d->seq = seq++;
+    d->period_ms = (uint16_t)mcp9600_conversion_ms(sensor_t1.adc_bits);
+    if (xQueueSend(q_SensorData, d, 0) != pdTRUE) {
+        SensorData stale;
+        xQueueReceive(q_SensorData, &stale, 0);
+        xQueueSend(q_SensorData, d, 0);
+    }
+    
+    // Published temperatures keep their last good value on error
+    if (d->flags & SENSOR_FUSED_VALID) temps->t1 = d->t1;
+    if (!std::isnan(d->amb)) temps->amb = d->amb;
+    temps->t2_connected = (d->flags & SENSOR_T2_VALID) != 0;
+    if (temps->t2_connected) temps->t2 = d->t2;
+    temps->confidence = d->confidence;
+    temps->flags = d->flags;
+    oven_state_publish_temps(temps);
+}
+
+void vSensorPollerTask(void *pvParameters) {
+    (void)pvParameters;
+    
+    // Sensor setup (I2C bus and transaction engine start in main())
+    sensors_discover(&sensor_t1, I2C_ADDR_MCP9600_T1);
+    sensors_discover(&sensor_t2, I2C_ADDR_MCP9600_T2);
+    if (!sensor_t1.present) printf("[Sensors] T1 MCP9600 not found!\n");
+    
+    uint32_t log_ms = 0;
+    uint32_t discover_ms = millis();
+    uint32_t t1_failures = 0;
+    OvenTemps temps = oven_state_temps();
+    sensor_fusion_reset(&fusion);
+
+    for (;;) {
+        uint32_t now = millis();
+        
+        // T2 is optional: look for it again every 5 s. T1 at each retry.
+        if (!sensor_t1.present) sensors_discover(&sensor_t1, I2C_ADDR_MCP9600_T1);
+        if (now - discover_ms >= SENSOR_DISCOVER_MS) {
+            discover_ms = now;
+            if (!sensor_t2.present) sensors_discover(&sensor_t2, I2C_ADDR_MCP9600_T2);
+        }
+        
+        SensorData d = {};
+        d.t1 = NAN;
+        d.t2 = NAN;
+        d.amb = NAN;
+        
+        // 1. Wait for T1's conversion (data-ready flag), it paces the loop
+        // On a failed read T2 still goes out: fusion stands it in for T1
+        uint8_t status1 = 0;
+        if (!sensor_t1.present || !mcp9600_read_status(&sensor_t1, &status1)) {
+            if (++t1_failures >= SENSOR_T1_FAIL_LIMIT) sensor_t1.present = false;
+            d.flags = SENSOR_T1_BUS_ERR;
+            sensors_read_t2(&d);
+            d.timestamp_us = i2c_bus_time_us();
+            sensors_publish(&d, &temps);
+            printf("[Sensors] MCP9600 Read Failed\n");
+            vTaskDelay(pdMS_TO_TICKS(SENSOR_RETRY_MS));
+            continue;
+        }
+        if (!(status1 & MCP9600_STATUS_TH_UPDATE)) {
+            vTaskDelay(pdMS_TO_TICKS(SENSOR_READY_POLL_MS));
+            continue;
+        }
+        
+        // 2. Burst read of every sensor
+        Mcp9600Reading r;
+        if (sensors_read(&sensor_t1, status1, &d, &r, 0, SENSOR_ALERTS_SHIFT)) {
+            d.timestamp_us = r.time_us;
+            d.t1 = r.hot;
+            d.delta1 = r.delta;
+            d.amb = r.cold;
+            t1_failures = 0;
+        } else {
+            d.timestamp_us = i2c_bus_time_us();
+            if (++t1_failures >= SENSOR_T1_FAIL_LIMIT) sensor_t1.present = false;
+        }
+        sensors_read_t2(&d);
+        sensors_publish(&d, &temps);
+        
+        if (!(d.flags & SENSOR_T1_VALID)) {
+            printf("[Sensors] T1 invalid (flags 0x%06X)\n", (unsigned)d.flags);
+        } else if (d.flags & SENSOR_T1_OUTLIER) {
+            printf("[Sensors] T1 outlier dropped (flags 0x%06X)\n", (unsigned)d.flags);
+        } else if (!link_streaming() && now - log_ms >= 2000) { // Log every 2s, unless streamed
+            log_ms = now;
+            printf("[Sensors] T1: %.2f C, T2: %.2f C, CJ: %.2f C%s\n", d.t1, d.t2, d.amb,
+                   (d.flags & SENSOR_DISAGREE) ? " (T1/T2 disagree)" : "");
+        }
+        
+        // 3. Sleep through most of the next conversion
+        uint32_t conv_ms = mcp9600_conversion_ms(sensor_t1.adc_bits);
+        vTaskDelay(pdMS_TO_TICKS(conv_ms > SENSOR_READY_MARGIN_MS ? conv_ms - SENSOR_READY_MARGIN_MS : 1));
+    }
+}
+
+SensorFusion oven_sensor_fusion() {
+    return fusion;
+}
+
+static PidLoopStats pid_stats;
+
+PidLoopStats oven_pid_stats() {
+    return pid_stats;
+}
+
+void vPIDLoopTask(void *pvParameters) {
+    (void)pvParameters;
+    
+    // One controller per SSR, coordinated per "zones" (control/zone_control.h)
+    static ZoneControl zones;
+    zone_control_reset(&zones);
+    
+    bool have_last = false;
+    uint32_t last_seq = 0;
+    uint32_t last_us = 0;
+    
+    for (;;) {
+        // Wake on each new sample from vSensorPollerTask
+        SensorData sample;
+        if (xQueueReceive(q_SensorData, &sample, pdMS_TO_TICKS(PID_SAMPLE_TIMEOUT_MS)) != pdTRUE) {
+            // Sensor task stalled: do not keep heating on an old reading
+            pid_stats.timeouts++;
+            printf("[PID] No sensor sample for %d ms, outputs off\n", PID_SAMPLE_TIMEOUT_MS);
+            OvenOutputs off = { 0, 0 };
+            oven_state_publish_outputs(&off);
+            zone_control_release(&zones, 0, 0);
+            have_last = false;
+            continue;
+        }
+        
+        // Real dt between samples; flag gaps and late samples
+        uint16_t log_flags = 0;
+        float dt_s = PID_REF_PERIOD_S;
+        if (have_last) {
+            uint32_t dt_us = sample.timestamp_us - last_us;
+            uint32_t missed = sample.seq - last_seq - 1;
+            if (missed) {
+                pid_stats.missed += missed;
+                log_flags |= RUN_LOG_FLAG_MISSED;
+            }
+            if (sample.period_ms && dt_us / 10u > (uint32_t)sample.period_ms * PID_LATE_PCT) {
+                pid_stats.late++;
+                log_flags |= RUN_LOG_FLAG_LATE;
+            }
+            if (dt_us > 0) dt_s = dt_us / 1e6f;
+            pid_stats.last_dt_ms = dt_us / 1000.0f;
+            if (pid_stats.last_dt_ms > pid_stats.max_dt_ms) pid_stats.max_dt_ms = pid_stats.last_dt_ms;
+        }
+        have_last = true;
+        last_seq = sample.seq;
+        last_us = sample.timestamp_us;
+        pid_stats.samples++;
+        
+        // PID Config (system.json), re-read each sample so gains tuned
+        // over the USB link apply at once. A 0 gain turns its term off;
+        // oven_control_init() set the defaults in case the config is not
+        // loaded. system.json gains were tuned per 200 ms step: the
+        // controllers scale them by dt.
+        PidParams p1;
+        p1.kp = sysConfig.pid_ssr1_kp;
+        p1.ki = sysConfig.pid_ssr1_ki;
+        p1.kd = sysConfig.pid_ssr1_kd;
+        p1.ref_period_s = PID_REF_PERIOD_S;
+        p1.out_min = 0.0f;
+        p1.out_max = 100.0f;
+        p1.i_limit = sysConfig.pid_i_limit_pct;
+        p1.d_filter_s = sysConfig.pid_d_filter_s;
+        p1.slew_per_s = sysConfig.pid_slew_pct_s;
+        
+        // SSR2 Params
+        PidParams p2 = p1;
+        p2.kp = sysConfig.pid_ssr2_kp;
+        p2.ki = sysConfig.pid_ssr2_ki;
+        p2.kd = sysConfig.pid_ssr2_kd;
+        
+        ZoneConfig zone_cfg;
+        zone_cfg.mode = (ZoneMode)sysConfig.zone_mode;
+        zone_cfg.ratio = sysConfig.zone_ratio;
+        zone_cfg.split_pct = sysConfig.zone_split_pct;
+        zone_cfg.trim_pct = sysConfig.zone_trim_pct;
+        zone_cfg.ssr2_present = sysConfig.ssr2_is_present;
+        
+        OvenMode mode = oven_state_mode();
+        OvenStateEnum state = mode.state;
+        
+        float output1 = 0;
+        float output2 = 0;
+        
+        // Feed-forward: model power for the setpoint ahead, the PID
+        // corrects what the model gets wrong (control/feedforward.h)
+        float feedforward = 0;
+        if (state == STATE_RUNNING && mode.control == CONTROL_FEEDFORWARD) {
+            FopdtModel model = { sysConfig.model_gain, sysConfig.model_tau_s, sysConfig.model_dead_s };
+            if (fopdt_valid(&model)) {
+                float ambient = (sample.amb > 0.0f) ? sample.amb : 25.0f; // Cold junction, near the oven
+                feedforward = fopdt_feedforward(&model, mode.lookahead_temp, mode.lookahead_rate, ambient);
+            }
+        }
+        
+        if (!(sample.flags & SENSOR_FUSED_VALID)) {
+            // Open/short/bus error with no stand-in (control/sensor_fusion.h):
+            // no control action on a bad reading. The controllers keep their
+            // state for the next good one.
+            output1 = 0; output2 = 0;
+        } else if (state == STATE_AUTOTUNE) {
+            // Relay power from the state machine
+            output1 = (mode.autotune_ssr == 1) ? mode.autotune_output : 0;
+            output2 = (mode.autotune_ssr == 2) ? mode.autotune_output : 0;
+            zone_control_release(&zones, output1, output2);
+        } else if (oven_state_is_heating(state)) {
+            // Takes over from the SSRs off or the auto-tune relay without a bump
+            ZoneInputs in;
+            in.setpoint = mode.target_temp;
+            in.t1 = sample.t1;
+            in.t2 = sample.t2;
+            in.t2_valid = (sample.flags & SENSOR_T2_VALID) != 0;
+            in.feedforward = feedforward;
+            in.dt_s = dt_s;
+            zone_control_update(&zones, &zone_cfg, &p1, &p2, &in, &output1, &output2);
+        } else {
+            output1 = 0; output2 = 0;
+            zone_control_release(&zones, 0, 0);
+        }
+        
+        // Update Output
+        OvenOutputs out = { output1, output2 };
+        oven_state_publish_outputs(&out);
+        
+        // Run log sample (drained by the disk logger, never blocks)
+        OvenTemps temps = oven_state_temps();
+        uint32_t t_ms = millis();
+        run_log_push(t_ms, &temps, &mode, &out, log_flags);
+        
+        // USB telemetry, if a host asked for it (comm/link_service.cpp)
+        link_send_telemetry(t_ms, &temps, &mode, &out, log_flags);
+    }
+}
+
+// --- Hardcoded Profile (SAC305 approx) ---
+
+static const ProfileSegment builtin_segments[] = {
+    { SEG_RAMP, 150.0f, 1.5f, 90, "Preheat" },  // Ramp to 150C in 90s -> ~1.6C/s
+    { SEG_HOLD, 150.0f, 0.0f, 60, "Soak" },
+    { SEG_RAMP, 245.0f, 0.0f, 60, "Ramp Up" },
+    { SEG_HOLD, 245.0f, 0.0f, 20, "Reflow" },
+    { SEG_RAMP, 50.0f,  0.0f, 60, "Cooling" },
+};
+#define BUILTIN_SEGMENTS (sizeof(builtin_segments) / sizeof(builtin_segments[0]))
+
+static TimelineSegment builtin_timeline[BUILTIN_SEGMENTS];
+
+void init_test_profile() {
+    // Basic Fallback if load fails
+    TimelineBuilder builder;
+    timeline_builder_init(&builder);
+    for (uint32_t i = 0; i < BUILTIN_SEGMENTS; i++) {
+        timeline_builder_add(&builder, &builtin_segments[i], &builtin_timeline[i]);
+    }
+
+    ProfileTimeline timeline;
+    profile_timeline_from_array(&timeline, builtin_timeline, BUILTIN_SEGMENTS);
+    profile_timeline_replace(&currentTimeline, &timeline);
+    snprintf(currentProfile.name, sizeof(currentProfile.name), "SAC305 Default");
+    snprintf(currentProfile.alloy, sizeof(currentProfile.alloy), "Sn96.5Ag3.0Cu0.5");
+    currentProfile.segment_count = BUILTIN_SEGMENTS;
+}
+
+// --- State Machine ---
+static TimelineCursor run_cursor;
+static TimelineCursor ahead_cursor;     // One model dead time ahead of run_cursor
+static Autotune tuner;
+static bool tune_pending = false;       // tuner DONE, result not taken yet
+
+bool oven_state_is_heating(OvenStateEnum state) {
+    return state == STATE_RUNNING || state == STATE_PRE_CHECK || state == STATE_MANUAL ||
+           state == STATE_AUTOTUNE;
+}
+
+void oven_cmd_start_stop() {
+    OvenMode mode = oven_state_mode();
+    if (mode.state == STATE_IDLE || mode.state == STATE_COOLDOWN || mode.state == STATE_INIT) {
+        if (currentProfile.segment_count > 0) {
+            mode.state = STATE_PRE_CHECK;
+            mode.profile_start_time = millis();
+            mode.current_segment_index = 0;
+            printf("CMD: Start Profile\n");
+        }
+    } else if (mode.state == STATE_RUNNING || mode.state == STATE_PRE_CHECK) {
+        mode.state = STATE_COOLDOWN;
+        printf("CMD: Stop Profile\n");
+    } else if (mode.state == STATE_AUTOTUNE) {
+        autotune_abort(&tuner, "stopped");
+        mode.state = STATE_COOLDOWN;
+        printf("CMD: Stop Auto-tune\n");
+    } else if (mode.state == STATE_FAULT) {
+        // A hardware trip holds until both alert outputs are released
+        if (!hw_alert_clear(&hw_alert, hal_alert_asserted(1) || hal_alert_asserted(2))) {
+            printf("CMD: Fault held, over-temperature alert still asserted\n");
+            return;
+        }
+        mode.state = STATE_IDLE;
+        mode.fault_active = false;
+        printf("CMD: Ack Fault\n");
+    }
+    oven_state_publish_mode(&mode);
+}
+
+bool oven_cmd_autotune(uint8_t ssr) {
+    OvenMode mode = oven_state_mode();
+    if (mode.state != STATE_IDLE && mode.state != STATE_COOLDOWN) return false;
+    if (ssr != 1 && !(ssr == 2 && sysConfig.ssr2_is_present)) return false;
+
+    autotune_start(&tuner, AUTOTUNE_SETPOINT_C, oven_state_temps().t1, millis());
+    tune_pending = false;
+    mode.state = STATE_AUTOTUNE;
+    mode.target_temp = AUTOTUNE_SETPOINT_C;
+    mode.autotune_ssr = ssr;
+    mode.autotune_output = 0;
+    oven_state_publish_mode(&mode);
+    printf("CMD: Auto-tune SSR%u at %.0f C\n", ssr, AUTOTUNE_SETPOINT_C);
+    return true;
+}
+
+Autotune oven_autotune_status() {
+    return tuner;
+}
+
+bool oven_autotune_result_pending() {
+    return tune_pending;
+}
+
+bool oven_autotune_take_result(AutotuneResult* out) {
+    if (!tune_pending) return false;
+    tune_pending = false;
+
+    // Both elements driven from the same error (zones shared or uniform):
+    // with SSR2 in the loop each gets half the gain the relay test found
+    // for it alone
+    bool shared = sysConfig.ssr2_is_present &&
+                  (sysConfig.zone_mode == ZONE_SHARED || sysConfig.zone_mode == ZONE_UNIFORM);
+    float share = shared ? 0.5f : 1.0f;
+    out->ssr = oven_state_mode().autotune_ssr;
+    out->ku = tuner.ku;
+    out->tu_s = tuner.tu_s;
+    out->kp = tuner.kp * share;
+    out->ki = tuner.ki * share * PID_REF_PERIOD_S;  // Integral summed per PID step
+    out->kd = tuner.kd * share / PID_REF_PERIOD_S;  // Derivative taken per PID step
+    return true;
+}
+
+void oven_autotune_apply(const AutotuneResult* result) {
+    if (result->ssr == 2) {
+        sysConfig.pid_ssr2_kp = result->kp;
+        sysConfig.pid_ssr2_ki = result->ki;
+        sysConfig.pid_ssr2_kd = result->kd;
+    } else {
+        sysConfig.pid_ssr1_kp = result->kp;
+        sysConfig.pid_ssr1_ki = result->ki;
+        sysConfig.pid_ssr1_kd = result->kd;
+    }
+    printf("[Autotune] SSR%u: Ku %.2f, Tu %.1f s -> Kp %.2f, Ki %.4f, Kd %.1f\n", result->ssr,
+           result->ku, result->tu_s, result->kp, result->ki, result->kd);
+}
+
+void oven_profile_prefetch() {
+    // currentTimeline is only replaced outside RUNNING (load_profile())
+    OvenMode mode = oven_state_mode();
+    if (mode.state != STATE_RUNNING) return;
+    timeline_cursor_prefetch(&run_cursor);
+    if (mode.control == CONTROL_FEEDFORWARD) timeline_cursor_prefetch(&ahead_cursor);
+}
+
+// Feed-forward only with a plant model in system.json
+static ControlMode run_control_mode() {
+    if (currentProfile.control_mode != CONTROL_FEEDFORWARD) return CONTROL_PID;
+    FopdtModel model = { sysConfig.model_gain, sysConfig.model_tau_s, sysConfig.model_dead_s };
+    if (fopdt_valid(&model)) return CONTROL_FEEDFORWARD;
+    printf("[Control] No plant model in system.json, PID only\n");
+    return CONTROL_PID;
+}
+
+// Setpoint and slope one dead time ahead, for the PID loop's feed-forward
+static void update_lookahead(OvenMode* mode, uint32_t elapsed_ms) {
+    mode->lookahead_temp = mode->target_temp;
+    mode->lookahead_rate = 0;
+    if (mode->control != CONTROL_FEEDFORWARD) return;
+
+    uint32_t ahead_ms = elapsed_ms + (uint32_t)(sysConfig.model_dead_s * 1000.0f);
+    float now_temp, next_temp;
+    if (timeline_cursor_eval(&ahead_cursor, ahead_ms, &now_temp) == TIMELINE_ERROR ||
+        timeline_cursor_eval(&ahead_cursor, ahead_ms + FEEDFORWARD_RATE_MS, &next_temp) == TIMELINE_ERROR) {
+        return; // Plain PID on the current setpoint; run_cursor reports the read error
+    }
+    mode->lookahead_temp = now_temp;
+    mode->lookahead_rate = (next_temp - now_temp) * 1000.0f / FEEDFORWARD_RATE_MS;
+}
+
+void oven_logic_step() {
+    OvenMode mode = oven_state_mode();
+    float t1 = oven_state_temps().t1;
+    
+    switch (mode.state) {
+        case STATE_INIT:
+            break;
+        case STATE_IDLE:
+            mode.target_temp = 0;
+            break;
+        case STATE_PRE_CHECK:
+            // Simple Safety Check before starting
+            if (t1 > 0 && t1 < 300) {
+                 mode.state = STATE_RUNNING;
+                 mode.profile_start_time = millis(); // Reset start time
+                 mode.control = run_control_mode();
+                 timeline_cursor_reset(&run_cursor, &currentTimeline);
+                 timeline_cursor_reset(&ahead_cursor, &currentTimeline);
+                 printf("Pre-Check OK -> RUNNING%s\n", mode.control == CONTROL_FEEDFORWARD ? " (feed-forward)" : "");
+            } else {
+                 mode.state = STATE_FAULT;
+                 printf("Pre-Check FAILED (T1=%.1f)\n", t1);
+            }
+            break;
+        case STATE_MANUAL:
+            // Do nothing, let PID run
+            break;
+        case STATE_RUNNING: {
+            uint32_t elapsed_ms = millis() - mode.profile_start_time;
+            float target = 0;
+            int active_seg = timeline_cursor_eval(&run_cursor, elapsed_ms, &target);
+            
+            if (active_seg == TIMELINE_END) {
+                // Profile Finished
+                mode.state = STATE_COOLDOWN;
+            } else if (active_seg == TIMELINE_ERROR) {
+                // Compiled profile unreadable (card pulled?): stop heating
+                mode.state = STATE_COOLDOWN;
+                printf("[Profile] Segment %lu unreadable, run aborted\n", (unsigned long)run_cursor.index);
+            } else {
+                mode.target_temp = target;
+                mode.current_segment_index = active_seg;
+                update_lookahead(&mode, elapsed_ms);
+            }
+            break;
+        }
+        case STATE_COOLDOWN:
+            mode.target_temp = 0;
+            if (t1 < 50.0f && t1 > 0) {
+                mode.state = STATE_IDLE;
+            }
+            // Timeout safety?
+            break;
+        case STATE_AUTOTUNE:
+            mode.autotune_output = autotune_step(&tuner, t1, millis());
+            if (tuner.phase == AUTOTUNE_DONE) {
+                tune_pending = true;
+                mode.state = STATE_COOLDOWN;
+                printf("[Autotune] Done after %lu cycles\n", (unsigned long)tuner.cycles);
+            } else if (tuner.phase == AUTOTUNE_FAILED) {
+                mode.state = STATE_COOLDOWN;
+                printf("[Autotune] Failed: %s\n", tuner.error);
+            }
+            break;
+        case STATE_FAULT:
+            // Outputs forced off by the SSR output stage
+            autotune_abort(&tuner, "fault");
+            break;
+        default:
+            break;
+    }
+    oven_state_publish_mode(&mode);
+}
@@ -0,0 +1,121 @@
+#ifndef OVEN_CONTROL_H
+#define OVEN_CONTROL_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "../project_defs.h"
+#include "profile_timeline.h"
+#include "oven_state.h"
+#include "autotune.h"
+#include "sensor_fusion.h"
+#include "hw_alert.h"
+
+// Control side of the oven: sensors, PID, SSR output, safety and the
+// profile state machine. Hardware goes through oven_hal.h so the same
+// code runs on the RP2040 and in the host simulator (sim/oven_sim.cpp).
+
+// --- Shared State (owned here) ---
+// currentProfile/currentTimeline are replaced with mtx_LVGL and mtx_OvenState
+// both held (load_profile()), never during a run: read them under either
+// one. The segments stream from the timeline's source (profile_timeline.h).
+// sysConfig writers hold mtx_LVGL; control code on the other core reads
+// single fields only.
+extern ReflowProfile currentProfile;
+extern ProfileTimeline currentTimeline;
+extern SystemConfig sysConfig;
+
+extern SemaphoreHandle_t mtx_OvenState; // Held by writers of the mode channel (oven_state.h)
+extern QueueHandle_t q_SensorData;
+
+extern TaskHandle_t hAlertTask;
+extern TaskHandle_t hSensorTask;
+extern TaskHandle_t hPIDTask;
+
+// Create the mutex/queue above and reset the oven state (before the scheduler starts)
+void oven_control_init();
+
+// Sensors, PID and alert tasks + the SSR output stage
+void oven_control_start_tasks();
+
+// Built-in SAC305 fallback profile (in RAM, no SD card needed)
+void init_test_profile();
+
+// States in which the PID drives the elements
+bool oven_state_is_heating(OvenStateEnum state);
+
+// --- PID Loop ---
+// Controller defaults until system.json says otherwise (pid_params)
+#define PID_DEFAULT_KP          4.0f    // Gains, both SSRs, per 200 ms step
+#define PID_DEFAULT_KI          0.02f
+#define PID_DEFAULT_KD          50.0f
+#define PID_DEFAULT_I_LIMIT_PCT 50.0f   // Integral term bound: what the old +/-2500 clamp gave at ki 0.02
+#define PID_DEFAULT_D_FILTER_S  1.0f    // Derivative low-pass
+#define PID_DEFAULT_SLEW_PCT_S  0.0f    // Output slew limit (%/s), 0 = none
+
+// --- PID Loop Timing ---
+// vPIDLoopTask runs once per q_SensorData sample
+typedef struct {
+    uint32_t samples;
+    uint32_t missed;       // Sequence gaps (queue overflow, sensor errors)
+    uint32_t late;         // dt above 150 % of the sample period
+    uint32_t timeouts;     // No sample for 500 ms (outputs forced off)
+    float last_dt_ms;
+    float max_dt_ms;
+} PidLoopStats;
+
+PidLoopStats oven_pid_stats();
+
+// Hardware over-temperature trips and their latencies (control/hw_alert.h)
+HwAlert oven_hw_alert();
+
+// SSRs held off by a hardware trip until it is acknowledged. Any context.
+bool oven_alert_tripped();
+
+// Sensor fusion state and counters (vSensorPollerTask, control/sensor_fusion.h)
+SensorFusion oven_sensor_fusion();
+
+// --- State Machine (caller holds mtx_OvenState) ---
+// One 100 ms step of the profile state machine
+void oven_logic_step();
+
+// Dashboard START/STOP button: start, abort or acknowledge a fault (held
+// while an MCP9600 alert output is asserted)
+void oven_cmd_start_stop();
+
+// --- Auto-tune ---
+// Gains found by a relay auto-tune, in system.json units (per PID step)
+typedef struct {
+    uint8_t ssr;
+    float ku;
+    float tu_s;
+    float kp, ki, kd;
+} AutotuneResult;
+
+// Relay auto-tune of SSR 1 or 2 at AUTOTUNE_SETPOINT_C, from IDLE or
+// COOLDOWN; START/STOP aborts it. Caller holds mtx_OvenState.
+bool oven_cmd_autotune(uint8_t ssr);
+
+// Copy of the tuner for the UI. Caller holds mtx_OvenState.
+Autotune oven_autotune_status();
+
+// A finished tune waits here until taken (state machine task, no lock)...
+bool oven_autotune_result_pending();
+// ...then is taken under mtx_OvenState...
+bool oven_autotune_take_result(AutotuneResult* out);
+// ...and written to sysConfig under mtx_LVGL, before save_system_config()
+void oven_autotune_apply(const AutotuneResult* result);
+
+// --- Profile Window (state machine task, no lock held) ---
+// Reads the run's next segments ahead of oven_logic_step(), outside
+// mtx_OvenState: the source may be the SD card. Feed-forward runs read
+// one model dead time further ahead as well.
+void oven_profile_prefetch();
+
+// --- Tasks ---
+void vAlertHandlingTask(void *pvParameters);
+void vSensorPollerTask(void *pvParameters);
+void vPIDLoopTask(void *pvParameters);
+
+#endif // OVEN_CONTROL_H
@@ -0,0 +1,36 @@
+#ifndef OVEN_HAL_H
+#define OVEN_HAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Hardware hooks used by the control tasks (oven_control.cpp).
+// Implemented in mtr_reflow_oven.cpp on target and sim/sim_hal.cpp on the host.
+
+// Milliseconds since boot (FreeRTOS tick time on the host)
+uint32_t millis();
+
+// Microseconds since boot (tick time on the host), for latencies
+uint32_t hal_time_us();
+
+// SSR outputs (GPIO_HEAT1 / GPIO_HEAT2), channel 1 or 2
+void hal_ssr_init();
+void hal_ssr_set(int channel, bool on);
+
+// Slot timer for one SSR channel (control/ssr_output.cpp). The callback
+// runs in timer context at the end of each slot, drives the SSR and
+// returns the length of the next slot in us. Slots follow each other
+// without drift (each is timed from the previous deadline).
+typedef uint32_t (*hal_ssr_slot_cb_t)(int channel);
+void hal_ssr_timer_start(int channel, uint32_t first_us, hal_ssr_slot_cb_t cb);
+
+// MCP9600 alert 1 outputs (GPIO_T1_ALT1 / GPIO_T2_ALT1), open drain and
+// active low. The callback runs in interrupt context on each asserting
+// edge, channel 1 or 2, with the time the interrupt was taken.
+typedef void (*hal_alert_cb_t)(int channel, uint32_t edge_us);
+void hal_alert_irq_start(hal_alert_cb_t cb);
+bool hal_alert_asserted(int channel);
+
+// Sensor bus: control/i2c_bus.h (transaction engine)
+
+#endif // OVEN_HAL_H
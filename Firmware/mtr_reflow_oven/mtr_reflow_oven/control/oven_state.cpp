@@ -0,0 +1,83 @@
+#include "oven_state.h"
+
+// Compiler + CPU barrier (DMB on the M0+, needed once both cores read)
+#define OVEN_STATE_BARRIER() __sync_synchronize()
+
+// Sequence counter + two copies. While seq is odd slot[0] is being written
+// and readers use slot[1], otherwise slot[0].
+template <typename T>
+struct Latch {
+    volatile uint32_t seq;
+    T slot[2];
+};
+
+static Latch<OvenTemps> ch_temps;
+static Latch<OvenOutputs> ch_outputs;
+static Latch<OvenMode> ch_mode;
+static volatile uint32_t read_retries = 0;
+
+template <typename T>
+static void latch_write(Latch<T>* l, const T* value) {
+    l->seq = l->seq + 1;        // Odd: readers move to slot[1]
+    OVEN_STATE_BARRIER();
+    l->slot[0] = *value;
+    OVEN_STATE_BARRIER();
+    l->seq = l->seq + 1;        // Even: readers back on slot[0]
+    OVEN_STATE_BARRIER();
+    l->slot[1] = *value;
+    OVEN_STATE_BARRIER();
+}
+
+template <typename T>
+static T latch_read(const Latch<T>* l) {
+    T value;
+    for (;;) {
+        uint32_t seq = l->seq;
+        OVEN_STATE_BARRIER();
+        value = l->slot[seq & 1];
+        OVEN_STATE_BARRIER();
+        if (l->seq == seq) return value;
+        read_retries = read_retries + 1;
+    }
+}
+
+void oven_state_init() {
+    OvenTemps temps = {};
+    OvenOutputs outputs = {};
+    OvenMode mode = {};
+    mode.state = STATE_INIT;
+    latch_write(&ch_temps, &temps);
+    latch_write(&ch_outputs, &outputs);
+    latch_write(&ch_mode, &mode);
+    read_retries = 0;
+}
+
+OvenTemps oven_state_temps() { return latch_read(&ch_temps); }
+OvenOutputs oven_state_outputs() { return latch_read(&ch_outputs); }
+OvenMode oven_state_mode() { return latch_read(&ch_mode); }
+
+void oven_state_read(OvenState* out) {
+    OvenTemps t = latch_read(&ch_temps);
+    OvenOutputs o = latch_read(&ch_outputs);
+    OvenMode m = latch_read(&ch_mode);
+
+    out->state = m.state;
+    out->current_temp_t1 = t.t1;
+    out->current_temp_t2 = t.t2;
+    out->current_temp_amb = t.amb;
+    out->target_temp = m.target_temp;
+    out->power_output_1 = o.power_output_1;
+    out->power_output_2 = o.power_output_2;
+    out->profile_start_time = m.profile_start_time;
+    out->current_segment_index = m.current_segment_index;
+    out->t2_connected = t.t2_connected;
+    out->fault_active = m.fault_active;
+}
+
+void oven_state_publish_temps(const OvenTemps* temps) { latch_write(&ch_temps, temps); }
+void oven_state_publish_outputs(const OvenOutputs* outputs) { latch_write(&ch_outputs, outputs); }
+void oven_state_publish_mode(const OvenMode* mode) { latch_write(&ch_mode, mode); }
+
+uint32_t oven_state_read_retries() {
+    return read_retries;
+}
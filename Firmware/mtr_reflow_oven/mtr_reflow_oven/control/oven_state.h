@@ -0,0 +1,67 @@
+#ifndef OVEN_STATE_H
+#define OVEN_STATE_H
+
+#include <stdint.h>
+#include "../project_defs.h"
+
+// Lock-free publication of OvenState.
+//
+// The state is split into channels, one per kind of writer. Each channel is
+// a latch (sequence counter + two copies): a writer bumps the counter around
+// each copy, a reader copies whichever slot is stable and retries only if a
+// write completed meanwhile. Readers never block and never wait for a
+// preempted writer, so any task can read at any rate.
+//
+//   temps   : vSensorPollerTask only
+//   outputs : vPIDLoopTask only
+//   mode    : state machine, commands, alerts, manual screen. Several writers,
+//             serialised by mtx_OvenState (readers do not take it).
+
+typedef struct {
+    float t1;
+    float t2;
+    float amb;
+    bool t2_connected;
+    float confidence;       // In t1 (control/sensor_fusion.h)
+    uint32_t flags;         // SensorData.flags of the last sample
+} OvenTemps;
+
+typedef struct {
+    float power_output_1; // 0-100%
+    float power_output_2; // 0-100%
+} OvenOutputs;
+
+typedef struct {
+    OvenStateEnum state;
+    float target_temp;
+    uint32_t profile_start_time;
+    uint32_t current_segment_index;
+    bool fault_active;
+    ControlMode control;        // Of the run in progress
+    float lookahead_temp;       // Setpoint one model dead time ahead (CONTROL_FEEDFORWARD)
+    float lookahead_rate;       // Its slope, degC/s
+    uint8_t autotune_ssr;       // STATE_AUTOTUNE: SSR on the relay (1 or 2)...
+    float autotune_output;      // ...and its power, the other one off
+} OvenMode;
+
+// Reset every channel (before the scheduler starts)
+void oven_state_init();
+
+// --- Readers (any task, never block) ---
+OvenTemps oven_state_temps();
+OvenOutputs oven_state_outputs();
+OvenMode oven_state_mode();
+
+// All channels. Each channel is self-consistent; channels are read one
+// after the other, not as a single atomic snapshot.
+void oven_state_read(OvenState* out);
+
+// --- Writers ---
+void oven_state_publish_temps(const OvenTemps* temps);
+void oven_state_publish_outputs(const OvenOutputs* outputs);
+void oven_state_publish_mode(const OvenMode* mode); // Caller holds mtx_OvenState
+
+// Reads that had to retry because a write landed during the copy
+uint32_t oven_state_read_retries();
+
+#endif // OVEN_STATE_H
@@ -0,0 +1,54 @@
+#include <cstring>
+#include "pid.h"
+
+static float clampf(float v, float lo, float hi) {
+    return (v < lo) ? lo : (v > hi) ? hi : v;
+}
+
+void pid_reset(Pid* pid) {
+    memset(pid, 0, sizeof(*pid));
+}
+
+void pid_bumpless(Pid* pid, const PidParams* p, float setpoint, float input, float feedforward, float output) {
+    float i_min = (p->out_min < 0.0f) ? -p->i_limit : 0.0f;
+    pid->i_term = clampf(output - p->kp * (setpoint - input) - feedforward, i_min, p->i_limit);
+    pid->last_input = input;
+    pid->d_filtered = 0.0f;
+    pid->output = output;
+    pid->primed = true;
+}
+
+float pid_update(Pid* pid, const PidParams* p, float setpoint, float input, float feedforward, float dt_s) {
+    float step = dt_s / p->ref_period_s;
+    float error = setpoint - input;
+
+    // Derivative of the measurement, low-passed
+    if (!pid->primed) {
+        pid->last_input = input;
+        pid->primed = true;
+    }
+    float d_raw = (step > 0.0f) ? -(input - pid->last_input) / step : 0.0f;
+    pid->last_input = input;
+    if (p->d_filter_s > 0.0f) {
+        pid->d_filtered += (d_raw - pid->d_filtered) * dt_s / (p->d_filter_s + dt_s);
+    } else {
+        pid->d_filtered = d_raw;
+    }
+
+    float i_term = clampf(pid->i_term + p->ki * error * step, -p->i_limit, p->i_limit);
+    float raw = p->kp * error + i_term + p->kd * pid->d_filtered + feedforward;
+
+    float out = clampf(raw, p->out_min, p->out_max);
+    if (p->slew_per_s > 0.0f) {
+        float max_delta = p->slew_per_s * dt_s;
+        out = clampf(out, pid->output - max_delta, pid->output + max_delta);
+    }
+
+    // Conditional integration: no integral growth the output cannot follow
+    bool held_high = (out < raw) && (error > 0.0f);
+    bool held_low = (out > raw) && (error < 0.0f);
+    if (!held_high && !held_low) pid->i_term = i_term;
+
+    pid->output = out;
+    return out;
+}
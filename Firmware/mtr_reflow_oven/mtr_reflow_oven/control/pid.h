@@ -0,0 +1,52 @@
+#ifndef PID_H
+#define PID_H
+
+#include <stdbool.h>
+
+// PID controller, one per SSR (vPIDLoopTask).
+//
+// Gains are in system.json units: per PID_REF_PERIOD_S step, each update
+// scaled by its real dt so they keep their meaning at any sample rate.
+//
+//   - Integral held as an output term (ki already applied): live gain
+//     changes (USB link) do not bump the output. It stops integrating
+//     while the output is saturated or slew-limited in the direction the
+//     error pushes (conditional integration), and stays within +/-i_limit
+//     of output.
+//   - Derivative on the measurement, not the error: a setpoint step does
+//     not kick the output. First-order low-pass on it (d_filter_s).
+//   - Output clamped to out_min..out_max, then slew-limited.
+//   - pid_bumpless() takes over from whatever drove the output before
+//     (SSR off, auto-tune relay): the next update starts from that output.
+
+typedef struct {
+    float kp, ki, kd;       // Per ref_period_s step (system.json)
+    float ref_period_s;
+    float out_min, out_max;
+    float i_limit;          // Integral term bound, output units
+    float d_filter_s;       // Derivative low-pass time constant, 0 = none
+    float slew_per_s;       // Output change limit per second, 0 = none
+} PidParams;
+
+typedef struct {
+    float i_term;           // Integral contribution to the output
+    float last_input;
+    float d_filtered;       // Filtered derivative, per ref step
+    float output;           // Last output, for the slew limit
+    bool primed;            // last_input valid
+} Pid;
+
+// Back to rest: no integral, no history, output 0
+void pid_reset(Pid* pid);
+
+// Hand over at output without a bump: the proportional and feed-forward
+// terms the next update will add are taken out of the integral (kept
+// within 0..i_limit, so taking over from an SSR that was off never starts
+// on a negative integral; +/-i_limit for a bipolar output), the
+// derivative restarts from this input and the slew limit from this output.
+void pid_bumpless(Pid* pid, const PidParams* p, float setpoint, float input, float feedforward, float output);
+
+// One step, dt_s since the last one. feedforward is added before the clamp.
+float pid_update(Pid* pid, const PidParams* p, float setpoint, float input, float feedforward, float dt_s);
+
+#endif // PID_H
@@ -0,0 +1,117 @@
+#include <cstring>
+#include "profile_binary.h"
+
+// --- Compilation ---
+
+typedef struct {
+    bin_write_fn write;
+    void* dst;
+    TimelineBuilder builder;
+    TimelineSegment pending[PROFILE_WINDOW_SEGMENTS];
+    uint32_t pending_count;
+    uint32_t written;       // Segments on file
+    bool write_failed;      // A flush failed during the parse
+} BinCompile;
+
+static uint32_t segment_offset(uint32_t index) {
+    return sizeof(ProfileBinHeader) + index * sizeof(TimelineSegment);
+}
+
+static bool compile_flush(BinCompile* c) {
+    if (c->pending_count == 0) return true;
+    bool ok = c->write(c->dst, segment_offset(c->written), c->pending,
+                       c->pending_count * sizeof(TimelineSegment));
+    c->written += c->pending_count;
+    c->pending_count = 0;
+    return ok;
+}
+
+static bool compile_segment(void* ctx, uint32_t index, const ProfileSegment* seg) {
+    BinCompile* c = (BinCompile*)ctx;
+    (void)index; // Segments come in order
+    timeline_builder_add(&c->builder, seg, &c->pending[c->pending_count++]);
+    if (c->pending_count < PROFILE_WINDOW_SEGMENTS || compile_flush(c)) return true;
+    c->write_failed = true;
+    return false;
+}
+
+static bool write_error(JsonError* err) {
+    if (err) {
+        err->line = err->column = 0;
+        strncpy(err->message, "write error", sizeof(err->message));
+        err->io = true;
+    }
+    return false;
+}
+
+bool profile_bin_compile(json_read_fn read, void* src, bin_write_fn write, void* dst,
+                         ProfileBinHeader* header, JsonError* err) {
+    static BinCompile c; // One compile at a time (load_profile(), host tools)
+    c.write = write;
+    c.dst = dst;
+    c.pending_count = 0;
+    c.written = 0;
+    c.write_failed = false;
+    timeline_builder_init(&c.builder);
+
+    ReflowProfile profile;
+    if (!profile_parse_stream(read, src, &profile, compile_segment, &c, err)) {
+        return c.write_failed ? write_error(err) : false;
+    }
+    if (!compile_flush(&c)) return write_error(err);
+
+    ProfileTimeline summary;
+    timeline_builder_finish(&c.builder, &summary);
+    memset(header, 0, sizeof(*header));
+    memcpy(header->magic, PROFILE_BIN_MAGIC, sizeof(header->magic));
+    header->version = PROFILE_BIN_VERSION;
+    header->record_size = sizeof(TimelineSegment);
+    header->segment_count = summary.segment_count;
+    header->total_ms = summary.total_ms;
+    header->start_temp = summary.start_temp;
+    header->end_temp = summary.end_temp;
+    header->peak_temp = summary.peak_temp;
+    strncpy(header->name, profile.name, sizeof(header->name) - 1);
+    strncpy(header->alloy, profile.alloy, sizeof(header->alloy) - 1);
+    header->control_mode = profile.control_mode;
+    header->max_slope = profile.max_slope;
+
+    if (!write(dst, 0, header, sizeof(*header))) return write_error(err);
+    return true;
+}
+
+// --- Reading ---
+
+static int read_segments(void* src, uint32_t first, TimelineSegment* out, uint32_t count) {
+    ProfileBinSource* s = (ProfileBinSource*)src;
+    if (!s->read(s->file, segment_offset(first), out, count * sizeof(TimelineSegment))) return -1;
+    return (int)count;
+}
+
+bool profile_bin_open(ProfileBinSource* source, ProfileBinHeader* header, ProfileTimeline* timeline) {
+    if (!source->read(source->file, 0, header, sizeof(*header))) return false;
+    if (memcmp(header->magic, PROFILE_BIN_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != PROFILE_BIN_VERSION || header->record_size != sizeof(TimelineSegment)) {
+        return false;
+    }
+    header->name[sizeof(header->name) - 1] = 0;
+    header->alloy[sizeof(header->alloy) - 1] = 0;
+
+    timeline->segment_count = header->segment_count;
+    timeline->total_ms = header->total_ms;
+    timeline->start_temp = header->start_temp;
+    timeline->end_temp = header->end_temp;
+    timeline->peak_temp = header->peak_temp;
+    timeline->read = read_segments;
+    timeline->src = source;
+    return true;
+}
+
+void profile_bin_summary(const ProfileBinHeader* header, ReflowProfile* profile) {
+    memset(profile, 0, sizeof(*profile));
+    strncpy(profile->name, header->name, sizeof(profile->name) - 1);
+    strncpy(profile->alloy, header->alloy, sizeof(profile->alloy) - 1);
+    profile->control_mode = (header->control_mode == CONTROL_FEEDFORWARD) ? CONTROL_FEEDFORWARD : CONTROL_PID;
+    profile->segment_count = header->segment_count;
+    profile->max_slope = header->max_slope;
+}
@@ -0,0 +1,58 @@
+#ifndef PROFILE_BINARY_H
+#define PROFILE_BINARY_H
+
+#include <stdint.h>
+#include "../project_defs.h"
+#include "profile_parser.h"
+#include "profile_timeline.h"
+
+// Compiled profile file: the TimelineSegments of a profile, resolved once
+// from the JSON, behind a fixed header. Segment i sits at
+// sizeof(ProfileBinHeader) + i * sizeof(TimelineSegment), so a cursor
+// window (profile_timeline.h) is one seek and one read at any position.
+//
+// No file I/O here: the firmware goes through FatFs (storage/
+// profile_store.cpp), the host tools through stdio.
+
+#define PROFILE_BIN_MAGIC   "MTRPROF"
+#define PROFILE_BIN_VERSION 4
+
+typedef struct {
+    char magic[8];          // PROFILE_BIN_MAGIC
+    uint16_t version;
+    uint16_t record_size;   // sizeof(TimelineSegment)
+    uint32_t segment_count;
+    uint32_t total_ms;
+    float start_temp;
+    float end_temp;
+    float peak_temp;
+    char name[32];
+    char alloy[24];
+    uint32_t control_mode;  // ControlMode
+    float max_slope;        // Profile "safety.max_slope"
+} ProfileBinHeader;
+
+// Whole transfers at a byte offset of the file: true on success
+typedef bool (*bin_read_fn)(void* file, uint32_t offset, void* data, uint32_t len);
+typedef bool (*bin_write_fn)(void* file, uint32_t offset, const void* data, uint32_t len);
+
+// ProfileTimeline.src of an opened file
+typedef struct {
+    bin_read_fn read;
+    void* file;
+} ProfileBinSource;
+
+// JSON profile -> compiled file, segments written as the parser emits them
+// (PROFILE_WINDOW_SEGMENTS per write). The header goes last: a file cut
+// short by an error or a power loss has no valid magic.
+bool profile_bin_compile(json_read_fn read, void* src, bin_write_fn write, void* dst,
+                         ProfileBinHeader* header, JsonError* err);
+
+// Checks the header and points timeline at the file. The source must
+// outlive the timeline; the generation is left to profile_timeline_replace().
+bool profile_bin_open(ProfileBinSource* source, ProfileBinHeader* header, ProfileTimeline* timeline);
+
+// Name, alloy, segment count, control mode and max slope as a ReflowProfile
+void profile_bin_summary(const ProfileBinHeader* header, ReflowProfile* profile);
+
+#endif // PROFILE_BINARY_H
@@ -0,0 +1,436 @@
+#include <stdio.h>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include "profile_parser.h"
+#include "profile_timeline.h"
+#include "zone_control.h"
+
+#define PROFILE_MIN_TEMP_C  0.0f
+#define PROFILE_MAX_TEMP_C  300.0f
+
+// --- Schema Helpers ---
+
+typedef struct {
+    const char* path;       // json_stream_at() syntax
+    JsonEventType type;     // OBJECT_BEGIN / ARRAY_BEGIN for containers
+} JsonField;
+
+static const char* json_type_name(JsonEventType type) {
+    switch (type) {
+        case JSON_EV_OBJECT_BEGIN: return "an object";
+        case JSON_EV_ARRAY_BEGIN:  return "an array";
+        case JSON_EV_STRING:       return "a string";
+        case JSON_EV_NUMBER:       return "a number";
+        case JSON_EV_BOOL:         return "true or false";
+        default:                   return "null";
+    }
+}
+
+// "path: message" at the current token. Returns false for the callback.
+static bool schema_error(JsonStream* js, const char* message) {
+    char path[40];
+    json_stream_path(js, path, sizeof(path));
+    json_stream_fail(js, "%s: %s", path[0] ? path : "document", message);
+    return false;
+}
+
+// Finds the event's path in fields (*field = index, -1 if unknown or the
+// root). Known paths must hold the expected JSON type, the root an object.
+static bool match_field(JsonStream* js, const JsonEvent* ev, const JsonField* fields, size_t count, int* field) {
+    bool end = (ev->type == JSON_EV_OBJECT_END || ev->type == JSON_EV_ARRAY_END);
+    *field = -1;
+    if (js->depth == 0) {
+        return end || ev->type == JSON_EV_OBJECT_BEGIN || schema_error(js, "expected an object");
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (!json_stream_at(js, fields[i].path)) continue;
+        *field = (int)i;
+        if (end || ev->type == fields[i].type) return true;
+        char message[32];
+        snprintf(message, sizeof(message), "expected %s", json_type_name(fields[i].type));
+        return schema_error(js, message);
+    }
+    return true; // Unknown key: ignored
+}
+
+typedef struct {
+    const char* p;
+    size_t left;
+} TextSource;
+
+static int read_text(void* src, char* buf, size_t max) {
+    TextSource* t = (TextSource*)src;
+    size_t n = (t->left < max) ? t->left : max;
+    memcpy(buf, t->p, n);
+    t->p += n;
+    t->left -= n;
+    return (int)n;
+}
+
+// Feed the whole document through the callback, a chunk at a time
+static bool parse_stream(json_read_fn read, void* src, json_event_cb cb, void* ctx, JsonError* err) {
+    JsonStream js;
+    json_stream_init(&js, cb, ctx);
+
+    char chunk[PROFILE_PARSE_CHUNK];
+    int n;
+    while ((n = read(src, chunk, sizeof(chunk))) > 0) {
+        if (!json_stream_feed(&js, chunk, (size_t)n)) break;
+    }
+    if (n < 0 && !js.failed) {
+        json_stream_fail(&js, "read error");
+        js.error.io = true;
+    }
+    bool ok = json_stream_finish(&js);
+    if (!ok && err) *err = js.error;
+    return ok;
+}
+
+// --- Profiles ---
+
+// Indexes into profile_fields
+enum {
+    PF_META,
+    PF_META_NAME,
+    PF_META_ALLOY,
+    PF_META_DESCRIPTION,
+    PF_SAFETY,
+    PF_SAFETY_MAX_TEMP,
+    PF_SAFETY_MAX_SLOPE,
+    PF_CONTROL,
+    PF_CONTROL_MODE,
+    PF_SEGMENTS,
+    PF_SEGMENT,
+    PF_SEG_TYPE,
+    PF_SEG_END_TEMP,
+    PF_SEG_TEMP,
+    PF_SEG_SLOPE,
+    PF_SEG_DURATION,
+    PF_SEG_DURATION_S,
+    PF_SEG_NOTE,
+    PF_COUNT
+};
+
+static const JsonField profile_fields[PF_COUNT] = {
+    { "meta",                   JSON_EV_OBJECT_BEGIN },
+    { "meta.name",              JSON_EV_STRING },
+    { "meta.alloy",             JSON_EV_STRING },
+    { "meta.description",       JSON_EV_STRING },
+    { "safety",                 JSON_EV_OBJECT_BEGIN },
+    { "safety.max_temp",        JSON_EV_NUMBER },
+    { "safety.max_slope",       JSON_EV_NUMBER },
+    { "control",                JSON_EV_OBJECT_BEGIN },
+    { "control.mode",           JSON_EV_STRING },
+    { "segments",               JSON_EV_ARRAY_BEGIN },
+    { "segments[]",             JSON_EV_OBJECT_BEGIN },
+    { "segments[].type",        JSON_EV_STRING },
+    { "segments[].end_temp",    JSON_EV_NUMBER },
+    { "segments[].temp",        JSON_EV_NUMBER },
+    { "segments[].slope",       JSON_EV_NUMBER },
+    { "segments[].duration",    JSON_EV_NUMBER },
+    { "segments[].duration_s",  JSON_EV_NUMBER },
+    { "segments[].note",        JSON_EV_STRING },
+};
+
+// Keys seen in the current segment
+#define SEG_KEY_TYPE        0x01
+#define SEG_KEY_END_TEMP    0x02
+#define SEG_KEY_TEMP        0x04
+#define SEG_KEY_SLOPE       0x08
+#define SEG_KEY_DURATION    0x10
+#define SEG_KEY_DURATION_S  0x20
+
+typedef struct {
+    ReflowProfile* profile;
+    profile_segment_fn on_segment;
+    void* ctx;
+    bool have_meta;
+    bool have_name;
+    bool have_segments;
+    float last_temp;        // Target of the previous segment
+    ProfileSegment seg;     // Segment being parsed
+    uint8_t seg_keys;
+    float end_temp;
+    float temp;
+    float duration;
+    float duration_s;
+} ProfileParse;
+
+// Keys may come in any order: the segment is resolved at its closing brace
+static bool profile_segment_done(JsonStream* js, ProfileParse* p) {
+    uint8_t keys = p->seg_keys;
+    bool has_target = keys & (SEG_KEY_END_TEMP | SEG_KEY_TEMP);
+    bool has_time = keys & (SEG_KEY_DURATION | SEG_KEY_DURATION_S);
+    ProfileSegment* seg = &p->seg;
+
+    if (!(keys & SEG_KEY_TYPE)) return schema_error(js, "missing \"type\"");
+    if (seg->type == SEG_RAMP && !(has_target && (has_time || (keys & SEG_KEY_SLOPE)))) {
+        return schema_error(js, "ramp needs end_temp and slope or duration_s");
+    }
+    if (seg->type == SEG_HOLD && !has_time) return schema_error(js, "hold needs duration_s");
+    if (seg->type == SEG_STEP && !has_target) return schema_error(js, "step needs temp");
+
+    if (keys & SEG_KEY_END_TEMP) seg->target_temp = p->end_temp;
+    else if (keys & SEG_KEY_TEMP) seg->target_temp = p->temp;
+    else seg->target_temp = p->last_temp;
+
+    if (keys & SEG_KEY_DURATION) {
+        seg->duration = (uint32_t)p->duration;
+    } else if (keys & SEG_KEY_DURATION_S) {
+        seg->duration = (uint32_t)p->duration_s;
+    } else if (keys & SEG_KEY_SLOPE) {
+        // Duration from the slope
+        if (seg->slope != 0) {
+            float diff = fabsf(seg->target_temp - p->last_temp);
+            seg->duration = (uint32_t)(diff / fabsf(seg->slope));
+        } else {
+            seg->duration = 0;
+        }
+    }
+    if (!(keys & SEG_KEY_SLOPE) || has_time) seg->slope = 0; // Only kept when it sets the duration
+
+    uint32_t index = (uint32_t)json_stream_index(js);
+    if (!p->on_segment(p->ctx, index, seg)) return schema_error(js, "cannot store segment");
+    p->profile->segment_count = index + 1;
+    p->last_temp = seg->target_temp;
+    return true;
+}
+
+static bool profile_number(JsonStream* js, ProfileParse* p, int field, float v) {
+    switch (field) {
+        case PF_SAFETY_MAX_SLOPE:
+            if (v < 0) return schema_error(js, "negative slope");
+            p->profile->max_slope = v;
+            return true;
+        case PF_SEG_END_TEMP:
+        case PF_SEG_TEMP:
+            if (v < PROFILE_MIN_TEMP_C || v > PROFILE_MAX_TEMP_C) return schema_error(js, "temperature out of range 0..300");
+            if (field == PF_SEG_END_TEMP) p->end_temp = v;
+            else p->temp = v;
+            p->seg_keys |= (field == PF_SEG_END_TEMP) ? SEG_KEY_END_TEMP : SEG_KEY_TEMP;
+            return true;
+        case PF_SEG_SLOPE:
+            p->seg.slope = v;
+            p->seg_keys |= SEG_KEY_SLOPE;
+            return true;
+        case PF_SEG_DURATION:
+        case PF_SEG_DURATION_S:
+            if (v < 0) return schema_error(js, "negative duration");
+            if (field == PF_SEG_DURATION) p->duration = v;
+            else p->duration_s = v;
+            p->seg_keys |= (field == PF_SEG_DURATION) ? SEG_KEY_DURATION : SEG_KEY_DURATION_S;
+            return true;
+        default:
+            return true;
+    }
+}
+
+static bool profile_string(JsonStream* js, ProfileParse* p, int field, const JsonEvent* ev) {
+    switch (field) {
+        case PF_META_NAME:
+            strncpy(p->profile->name, ev->str, sizeof(p->profile->name) - 1);
+            p->profile->name[sizeof(p->profile->name) - 1] = 0;
+            p->have_name = true;
+            return true;
+        case PF_META_ALLOY:
+            strncpy(p->profile->alloy, ev->str, sizeof(p->profile->alloy) - 1);
+            p->profile->alloy[sizeof(p->profile->alloy) - 1] = 0;
+            return true;
+        case PF_CONTROL_MODE:
+            if (strcmp(ev->str, "pid") == 0) p->profile->control_mode = CONTROL_PID;
+            else if (strcmp(ev->str, "feedforward") == 0) p->profile->control_mode = CONTROL_FEEDFORWARD;
+            else return schema_error(js, "mode must be pid or feedforward");
+            return true;
+        case PF_SEG_TYPE:
+            if (strcmp(ev->str, "ramp") == 0) p->seg.type = SEG_RAMP;
+            else if (strcmp(ev->str, "hold") == 0) p->seg.type = SEG_HOLD;
+            else if (strcmp(ev->str, "step") == 0) p->seg.type = SEG_STEP;
+            else return schema_error(js, "type must be ramp, hold or step");
+            p->seg_keys |= SEG_KEY_TYPE;
+            return true;
+        case PF_SEG_NOTE:
+            strncpy(p->seg.note, ev->str, sizeof(p->seg.note) - 1);
+            return true;
+        default:
+            return true;
+    }
+}
+
+static bool profile_event(JsonStream* js, const JsonEvent* ev, void* ctx) {
+    ProfileParse* p = (ProfileParse*)ctx;
+    int field;
+    if (!match_field(js, ev, profile_fields, PF_COUNT, &field)) return false;
+
+    switch (ev->type) {
+        case JSON_EV_OBJECT_BEGIN:
+            if (field == PF_META) p->have_meta = true;
+            if (field == PF_SEGMENT) {
+                memset(&p->seg, 0, sizeof(p->seg));
+                p->seg_keys = 0;
+            }
+            return true;
+        case JSON_EV_OBJECT_END:
+            if (field == PF_SEGMENT) return profile_segment_done(js, p);
+            if (js->depth == 0 && !p->have_segments) return schema_error(js, "missing \"segments\"");
+            return true;
+        case JSON_EV_ARRAY_BEGIN:
+            if (field == PF_SEGMENTS) p->have_segments = true;
+            return true;
+        case JSON_EV_ARRAY_END:
+            if (field == PF_SEGMENTS && p->profile->segment_count == 0) return schema_error(js, "no segments");
+            return true;
+        case JSON_EV_NUMBER:
+            return profile_number(js, p, field, ev->number);
+        case JSON_EV_STRING:
+            return profile_string(js, p, field, ev);
+        default:
+            return true;
+    }
+}
+
+bool profile_parse_stream(json_read_fn read, void* src, ReflowProfile* profile,
+                          profile_segment_fn on_segment, void* ctx, JsonError* err) {
+    ProfileParse p;
+    memset(&p, 0, sizeof(p));
+    p.profile = profile;
+    p.on_segment = on_segment;
+    p.ctx = ctx;
+    p.last_temp = PROFILE_START_TEMP_C; // Assumed start
+    memset(profile, 0, sizeof(*profile));
+
+    bool ok = parse_stream(read, src, profile_event, &p, err);
+    if (!ok) return false;
+
+    if (!p.have_name) strncpy(profile->name, p.have_meta ? "Unknown" : "No Meta", sizeof(profile->name) - 1);
+    return true;
+}
+
+bool profile_parse_json(const char* text, ReflowProfile* profile,
+                        profile_segment_fn on_segment, void* ctx, JsonError* err) {
+    TextSource src = { text, strlen(text) };
+    return profile_parse_stream(read_text, &src, profile, on_segment, ctx, err);
+}
+
+// --- System Config ---
+
+typedef enum {
+    CFG_BOOL,
+    CFG_INT,
+    CFG_FLOAT,
+    CFG_TC_TYPE,            // One letter string
+    CFG_ZONE_MODE           // zone_mode_name() string
+} CfgType;
+
+typedef struct {
+    const char* path;
+    CfgType type;
+    size_t offset;          // In SystemConfig
+    float min;
+    float max;
+} CfgField;
+
+static const CfgField config_fields[] = {
+    { "hardware.enable_sensor2_check", CFG_BOOL,    offsetof(SystemConfig, enable_sensor2_check), 0, 1 },
+    { "hardware.screen_orientation",   CFG_INT,     offsetof(SystemConfig, screen_orientation), 0, 3 },
+    { "hardware.ssr2_is_present",      CFG_INT,     offsetof(SystemConfig, ssr2_is_present), 0, 1 },
+    { "hardware.buzzer_volume",        CFG_INT,     offsetof(SystemConfig, buzzer_volume), 0, 100 },
+    { "hardware.ssr1_window_ms",       CFG_INT,     offsetof(SystemConfig, ssr1_window_ms), 10, 60000 },
+    { "hardware.ssr2_window_ms",       CFG_INT,     offsetof(SystemConfig, ssr2_window_ms), 10, 60000 },
+    { "hardware.mains_hz",             CFG_INT,     offsetof(SystemConfig, mains_hz), 0, 60 },
+    { "hardware.tc_type",              CFG_TC_TYPE, offsetof(SystemConfig, tc_type), 0, 0 },
+    { "hardware.tc_filter",            CFG_INT,     offsetof(SystemConfig, tc_filter), 0, 7 },
+    { "hardware.adc_bits",             CFG_INT,     offsetof(SystemConfig, adc_bits), 12, 18 },
+    { "pid_params.ssr1.kp",            CFG_FLOAT,   offsetof(SystemConfig, pid_ssr1_kp), 0, 1000 },
+    { "pid_params.ssr1.ki",            CFG_FLOAT,   offsetof(SystemConfig, pid_ssr1_ki), 0, 1000 },
+    { "pid_params.ssr1.kd",            CFG_FLOAT,   offsetof(SystemConfig, pid_ssr1_kd), 0, 1000 },
+    { "pid_params.ssr2.kp",            CFG_FLOAT,   offsetof(SystemConfig, pid_ssr2_kp), 0, 1000 },
+    { "pid_params.ssr2.ki",            CFG_FLOAT,   offsetof(SystemConfig, pid_ssr2_ki), 0, 1000 },
+    { "pid_params.ssr2.kd",            CFG_FLOAT,   offsetof(SystemConfig, pid_ssr2_kd), 0, 1000 },
+    { "pid_params.i_limit_pct",        CFG_FLOAT,   offsetof(SystemConfig, pid_i_limit_pct), 0, 100 },
+    { "pid_params.d_filter_s",         CFG_FLOAT,   offsetof(SystemConfig, pid_d_filter_s), 0, 60 },
+    { "pid_params.slew_pct_per_s",     CFG_FLOAT,   offsetof(SystemConfig, pid_slew_pct_s), 0, 1000 },
+    { "calibration.t1_offset",         CFG_FLOAT,   offsetof(SystemConfig, t1_offset), -50, 50 },
+    { "calibration.t2_offset",         CFG_FLOAT,   offsetof(SystemConfig, t2_offset), -50, 50 },
+    { "model.gain_c_per_pct",          CFG_FLOAT,   offsetof(SystemConfig, model_gain), 0, 20 },
+    { "model.tau_s",                   CFG_FLOAT,   offsetof(SystemConfig, model_tau_s), 0, 3600 },
+    { "model.dead_time_s",             CFG_FLOAT,   offsetof(SystemConfig, model_dead_s), 0, 600 },
+    { "zones.mode",                    CFG_ZONE_MODE, offsetof(SystemConfig, zone_mode), 0, 0 },
+    { "zones.ratio",                   CFG_FLOAT,   offsetof(SystemConfig, zone_ratio), 0, 1 },
+    { "zones.split_pct",               CFG_FLOAT,   offsetof(SystemConfig, zone_split_pct), 10, 90 },
+    { "zones.trim_pct",                CFG_FLOAT,   offsetof(SystemConfig, zone_trim_pct), 0, 50 },
+};
+
+static const JsonField config_sections[] = {
+    { "hardware",        JSON_EV_OBJECT_BEGIN },
+    { "pid_params",      JSON_EV_OBJECT_BEGIN },
+    { "pid_params.ssr1", JSON_EV_OBJECT_BEGIN },
+    { "pid_params.ssr2", JSON_EV_OBJECT_BEGIN },
+    { "calibration",     JSON_EV_OBJECT_BEGIN },
+    { "model",           JSON_EV_OBJECT_BEGIN },
+    { "zones",           JSON_EV_OBJECT_BEGIN },
+};
+
+static bool config_set(JsonStream* js, const CfgField* f, const JsonEvent* ev, SystemConfig* cfg) {
+    char message[3 * 13 + sizeof(" out of range ..")]; // %g is 13 chars at most
+    uint8_t* field = (uint8_t*)cfg + f->offset;
+
+    switch (f->type) {
+        case CFG_BOOL:
+            if (ev->type != JSON_EV_BOOL) return schema_error(js, "expected true or false");
+            *(bool*)field = ev->boolean;
+            return true;
+        case CFG_TC_TYPE:
+            if (ev->type != JSON_EV_STRING || ev->str_len != 1 || !strchr("KJTNSEBRkjtnsebr", ev->str[0])) {
+                return schema_error(js, "expected one of K J T N S E B R");
+            }
+            *(char*)field = ev->str[0];
+            return true;
+        case CFG_ZONE_MODE: {
+            ZoneMode mode;
+            if (ev->type != JSON_EV_STRING || !zone_mode_parse(ev->str, &mode)) {
+                return schema_error(js, "expected shared independent ratio split uniform");
+            }
+            *(int*)field = (int)mode;
+            return true;
+        }
+        default:
+            break;
+    }
+
+    if (ev->type != JSON_EV_NUMBER) return schema_error(js, "expected a number");
+    float v = ev->number;
+    if (v < f->min || v > f->max) {
+        snprintf(message, sizeof(message), "%g out of range %g..%g", v, f->min, f->max);
+        return schema_error(js, message);
+    }
+    if (f->type == CFG_FLOAT) {
+        *(float*)field = v;
+    } else {
+        if (v != floorf(v)) return schema_error(js, "expected an integer");
+        *(int*)field = (int)v;
+    }
+    return true;
+}
+
+static bool config_event(JsonStream* js, const JsonEvent* ev, void* ctx) {
+    SystemConfig* cfg = (SystemConfig*)ctx;
+    int field;
+    if (ev->type == JSON_EV_OBJECT_END || ev->type == JSON_EV_ARRAY_END) return true;
+    if (!match_field(js, ev, config_sections, sizeof(config_sections) / sizeof(config_sections[0]), &field)) return false;
+    if (field >= 0 || ev->type == JSON_EV_OBJECT_BEGIN || ev->type == JSON_EV_ARRAY_BEGIN) return true;
+
+    for (size_t i = 0; i < sizeof(config_fields) / sizeof(config_fields[0]); i++) {
+        if (json_stream_at(js, config_fields[i].path)) return config_set(js, &config_fields[i], ev, cfg);
+    }
+    return true; // Unknown key: ignored
+}
+
+bool system_config_parse_stream(json_read_fn read, void* src, SystemConfig* cfg, JsonError* err) {
+    return parse_stream(read, src, config_event, cfg, err);
+}
+
+bool system_config_parse_json(const char* text, SystemConfig* cfg, JsonError* err) {
+    TextSource src = { text, strlen(text) };
+    return system_config_parse_stream(read_text, &src, cfg, err);
+}
@@ -0,0 +1,42 @@
+#ifndef PROFILE_PARSER_H
+#define PROFILE_PARSER_H
+
+#include <stddef.h>
+#include "../project_defs.h"
+#include "json_stream.h"
+
+// JSON -> struct parsing for doc/profiles/*.json and config/system.json,
+// streamed (json_stream.h): the document is read PROFILE_PARSE_CHUNK bytes
+// at a time into a stack buffer, nothing is allocated. Profile segments are
+// handed out one by one as they are parsed, so their number is unbounded.
+//
+// Documents are checked against their schema. Any error (syntax, wrong
+// type, value out of range, missing segment key) fails the whole parse
+// with its line, column and path in *err; the output struct may then be
+// half written, so parse into a copy. Unknown keys are ignored.
+//
+// No file I/O here: the firmware reads the files through FatFs, the host
+// simulator through stdio, both via a json_read_fn.
+
+#define PROFILE_PARSE_CHUNK 128
+
+// Next bytes of the document: count read, 0 at the end, < 0 on error
+typedef int (*json_read_fn)(void* src, char* buf, size_t max);
+
+// Each segment as soon as it is complete, in profile order. Returning
+// false stops the parse with a "cannot store segment" error.
+typedef bool (*profile_segment_fn)(void* ctx, uint32_t index, const ProfileSegment* seg);
+
+// Fills *profile (name, alloy, segment count, control mode) from a profile document
+bool profile_parse_stream(json_read_fn read, void* src, ReflowProfile* profile,
+                          profile_segment_fn on_segment, void* ctx, JsonError* err = NULL);
+
+// Updates the fields present in a system.json document, leaves the others untouched
+bool system_config_parse_stream(json_read_fn read, void* src, SystemConfig* cfg, JsonError* err = NULL);
+
+// Same from a string in memory
+bool profile_parse_json(const char* text, ReflowProfile* profile,
+                        profile_segment_fn on_segment, void* ctx, JsonError* err = NULL);
+bool system_config_parse_json(const char* text, SystemConfig* cfg, JsonError* err = NULL);
+
+#endif // PROFILE_PARSER_H
@@ -0,0 +1,164 @@
+#include <cstring>
+#include "profile_timeline.h"
+
+// --- Compilation ---
+
+void timeline_builder_init(TimelineBuilder* b) {
+    b->count = 0;
+    b->t_ms = 0;
+    b->temp = PROFILE_START_TEMP_C;
+    b->peak_temp = PROFILE_START_TEMP_C;
+}
+
+void timeline_builder_add(TimelineBuilder* b, const ProfileSegment* s, TimelineSegment* ts) {
+    uint32_t duration_ms = s->duration * 1000;
+
+    ts->type = s->type;
+    ts->start_ms = b->t_ms;
+    ts->end_ms = b->t_ms + duration_ms;
+    ts->end_temp = s->target_temp;
+    if (s->type == SEG_RAMP && duration_ms > 0) {
+        // Ramps start from wherever the previous segment ended
+        ts->start_temp = b->temp;
+        ts->rate_c_per_ms = (s->target_temp - b->temp) / (float)duration_ms;
+    } else {
+        // Hold and step jump straight to their temperature
+        ts->start_temp = s->target_temp;
+        ts->rate_c_per_ms = 0.0f;
+    }
+
+    b->t_ms = ts->end_ms;
+    b->temp = s->target_temp;
+    if (b->temp > b->peak_temp) b->peak_temp = b->temp;
+    b->count++;
+}
+
+void timeline_builder_finish(const TimelineBuilder* b, ProfileTimeline* timeline) {
+    timeline->segment_count = b->count;
+    timeline->total_ms = b->t_ms;
+    timeline->start_temp = PROFILE_START_TEMP_C;
+    timeline->end_temp = b->temp;
+    timeline->peak_temp = b->peak_temp;
+}
+
+static int read_array(void* src, uint32_t first, TimelineSegment* out, uint32_t count) {
+    memcpy(out, (const TimelineSegment*)src + first, count * sizeof(TimelineSegment));
+    return (int)count;
+}
+
+void profile_timeline_from_array(ProfileTimeline* timeline, const TimelineSegment* segments, uint32_t count) {
+    float end = PROFILE_START_TEMP_C;
+    float peak = PROFILE_START_TEMP_C;
+    for (uint32_t i = 0; i < count; i++) {
+        end = segments[i].end_temp;
+        if (end > peak) peak = end;
+    }
+    timeline->segment_count = count;
+    timeline->total_ms = count ? segments[count - 1].end_ms : 0;
+    timeline->start_temp = PROFILE_START_TEMP_C;
+    timeline->end_temp = end;
+    timeline->peak_temp = peak;
+    timeline->read = read_array;
+    timeline->src = (void*)segments;
+}
+
+void profile_timeline_replace(ProfileTimeline* current, const ProfileTimeline* next) {
+    uint32_t generation = current->generation + 1;
+    *current = *next;
+    current->generation = generation;
+}
+
+// --- Evaluation ---
+
+// Window starting at first (clipped to the end of the profile)
+static bool cursor_load(TimelineCursor* c, uint32_t first) {
+    const ProfileTimeline* tl = c->timeline;
+    uint32_t count = tl->segment_count - first;
+    if (count > PROFILE_WINDOW_SEGMENTS) count = PROFILE_WINDOW_SEGMENTS;
+
+    c->loads++;
+    int n = tl->read(tl->src, first, c->window, count);
+    if (n != (int)count) {
+        c->window_count = 0;
+        return false;
+    }
+    c->window_first = first;
+    c->window_count = count;
+    return true;
+}
+
+// Segment i from the window, reloading it around i if needed. Walking
+// backwards, the window ends at i so the next steps back stay in it.
+static const TimelineSegment* cursor_segment(TimelineCursor* c, uint32_t i, bool backwards) {
+    if (i >= c->timeline->segment_count) return NULL; // Inconsistent source
+    if (c->window_count == 0 || i < c->window_first || i >= c->window_first + c->window_count) {
+        uint32_t first = i;
+        if (backwards) first = (i + 1 >= PROFILE_WINDOW_SEGMENTS) ? i + 1 - PROFILE_WINDOW_SEGMENTS : 0;
+        if (!cursor_load(c, first)) return NULL;
+    }
+    return &c->window[i - c->window_first];
+}
+
+// A replaced profile invalidates the window
+static void cursor_sync(TimelineCursor* c) {
+    const ProfileTimeline* tl = c->timeline;
+    if (c->generation == tl->generation) return;
+    c->generation = tl->generation;
+    c->window_count = 0;
+    if (c->index >= tl->segment_count) c->index = 0;
+}
+
+void timeline_cursor_reset(TimelineCursor* cursor, const ProfileTimeline* timeline) {
+    cursor->timeline = timeline;
+    cursor->generation = timeline->generation;
+    cursor->index = 0;
+    cursor->window_first = 0;
+    cursor->window_count = 0;
+    cursor->loads = 0;
+}
+
+int timeline_cursor_eval(TimelineCursor* cursor, uint32_t t_ms, float* target_temp) {
+    const ProfileTimeline* tl = cursor->timeline;
+    cursor_sync(cursor);
+    if (tl->segment_count == 0) {
+        *target_temp = tl->start_temp;
+        return TIMELINE_END;
+    }
+    if (t_ms >= tl->total_ms) {
+        cursor->index = tl->segment_count - 1;
+        *target_temp = tl->end_temp;
+        return TIMELINE_END;
+    }
+
+    // Usually already there or one segment ahead; zero-length segments are stepped over
+    uint32_t i = cursor->index;
+    if (i >= tl->segment_count) i = 0;
+    const TimelineSegment* s = cursor_segment(cursor, i, false);
+    while (s && i > 0 && t_ms < s->start_ms) {
+        i--;
+        s = cursor_segment(cursor, i, true);
+    }
+    while (s && t_ms >= s->end_ms) {
+        i++;
+        s = cursor_segment(cursor, i, false);
+    }
+    if (!s) return TIMELINE_ERROR;
+    cursor->index = i;
+
+    *target_temp = s->start_temp + s->rate_c_per_ms * (float)(t_ms - s->start_ms);
+    return (int)i;
+}
+
+void timeline_cursor_prefetch(TimelineCursor* cursor) {
+    const ProfileTimeline* tl = cursor->timeline;
+    cursor_sync(cursor);
+    if (cursor->index >= tl->segment_count) return;
+
+    if (cursor->window_count == 0) {
+        cursor_load(cursor, cursor->index);
+        return;
+    }
+    // Within the last two segments of the window, with more to come
+    uint32_t window_end = cursor->window_first + cursor->window_count;
+    if (cursor->index + 2 >= window_end && window_end < tl->segment_count) cursor_load(cursor, cursor->index);
+}
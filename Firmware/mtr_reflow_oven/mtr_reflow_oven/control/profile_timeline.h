@@ -0,0 +1,94 @@
+#ifndef PROFILE_TIMELINE_H
+#define PROFILE_TIMELINE_H
+
+#include <stdint.h>
+#include "../project_defs.h"
+
+// A profile compiled into absolute time: every segment gets its start time
+// and start/end temperatures resolved once, at load time. Setpoint queries
+// then go through a cursor that remembers the last segment, so the usual
+// monotonic walk (state machine, chart, predictors) costs O(1).
+//
+// The segments are not held in RAM. A ProfileTimeline only describes the
+// profile and reads segments on demand from its source: the compiled
+// profile file on the SD card (profile_binary.h) or an array (built-in
+// profile). Each cursor keeps a window of PROFILE_WINDOW_SEGMENTS, so a
+// profile of any length runs in constant memory.
+
+// Oven temperature assumed at t=0, also used to turn the first "slope"
+// segment into a duration (profile_parser.cpp)
+#define PROFILE_START_TEMP_C 25.0f
+
+#define PROFILE_WINDOW_SEGMENTS 8
+
+// timeline_cursor_eval() results besides a segment index
+#define TIMELINE_END    -1  // Profile over
+#define TIMELINE_ERROR  -2  // Source read failed
+
+typedef struct {
+    uint32_t start_ms;      // From profile start
+    uint32_t end_ms;
+    float start_temp;
+    float end_temp;
+    float rate_c_per_ms;    // Ramp coefficient, 0 for hold/step
+    SegmentType type;
+} TimelineSegment;
+
+// Copies up to count segments from index first: number copied, < 0 on error
+typedef int (*timeline_read_fn)(void* src, uint32_t first, TimelineSegment* out, uint32_t count);
+
+typedef struct {
+    uint32_t segment_count;
+    uint32_t total_ms;
+    float start_temp;
+    float end_temp;         // Of the last segment
+    float peak_temp;
+    timeline_read_fn read;
+    void* src;
+    uint32_t generation;    // Bumped by profile_timeline_replace(): cursors reload
+} ProfileTimeline;
+
+typedef struct {
+    const ProfileTimeline* timeline;
+    uint32_t generation;
+    uint32_t index;
+    uint32_t window_first;
+    uint32_t window_count;  // 0: nothing loaded
+    uint32_t loads;         // Source reads, for statistics
+    TimelineSegment window[PROFILE_WINDOW_SEGMENTS];
+} TimelineCursor;
+
+// --- Compilation ---
+// Resolves segments one at a time, in profile order
+typedef struct {
+    uint32_t count;
+    uint32_t t_ms;
+    float temp;
+    float peak_temp;
+} TimelineBuilder;
+
+void timeline_builder_init(TimelineBuilder* b);
+void timeline_builder_add(TimelineBuilder* b, const ProfileSegment* s, TimelineSegment* out);
+
+// Summary fields of the timeline (source and generation left alone)
+void timeline_builder_finish(const TimelineBuilder* b, ProfileTimeline* timeline);
+
+// Timeline over segments already resolved in RAM
+void profile_timeline_from_array(ProfileTimeline* timeline, const TimelineSegment* segments, uint32_t count);
+
+// Swap in a new profile (caller holds the locks guarding *current)
+void profile_timeline_replace(ProfileTimeline* current, const ProfileTimeline* next);
+
+// --- Evaluation ---
+void timeline_cursor_reset(TimelineCursor* cursor, const ProfileTimeline* timeline);
+
+// Setpoint at t_ms. Returns the active segment index, TIMELINE_END once the
+// profile is over (*target_temp then holds the last end temperature) or
+// TIMELINE_ERROR if the source could not be read.
+int timeline_cursor_eval(TimelineCursor* cursor, uint32_t t_ms, float* target_temp);
+
+// Loads the next window ahead of time when the cursor nears the end of
+// the current one, so the source is read outside the caller's locks
+void timeline_cursor_prefetch(TimelineCursor* cursor);
+
+#endif // PROFILE_TIMELINE_H
@@ -0,0 +1,96 @@
+#include "run_log.h"
+#include <cmath>
+#include <cstring>
+
+#define RUN_LOG_BARRIER() __sync_synchronize()
+
+static_assert(sizeof(RunLogRecord) == 16, "RunLogRecord must stay 16 bytes");
+static_assert(sizeof(RunLogHeader) == RUN_LOG_SECTOR_SIZE, "RunLogHeader must fill one sector");
+static_assert(sizeof(RunLogSector) == RUN_LOG_SECTOR_SIZE, "RunLogSector must fill one sector");
+static_assert((RUN_LOG_RING_SIZE & (RUN_LOG_RING_SIZE - 1)) == 0, "RUN_LOG_RING_SIZE must be a power of two");
+
+static RunLogRecord ring[RUN_LOG_RING_SIZE];
+static volatile uint32_t head = 0;  // Written by the producer only
+static volatile uint32_t tail = 0;  // Written by the consumer only
+static volatile uint32_t dropped = 0;
+
+static int16_t pack_temp(float c) {
+    float v = roundf(c * RUN_LOG_TEMP_SCALE);
+    if (v > 32767.0f) v = 32767.0f;
+    if (v < -32768.0f) v = -32768.0f;
+    return (int16_t)v;
+}
+
+static uint8_t pack_power(float p) {
+    if (p < 0.0f) p = 0.0f;
+    if (p > 100.0f) p = 100.0f;
+    return (uint8_t)(p + 0.5f);
+}
+
+void run_log_init() {
+    head = 0;
+    tail = 0;
+    dropped = 0;
+}
+
+void run_log_pack(RunLogRecord* r, uint32_t t_ms, const OvenTemps* temps, const OvenMode* mode,
+                  const OvenOutputs* outputs, uint16_t extra_flags) {
+    r->t_ms = t_ms;
+    r->t1 = pack_temp(temps->t1);
+    r->t2 = pack_temp(temps->t2);
+    r->setpoint = pack_temp(mode->target_temp);
+    r->out1 = pack_power(outputs->power_output_1);
+    r->out2 = pack_power(outputs->power_output_2);
+    r->state = (uint8_t)mode->state;
+    r->segment = (mode->current_segment_index < 255) ? (uint8_t)mode->current_segment_index : 255;
+    bool t1_good = (temps->flags & SENSOR_T1_VALID) && !(temps->flags & SENSOR_T1_OUTLIER);
+    r->flags = (uint16_t)((temps->t2_connected ? RUN_LOG_FLAG_T2 : 0) | (mode->fault_active ? RUN_LOG_FLAG_FAULT : 0) |
+                          ((temps->flags & SENSOR_FUSED_VALID) && !t1_good ? RUN_LOG_FLAG_T1_SUBST : 0) |
+                          ((temps->flags & SENSOR_DISAGREE) ? RUN_LOG_FLAG_DISAGREE : 0) | extra_flags);
+}
+
+bool run_log_push(uint32_t t_ms, const OvenTemps* temps, const OvenMode* mode, const OvenOutputs* outputs,
+                  uint16_t extra_flags) {
+    uint32_t h = head;
+    if (h - tail >= RUN_LOG_RING_SIZE) {
+        dropped = dropped + 1;
+        return false;
+    }
+
+    run_log_pack(&ring[h & (RUN_LOG_RING_SIZE - 1)], t_ms, temps, mode, outputs, extra_flags);
+
+    RUN_LOG_BARRIER(); // Record visible before the index
+    head = h + 1;
+    return true;
+}
+
+bool run_log_pop(RunLogRecord* out) {
+    uint32_t t = tail;
+    if (t == head) return false;
+    RUN_LOG_BARRIER(); // Index read before the record
+    *out = ring[t & (RUN_LOG_RING_SIZE - 1)];
+    RUN_LOG_BARRIER(); // Copy done before the slot is handed back
+    tail = t + 1;
+    return true;
+}
+
+bool run_log_fill_sector(RunLogSector* sector, uint32_t* fill) {
+    while (*fill < RUN_LOG_RECORDS_PER_SECTOR && run_log_pop(&sector->records[*fill])) {
+        (*fill)++;
+    }
+    return *fill == RUN_LOG_RECORDS_PER_SECTOR;
+}
+
+void run_log_make_header(RunLogHeader* header, uint32_t start_ms, uint32_t period_ms, const char* profile) {
+    memset(header, 0, sizeof(*header));
+    memcpy(header->magic, RUN_LOG_MAGIC, sizeof(RUN_LOG_MAGIC));
+    header->version = RUN_LOG_VERSION;
+    header->record_size = sizeof(RunLogRecord);
+    header->period_ms = period_ms;
+    header->start_ms = start_ms;
+    if (profile) strncpy(header->profile, profile, sizeof(header->profile) - 1);
+}
+
+uint32_t run_log_dropped() {
+    return dropped;
+}
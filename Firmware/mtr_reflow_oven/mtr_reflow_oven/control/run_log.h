@@ -0,0 +1,86 @@
+#ifndef RUN_LOG_H
+#define RUN_LOG_H
+
+#include <stdint.h>
+#include "oven_state.h"
+
+// Run log: fixed-size samples from the control loop to the disk logger.
+//
+// vPIDLoopTask pushes one record per sensor sample into a single-producer /
+// single-consumer ring (no locks, never blocks; a full ring drops the
+// sample and counts it). The logger drains the ring into 512-byte sectors
+// and writes whole sectors only (storage/run_logger.cpp on target,
+// sim/oven_sim.cpp --log on the host).
+//
+// File layout (little-endian): one RunLogHeader sector, then records packed
+// RUN_LOG_RECORDS_PER_SECTOR to a sector. sim/log2csv converts to CSV.
+
+#define RUN_LOG_SECTOR_SIZE   512
+#define RUN_LOG_RING_SIZE     256   // Records, power of two (20 s at 12.5 Hz)
+#define RUN_LOG_MAGIC         "MTRLOG1"
+#define RUN_LOG_VERSION       1
+
+// Temperatures are stored in 1/16 degC (the MCP9600 resolution)
+#define RUN_LOG_TEMP_SCALE    16.0f
+
+// RunLogRecord.flags
+#define RUN_LOG_FLAG_T2       0x0001  // t2 valid
+#define RUN_LOG_FLAG_FAULT    0x0002  // fault_active
+#define RUN_LOG_FLAG_LATE     0x0004  // Sample arrived late (PidLoopStats)
+#define RUN_LOG_FLAG_MISSED   0x0008  // Samples lost before this one
+#define RUN_LOG_FLAG_T1_SUBST 0x0010  // t1 not a good T1 reading: outlier, T2 stand-in or coast
+#define RUN_LOG_FLAG_DISAGREE 0x0020  // T1 and T2 too far apart (enable_sensor2_check)
+
+typedef struct {
+    uint32_t t_ms;          // millis()
+    int16_t t1;             // 1/16 degC
+    int16_t t2;             // 1/16 degC
+    int16_t setpoint;       // 1/16 degC
+    uint8_t out1;           // SSR1 %
+    uint8_t out2;           // SSR2 %
+    uint8_t state;          // OvenStateEnum
+    uint8_t segment;        // Saturates at 255
+    uint16_t flags;
+} RunLogRecord;
+
+#define RUN_LOG_RECORDS_PER_SECTOR (RUN_LOG_SECTOR_SIZE / sizeof(RunLogRecord))
+
+typedef struct {
+    char magic[8];          // RUN_LOG_MAGIC
+    uint16_t version;
+    uint16_t record_size;
+    uint32_t period_ms;     // Nominal sample period
+    uint32_t start_ms;      // millis() at the start of the run
+    uint32_t record_count;  // 0 if the file was not closed cleanly
+    uint32_t dropped;       // Samples lost to a full ring during the run
+    char profile[32];
+    uint8_t reserved[RUN_LOG_SECTOR_SIZE - 60];
+} RunLogHeader;
+
+typedef struct {
+    RunLogRecord records[RUN_LOG_RECORDS_PER_SECTOR];
+} RunLogSector;
+
+void run_log_init();
+
+// One sample as a record (also the USB telemetry message, comm/link_service.cpp)
+void run_log_pack(RunLogRecord* r, uint32_t t_ms, const OvenTemps* temps, const OvenMode* mode,
+                  const OvenOutputs* outputs, uint16_t extra_flags);
+
+// --- Producer (vPIDLoopTask) ---
+bool run_log_push(uint32_t t_ms, const OvenTemps* temps, const OvenMode* mode, const OvenOutputs* outputs,
+                  uint16_t extra_flags);
+
+// --- Consumer (logger) ---
+bool run_log_pop(RunLogRecord* out);
+
+// Move queued records into sector after *fill records.
+// Returns true once the sector is full (then reset *fill to 0 after writing it).
+bool run_log_fill_sector(RunLogSector* sector, uint32_t* fill);
+
+void run_log_make_header(RunLogHeader* header, uint32_t start_ms, uint32_t period_ms, const char* profile);
+
+// Samples dropped because the ring was full, since boot
+uint32_t run_log_dropped();
+
+#endif // RUN_LOG_H
@@ -0,0 +1,122 @@
+#include <cmath>
+#include <cstring>
+#include "sensor_fusion.h"
+
+enum { READ_NONE, READ_GOOD, READ_OUTLIER };
+
+static void channel_seed(FusionChannel* c, float z, uint32_t now_us) {
+    c->seeded = true;
+    c->temp = z;
+    c->rate = 0.0f;
+    c->p00 = FUSION_MEAS_VAR;
+    c->p01 = 0.0f;
+    c->p11 = 1.0f;          // Rate unknown: about 1 degC/s
+    c->rejects = 0;
+    c->last_good_us = now_us;
+}
+
+static void channel_predict(FusionChannel* c, float dt) {
+    if (!c->seeded || dt <= 0.0f) return;
+    c->temp += c->rate * dt;
+    // P = F P F' + Q, F = [1 dt; 0 1], white-noise acceleration Q
+    float q = FUSION_ACCEL_VAR;
+    float p00 = c->p00 + dt * (2.0f * c->p01 + dt * c->p11) + q * dt * dt * dt / 3.0f;
+    float p01 = c->p01 + dt * c->p11 + q * dt * dt / 2.0f;
+    float p11 = c->p11 + q * dt;
+    c->p00 = p00;
+    c->p01 = p01;
+    c->p11 = p11;
+}
+
+// One reading through the gate and the filter (prediction already done)
+static int channel_update(FusionChannel* c, float z, float gate, uint32_t now_us) {
+    if (!c->seeded || now_us - c->last_good_us > FUSION_COAST_MS * 1000u) {
+        channel_seed(c, z, now_us); // First reading, or back after a gap
+        return READ_GOOD;
+    }
+    float y = z - c->temp;
+    if (fabsf(y) > gate) {
+        if (++c->rejects <= FUSION_MAX_REJECTS) return READ_OUTLIER;
+        channel_seed(c, z, now_us); // Persistent: a real jump
+        return READ_GOOD;
+    }
+    float s = c->p00 + FUSION_MEAS_VAR;
+    float k0 = c->p00 / s;
+    float k1 = c->p01 / s;
+    c->temp += k0 * y;
+    c->rate += k1 * y;
+    float p00 = (1.0f - k0) * c->p00;
+    float p01 = (1.0f - k0) * c->p01;
+    float p11 = c->p11 - k1 * c->p01;
+    c->p00 = p00;
+    c->p01 = p01;
+    c->p11 = p11;
+    c->rejects = 0;
+    c->last_good_us = now_us;
+    return READ_GOOD;
+}
+
+void sensor_fusion_reset(SensorFusion* f) {
+    memset(f, 0, sizeof(*f));
+}
+
+void sensor_fusion_step(SensorFusion* f, const FusionConfig* cfg, SensorData* d) {
+    uint32_t now_us = d->timestamp_us;
+    float dt = (f->last_us && now_us != f->last_us) ? (now_us - f->last_us) / 1e6f : 0.0f;
+    f->last_us = now_us;
+
+    float slope = (cfg->max_slope > 0.0f) ? cfg->max_slope : FUSION_DEFAULT_SLOPE;
+    float gate = FUSION_GATE_C + FUSION_SLOPE_MARGIN * slope * dt;
+
+    channel_predict(&f->ch1, dt);
+    channel_predict(&f->ch2, dt);
+
+    int r1 = READ_NONE, r2 = READ_NONE;
+    if (d->flags & SENSOR_T1_VALID) r1 = channel_update(&f->ch1, d->t1 + cfg->t1_offset, gate, now_us);
+    if (d->flags & SENSOR_T2_VALID) r2 = channel_update(&f->ch2, d->t2 + cfg->t2_offset, gate, now_us);
+    if (r1 == READ_OUTLIER) { d->flags |= SENSOR_T1_OUTLIER; f->outliers1++; }
+    if (r2 == READ_OUTLIER) { d->flags |= SENSOR_T2_OUTLIER; f->outliers2++; }
+
+    // T1 - T2: offset while both are good, disagreement if asked for
+    bool both = (r1 == READ_GOOD) && (r2 == READ_GOOD);
+    if (both) {
+        float gap = f->ch1.temp - f->ch2.temp;
+        if (!f->bias_valid) {
+            f->bias_12 = gap;
+            f->bias_valid = true;
+        } else {
+            f->bias_12 += (gap - f->bias_12) * dt / (FUSION_BIAS_TAU_S + dt);
+        }
+        if (cfg->cross_check && fabsf(gap) > FUSION_DISAGREE_C) {
+            d->flags |= SENSOR_DISAGREE;
+            f->disagree_ms += (uint32_t)(dt * 1000.0f);
+        } else {
+            f->disagree_ms = 0;
+        }
+    } else if (r2 == READ_NONE) {
+        f->bias_valid = false; // T2 gone: the offset will be relearnt
+        f->disagree_ms = 0;
+    }
+    if (f->disagree_ms >= FUSION_DISAGREE_FAULT_MS) d->flags |= SENSOR_CROSS_FAULT;
+
+    if (r2 == READ_GOOD || (f->ch2.seeded && r2 == READ_OUTLIER)) d->t2 = f->ch2.temp;
+
+    // Fused T1
+    if (r1 == READ_GOOD) {
+        d->t1 = f->ch1.temp;
+        d->confidence = (d->flags & SENSOR_DISAGREE) ? 0.5f : 1.0f;
+        d->flags |= SENSOR_FUSED_VALID;
+    } else if (r2 == READ_GOOD && f->bias_valid) {
+        d->t1 = f->ch2.temp + f->bias_12;
+        d->confidence = 0.6f;
+        d->flags |= SENSOR_FUSED_VALID | SENSOR_T1_FROM_T2;
+        f->stand_ins++;
+    } else if (f->ch1.seeded && now_us - f->ch1.last_good_us < FUSION_COAST_MS * 1000u) {
+        d->t1 = f->ch1.temp;
+        d->confidence = 0.5f * (1.0f - (now_us - f->ch1.last_good_us) / (FUSION_COAST_MS * 1000.0f));
+        d->flags |= SENSOR_FUSED_VALID;
+        f->coasts++;
+    } else {
+        d->confidence = 0.0f;
+    }
+}
@@ -0,0 +1,76 @@
+#ifndef SENSOR_FUSION_H
+#define SENSOR_FUSION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../project_defs.h"
+
+// Sensor fusion between acquisition and control (vSensorPollerTask, before
+// each sample goes out on q_SensorData).
+//
+// Per thermocouple, in this order:
+//   - calibration offset (system.json "calibration")
+//   - constant-velocity Kalman filter (temperature and its rate): tracks a
+//     profile ramp without lag, smooths the reading noise
+//   - plausibility gate on the innovation: a reading further from the
+//     prediction than the profile max_slope allows (times a margin) is an
+//     outlier and dropped. After FUSION_MAX_REJECTS in a row the filter
+//     restarts from the reading: the oven really did move.
+//
+// Across T1 and T2:
+//   - the T1 - T2 offset is tracked while both are good
+//   - with enable_sensor2_check, a gap of more than FUSION_DISAGREE_C is a
+//     disagreement (SENSOR_DISAGREE); FUSION_DISAGREE_FAULT_MS of it sets
+//     SENSOR_CROSS_FAULT, which the alert task turns into a fault
+//   - T1 missing or rejected: T2 plus the tracked offset stands in
+//     (SENSOR_T1_FROM_T2), or else the T1 filter coasts on its prediction
+//     for up to FUSION_COAST_MS
+//
+// SensorData.t1/t2 come out fused, SENSOR_FUSED_VALID says t1 is fit for
+// control, and confidence (0-1) how much to trust it: 1 for a good
+// reading, less for a disagreement, a stand-in or a coast, 0 when invalid.
+
+#define FUSION_MEAS_VAR         0.01f   // Reading noise, degC^2 (MCP9600 at 16-18 bits)
+#define FUSION_ACCEL_VAR        0.5f    // Rate changes, (degC/s^2)^2 per Hz
+#define FUSION_GATE_C           2.0f    // Innovation always allowed
+#define FUSION_SLOPE_MARGIN     3.0f    // Rate allowed: margin x profile max_slope...
+#define FUSION_DEFAULT_SLOPE    3.0f    // ...or this if the profile sets none (degC/s)
+#define FUSION_MAX_REJECTS      3
+#define FUSION_COAST_MS         1000
+#define FUSION_BIAS_TAU_S       30.0f   // T1 - T2 offset tracking
+#define FUSION_DISAGREE_C       15.0f
+#define FUSION_DISAGREE_FAULT_MS 10000
+
+typedef struct {
+    float t1_offset, t2_offset;
+    float max_slope;        // Profile "safety.max_slope", 0 = none
+    bool cross_check;       // enable_sensor2_check
+} FusionConfig;
+
+typedef struct {
+    bool seeded;
+    float temp, rate;       // Kalman state
+    float p00, p01, p11;    // Its covariance
+    uint8_t rejects;        // In a row
+    uint32_t last_good_us;
+} FusionChannel;
+
+typedef struct {
+    FusionChannel ch1, ch2;
+    float bias_12;          // T1 - T2 while both are good
+    bool bias_valid;
+    uint32_t disagree_ms;
+    uint32_t last_us;
+    // Statistics
+    uint32_t outliers1, outliers2;
+    uint32_t stand_ins;     // T1 from T2
+    uint32_t coasts;
+} SensorFusion;
+
+void sensor_fusion_reset(SensorFusion* f);
+
+// Fuses one sample in place: t1/t2 filtered and calibrated, confidence
+// and the SENSOR_* fusion flags set
+void sensor_fusion_step(SensorFusion* f, const FusionConfig* cfg, SensorData* d);
+
+#endif // SENSOR_FUSION_H
@@ -0,0 +1,94 @@
+#include "ssr_output.h"
+#include "oven_control.h"
+#include "oven_hal.h"
+
+typedef struct {
+    int32_t acc;                // Sigma-delta accumulator
+    volatile uint32_t slot_us;
+    volatile uint32_t on_slots;
+    volatile uint32_t slots;
+} SsrChannel;
+
+static SsrChannel channels[2];
+static volatile bool killed = false;
+
+static uint32_t compute_slot_us(int channel) {
+    int window_ms = (channel == 2) ? sysConfig.ssr2_window_ms : sysConfig.ssr1_window_ms;
+    if (window_ms <= 0) window_ms = SSR_OUTPUT_DEFAULT_WINDOW_MS;
+    uint32_t slot_us = (uint32_t)window_ms * 1000u / SSR_OUTPUT_STEPS;
+
+    if (sysConfig.mains_hz > 0) {
+        // Round to whole mains cycles
+        uint32_t cycle_us = 1000000u / (uint32_t)sysConfig.mains_hz;
+        uint32_t cycles = (slot_us + cycle_us / 2) / cycle_us;
+        if (cycles < 1) cycles = 1;
+        return cycles * cycle_us;
+    }
+    return (slot_us < SSR_OUTPUT_MIN_SLOT_US) ? SSR_OUTPUT_MIN_SLOT_US : slot_us;
+}
+
+// Timer context: lock-free reads of the published state only
+static uint32_t ssr_slot(int channel) {
+    SsrChannel* ch = &channels[channel - 1];
+    bool on = false;
+
+    if (!killed && !oven_alert_tripped() && oven_state_is_heating(oven_state_mode().state)) {
+        OvenOutputs out = oven_state_outputs();
+        float p = (channel == 2) ? out.power_output_2 : out.power_output_1; // 0-100
+        int32_t level = (int32_t)(p * (SSR_OUTPUT_SCALE / 100) + 0.5f);
+        if (level < 0) level = 0;
+        if (level > SSR_OUTPUT_SCALE) level = SSR_OUTPUT_SCALE;
+
+        ch->acc += level;
+        if (ch->acc >= SSR_OUTPUT_SCALE) {
+            ch->acc -= SSR_OUTPUT_SCALE;
+            on = true;
+        }
+    } else {
+        ch->acc = 0; // No stored energy released when heating resumes
+    }
+
+    hal_ssr_set(channel, on);
+    // The alert IRQ (or a kill) may have switched the SSRs off between the
+    // check above and this write: checked again once it has landed
+    if (on && (killed || oven_alert_tripped())) {
+        hal_ssr_set(channel, false);
+        on = false;
+    }
+    ch->slots = ch->slots + 1;
+    if (on) ch->on_slots = ch->on_slots + 1;
+
+    // Window/mains changes from system.json apply from the next slot
+    ch->slot_us = compute_slot_us(channel);
+    return ch->slot_us;
+}
+
+void ssr_output_start() {
+    hal_ssr_init();
+    for (int c = 1; c <= 2; c++) {
+        SsrChannel* ch = &channels[c - 1];
+        ch->acc = 0;
+        ch->on_slots = 0;
+        ch->slots = 0;
+        ch->slot_us = compute_slot_us(c);
+        hal_ssr_timer_start(c, ch->slot_us, ssr_slot);
+    }
+}
+
+void ssr_output_kill() {
+    killed = true;
+    hal_ssr_set(1, false);
+    hal_ssr_set(2, false);
+}
+
+uint32_t ssr_output_slot_us(int channel) {
+    return channels[(channel == 2) ? 1 : 0].slot_us;
+}
+
+uint32_t ssr_output_on_slots(int channel) {
+    return channels[(channel == 2) ? 1 : 0].on_slots;
+}
+
+uint32_t ssr_output_slots(int channel) {
+    return channels[(channel == 2) ? 1 : 0].slots;
+}
@@ -0,0 +1,44 @@
+#ifndef SSR_OUTPUT_H
+#define SSR_OUTPUT_H
+
+#include <stdint.h>
+
+// SSR output stage: time-proportioning driven by a hardware alarm per SSR
+// (hal_ssr_timer_start), no task involved.
+//
+// Each window (sysConfig.ssrN_window_ms) is split into SSR_OUTPUT_STEPS
+// slots. At every slot a first-order sigma-delta (Bresenham) accumulator
+// decides on/off from the published PID output, so a window carries the
+// power to 1 % and the remainder carries over to the next one instead of
+// being truncated.
+//
+// With sysConfig.mains_hz set, slots are whole mains cycles (at least one):
+// a zero-crossing SSR then always conducts full cycles, with no DC
+// component. There is no zero-cross input on this board, so slots are
+// cycle-long but not phase-locked to the mains.
+//
+// Outputs are forced off at the next slot (<= one slot) unless the state
+// is a heating state, whatever the PID last published. A hardware
+// over-temperature trip switches them off at once from its ISR and the
+// slots keep them off until it is acknowledged (control/hw_alert.h).
+
+#define SSR_OUTPUT_STEPS        100   // Slots per window (1 % resolution)
+#define SSR_OUTPUT_SCALE        1000  // Accumulator units per slot (0.1 % input)
+#define SSR_OUTPUT_MIN_SLOT_US  10000 // A zero-crossing SSR cannot switch faster than a half-cycle
+#define SSR_OUTPUT_DEFAULT_WINDOW_MS 1000
+
+// hal_ssr_init() + start both slot timers
+void ssr_output_start();
+
+// Both SSRs off now and at every slot until reset, whatever the state.
+// Safe from any context (ISR, fault hooks, either core).
+void ssr_output_kill();
+
+// Slot length currently used by a channel, in us
+uint32_t ssr_output_slot_us(int channel);
+
+// Slots switched on / total since start (duty check, SYS INFO)
+uint32_t ssr_output_on_slots(int channel);
+uint32_t ssr_output_slots(int channel);
+
+#endif // SSR_OUTPUT_H
@@ -0,0 +1,139 @@
+#include <cstring>
+#include "zone_control.h"
+
+static const char* const zone_mode_names[ZONE_MODE_COUNT] = {
+    "shared", "independent", "ratio", "split", "uniform"
+};
+
+static float clampf(float v, float lo, float hi) {
+    return (v < lo) ? lo : (v > hi) ? hi : v;
+}
+
+// Mode actually run: the T2 modes need T2, all of them need SSR2
+static ZoneMode effective_mode(const ZoneConfig* cfg, const ZoneInputs* in) {
+    if (!cfg->ssr2_present) return ZONE_SHARED;
+    if ((cfg->mode == ZONE_INDEPENDENT || cfg->mode == ZONE_UNIFORM) && !in->t2_valid) return ZONE_SHARED;
+    return cfg->mode;
+}
+
+// Uniformity trim loop: SSR2 gains, bipolar output
+static PidParams trim_params(const ZoneConfig* cfg, const PidParams* p2) {
+    PidParams pb = *p2;
+    pb.out_min = -cfg->trim_pct;
+    pb.out_max = cfg->trim_pct;
+    if (pb.i_limit > cfg->trim_pct) pb.i_limit = cfg->trim_pct;
+    return pb;
+}
+
+// Split range: demand u -> SSR1 0..100 % over 0..split, SSR2 above
+static void split_outputs(float u, float split, float* out1, float* out2) {
+    *out1 = clampf(u * 100.0f / split, 0.0f, 100.0f);
+    *out2 = clampf((u - split) * 100.0f / (100.0f - split), 0.0f, 100.0f);
+}
+
+static float split_demand(float out1, float out2, float split) {
+    if (out2 > 0.0f) return split + out2 * (100.0f - split) / 100.0f;
+    return out1 * split / 100.0f;
+}
+
+// Take over from the last outputs in the mode about to run
+static void hand_over(ZoneControl* zc, ZoneMode mode, const ZoneConfig* cfg, const PidParams* p1, const PidParams* p2,
+                      const ZoneInputs* in) {
+    switch (mode) {
+        case ZONE_INDEPENDENT:
+            pid_bumpless(&zc->pid1, p1, in->setpoint, in->t1, in->feedforward, zc->out1);
+            pid_bumpless(&zc->pid2, p2, in->setpoint, in->t2, in->feedforward, zc->out2);
+            break;
+        case ZONE_RATIO:
+            pid_bumpless(&zc->pid1, p1, in->setpoint, in->t1, in->feedforward, zc->out1);
+            break;
+        case ZONE_SPLIT:
+            pid_bumpless(&zc->pid1, p1, in->setpoint, in->t1, in->feedforward,
+                         split_demand(zc->out1, zc->out2, cfg->split_pct));
+            break;
+        case ZONE_UNIFORM: {
+            PidParams pb = trim_params(cfg, p2);
+            float avg = 0.5f * (in->t1 + in->t2);
+            pid_bumpless(&zc->pid1, p1, in->setpoint, avg, in->feedforward, 0.5f * (zc->out1 + zc->out2));
+            pid_bumpless(&zc->pid2, &pb, 0.0f, in->t1 - in->t2, 0.0f,
+                         clampf(0.5f * (zc->out1 - zc->out2), pb.out_min, pb.out_max));
+            break;
+        }
+        default:
+            pid_bumpless(&zc->pid1, p1, in->setpoint, in->t1, in->feedforward, zc->out1);
+            pid_bumpless(&zc->pid2, p2, in->setpoint, in->t1, in->feedforward, zc->out2);
+            break;
+    }
+}
+
+void zone_control_reset(ZoneControl* zc) {
+    memset(zc, 0, sizeof(*zc));
+    pid_reset(&zc->pid1);
+    pid_reset(&zc->pid2);
+}
+
+void zone_control_release(ZoneControl* zc, float out1, float out2) {
+    zc->active = false;
+    zc->out1 = out1;
+    zc->out2 = out2;
+}
+
+void zone_control_update(ZoneControl* zc, const ZoneConfig* cfg, const PidParams* p1, const PidParams* p2,
+                         const ZoneInputs* in, float* out1, float* out2) {
+    ZoneMode mode = effective_mode(cfg, in);
+    if (!zc->active || mode != zc->in_use) {
+        hand_over(zc, mode, cfg, p1, p2, in);
+        zc->active = true;
+        zc->in_use = mode;
+    }
+
+    float o1 = 0, o2 = 0;
+    switch (mode) {
+        case ZONE_INDEPENDENT:
+            o1 = pid_update(&zc->pid1, p1, in->setpoint, in->t1, in->feedforward, in->dt_s);
+            o2 = pid_update(&zc->pid2, p2, in->setpoint, in->t2, in->feedforward, in->dt_s);
+            break;
+        case ZONE_RATIO:
+            o1 = pid_update(&zc->pid1, p1, in->setpoint, in->t1, in->feedforward, in->dt_s);
+            o2 = clampf(cfg->ratio * o1, p2->out_min, p2->out_max);
+            break;
+        case ZONE_SPLIT: {
+            float u = pid_update(&zc->pid1, p1, in->setpoint, in->t1, in->feedforward, in->dt_s);
+            split_outputs(u, cfg->split_pct, &o1, &o2);
+            break;
+        }
+        case ZONE_UNIFORM: {
+            PidParams pb = trim_params(cfg, p2);
+            float u = pid_update(&zc->pid1, p1, in->setpoint, 0.5f * (in->t1 + in->t2), in->feedforward, in->dt_s);
+            float b = pid_update(&zc->pid2, &pb, 0.0f, in->t1 - in->t2, 0.0f, in->dt_s);
+            o1 = clampf(u + b, p1->out_min, p1->out_max);
+            o2 = clampf(u - b, p2->out_min, p2->out_max);
+            break;
+        }
+        default:
+            o1 = pid_update(&zc->pid1, p1, in->setpoint, in->t1, in->feedforward, in->dt_s);
+            if (cfg->ssr2_present) {
+                o2 = pid_update(&zc->pid2, p2, in->setpoint, in->t1, in->feedforward, in->dt_s);
+            }
+            break;
+    }
+
+    zc->out1 = o1;
+    zc->out2 = o2;
+    *out1 = o1;
+    *out2 = o2;
+}
+
+const char* zone_mode_name(ZoneMode mode) {
+    return ((unsigned)mode < ZONE_MODE_COUNT) ? zone_mode_names[mode] : "?";
+}
+
+bool zone_mode_parse(const char* name, ZoneMode* mode) {
+    for (int i = 0; i < ZONE_MODE_COUNT; i++) {
+        if (strcmp(name, zone_mode_names[i]) == 0) {
+            *mode = (ZoneMode)i;
+            return true;
+        }
+    }
+    return false;
+}
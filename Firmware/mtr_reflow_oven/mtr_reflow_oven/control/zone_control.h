@@ -0,0 +1,78 @@
+#ifndef ZONE_CONTROL_H
+#define ZONE_CONTROL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pid.h"
+
+// Dual-zone control: how the two PIDs (control/pid.h) share the work of
+// the two SSRs. Selected by "zones": {"mode": ...} in system.json.
+//
+//   shared       both PIDs on T1, each with its own gains (the original
+//                behaviour, and the default)
+//   independent  T1 -> PID1 -> SSR1, T2 -> PID2 -> SSR2: one loop per
+//                zone, each element under its own probe
+//   ratio        SSR2 slaved to SSR1: SSR2 = ratio * SSR1 (PID1 on T1)
+//   split        split range on one demand u (PID1 on T1, 0-100 %):
+//                SSR1 carries 0..split_pct, SSR2 engages above it
+//   uniform      cross-coupled: PID1 holds the zone average (T1 + T2) / 2
+//                to the setpoint with a common power u, PID2 (SSR2 gains)
+//                holds T1 - T2 to zero with a trim b within +/-trim_pct:
+//                SSR1 = u + b, SSR2 = u - b
+//
+// The T2 modes (independent, uniform) fall back to shared while T2 is
+// not valid, and back again once it is: every change of the mode in use
+// hands the outputs over without a bump. Without SSR2 every mode is
+// shared, on SSR1 alone.
+
+typedef enum {
+    ZONE_SHARED = 0,
+    ZONE_INDEPENDENT,
+    ZONE_RATIO,
+    ZONE_SPLIT,
+    ZONE_UNIFORM,
+    ZONE_MODE_COUNT
+} ZoneMode;
+
+#define ZONE_DEFAULT_RATIO      0.8f    // SSR2 = 80 % of SSR1 (design doc)
+#define ZONE_DEFAULT_SPLIT_PCT  60.0f
+#define ZONE_DEFAULT_TRIM_PCT   20.0f
+
+typedef struct {
+    ZoneMode mode;
+    float ratio;            // ratio: SSR2 / SSR1
+    float split_pct;        // split: demand at which SSR1 is full and SSR2 starts
+    float trim_pct;         // uniform: SSR1/SSR2 power difference bound, each way
+    bool ssr2_present;
+} ZoneConfig;
+
+typedef struct {
+    float setpoint;
+    float t1, t2;
+    bool t2_valid;
+    float feedforward;      // Added to the demand (control/feedforward.h)
+    float dt_s;
+} ZoneInputs;
+
+typedef struct {
+    Pid pid1, pid2;
+    bool active;            // The PIDs drove the outputs last update
+    ZoneMode in_use;        // Mode after the T2 fallback
+    float out1, out2;       // Last outputs, whoever drove them
+} ZoneControl;
+
+void zone_control_reset(ZoneControl* zc);
+
+// The outputs were set from outside (SSRs off, auto-tune relay): the next
+// update takes over from them without a bump
+void zone_control_release(ZoneControl* zc, float out1, float out2);
+
+// One step. p1/p2 are the SSR1/SSR2 gains and limits.
+void zone_control_update(ZoneControl* zc, const ZoneConfig* cfg, const PidParams* p1, const PidParams* p2,
+                         const ZoneInputs* in, float* out1, float* out2);
+
+// system.json names: "shared", "independent", "ratio", "split", "uniform"
+const char* zone_mode_name(ZoneMode mode);
+bool zone_mode_parse(const char* name, ZoneMode* mode);
+
+#endif // ZONE_CONTROL_H
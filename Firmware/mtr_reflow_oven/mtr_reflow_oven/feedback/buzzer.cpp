@@ -0,0 +1,149 @@
+#include "buzzer.h"
+#include "../board_config.h"
+#include "hardware/gpio.h"
+#include "hardware/pwm.h"
+#include "hardware/clocks.h"
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "timers.h"
+#include <stdio.h>
+
+// --- Patterns ---
+static const BuzzerNote notes_click[] = {
+    { 500, 15, 100 },
+};
+static const BuzzerNote notes_boot[] = {
+    { 500, 100, 100 }, { 0, 100, 0 },
+    { 500, 100, 100 }, { 0, 100, 0 },
+    { 500, 100, 100 },
+};
+static const BuzzerNote notes_cycle_done[] = {
+    { 523, 120, 100 }, { 659, 120, 100 }, { 784, 120, 100 }, { 0, 60, 0 },
+    { 1047, 300, 100 },
+};
+static const BuzzerNote notes_fault_siren[] = {
+    { 500, 250, 100 }, { 350, 250, 100 },
+};
+
+typedef struct {
+    const BuzzerNote* notes;
+    uint8_t count;
+    bool loop;
+} BuzzerPatternDef;
+
+static const BuzzerPatternDef patterns[BUZZER_PATTERN_COUNT] = {
+    { notes_click, 1, false },
+    { notes_boot, 5, false },
+    { notes_cycle_done, 5, false },
+    { notes_fault_siren, 2, true },
+};
+
+// --- Engine State (timer task only) ---
+static uint buzzer_slice;
+static uint32_t pwm_tick_hz;            // PWM counter rate after the divider
+static volatile int master_volume = 100;
+static TimerHandle_t note_timer = NULL;
+static QueueHandle_t q_Buzzer = NULL;
+static const BuzzerPatternDef* current = NULL;
+static uint8_t note_index = 0;
+
+// PWM counter at 1 MHz: 16-bit wrap covers 16 Hz .. 20 kHz comfortably
+#define BUZZER_PWM_TICK_HZ 1000000u
+
+static void buzzer_output(uint16_t freq_hz, uint8_t volume_pct) {
+    uint32_t level_pct = (uint32_t)volume_pct * (uint32_t)master_volume / 100;
+    if (freq_hz == 0 || level_pct == 0) {
+        pwm_set_gpio_level(GPIO_BUZZER, 0);
+        return;
+    }
+    uint32_t wrap = pwm_tick_hz / freq_hz;
+    if (wrap < 2) wrap = 2;
+    if (wrap > 65535) wrap = 65535;
+    pwm_set_wrap(buzzer_slice, (uint16_t)(wrap - 1));
+    // A passive buzzer is loudest at 50% duty: full volume maps to 50%
+    pwm_set_gpio_level(GPIO_BUZZER, (uint16_t)(wrap * level_pct / 200));
+}
+
+// Start the next note, or the next queued pattern. Runs in the timer task.
+static void buzzer_advance(void) {
+    for (;;) {
+        if (current && note_index >= current->count) {
+            if (current->loop) note_index = 0;
+            else current = NULL;
+        }
+        if (!current) {
+            uint8_t next;
+            if (xQueueReceive(q_Buzzer, &next, 0) != pdTRUE) {
+                buzzer_output(0, 0);
+                return;
+            }
+            current = &patterns[next];
+            note_index = 0;
+        }
+        const BuzzerNote* n = &current->notes[note_index++];
+        if (n->duration_ms == 0) continue;
+        buzzer_output(n->freq_hz, n->volume_pct);
+        xTimerChangePeriod(note_timer, pdMS_TO_TICKS(n->duration_ms), 0);
+        return;
+    }
+}
+
+static void buzzer_timer_cb(TimerHandle_t timer) {
+    (void)timer;
+    buzzer_advance();
+}
+
+// xTimerPendFunctionCall() targets: keep all sequencing in the timer task
+static void buzzer_kick(void* param, uint32_t interrupt) {
+    (void)param;
+    if (interrupt) {
+        // Fault siren: drop what is playing
+        xTimerStop(note_timer, 0);
+        current = NULL;
+    }
+    if (!current) buzzer_advance();
+}
+
+static void buzzer_silence(void* param, uint32_t unused) {
+    (void)param; (void)unused;
+    xTimerStop(note_timer, 0);
+    xQueueReset(q_Buzzer);
+    current = NULL;
+    buzzer_output(0, 0);
+}
+
+void buzzer_init(void) {
+    gpio_set_function(GPIO_BUZZER, GPIO_FUNC_PWM);
+    gpio_set_drive_strength(GPIO_BUZZER, GPIO_DRIVE_STRENGTH_12MA);
+    buzzer_slice = pwm_gpio_to_slice_num(GPIO_BUZZER);
+
+    pwm_config cfg = pwm_get_default_config();
+    pwm_config_set_clkdiv(&cfg, (float)clock_get_hz(clk_sys) / BUZZER_PWM_TICK_HZ);
+    pwm_init(buzzer_slice, &cfg, true);
+    pwm_tick_hz = BUZZER_PWM_TICK_HZ;
+    pwm_set_gpio_level(GPIO_BUZZER, 0);
+
+    q_Buzzer = xQueueCreate(4, sizeof(uint8_t));
+    note_timer = xTimerCreate("Buzzer", pdMS_TO_TICKS(10), pdFALSE, NULL, buzzer_timer_cb);
+}
+
+bool buzzer_play(BuzzerPattern pattern) {
+    if (!q_Buzzer || pattern >= BUZZER_PATTERN_COUNT) return false;
+    uint8_t id = (uint8_t)pattern;
+    bool interrupt = patterns[pattern].loop;
+    if (interrupt) xQueueReset(q_Buzzer);
+    if (xQueueSend(q_Buzzer, &id, 0) != pdTRUE) return false;
+    xTimerPendFunctionCall(buzzer_kick, NULL, interrupt ? 1 : 0, 0);
+    return true;
+}
+
+void buzzer_stop(void) {
+    if (!q_Buzzer) return;
+    xTimerPendFunctionCall(buzzer_silence, NULL, 0, 0);
+}
+
+void buzzer_set_volume(int volume_pct) {
+    if (volume_pct < 0) volume_pct = 0;
+    if (volume_pct > 100) volume_pct = 100;
+    master_volume = volume_pct;
+}
@@ -0,0 +1,40 @@
+#ifndef BUZZER_H
+#define BUZZER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Non-blocking tone engine for the passive buzzer on GPIO_BUZZER.
+// The pin is driven by its PWM slice (frequency = note, duty = volume) and
+// notes are sequenced by a FreeRTOS software timer, so callers only post a
+// request and return.
+
+typedef struct {
+    uint16_t freq_hz;       // 0 = rest
+    uint16_t duration_ms;
+    uint8_t volume_pct;     // Relative to SystemConfig::buzzer_volume
+} BuzzerNote;
+
+typedef enum {
+    BUZZER_CLICK = 0,       // Button / encoder press
+    BUZZER_BOOT,            // Three short beeps
+    BUZZER_CYCLE_DONE,      // Profile finished
+    BUZZER_FAULT_SIREN,     // Loops until buzzer_stop()
+    BUZZER_PATTERN_COUNT
+} BuzzerPattern;
+
+// PWM + timer + request queue. Can be called before the scheduler starts;
+// anything queued then plays once it runs.
+void buzzer_init(void);
+
+// Queue a pattern behind whatever is playing. The fault siren interrupts
+// instead and drops the queue. Returns false if the queue is full.
+bool buzzer_play(BuzzerPattern pattern);
+
+// Silence now and drop anything queued (ends the siren loop)
+void buzzer_stop(void);
+
+// 0-100, usually sysConfig.buzzer_volume. 0 mutes.
+void buzzer_set_volume(int volume_pct);
+
+#endif // BUZZER_H
@@ -0,0 +1,82 @@
+#include "status_leds.h"
+#include "ws2812.h"
+
+typedef struct { uint8_t r, g, b; } Rgb;
+
+static const Rgb C_OFF    = {0, 0, 0};
+static const Rgb C_WHITE  = {40, 40, 40};
+static const Rgb C_BLUE   = {0, 40, 255};
+static const Rgb C_ORANGE = {255, 100, 0};
+static const Rgb C_RED    = {255, 0, 0};
+static const Rgb C_GREEN  = {0, 255, 0};
+
+static uint8_t lerp8(uint8_t a, uint8_t b, float f) {
+    return (uint8_t)(a + (b - a) * f);
+}
+
+static Rgb mix(Rgb a, Rgb b, float f) {
+    if (f < 0.0f) f = 0.0f;
+    if (f > 1.0f) f = 1.0f;
+    Rgb c = { lerp8(a.r, b.r, f), lerp8(a.g, b.g, f), lerp8(a.b, b.b, f) };
+    return c;
+}
+
+// Blue (cool) -> orange (preheat, 150 C) -> red (reflow)
+static Rgb temp_gradient(float t) {
+    const float t_pre = 150.0f;
+    if (t <= STATUS_LED_HOT_C) return C_BLUE;
+    if (t < t_pre) return mix(C_BLUE, C_ORANGE, (t - STATUS_LED_HOT_C) / (t_pre - STATUS_LED_HOT_C));
+    return mix(C_ORANGE, C_RED, (t - t_pre) / (STATUS_LED_REFLOW_C - t_pre));
+}
+
+void status_leds_update(OvenStateEnum state, float t1, uint32_t now_ms) {
+    uint32_t n = ws2812_count();
+    bool hot = (t1 > STATUS_LED_HOT_C);
+
+    switch (state) {
+        case STATE_INIT:
+            ws2812_fill(C_WHITE.r, C_WHITE.g, C_WHITE.b);
+            break;
+
+        case STATE_PRE_CHECK:
+        case STATE_RUNNING:
+        case STATE_MANUAL:
+        case STATE_AUTOTUNE: {
+            Rgb c = temp_gradient(t1);
+            ws2812_fill(c.r, c.g, c.b);
+            break;
+        }
+
+        case STATE_IDLE:
+        case STATE_COOLDOWN: {
+            if (hot) {
+                // "HOT": red/orange alternating at 1 Hz until safe to open
+                bool phase = ((now_ms / 500) & 1) != 0;
+                for (uint32_t i = 0; i < n; i++) {
+                    Rgb c = (((i & 1) != 0) == phase) ? C_RED : C_ORANGE;
+                    ws2812_set_pixel(i, c.r, c.g, c.b);
+                }
+            } else {
+                Rgb c = (state == STATE_COOLDOWN) ? C_GREEN : C_BLUE;
+                ws2812_fill(c.r, c.g, c.b);
+            }
+            break;
+        }
+
+        case STATE_FAULT: {
+            // Strobe: 10 Hz, even/odd LEDs in opposition
+            bool phase = ((now_ms / 50) & 1) != 0;
+            for (uint32_t i = 0; i < n; i++) {
+                Rgb c = (((i & 1) != 0) == phase) ? C_RED : C_OFF;
+                ws2812_set_pixel(i, c.r, c.g, c.b);
+            }
+            break;
+        }
+
+        default:
+            ws2812_fill(C_OFF.r, C_OFF.g, C_OFF.b);
+            break;
+    }
+
+    ws2812_show();
+}
@@ -0,0 +1,19 @@
+#ifndef STATUS_LEDS_H
+#define STATUS_LEDS_H
+
+#include <stdint.h>
+#include "../project_defs.h"
+
+// Status LED effects (doc/project_description.md): Blue = cool,
+// Orange = preheat, Red = reflow, Green = complete, "HOT" blink while the
+// oven is above 50 C after a cycle, strobe on fault.
+// Renders into the WS2812 frame buffer and calls ws2812_show(), which only
+// transmits when the colours actually changed.
+
+#define STATUS_LED_HOT_C      50.0f   // Above this an idle/cooling oven blinks "HOT"
+#define STATUS_LED_REFLOW_C   217.0f  // Full red from here (SAC305 liquidus)
+
+// Call periodically (20-50 ms) from the feedback task
+void status_leds_update(OvenStateEnum state, float t1, uint32_t now_ms);
+
+#endif // STATUS_LEDS_H
@@ -0,0 +1,130 @@
+#include "ws2812.h"
+#include "hardware/pio.h"
+#include "hardware/dma.h"
+#include "hardware/clocks.h"
+#include "hardware/timer.h"
+#include <cstring>
+
+#define WS2812_PIO          pio0
+#define WS2812_FREQ_HZ      800000
+
+// No DMA interrupt: DMA_IRQ_0 is FatFs and DMA_IRQ_1 the display, which is
+// enabled on core 1 only. The end of a frame is computed instead: 30 us per
+// LED on the wire, then the line must stay low for the reset latch.
+#define WS2812_LED_US       30
+#define WS2812_LATCH_US     300
+
+// --- WS2812B PIO Program (Pre-compiled) ---
+static const uint16_t ws2812_program_instructions[] = {
+    0x6221, //  0: out    x, 1            side 0 [2] 
+    0x1123, //  1: jmp    !x, 3           side 1 [1] 
+    0x1400, //  2: jmp    0               side 1 [4] 
+    0xa442, //  3: nop                    side 0 [4] 
+};
+
+static const struct pio_program ws2812_program = {
+    .instructions = ws2812_program_instructions,
+    .length = 4,
+    .origin = -1,
+};
+
+static uint sm = 0;
+static int dma_chan = -1;
+static uint32_t led_count = 0;
+static uint8_t brightness = 255;
+
+static uint32_t frame[WS2812_MAX_LEDS];     // GRB, written by the caller
+static uint32_t sent[WS2812_MAX_LEDS];      // Last frame put on the wire (after brightness)
+static uint32_t tx_buf[WS2812_MAX_LEDS];    // Read by DMA, GRB << 8
+static uint32_t tx_start_us = 0;            // Last frame: start and length
+static uint32_t tx_len_us = 0;              // on the wire, latch included
+static uint32_t frames_sent = 0;
+
+static void ws2812_program_init(PIO pio, uint sm, uint offset, uint pin, float freq) {
+    pio_gpio_init(pio, pin);
+    pio_sm_set_consecutive_pindirs(pio, sm, pin, 1, true);
+
+    pio_sm_config c = pio_get_default_sm_config();
+    sm_config_set_sideset_pins(&c, pin);
+    sm_config_set_sideset(&c, 1, false, false); // 1 sideset bit, not optional, not pindirs
+    sm_config_set_out_shift(&c, false, true, 24);
+    sm_config_set_fifo_join(&c, PIO_FIFO_JOIN_TX);
+    sm_config_set_wrap(&c, offset, offset + 3); // wrap around all 4 instructions
+
+    float div = clock_get_hz(clk_sys) / (freq * 10);
+    sm_config_set_clkdiv(&c, div);
+
+    pio_sm_init(pio, sm, offset, &c);
+    pio_sm_set_enabled(pio, sm, true);
+}
+
+void ws2812_init(uint32_t pin, uint32_t count) {
+    led_count = (count > WS2812_MAX_LEDS) ? WS2812_MAX_LEDS : count;
+    memset(frame, 0, sizeof(frame));
+    memset(sent, 0xFF, sizeof(sent)); // Force the first show()
+
+    uint offset = pio_add_program(WS2812_PIO, &ws2812_program);
+    sm = (uint)pio_claim_unused_sm(WS2812_PIO, true);
+    ws2812_program_init(WS2812_PIO, sm, offset, pin, WS2812_FREQ_HZ);
+
+    // Frame DMA: memory -> PIO TX FIFO, paced by the state machine DREQ
+    dma_chan = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(dma_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_dreq(&c, pio_get_dreq(WS2812_PIO, sm, true));
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    dma_channel_configure(dma_chan, &c, &WS2812_PIO->txf[sm], tx_buf, 0, false);
+}
+
+uint32_t ws2812_count(void) {
+    return led_count;
+}
+
+void ws2812_set_brightness(uint8_t level) {
+    brightness = level;
+}
+
+void ws2812_set_pixel(uint32_t index, uint8_t r, uint8_t g, uint8_t b) {
+    if (index >= led_count) return;
+    frame[index] = ((uint32_t)g << 16) | ((uint32_t)r << 8) | b;
+}
+
+void ws2812_fill(uint8_t r, uint8_t g, uint8_t b) {
+    for (uint32_t i = 0; i < led_count; i++) ws2812_set_pixel(i, r, g, b);
+}
+
+static uint32_t scale_grb(uint32_t grb) {
+    if (brightness == 255) return grb;
+    uint32_t g = ((grb >> 16) & 0xFF) * brightness / 255;
+    uint32_t r = ((grb >> 8) & 0xFF) * brightness / 255;
+    uint32_t b = (grb & 0xFF) * brightness / 255;
+    return (g << 16) | (r << 8) | b;
+}
+
+bool ws2812_show(void) {
+    if (dma_chan < 0 || led_count == 0) return false;
+    if (dma_channel_is_busy(dma_chan) || time_us_32() - tx_start_us < tx_len_us) return false;
+
+    bool changed = false;
+    uint32_t scaled[WS2812_MAX_LEDS];
+    for (uint32_t i = 0; i < led_count; i++) {
+        scaled[i] = scale_grb(frame[i]);
+        if (scaled[i] != sent[i]) changed = true;
+    }
+    if (!changed) return false;
+
+    for (uint32_t i = 0; i < led_count; i++) {
+        sent[i] = scaled[i];
+        tx_buf[i] = scaled[i] << 8u; // 24 bits, MSB first
+    }
+    tx_start_us = time_us_32();
+    tx_len_us = led_count * WS2812_LED_US + WS2812_LATCH_US;
+    frames_sent++;
+    dma_channel_transfer_from_buffer_now(dma_chan, tx_buf, led_count);
+    return true;
+}
+
+uint32_t ws2812_frames_sent(void) {
+    return frames_sent;
+}
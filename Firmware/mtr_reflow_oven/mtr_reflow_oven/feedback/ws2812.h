@@ -0,0 +1,35 @@
+#ifndef WS2812_H
+#define WS2812_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// DMA-fed WS2812B chain on one PIO state machine.
+// Pixels are set in a frame buffer; ws2812_show() hands the frame to DMA and
+// returns. The >280 us reset latch after the last bit is respected by
+// refusing the next frame until it has passed (no sleep, no interrupt), and
+// nothing is sent if the frame did not change. Single caller (vFeedbackTask).
+
+#define WS2812_MAX_LEDS 16
+
+// count <= WS2812_MAX_LEDS
+void ws2812_init(uint32_t pin, uint32_t count);
+
+uint32_t ws2812_count(void);
+
+// Global brightness 0-255 applied at transmit time
+void ws2812_set_brightness(uint8_t level);
+
+// Frame buffer access (not sent until ws2812_show())
+void ws2812_set_pixel(uint32_t index, uint8_t r, uint8_t g, uint8_t b);
+void ws2812_fill(uint8_t r, uint8_t g, uint8_t b);
+
+// Send the frame if it differs from the last one sent. Never blocks: returns
+// false if unchanged or if the previous frame (or its latch) is still in
+// flight, in which case the next call picks the change up.
+bool ws2812_show(void);
+
+// Frames actually put on the wire (for SYS INFO / debugging)
+uint32_t ws2812_frames_sent(void);
+
+#endif // WS2812_H
@@ -7,6 +7,7 @@
 #include "hardware/i2c.h"
 #include "hardware/dma.h"
 #include "hardware/gpio.h"
+#include "hardware/irq.h"
 
 // FreeRTOS Headers
 #include "FreeRTOS.h"
@@ -17,6 +18,21 @@
 // Project Headers
 #include "board_config.h"
 #include "project_defs.h"
+#include "control/oven_control.h"
+#include "control/oven_hal.h"
+#include "control/profile_parser.h"
+#include "control/i2c_bus.h"
+#include "control/ssr_output.h"
+#include "control/zone_control.h"
+#include "feedback/buzzer.h"
+#include "feedback/ws2812.h"
+#include "feedback/status_leds.h"
+#include "storage/profile_store.h"
+#include "storage/run_logger.h"
+#include "system/spi_bus.h"
+#include "system/sys_stats.h"
+#include "comm/link_service.h"
+#include "comm/link_commands.h"
 
 // Library Headers
 // #include "hagl_hal.h"
@@ -25,6 +41,7 @@
 #include <cwchar>
 #include <cstring>
 #include "ui/ui_manager.h"
+#include "ui/ui_screens.h"
 
 // LVGL Tick Interface
 extern "C" uint32_t my_tick_get(void) {
@@ -34,38 +51,15 @@ extern "C" uint32_t my_tick_get(void) {
 #include "ff.h"
 #include "diskio.h"
 #include "sd_card.h"
-#include "cJSON.h"
-#include "hardware/pio.h"
-#include "hardware/clocks.h"
 
 // --- Project Definitions ---
 // --- Project Definitions ---
-// MAX_PROFILE_SEGMENTS moved to project_defs.h
 
 // --- Helper Functions ---
 uint32_t millis() {
     return to_ms_since_boot(get_absolute_time());
 }
 
-// Helper: Play tone for passive buzzer (blocking)
-void play_tone(uint32_t freq_hz, uint32_t duration_ms) {
-    if (freq_hz == 0) {
-        sleep_ms(duration_ms);
-        return;
-    }
-    
-    uint32_t period_us = 1000000 / freq_hz;
-    uint32_t half_period = period_us / 2;
-    
-    uint32_t end = millis() + duration_ms;
-    while (millis() < end) {
-        gpio_put(GPIO_BUZZER, 1);
-        sleep_us(half_period);
-        gpio_put(GPIO_BUZZER, 0);
-        sleep_us(half_period);
-    }
-}
-
 // --- Colors ---
 #define TFT_BLACK   0x0000
 #define TFT_WHITE   0xFFFF
@@ -81,69 +75,33 @@ void play_tone(uint32_t freq_hz, uint32_t duration_ms) {
 
 
 // --- UI Context ---
+// LVGL side only: read and written with mtx_LVGL held
 UIContext uiCtx;
 
-// --- WS2812B PIO Program (Pre-compiled) ---
-static const uint16_t ws2812_program_instructions[] = {
-    0x6221, //  0: out    x, 1            side 0 [2] 
-    0x1123, //  1: jmp    !x, 3           side 1 [1] 
-    0x1400, //  2: jmp    0               side 1 [4] 
-    0xa442, //  3: nop                    side 0 [4] 
-};
-
-static const struct pio_program ws2812_program = {
-    .instructions = ws2812_program_instructions,
-    .length = 4,
-    .origin = -1,
-};
-
-void ws2812_program_init(PIO pio, uint sm, uint offset, uint pin, float freq, bool rgbw) {
-    pio_gpio_init(pio, pin);
-    pio_sm_set_consecutive_pindirs(pio, sm, pin, 1, true);
-
-    pio_sm_config c = pio_get_default_sm_config();
-    sm_config_set_sideset_pins(&c, pin);
-    sm_config_set_sideset(&c, 1, false, false); // 1 sideset bit, not optional, not pindirs
-    sm_config_set_out_shift(&c, false, true, rgbw ? 32 : 24);
-    sm_config_set_fifo_join(&c, PIO_FIFO_JOIN_TX);
-    sm_config_set_wrap(&c, offset, offset + 3); // wrap around all 4 instructions
-
-    float div = clock_get_hz(clk_sys) / (freq * 10);
-    sm_config_set_clkdiv(&c, div);
-
-    pio_sm_init(pio, sm, offset, &c);
-    pio_sm_set_enabled(pio, sm, true);
-}
-
-void put_pixel(uint32_t pixel_grb) {
-    // Send to both LEDs (2 LEDs chained)
-    pio_sm_put_blocking(pio0, 0, pixel_grb << 8u);
-    sleep_us(10); // Small delay between pixels
-    pio_sm_put_blocking(pio0, 0, pixel_grb << 8u);
-    sleep_us(100); // Reset delay after last pixel
-}
-
 // --- Global Objects ---
-OvenState ovenState; // Protected by mtx_OvenState
-ReflowProfile currentProfile; // Global Profile Object
-
-SystemConfig sysConfig;
-
-
+// Oven state: control/oven_state.h. currentProfile, sysConfig: control/oven_control.cpp
 
 // --- Mutexes & Queues ---
-SemaphoreHandle_t mtx_SPI0 = NULL;
-SemaphoreHandle_t mtx_I2C = NULL;
-SemaphoreHandle_t mtx_OvenState = NULL;
+// Lock order: mtx_LVGL -> mtx_OvenState -> SPI0 bus claim (profile window
+// reads, profile_timeline.h), mtx_LVGL -> SPI0 bus claim. FatFs calls hold
+// the SD card claim (system/spi_bus.h, the card shares the bus with the
+// display), sysConfig writers hold mtx_LVGL (see load_system_config()).
 SemaphoreHandle_t mtx_LVGL = NULL;
 
-QueueHandle_t q_SensorData = NULL;
 QueueHandle_t q_InputEvents = NULL;
 
 // --- Interrupt Handling ---
 volatile uint32_t last_irq_time = 0;
+static hal_alert_cb_t alert_cb = NULL;
 
 void gpio_callback(uint gpio, uint32_t events) {
+    // MCP9600 alerts first and without debounce: the SSRs go off from here
+    if (gpio == GPIO_T1_ALT1 || gpio == GPIO_T2_ALT1) {
+        uint32_t edge_us = time_us_32();
+        if (alert_cb) alert_cb((gpio == GPIO_T2_ALT1) ? 2 : 1, edge_us);
+        return;
+    }
+
     uint32_t now = to_ms_since_boot(get_absolute_time());
     if (now - last_irq_time < 50) return; // Simple debounce 50ms
     last_irq_time = now;
@@ -160,20 +118,6 @@ void gpio_callback(uint gpio, uint32_t events) {
         // Encoder Logic (Simplified)
         if (gpio_get(GPIO_ROT_CLK)) evt.type = EVT_ENC_CCW;
         else evt.type = EVT_ENC_CW;
-    } else if (gpio == GPIO_T1_ALT1) {
-        // Safety Cutoff immediately (bypass queue for speed?)
-        // Or just set state directly if mutex available.
-        // Queue is safer for context.
-        // Let's rely on vAlertHandlingTask polling software limit too.
-        // But for hard interrupt:
-        // Force state fault?
-        // We can't take Mutex from ISR easily (xSemaphoreTakeFromISR).
-        // Let's just log or set a volatile flag.
-        // Ideally, we DISABLE HEATERS immediately here.
-        gpio_put(GPIO_HEAT1, 0);
-        gpio_put(GPIO_HEAT2, 0);
-        // And send event? No input event for fault?
-        // Let's make vAlertHandlingTask check the pin state too.
     }
     
     if (evt.type != EVT_NONE) {
@@ -184,81 +128,81 @@ void gpio_callback(uint gpio, uint32_t events) {
 }
 
 // --- Task Handles ---
-TaskHandle_t hAlertTask = NULL;
-TaskHandle_t hSensorTask = NULL;
-TaskHandle_t hPIDTask = NULL;
+// hAlertTask, hSensorTask, hPIDTask: see control/oven_control.cpp
 TaskHandle_t hAppLogicTask = NULL;
 TaskHandle_t hTFTDebugTask = NULL;
 
+// --- Core Split (configNUMBER_OF_CORES 2) ---
+#define CORE_CONTROL    (1 << 0) // Alerts, sensors, PID, SSR alarms, logging
+#define CORE_UI         (1 << 1) // LVGL rendering, display flush, input
+
 // --- Task Definitions ---
 
 void vApplicationPassiveIdleHook(void) {
     // Required for SMP
 }
 
+// configCHECK_FOR_STACK_OVERFLOW 2: checked at each context switch. Memory
+// next to the stack is already corrupt, so cut the heaters for good (the
+// other core keeps running its alarms) and stop.
+extern "C" void vApplicationStackOverflowHook(TaskHandle_t xTask, char* pcTaskName) {
+    (void)xTask;
+    ssr_output_kill();
+    panic("Stack overflow in task %s", pcTaskName);
+}
+
 // --- Task Functions (Core 0) ---
 
-// --- SSR Control Logic ---
-void vSSRControlTask(void *pvParameters) {
-    (void)pvParameters;
-    
-    // Low Frequency PWM (e.g. 5Hz -> 200ms period)
-    const int period_ticks = 10; // 10 * 20ms = 200ms window
-    int tick_counter = 0;
-    
+// --- SSR Outputs (oven_hal.h) ---
+uint32_t hal_time_us() {
+    return time_us_32();
+}
+
+void hal_ssr_init() {
     gpio_init(GPIO_HEAT1); gpio_set_dir(GPIO_HEAT1, GPIO_OUT);
     gpio_init(GPIO_HEAT2); gpio_set_dir(GPIO_HEAT2, GPIO_OUT);
-    
-    for (;;) {
-        float p1 = 0, p2 = 0;
-        if (xSemaphoreTake(mtx_OvenState, pdMS_TO_TICKS(10)) == pdTRUE) {
-            p1 = ovenState.power_output_1; // 0-100
-            p2 = ovenState.power_output_2;
-            xSemaphoreGive(mtx_OvenState);
-        }
-        
-        int threshold1 = (int)(p1 / 10.0f); // Map 0-100 to 0-10
-        int threshold2 = (int)(p2 / 10.0f);
-        
-        gpio_put(GPIO_HEAT1, tick_counter < threshold1);
-        gpio_put(GPIO_HEAT2, tick_counter < threshold2);
-        
-        tick_counter++;
-        if (tick_counter >= period_ticks) tick_counter = 0;
-        
-        vTaskDelay(pdMS_TO_TICKS(20)); // 50Hz Loop
+}
+
+void hal_ssr_set(int channel, bool on) {
+    gpio_put((channel == 2) ? GPIO_HEAT2 : GPIO_HEAT1, on);
+}
+
+static hal_ssr_slot_cb_t ssr_slot_cb = NULL;
+
+// Alarm pool callback: a negative return re-arms relative to this alarm's
+// deadline, so slots do not drift with IRQ latency
+static int64_t ssr_alarm_cb(alarm_id_t id, void* user_data) {
+    (void)id;
+    int channel = (int)(intptr_t)user_data;
+    return -(int64_t)ssr_slot_cb(channel);
+}
+
+void hal_ssr_timer_start(int channel, uint32_t first_us, hal_ssr_slot_cb_t cb) {
+    ssr_slot_cb = cb;
+    if (add_alarm_in_us(first_us, ssr_alarm_cb, (void*)(intptr_t)channel, true) < 0) {
+        printf("[SSR] No alarm for SSR%d!\n", channel);
     }
 }
 
-// --- Helper to update Feedback ---
-void update_feedback(OvenStateEnum state) {
-    // LED Colors (GRB format) - BRIGHTER values
-    uint32_t color = 0;
-    switch (state) {
-        case STATE_IDLE:     color = 0x00FF00; break; // Red (GRB: 0, 255, 0)
-        case STATE_RUNNING:  color = 0x80FF00; break; // Orange (GRB: 128, 255, 0)
-        case STATE_COOLDOWN: color = 0x0000FF; break; // Blue (GRB: 0, 0, 255)
-        case STATE_FAULT:    color = 0x00FF00; break; // Red (fault = red)
-        case STATE_INIT:     color = 0xFFFFFF; break; // White
-        default:             color = 0; break;
+// --- MCP9600 Alerts (oven_hal.h) ---
+// Open-drain outputs, pulled up here. The bank IRQ goes above every other
+// one (I2C, SSR alarms, DMA) so nothing delays the cutoff; the M0+ port
+// masks all interrupts in critical sections, so FromISR calls stay safe.
+void hal_alert_irq_start(hal_alert_cb_t cb) {
+    alert_cb = cb;
+    const uint pins[2] = { GPIO_T1_ALT1, GPIO_T2_ALT1 };
+    for (int i = 0; i < 2; i++) {
+        gpio_init(pins[i]);
+        gpio_set_dir(pins[i], GPIO_IN);
+        gpio_pull_up(pins[i]);
     }
-    put_pixel(color);
+    irq_set_priority(IO_IRQ_BANK0, PICO_HIGHEST_IRQ_PRIORITY);
+    gpio_set_irq_enabled_with_callback(GPIO_T1_ALT1, GPIO_IRQ_EDGE_FALL, true, &gpio_callback);
+    gpio_set_irq_enabled(GPIO_T2_ALT1, GPIO_IRQ_EDGE_FALL, true);
 }
 
-// Helper: Read MCP9600 temperature via raw I2C (register 0x00 = hot junction)
-float read_mcp9600_temp(uint8_t addr) {
-    uint8_t reg = 0x00; // Hot junction register
-    uint8_t buf[2];
-    
-    int ret = i2c_write_blocking(I2C_PORT, addr, &reg, 1, true);
-    if (ret < 0) return -999.0f;
-    
-    ret = i2c_read_blocking(I2C_PORT, addr, buf, 2, false);
-    if (ret < 0) return -999.0f;
-    
-    // MCP9600: Upper byte is integer part, lower is fractional (0.0625 per bit)
-    int16_t raw = (buf[0] << 8) | buf[1];
-    return raw * 0.0625f;
+bool hal_alert_asserted(int channel) {
+    return !gpio_get((channel == 2) ? GPIO_T2_ALT1 : GPIO_T1_ALT1);
 }
 
 // ============================================================
@@ -290,7 +234,7 @@ void vInputTask(void *pvParameters) {
                                            // Board defined Input. Usually Pull-up -> 0 is press.
                                            // HW test showed 0=Pressed
              evt.type = EVT_BTN1_PRESS;
-             play_tone(500, 50); // Audio Feedback
+             buzzer_play(BUZZER_CLICK); // Audio Feedback (non-blocking)
              xQueueSend(q_InputEvents, &evt, 0);
         }
         last_btn1 = btn1;
@@ -299,7 +243,7 @@ void vInputTask(void *pvParameters) {
         int btn2 = gpio_get(GPIO_BTN2);
         if (btn2 == 0 && last_btn2 == 1) {
              evt.type = EVT_BTN2_PRESS;
-             play_tone(500, 50);
+             buzzer_play(BUZZER_CLICK);
              xQueueSend(q_InputEvents, &evt, 0);
         }
         last_btn2 = btn2;
@@ -310,7 +254,7 @@ void vInputTask(void *pvParameters) {
         int rot_btn = gpio_get(GPIO_ROT_BTN);
         if (rot_btn == 0 && last_rot_btn == 1) {
              evt.type = EVT_ENC_BTN_PRESS;
-             play_tone(500, 50);
+             buzzer_play(BUZZER_CLICK);
              xQueueSend(q_InputEvents, &evt, 0);
         }
         last_rot_btn = rot_btn;
@@ -350,199 +294,68 @@ void vInputTask(void *pvParameters) {
 void vFeedbackTask(void *pvParameters) {
     (void)pvParameters;
     
-    printf("[Feedback] Task started. PIO already initialized in main().\\n");
+    printf("[Feedback] Task started.\n");
     
-    // PIO already initialized in main() - don't reinitialize!
-    
-    gpio_init(GPIO_BUZZER); gpio_set_dir(GPIO_BUZZER, GPIO_OUT);
-    
-    for (;;) {
-        OvenStateEnum s = STATE_INIT;
-        if (xSemaphoreTake(mtx_OvenState, pdMS_TO_TICKS(50)) == pdTRUE) {
-            s = ovenState.state;
-            if (s == STATE_FAULT) {
-                 // Pulse 500Hz for 100ms
-                 play_tone(100, 100); 
-            } else {
-                 gpio_put(GPIO_BUZZER, 0);
-            }
-            xSemaphoreGive(mtx_OvenState);
-        }
-        
-        update_feedback(s);
-        vTaskDelay(pdMS_TO_TICKS(200));
-    }
-}
-
-void vAlertHandlingTask(void *pvParameters) {
-    (void)pvParameters;
-    TickType_t xLastWakeTime = xTaskGetTickCount();
+    // Buzzer driven by its PWM slice (feedback/buzzer.cpp), only state edges here
+    OvenStateEnum last = STATE_INIT;
     
     for (;;) {
-        // High priority: check alerts, watchdog
-        // In real hardware, we would check GPIO_T1_ALT1, etc.
+        OvenMode mode = oven_state_mode();
+        OvenStateEnum s = mode.state;
+        buzzer_set_volume(sysConfig.buzzer_volume);
         
-        float current_t1 = 0;
-        if (xSemaphoreTake(mtx_OvenState, pdMS_TO_TICKS(10)) == pdTRUE) {
-            current_t1 = ovenState.current_temp_t1;
-            
-            // Software Limit Check
-            if (current_t1 > 260.0f) {
-                ovenState.state = STATE_FAULT;
-                ovenState.fault_active = true;
-                ovenState.power_output_1 = 0;
-                printf("!!! OVERTEMP FAULT !!!\n");
-            }
-            xSemaphoreGive(mtx_OvenState);
-        }
-        
-        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(100)); // 10Hz safety check
-    }
-}
-
-// --- MCP9600 Interface ---
-// --- Legacy Sensor Drivers Removed (Using direct I2C) ---
-// MCP9600 is handled via read_mcp9600_temp()
-// DS18B20 is removed/disabled as per request (AUX not connected)
-
-void vSensorPollerTask(void *pvParameters) {
-    (void)pvParameters;
-    TickType_t xLastWakeTime = xTaskGetTickCount();
-    
-    // Initial Setup
-    // Raw I2C used, no specific setup_sensors() needed.
-    // I2C bus init happens in main().
-    
-    uint32_t log_counter = 0;
-
-    for (;;) {
-        // 1. Read MCP9600 (I2C) - Fast (approx 5-10ms)
-        if (xSemaphoreTake(mtx_I2C, pdMS_TO_TICKS(20)) == pdTRUE) {
-            float t = read_mcp9600_temp(I2C_ADDR_MCP9600_T1);
-            
-            // Check for error (e.g. -999.0f)
-            if (t > -100.0f) {
-                 if (xSemaphoreTake(mtx_OvenState, pdMS_TO_TICKS(5)) == pdTRUE) {
-                    ovenState.current_temp_t1 = t;
+        if (s != last) {
+            if (s == STATE_FAULT) {
+                buzzer_play(BUZZER_FAULT_SIREN);
+            } else if (last == STATE_FAULT) {
+                buzzer_stop();
+            } else if (last == STATE_RUNNING && s == STATE_COOLDOWN) {
+                // currentProfile can be swapped from the other core
+                uint32_t segments = 0;
+                if (xSemaphoreTake(mtx_OvenState, pdMS_TO_TICKS(50)) == pdTRUE) {
+                    segments = currentProfile.segment_count;
                     xSemaphoreGive(mtx_OvenState);
-                 }
-                 if (log_counter++ % 10 == 0) { // Log every 2s
-                     printf("[Sensors] T1: %.2f C\n", t);
-                 }
-            } else {
-                 printf("[Sensors] MCP9600 Read Failed\n");
+                }
+                if (mode.current_segment_index + 1 >= segments) {
+                    buzzer_play(BUZZER_CYCLE_DONE); // Ran to the end (not aborted early)
+                }
             }
-            xSemaphoreGive(mtx_I2C);
+            last = s;
         }
         
-        // Loop at 5Hz (200ms)
-        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(200));
+        // LEDs: frame goes out by DMA and only when it changed (feedback/ws2812.cpp)
+        status_leds_update(s, oven_state_temps().t1, millis());
+        vTaskDelay(pdMS_TO_TICKS(20));
     }
 }
 
-void vPIDLoopTask(void *pvParameters) {
-    (void)pvParameters;
-    TickType_t xLastWakeTime = xTaskGetTickCount();
-    
-    float integral = 0.0f;
-    float last_error = 0.0f;
-    
-    // PID Config (Loaded from system.json)
-    // If config not loaded (defaults in load_system_config should handle this), 
-    // we use safe fallbacks.
-    float kp1 = (sysConfig.pid_ssr1_kp > 0) ? sysConfig.pid_ssr1_kp : 4.0f;
-    float ki1 = (sysConfig.pid_ssr1_ki > 0) ? sysConfig.pid_ssr1_ki : 0.02f;
-    float kd1 = (sysConfig.pid_ssr1_kd > 0) ? sysConfig.pid_ssr1_kd : 50.0f; 
-
-    // SSR2 Params
-    float kp2 = (sysConfig.pid_ssr2_kp > 0) ? sysConfig.pid_ssr2_kp : 4.0f;
-    float ki2 = (sysConfig.pid_ssr2_ki > 0) ? sysConfig.pid_ssr2_ki : 0.02f;
-    float kd2 = (sysConfig.pid_ssr2_kd > 0) ? sysConfig.pid_ssr2_kd : 50.0f;
-    
-    // SSR2 State
-    float integral2 = 0.0f;
-    float last_error2 = 0.0f;
-    
-    for (;;) {
-        float input = 0;
-        float setpoint = 0;
-        OvenStateEnum state = STATE_IDLE;
-        
-        if (xSemaphoreTake(mtx_OvenState, pdMS_TO_TICKS(10)) == pdTRUE) {
-            input = ovenState.current_temp_t1;
-            setpoint = ovenState.target_temp;
-            state = ovenState.state;
-            xSemaphoreGive(mtx_OvenState);
-        }
-        
-        float output1 = 0;
-        float output2 = 0;
-        
-        if (state == STATE_RUNNING || state == STATE_PRE_CHECK || state == STATE_MANUAL) {
-            float error = setpoint - input;
-            
-            // --- PID 1 ---
-            integral += error;
-            if (integral > 2500.0f) integral = 2500.0f;
-            if (integral < -2500.0f) integral = -2500.0f;
-            
-            float derivative = error - last_error;
-            last_error = error;
-            
-            output1 = (kp1 * error) + (ki1 * integral) + (kd1 * derivative);
-            
-            if (output1 > 100.0f) output1 = 100.0f;
-            if (output1 < 0.0f) output1 = 0.0f;
-            
-            // --- PID 2 (If Present) ---
-            if (sysConfig.ssr2_is_present) {
-                 integral2 += error;
-                 if (integral2 > 2500.0f) integral2 = 2500.0f;
-                 if (integral2 < -2500.0f) integral2 = -2500.0f;
-                 
-                 float derivative2 = error - last_error2;
-                 last_error2 = error;
-                 
-                 output2 = (kp2 * error) + (ki2 * integral2) + (kd2 * derivative2);
-                 
-                 if (output2 > 100.0f) output2 = 100.0f;
-                 if (output2 < 0.0f) output2 = 0.0f;
-            }
-
-            // CSV Log: Using simplified log for now or extend it
-            // printf("[PID],%d,SP=%.2f,T=%.2f,OUT1=%.2f,OUT2=%.2f\n", xTaskGetTickCount(), setpoint, input, output1, output2);
-            
-        } else {
-             output1 = 0; integral = 0; last_error = 0;
-             output2 = 0; integral2 = 0; last_error2 = 0;
-        }
-        
-        // Update Output
-        if (xSemaphoreTake(mtx_OvenState, pdMS_TO_TICKS(10)) == pdTRUE) {
-            ovenState.power_output_1 = output1;
-            ovenState.power_output_2 = output2;
-            xSemaphoreGive(mtx_OvenState);
-        }
-        
-        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(200)); // 5Hz Control Loop
-    }
-}
+// Alert, sensor and PID tasks: see control/oven_control.cpp
 
 // --- Duplicate Removed ---
 
 // --- HW Config for FatFs Library ---
 // See hw_config.h
 
+// SD card clock: 125 MHz / 10, the divider the FatFs driver examples use
+// (10 MHz used to give 8.9 MHz)
+#define SD_SPI_HZ (12500 * 1000)
+
 // SPI0 Configuration
 static spi_t spi0_obj = {
     .hw_inst = spi0,
     .miso_gpio = GPIO_SPI_MISO, 
     .mosi_gpio = GPIO_SPI_MOSI, 
     .sck_gpio = GPIO_SPI_SCK,  
-    .baud_rate = 10 * 1000 * 1000, 
+    .baud_rate = SD_SPI_HZ, 
     //.DMA_IRQ_num = DMA_IRQ_0 // Handled by library init?
 };
 
+// Same clock on the shared bus (system/spi_bus.h). Above the display: the
+// profile streams from the card during a run.
+static const SpiDevice sd_spi_dev = {
+    "sd", SD_SPI_HZ, 0, 0, GPIO_SD_CS, SPI_BUS_NO_PIN, 2
+};
+
 // SD Card Configuration
 static sd_card_t sd_card_obj = {
     .pcName = "0:",
@@ -571,78 +384,52 @@ bool sd_mounted = false;
 
 // Load System Config
 void load_system_config() {
-    FIL file;
-    if (f_open(&file, "/config/system.json", FA_READ) == FR_OK) {
-        UINT read_bytes;
-        char *buffer = (char*)malloc(f_size(&file) + 1);
-        if (buffer) {
-            f_read(&file, buffer, f_size(&file), &read_bytes);
-            buffer[read_bytes] = 0;
-            f_close(&file);
-            
-            cJSON *json = cJSON_Parse(buffer);
-            if (json) {
-                // Parse Hardware
-                cJSON *hw = cJSON_GetObjectItem(json, "hardware");
-                if (hw) {
-                    cJSON *item = cJSON_GetObjectItem(hw, "enable_sensor2_check");
-                    if (item) sysConfig.enable_sensor2_check = cJSON_IsTrue(item);
-                    
-                    item = cJSON_GetObjectItem(hw, "screen_orientation");
-                    if (item) sysConfig.screen_orientation = item->valueint;
-
-                    item = cJSON_GetObjectItem(hw, "ssr2_is_present");
-                    if (item) sysConfig.ssr2_is_present = item->valueint;
-                }
-                
-                // Parse PID
-                cJSON *pid = cJSON_GetObjectItem(json, "pid_params");
-                if (pid) {
-                    cJSON *s1 = cJSON_GetObjectItem(pid, "ssr1");
-                    if (s1) {
-                        sysConfig.pid_ssr1_kp = cJSON_GetObjectItem(s1, "kp")->valuedouble;
-                        sysConfig.pid_ssr1_ki = cJSON_GetObjectItem(s1, "ki")->valuedouble;
-                        sysConfig.pid_ssr1_kd = cJSON_GetObjectItem(s1, "kd")->valuedouble;
-                    }
-                    cJSON *s2 = cJSON_GetObjectItem(pid, "ssr2");
-                    if (s2) {
-                        sysConfig.pid_ssr2_kp = cJSON_GetObjectItem(s2, "kp")->valuedouble;
-                        sysConfig.pid_ssr2_ki = cJSON_GetObjectItem(s2, "ki")->valuedouble;
-                        sysConfig.pid_ssr2_kd = cJSON_GetObjectItem(s2, "kd")->valuedouble;
-                    }
-                }
-                
-                // Calibration
-                cJSON *cal = cJSON_GetObjectItem(json, "calibration");
-                if (cal) {
-                    sysConfig.t1_offset = cJSON_GetObjectItem(cal, "t1_offset")->valuedouble;
-                }
-
-                cJSON_Delete(json);
-                printf("Config Loaded!\n");
-            }
-            free(buffer);
-        } else {
-             f_close(&file);
-        }
-    } else {
+    static SdJsonFile src;
+    if (!sd_json_open(&src, "/config/system.json")) {
         printf("Config File Not Found!\n");
+        return;
+    }
+    
+    // Parse aside (keys missing from the file keep their current value),
+    // then swap in under mtx_LVGL like the SETTINGS screen edits. Readers
+    // on core 0 only read single 32-bit fields.
+    static SystemConfig loaded;
+    JsonError err;
+    loaded = sysConfig;
+    bool ok = system_config_parse_stream(sd_json_read, &src, &loaded, &err);
+    sd_json_close(&src);
+    if (!ok) {
+        printf("/config/system.json:%lu:%lu: %s\n", (unsigned long)err.line, (unsigned long)err.column, err.message);
+        return;
+    }
+    if (xSemaphoreTake(mtx_LVGL, pdMS_TO_TICKS(1000)) == pdTRUE) {
+        sysConfig = loaded;
+        xSemaphoreGive(mtx_LVGL);
+        printf("Config Loaded!\n");
     }
 }
 
 void save_system_config() {
-    // Manual JSON serialization since cJSON_Print/Create is missing/stripped
-    char* buffer = (char*)malloc(1024); // Shared buffer
+    // Manual JSON serialization (no JSON library in the build)
+    const int size = 1024;
+    char* buffer = (char*)malloc(size); // Shared buffer
     if (!buffer) return;
 
     // We can just format the string directly.
     // Note: Floats formatting might need care
-    int len = snprintf(buffer, 1024, 
+    int len = snprintf(buffer, size, 
         "{\n"
         "  \"hardware\": {\n"
         "    \"enable_sensor2_check\": %s,\n"
         "    \"screen_orientation\": %d,\n"
-        "    \"ssr2_is_present\": %d\n"
+        "    \"ssr2_is_present\": %d,\n"
+        "    \"buzzer_volume\": %d,\n"
+        "    \"ssr1_window_ms\": %d,\n"
+        "    \"ssr2_window_ms\": %d,\n"
+        "    \"mains_hz\": %d,\n"
+        "    \"tc_type\": \"%c\",\n"
+        "    \"tc_filter\": %d,\n"
+        "    \"adc_bits\": %d\n"
         "  },\n"
         "  \"pid_params\": {\n"
         "    \"ssr1\": {\n"
@@ -654,186 +441,184 @@ void save_system_config() {
         "      \"kp\": %.2f,\n"
         "      \"ki\": %.4f,\n"
         "      \"kd\": %.2f\n"
-        "    }\n"
+        "    },\n"
+        "    \"i_limit_pct\": %.1f,\n"
+        "    \"d_filter_s\": %.2f,\n"
+        "    \"slew_pct_per_s\": %.1f\n"
         "  },\n"
         "  \"calibration\": {\n"
-        "    \"t1_offset\": %.2f\n"
+        "    \"t1_offset\": %.2f,\n"
+        "    \"t2_offset\": %.2f\n"
+        "  },\n"
+        "  \"model\": {\n"
+        "    \"gain_c_per_pct\": %.3f,\n"
+        "    \"tau_s\": %.1f,\n"
+        "    \"dead_time_s\": %.1f\n"
+        "  },\n"
+        "  \"zones\": {\n"
+        "    \"mode\": \"%s\",\n"
+        "    \"ratio\": %.2f,\n"
+        "    \"split_pct\": %.1f,\n"
+        "    \"trim_pct\": %.1f\n"
         "  }\n"
         "}",
         sysConfig.enable_sensor2_check ? "true" : "false",
         sysConfig.screen_orientation,
         sysConfig.ssr2_is_present,
+        sysConfig.buzzer_volume,
+        sysConfig.ssr1_window_ms, sysConfig.ssr2_window_ms, sysConfig.mains_hz,
+        sysConfig.tc_type, sysConfig.tc_filter, sysConfig.adc_bits,
         sysConfig.pid_ssr1_kp, sysConfig.pid_ssr1_ki, sysConfig.pid_ssr1_kd,
         sysConfig.pid_ssr2_kp, sysConfig.pid_ssr2_ki, sysConfig.pid_ssr2_kd,
-        sysConfig.t1_offset
+        sysConfig.pid_i_limit_pct, sysConfig.pid_d_filter_s, sysConfig.pid_slew_pct_s,
+        sysConfig.t1_offset, sysConfig.t2_offset,
+        sysConfig.model_gain, sysConfig.model_tau_s, sysConfig.model_dead_s,
+        zone_mode_name((ZoneMode)sysConfig.zone_mode),
+        sysConfig.zone_ratio, sysConfig.zone_split_pct, sysConfig.zone_trim_pct
     );
 
-    if (len > 0) {
+    if (len <= 0 || len >= size) {
+        // Truncated: a partial file would not parse back
+        printf("Config Not Saved! (%d bytes, buffer %d)\n", len, size);
+    } else if (spi_bus_acquire(SPI_DEV_SD, 500)) {
         FIL file;
         if (f_open(&file, "/config/system.json", FA_WRITE | FA_CREATE_ALWAYS) == FR_OK) {
-            UINT written;
-            f_write(&file, buffer, len, &written);
-            f_close(&file);
-            printf("Config Saved! (%d bytes)\n", written);
+            UINT written = 0;
+            FRESULT fr = f_write(&file, buffer, (UINT)len, &written);
+            FRESULT fc = f_close(&file);
+            if (fr == FR_OK && fc == FR_OK && written == (UINT)len) {
+                printf("Config Saved! (%u bytes)\n", written);
+            } else {
+                printf("Config Write Failed! (%u of %d bytes)\n", written, len);
+            }
         } else {
             printf("Failed to Open Config for Writing!\n");
         }
+        spi_bus_release(SPI_DEV_SD);
     }
     free(buffer);
 }
 
-// Load Profile
-void load_profile(const char* path) {
-    FIL file;
-    if (f_open(&file, path, FA_READ) == FR_OK) {
-        UINT read_bytes;
-        char *buffer = (char*)malloc(f_size(&file) + 1);
-        if (buffer) {
-            f_read(&file, buffer, f_size(&file), &read_bytes);
-            buffer[read_bytes] = 0;
-            f_close(&file);
-            
-            cJSON *json = cJSON_Parse(buffer);
-            if (json) {
-                // Meta
-                cJSON *meta = cJSON_GetObjectItem(json, "meta");
-                if (meta) {
-                    cJSON *nm = cJSON_GetObjectItem(meta, "name");
-                    if (nm && nm->valuestring) {
-                        strncpy(currentProfile.name, nm->valuestring, 31);
-                        currentProfile.name[31] = 0; // Ensure null term
-                        printf("[Profile] Name Parsed: '%s'\n", currentProfile.name);
-                    } else {
-                        printf("[Profile] Name NOT found in JSON\n");
-                        strncpy(currentProfile.name, "Unknown", 31);
-                    }
-                } else {
-                    printf("[Profile] Meta block not found\n");
-                    strncpy(currentProfile.name, "No Meta", 31);
-                }
-                
-                // Segments
-                cJSON *segs = cJSON_GetObjectItem(json, "segments");
-                int count = cJSON_GetArraySize(segs);
-                if (count > MAX_PROFILE_SEGMENTS) count = MAX_PROFILE_SEGMENTS;
-                
-                currentProfile.segment_count = count;
-                float last_temp = 25.0f; // Assumed start
-                
-                for (int i=0; i<count; i++) {
-                    cJSON *s = cJSON_GetArrayItem(segs, i);
-                    cJSON *type = cJSON_GetObjectItem(s, "type");
-                    
-                    if (strcmp(type->valuestring, "ramp") == 0) currentProfile.segments[i].type = SEG_RAMP;
-                    else if (strcmp(type->valuestring, "hold") == 0) currentProfile.segments[i].type = SEG_HOLD;
-                    else currentProfile.segments[i].type = SEG_STEP;
-                    
-                    // Target Temp
-                    if (cJSON_GetObjectItem(s, "end_temp") != NULL) 
-                        currentProfile.segments[i].target_temp = cJSON_GetObjectItem(s, "end_temp")->valuedouble;
-                    else if (cJSON_GetObjectItem(s, "temp") != NULL)
-                        currentProfile.segments[i].target_temp = cJSON_GetObjectItem(s, "temp")->valuedouble;
-                        
-                    // Duration or Slope
-                    if (cJSON_GetObjectItem(s, "duration") != NULL)
-                         currentProfile.segments[i].duration = cJSON_GetObjectItem(s, "duration")->valueint;
-                    else if (cJSON_GetObjectItem(s, "duration_s") != NULL)
-                         currentProfile.segments[i].duration = cJSON_GetObjectItem(s, "duration_s")->valueint;
-                    else if (cJSON_GetObjectItem(s, "slope") != NULL) {
-                        // Calculate Duration from Slope
-                        float slope = cJSON_GetObjectItem(s, "slope")->valuedouble;
-                        currentProfile.segments[i].slope = slope;
-                        if (slope != 0) {
-                            float diff = fabsf(currentProfile.segments[i].target_temp - last_temp);
-                            currentProfile.segments[i].duration = (uint32_t)(diff / fabsf(slope));
-                        } else {
-                            currentProfile.segments[i].duration = 0;
-                        }
-                    }
-                    
-                    last_temp = currentProfile.segments[i].target_temp;
-                }
-                
-                cJSON_Delete(json);
-                printf("Profile Loaded: %s\n", currentProfile.name);
-            }
-            free(buffer);
-        } else {
-            f_close(&file);
+// Last profile loaded from the card, reopened after a card change
+static char loaded_profile_path[64];
+
+// Load Profile (PROFILE screen / USB link, caller holds mtx_LVGL)
+bool load_profile(const char* path) {
+    // The compiled profile streams from the SD card during a run
+    OvenStateEnum state = oven_state_mode().state;
+    if (state == STATE_RUNNING || state == STATE_PRE_CHECK) {
+        printf("[Profile] Run in progress, %s not loaded\n", path);
+        return false;
+    }
+
+    // Compile aside, then swap in under mtx_OvenState so the state
+    // machine never steps a half-loaded profile. With mtx_LVGL also
+    // held, the dashboard (core 1) never draws one either.
+    ReflowProfile loaded;
+    ProfileTimeline timeline;
+    if (!profile_store_load(path, &currentTimeline, &loaded, &timeline)) return false;
+
+    bool loaded_ok = false;
+    if (xSemaphoreTake(mtx_OvenState, pdMS_TO_TICKS(100)) == pdTRUE) {
+        state = oven_state_mode().state;
+        if (state != STATE_RUNNING && state != STATE_PRE_CHECK) {
+            currentProfile = loaded;
+            profile_timeline_replace(&currentTimeline, &timeline);
+            loaded_ok = true;
         }
+        xSemaphoreGive(mtx_OvenState);
+    }
+    if (loaded_ok) {
+        strncpy(loaded_profile_path, path, sizeof(loaded_profile_path) - 1);
+        printf("Profile Loaded: %s\n", currentProfile.name);
     }
+    return loaded_ok;
 }
 
-// --- Hardcoded Profile (SAC305 approx) ---
-// ReflowProfile currentProfile; // Moved to Global Objects
+// --- SD Card ---
+// No card detect switch on the board: a pulled card shows up as a failed
+// refresh, a new one as a new FatFs mount. Not polled during a run, the
+// profile streams from the card then.
+#define SD_POLL_MS 5000
+
+static void sd_card_poll() {
+    if (!sd_mounted) {
+        FRESULT fr = FR_NOT_READY;
+        if (spi_bus_acquire(SPI_DEV_SD, 500)) {
+            fr = f_mount(&sdCardFS, "", 1);
+            spi_bus_release(SPI_DEV_SD);
+        }
+        if (fr != FR_OK) return;
+        printf("SD Card Mounted.\n");
+        sd_mounted = true;
+        load_system_config();
+    }
 
-void init_test_profile() {
-    // Basic Fallback if load fails
-    snprintf(currentProfile.name, 32, "SAC305 Default");
-    currentProfile.segment_count = 5;
-    
-    // 1. Preheat (Ramp to 150C in 90s -> ~1.6C/s)
-    currentProfile.segments[0].type = SEG_RAMP;
-    currentProfile.segments[0].target_temp = 150.0f;
-    currentProfile.segments[0].duration = 90; 
-    currentProfile.segments[0].slope = 1.5f; 
-    snprintf(currentProfile.segments[0].note, 16, "Preheat");
-
-    // ... (Rest of default profile)
-    currentProfile.segments[1].type = SEG_HOLD;
-    currentProfile.segments[1].target_temp = 150.0f;
-    currentProfile.segments[1].duration = 60;
-    snprintf(currentProfile.segments[1].note, 16, "Soak");
-
-    currentProfile.segments[2].type = SEG_RAMP;
-    currentProfile.segments[2].target_temp = 245.0f;
-    currentProfile.segments[2].duration = 60; 
-    snprintf(currentProfile.segments[2].note, 16, "Ramp Up");
-
-    currentProfile.segments[3].type = SEG_HOLD;
-    currentProfile.segments[3].target_temp = 245.0f;
-    currentProfile.segments[3].duration = 20;
-    snprintf(currentProfile.segments[3].note, 16, "Reflow");
-    
-    currentProfile.segments[4].type = SEG_RAMP;
-    currentProfile.segments[4].target_temp = 50.0f;
-    currentProfile.segments[4].duration = 60;
-    snprintf(currentProfile.segments[4].note, 16, "Cooling");
+    // Profile index and the PROFILE screen list in step with the card
+    if (xSemaphoreTake(mtx_LVGL, pdMS_TO_TICKS(1000)) != pdTRUE) return;
+    ProfileStoreScan scan = profile_store_refresh();
+    if (scan == PROFILE_STORE_NO_CARD) {
+        printf("SD Card Removed.\n");
+        sd_mounted = false;
+        profile_store_forget();
+    } else if (scan == PROFILE_STORE_NEW_VOLUME && loaded_profile_path[0]) {
+        // The compiled profile was open on the previous mount: reopen it,
+        // or fall back to the built-in one if this card does not have it
+        if (!load_profile(loaded_profile_path) &&
+            xSemaphoreTake(mtx_OvenState, pdMS_TO_TICKS(100)) == pdTRUE) {
+            init_test_profile();
+            xSemaphoreGive(mtx_OvenState);
+            loaded_profile_path[0] = 0;
+        }
+        ui_refresh_dashboard_chart();
+    }
+    xSemaphoreGive(mtx_LVGL);
+}
+
+// --- Auto-tune ---
+// Gains from a finished relay tune (SETTINGS screen): sysConfig writers
+// hold mtx_LVGL, and the result is taken under mtx_OvenState after it
+// (lock order). Kept pending if the UI holds the lock for now.
+static void save_autotune_result() {
+    if (xSemaphoreTake(mtx_LVGL, pdMS_TO_TICKS(100)) != pdTRUE) return;
+    AutotuneResult result;
+    bool taken = false;
+    if (xSemaphoreTake(mtx_OvenState, pdMS_TO_TICKS(50)) == pdTRUE) {
+        taken = oven_autotune_take_result(&result);
+        xSemaphoreGive(mtx_OvenState);
+    }
+    if (taken) {
+        oven_autotune_apply(&result);
+        save_system_config();
+    }
+    xSemaphoreGive(mtx_LVGL);
 }
 
+// init_test_profile(): see control/oven_control.cpp
+
 void vAppLogicTask(void *pvParameters) {
     (void)pvParameters;
     TickType_t xLastWakeTime = xTaskGetTickCount();
     
-    // Default Init
-    init_test_profile(); 
+    // Default profile: loaded by main() before the scheduler started
     
     // Wait for system stablization
     vTaskDelay(pdMS_TO_TICKS(1000));
     
     // Auto-transition INIT -> IDLE using mutex
     if (xSemaphoreTake(mtx_OvenState, pdMS_TO_TICKS(100)) == pdTRUE) {
-        ovenState.state = STATE_IDLE;
+        OvenMode mode = oven_state_mode();
+        mode.state = STATE_IDLE;
+        oven_state_publish_mode(&mode);
         xSemaphoreGive(mtx_OvenState);
     }
     
     // --- Initial File System Mount ---
-    // Try to mount SD card and load real configs
-    if (f_mount(&sdCardFS, "", 1) == FR_OK) {
-        printf("SD Card Mounted.\n");
-        sd_mounted = true;
-        load_system_config();
-        
-        // Try loading profile
-        ReflowProfile backup = currentProfile; // Save default
-        // Clear current for clean load? 
-        // load_profile("/profiles/sac305.json");
-        // If load fails (name empty?), revert?
-        // simple check:
-        // if (currentProfile.segment_count == 0) currentProfile = backup;
-    } else {
-        printf("SD Mount Failed - Using Defaults\n");
-    }
+    // Mount the SD card, load real configs and index the profiles.
+    // Retried by the loop below if no card is in.
+    sd_card_poll();
+    if (!sd_mounted) printf("SD Mount Failed - Using Defaults\n");
+    uint32_t last_sd_poll = to_ms_since_boot(get_absolute_time());
 
     // Auto-Start (Removed for Manual Button Control)
     bool test_started = false;
@@ -847,52 +632,39 @@ void vAppLogicTask(void *pvParameters) {
         if (xQueueReceive(q_InputEvents, &evt, 0) == pdTRUE) {
             printf("Input Event: %d\n", evt.type);
 
-            if (xSemaphoreTake(mtx_OvenState, pdMS_TO_TICKS(50)) == pdTRUE) {
-                // UI Navigation Logic via UI Manager
+            // UI Navigation Logic via UI Manager
+            // Screens that change the oven mode take mtx_OvenState themselves,
+            // it is never held while waiting for LVGL.
+            if (xSemaphoreTake(mtx_LVGL, pdMS_TO_TICKS(100)) == pdTRUE) {
+                UIScreenEnum prev_screen = uiCtx.current_screen;
+                ui_process_input(evt);
                 
-                // Protect LVGL Calls
-                if (xSemaphoreTake(mtx_LVGL, pdMS_TO_TICKS(100)) == pdTRUE) {
-                    UIScreenEnum prev_screen = uiCtx.current_screen;
-                    ui_process_input(evt);
-                    
-                    // If screen didn't change, check for Contextual Actions
-                    if (uiCtx.current_screen == prev_screen) {
-                       // ... (Contextual actions)
-                    }
-                    xSemaphoreGive(mtx_LVGL); // Release UI Lock
-                    
-                    // Logic that DOES NOT need LVGL mutex but needs OvenState mutex
-                    if (uiCtx.current_screen == UI_SCREEN_DASHBOARD) {
-                        // Dashboard Controls
-                        if (evt.type == EVT_BTN1_PRESS) { // START / STOP
-                            // ... (Logic)
-                            if (ovenState.state == STATE_IDLE || ovenState.state == STATE_COOLDOWN || ovenState.state == STATE_INIT) {
-                                if (currentProfile.segment_count > 0) {
-                                    ovenState.state = STATE_PRE_CHECK;
-                                    ovenState.profile_start_time = millis();
-                                    ovenState.current_segment_index = 0;
-                                    printf("CMD: Start Profile\n");
-                                }
-                            } else if (ovenState.state == STATE_RUNNING || ovenState.state == STATE_PRE_CHECK) {
-                                ovenState.state = STATE_COOLDOWN;
-                                printf("CMD: Stop Profile\n");
-                            } else if (ovenState.state == STATE_FAULT) {
-                                ovenState.state = STATE_IDLE;
-                                ovenState.fault_active = false;
-                                printf("CMD: Ack Fault\n");
-                            }
+                // If screen didn't change, check for Contextual Actions
+                if (uiCtx.current_screen == prev_screen) {
+                   // ... (Contextual actions)
+                }
+                // uiCtx belongs to the UI task: copy it before letting go
+                UIScreenEnum screen = uiCtx.current_screen;
+                xSemaphoreGive(mtx_LVGL); // Release UI Lock
+                
+                // Logic that DOES NOT need LVGL mutex but needs OvenState mutex
+                if (screen == UI_SCREEN_DASHBOARD) {
+                    // Dashboard Controls
+                    if (evt.type == EVT_BTN1_PRESS) { // START / STOP
+                        if (xSemaphoreTake(mtx_OvenState, pdMS_TO_TICKS(50)) == pdTRUE) {
+                            oven_cmd_start_stop();
+                            xSemaphoreGive(mtx_OvenState);
                         }
                     }
-                     else if (uiCtx.current_screen == UI_SCREEN_MANUAL) {
-                        // Manual Mode Logic (Toggle Heater)
-                        if (evt.type == EVT_BTN1_PRESS) {
-                            if (ovenState.state == STATE_IDLE) {
-                                 printf("Manual Toggle\n");
-                            }
-                        }
-                    } 
                 }
-                xSemaphoreGive(mtx_OvenState);
+                 else if (screen == UI_SCREEN_MANUAL) {
+                    // Manual Mode Logic (Toggle Heater)
+                    if (evt.type == EVT_BTN1_PRESS) {
+                        if (oven_state_mode().state == STATE_IDLE) {
+                             printf("Manual Toggle\n");
+                        }
+                    }
+                } 
             }
         }
         
@@ -903,86 +675,23 @@ void vAppLogicTask(void *pvParameters) {
         }
         */
 
-        // State machine logic
+        // SD card: remount, profile index refresh (upload done, card swapped)
+        OvenStateEnum state = oven_state_mode().state;
+        if (state != STATE_RUNNING && state != STATE_PRE_CHECK &&
+            (now - last_sd_poll >= SD_POLL_MS || profile_store_stale())) {
+            last_sd_poll = now;
+            sd_card_poll();
+        }
+
+        // State machine logic, next profile segments read from the SD first
+        oven_profile_prefetch();
         if (xSemaphoreTake(mtx_OvenState, pdMS_TO_TICKS(50)) == pdTRUE) {
-            OvenStateEnum currentState = ovenState.state;
-            
-            switch (currentState) {
-                case STATE_INIT:
-                    break;
-                case STATE_IDLE:
-                    ovenState.power_output_1 = 0;
-                    ovenState.target_temp = 0;
-                    break;
-                case STATE_PRE_CHECK:
-                    // Simple Safety Check before starting
-                    if (ovenState.current_temp_t1 > 0 && ovenState.current_temp_t1 < 300) {
-                         ovenState.state = STATE_RUNNING;
-                         ovenState.profile_start_time = millis(); // Reset start time
-                         printf("Pre-Check OK -> RUNNING\n");
-                    } else {
-                         ovenState.state = STATE_FAULT;
-                         printf("Pre-Check FAILED (T1=%.1f)\n", ovenState.current_temp_t1);
-                    }
-                    break;
-                case STATE_MANUAL:
-                    // Do nothing, let PID run
-                    break;
-                case STATE_RUNNING: {
-                    uint32_t elapsed_total_sec = (millis() - ovenState.profile_start_time) / 1000;
-                    uint32_t seg_accum_time = 0;
-                    int active_seg = -1;
-                    
-                    // Find current segment based on elapsed time
-                    for (int i=0; i < currentProfile.segment_count; i++) {
-                        if (elapsed_total_sec < (seg_accum_time + currentProfile.segments[i].duration)) {
-                            active_seg = i;
-                            // Calculate Target Temp interpolation
-                            uint32_t seg_local_time = elapsed_total_sec - seg_accum_time;
-                            ProfileSegment *s = &currentProfile.segments[i];
-                            
-                            if (s->type == SEG_HOLD) {
-                                ovenState.target_temp = s->target_temp;
-                            } 
-                            else if (s->type == SEG_RAMP) {
-                                // interpolate from previous segment end temp
-                                float start_temp = 25.0f; // Default room temp
-                                if (i > 0) start_temp = currentProfile.segments[i-1].target_temp;
-                                
-                                float progress = (float)seg_local_time / (float)s->duration;
-                                ovenState.target_temp = start_temp + (s->target_temp - start_temp) * progress;
-                            } else {
-                                ovenState.target_temp = s->target_temp; // Step
-                            }
-                            
-                            ovenState.current_segment_index = i;
-                            break;
-                        }
-                        seg_accum_time += currentProfile.segments[i].duration;
-                    }
-                    
-                    if (active_seg == -1) {
-                        // Profile Finished
-                        ovenState.state = STATE_COOLDOWN;
-                    }
-                    break;
-                }
-                case STATE_COOLDOWN:
-                    ovenState.power_output_1 = 0;
-                    ovenState.target_temp = 0;
-                    if (ovenState.current_temp_t1 < 50.0f && ovenState.current_temp_t1 > 0) {
-                        ovenState.state = STATE_IDLE;
-                    }
-                    // Timeout safety?
-                    break;
-                case STATE_FAULT:
-                    ovenState.power_output_1 = 0;
-                    break;
-                default:
-                    break;
-            }
+            oven_logic_step();
             xSemaphoreGive(mtx_OvenState);
         }
+
+        // Finished auto-tune: new gains into sysConfig and system.json
+        if (oven_autotune_result_pending()) save_autotune_result();
         
         vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(100)); // 10Hz logic
     }
@@ -992,7 +701,8 @@ void vAppLogicTask(void *pvParameters) {
 
 // --- UI Task ---
 void vUITask(void *pvParameters) {
-    // Affinity to Core 1 is set in main
+    // Affinity to Core 1 is set in main. disp_bus_init() (from ui_init())
+    // enables the display DMA IRQ on the calling core, so it lands here too.
     printf("[UI] Starting UI Task on Core %d\n", get_core_num());
     
     // UI Init (LVGL + Drivers + Screens)
@@ -1009,21 +719,13 @@ void vUITask(void *pvParameters) {
     }
     
     for (;;) {
-        // Update State from global ovenState
+        // Update State from the published oven state (lock-free)
         OvenState localState;
-        bool state_valid = false;
-        
-        if (xSemaphoreTake(mtx_OvenState, pdMS_TO_TICKS(10)) == pdTRUE) {
-            localState = ovenState;
-            state_valid = true;
-            xSemaphoreGive(mtx_OvenState);
-        }
+        oven_state_read(&localState);
         
         // Take LVGL Mutex for Rendering Cycle
         if (xSemaphoreTake(mtx_LVGL, pdMS_TO_TICKS(50)) == pdTRUE) {
-            if (state_valid) {
-                 ui_update_state(&localState);
-            }
+            ui_update_state(&localState);
             ui_tick(); // Calls lv_tick_inc and lv_timer_handler
             xSemaphoreGive(mtx_LVGL);
         }
@@ -1090,12 +792,12 @@ int main() {
     // --- HW Init ---
     // Initialize I2C
     printf("[I2C] Initializing I2C0 on GPIO %d (SDA) / %d (SCL)...\n", GPIO_I2C_SDA, GPIO_I2C_SCL);
-    i2c_init(I2C_PORT, 100 * 1000); // Lowered to 100kHz for reliability
+    i2c_init(I2C_PORT, 400 * 1000); // Fast mode: MCP9600 supports up to 400 kHz
     gpio_set_function(GPIO_I2C_SDA, GPIO_FUNC_I2C);
     gpio_set_function(GPIO_I2C_SCL, GPIO_FUNC_I2C);
     gpio_pull_up(GPIO_I2C_SDA);
     gpio_pull_up(GPIO_I2C_SCL);
-    printf("[I2C] I2C initialized at 100kHz\n");
+    printf("[I2C] I2C initialized at 400kHz\n");
     
     // === I2C BUS SCAN ===
     printf("\n[I2C] Scanning I2C bus...\n");
@@ -1120,6 +822,9 @@ int main() {
     }
     printf("[I2C] Scan complete\n\n");
     
+    // Sensor transactions are IRQ-driven from here on (control/i2c_bus_rp2040.cpp)
+    i2c_bus_init();
+    
     // === GPIO DEBUG TEST ===
     printf("[GPIO] Initializing buttons and encoder...\n");
     gpio_init(GPIO_BTN1); gpio_set_dir(GPIO_BTN1, GPIO_IN); gpio_pull_up(GPIO_BTN1);
@@ -1135,22 +840,17 @@ int main() {
     printf("[GPIO] Encoder: CLK=%d DT=%d\n", gpio_get(GPIO_ROT_CLK), gpio_get(GPIO_ROT_DT));
     
     // === BUZZER TEST ===
-    printf("\n[BUZZER] Testing buzzer on GPIO %d...\n", GPIO_BUZZER);
-    gpio_init(GPIO_BUZZER);
-    gpio_set_dir(GPIO_BUZZER, GPIO_OUT);
-    // === BUZZER TEST (500Hz confirmed loudest) ===
-    printf("\n[BUZZER] Testing buzzer on GPIO %d (500Hz)...\n", GPIO_BUZZER);
-    gpio_init(GPIO_BUZZER);
-    gpio_set_dir(GPIO_BUZZER, GPIO_OUT);
-    gpio_set_drive_strength(GPIO_BUZZER, GPIO_DRIVE_STRENGTH_12MA);
+    // === BUZZER (500Hz confirmed loudest) ===
+    printf("\n[BUZZER] PWM tone engine on GPIO %d\n", GPIO_BUZZER);
+    buzzer_init();
     
-    // Play "OK" pattern: 3 short beeps
-    play_tone(500, 100); sleep_ms(100);
-    play_tone(500, 100); sleep_ms(100);
-    play_tone(500, 100);
-    printf("[BUZZER] Startup tones complete\n");
+    // "OK" pattern: 3 short beeps, plays once the scheduler runs
+    buzzer_play(BUZZER_BOOT);
     
     // === SD CARD TEST ===
+    // Shared SPI0 (display + card), CS lines high before the card sees a clock
+    spi_bus_init();
+    spi_bus_register(SPI_DEV_SD, &sd_spi_dev);
     test_sd_card();
     
     // === SSR TEST ===
@@ -1163,7 +863,8 @@ int main() {
     gpio_put(GPIO_HEAT2, 0);
     printf("[SSR] SSRs initialized (OFF)\n");
     
-    // LED Test removed (WS2812B handled by vFeedbackTask)
+    // Status LEDs (PIO + DMA), animated by vFeedbackTask
+    ws2812_init(GPIO_WS_LED, WS_LED_COUNT);
 
 
     // SPI Init / LCD Init removed (handled by hagl_init in vUITask)
@@ -1174,18 +875,12 @@ int main() {
     // Interrupts handled by vInputTask (Polling)
     
     // --- FreeRTOS Objects ---
-    mtx_SPI0 = xSemaphoreCreateMutex();
-    mtx_I2C = xSemaphoreCreateMutex();
-    mtx_OvenState = xSemaphoreCreateMutex();
     mtx_LVGL = xSemaphoreCreateMutex();
     
-    q_SensorData = xQueueCreate(5, sizeof(SensorData));
     q_InputEvents = xQueueCreate(10, sizeof(InputEvent));
     
-    // Default State Init
-    ovenState.state = STATE_INIT;
-    ovenState.t2_connected = false;
-    ovenState.fault_active = false;
+    // mtx_OvenState, q_SensorData + default state
+    oven_control_init();
     
     // --- Initial File System Mount ---
     // Note: SD Card shares SPI with TFT. Need proper CS management?
@@ -1211,31 +906,44 @@ int main() {
 
     // gpio_set_irq_enabled(GPIO_ROT_BTN, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, true);
     // gpio_set_irq_enabled(GPIO_ROT_DT, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, true);
-    // gpio_set_irq_enabled(GPIO_T1_ALT1, GPIO_IRQ_EDGE_FALL, true);
+    // MCP9600 alert pins: hal_alert_irq_start(), from oven_control_start_tasks()
     
     // --- Create Tasks ---
+    // Interrupts are enabled on the core that sets them up: the I2C, SSR
+    // alarm, MCP9600 alert, WS2812 and FatFs DMA ones above on core 0
+    // (main), the display DMA one on core 1 (vUITask).
+    
+    // Core 0 Tasks (control)
+    // Sensors, PID, Alerts + SSR alarms and alert IRQs (control/oven_control.cpp)
+    oven_control_start_tasks();
+    vTaskCoreAffinitySet(hAlertTask, CORE_CONTROL);
+    vTaskCoreAffinitySet(hSensorTask, CORE_CONTROL);
+    vTaskCoreAffinitySet(hPIDTask, CORE_CONTROL);
+    
+    // Output Tasks
+    xTaskCreateAffinitySet(vFeedbackTask, "Feedback", 512, NULL, 2, CORE_CONTROL, NULL);
+    
+    // Run logs to /logs on the SD card (storage/run_logger.cpp)
+    vTaskCoreAffinitySet(run_logger_start_task(), CORE_CONTROL);
     
-    // Core 0 Tasks
-    xTaskCreate(vAppLogicTask, "AppLogic", 2048, NULL, 3, &hAppLogicTask);
-    xTaskCreate(vSensorPollerTask, "Sensors", 1024, NULL, 2, NULL); 
     // xTaskCreate(vAuxiliaryTask, "AuxSensors", 1024, NULL, 1, NULL); // DISABLED - DS18B20 not connected
-    xTaskCreate(vPIDLoopTask, "PID", 1024, NULL, 2, &hPIDTask);
-    xTaskCreate(vAlertHandlingTask, "Alerts", 512, NULL, 5, &hAlertTask);
+
+    // Core 1 Tasks (UI)
+    // AppLogic drives ui_process_input() and the profile state machine,
+    // it stays next to the LVGL task it shares mtx_LVGL with
+    xTaskCreateAffinitySet(vAppLogicTask, "AppLogic", 2048, NULL, 3, CORE_UI, &hAppLogicTask);
     
     // Input Task (Polling)
-    xTaskCreate(vInputTask, "Input", 1024, NULL, 3, NULL);
+    xTaskCreateAffinitySet(vInputTask, "Input", 1024, NULL, 3, CORE_UI, NULL);
     
-    // Output Tasks
-    xTaskCreate(vSSRControlTask, "SSR_PWM", 512, NULL, 4, NULL);
-    xTaskCreate(vFeedbackTask, "Feedback", 512, NULL, 2, NULL);
-
-    // Core 1 (UI)
-    // Note: Display is not working yet, but task structure is preserved.
-    xTaskCreate(vUITask, "UI_Manager", 2048, NULL, 2, &hTFTDebugTask);
+    xTaskCreateAffinitySet(vUITask, "UI_Manager", 2048, NULL, 2, CORE_UI, &hTFTDebugTask);
+    
+    // CPU, stack and heap telemetry: SYS INFO screen + USB dump (system/sys_stats.cpp)
+    sys_stats_start_task();
     
-    // Pinning example (if supported):
-    // vTaskCoreAffinitySet(hTFTDebugTask, (1 << 1)); // Pin to Core 1
-    // vTaskCoreAffinitySet(hAlertTask, (1 << 0));    // Pin to Core 0
+    // Binary telemetry and commands over USB (comm/link_service.cpp). Its
+    // commands take mtx_LVGL like the UI, it runs next to it.
+    vTaskCoreAffinitySet(link_service_start_task(link_commands_handle), CORE_UI);
     
     // Initialize TFT before scheduler to ensure hardware is ready ? 
     // Or protect with Mutex. TFT_eSPI init isn't thread safe usually.
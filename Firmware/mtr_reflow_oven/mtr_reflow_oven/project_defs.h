@@ -4,9 +4,6 @@
 #include <stdint.h>
 #include <stdbool.h>
 
-// --- Constants ---
-#define MAX_PROFILE_SEGMENTS 20
-
 // --- Enums ---
 typedef enum {
     STATE_INIT,
@@ -15,7 +12,8 @@ typedef enum {
     STATE_RUNNING,
     STATE_MANUAL,
     STATE_COOLDOWN,
-    STATE_FAULT
+    STATE_FAULT,
+    STATE_AUTOTUNE      // Relay auto-tune of one SSR (control/autotune.h)
 } OvenStateEnum;
 
 typedef enum {
@@ -24,6 +22,12 @@ typedef enum {
     SEG_HOLD
 } SegmentType;
 
+// How the PID loop follows a profile (ReflowProfile.control_mode)
+typedef enum {
+    CONTROL_PID,            // Feedback only
+    CONTROL_FEEDFORWARD     // PID + model power for the setpoint ahead (control/feedforward.h)
+} ControlMode;
+
 typedef enum {
     UI_SCREEN_DASHBOARD,
     UI_SCREEN_MAIN_MENU,
@@ -54,10 +58,14 @@ typedef struct {
     char note[16];
 } ProfileSegment;
 
+// Profile summary. The segments themselves are streamed from the compiled
+// profile on the SD card (control/profile_timeline.h), any number of them.
 typedef struct {
     char name[32];
-    ProfileSegment segments[MAX_PROFILE_SEGMENTS];
-    uint8_t segment_count;
+    char alloy[24];
+    uint32_t segment_count;
+    ControlMode control_mode;   // "control": {"mode": ...}, CONTROL_PID if absent
+    float max_slope;            // "safety": {"max_slope": ...} degC/s, 0 if absent
 } ReflowProfile;
 
 typedef struct {
@@ -69,16 +77,40 @@ typedef struct {
     float power_output_1; // 0-100%
     float power_output_2; // 0-100%
     uint32_t profile_start_time;
-    uint8_t current_segment_index;
+    uint32_t current_segment_index;
     bool t2_connected;
     bool fault_active;
 } OvenState;
 
+// SensorData.flags
+#define SENSOR_T1_VALID     (1u << 0)
+#define SENSOR_T1_OPEN      (1u << 1)
+#define SENSOR_T1_SHORT     (1u << 2)
+#define SENSOR_T1_BUS_ERR   (1u << 3)
+#define SENSOR_T2_VALID     (1u << 4)
+#define SENSOR_T2_OPEN      (1u << 5)
+#define SENSOR_T2_SHORT     (1u << 6)
+#define SENSOR_T2_BUS_ERR   (1u << 7)
+#define SENSOR_T2_PRESENT   (1u << 8)
+#define SENSOR_T1_OUTLIER   (1u << 9)   // Sensor fusion (control/sensor_fusion.h): reading dropped
+#define SENSOR_T2_OUTLIER   (1u << 10)
+#define SENSOR_DISAGREE     (1u << 11)  // T1 and T2 too far apart
+#define SENSOR_ALERTS_SHIFT 12          // T1 alert outputs [15:12], T2 [19:16]
+#define SENSOR_FUSED_VALID  (1u << 20)  // t1 fit for control
+#define SENSOR_T1_FROM_T2   (1u << 21)  // t1 is T2 plus the tracked offset
+#define SENSOR_CROSS_FAULT  (1u << 22)  // Disagreement held too long
+
 typedef struct {
-    float t1;
+    uint32_t timestamp_us; // End of the hot-junction read (i2c_bus_time_us)
+    uint32_t seq;          // +1 per sample, gaps = samples lost
+    uint16_t period_ms;    // Expected interval (MCP9600 conversion time)
+    float t1;            // Hot junctions (degC)
     float t2;
-    float amb;
-    uint32_t flags;
+    float amb;           // Cold junction of T1 (board temperature)
+    float delta1;        // Hot - cold junction
+    float delta2;
+    float confidence;    // In t1, 0-1 (sensor fusion)
+    uint32_t flags;      // SENSOR_*
 } SensorData;
 
 typedef struct {
@@ -106,10 +138,26 @@ typedef struct {
     int screen_orientation;
     int ssr2_is_present; // Added as per request
     int buzzer_volume;
+    int ssr1_window_ms;  // Time-proportioning window (1% resolution per window)
+    int ssr2_window_ms;
+    int mains_hz;        // 0 = free-running slots, 50/60 = whole mains cycles
+    char tc_type;        // Thermocouple type letter (K, J, T, N, S, E, B, R)
+    int tc_filter;       // MCP9600 filter coefficient 0-7
+    int adc_bits;        // MCP9600 ADC resolution 12/14/16/18
     float pid_ssr1_kp, pid_ssr1_ki, pid_ssr1_kd;
     float pid_ssr2_kp, pid_ssr2_ki, pid_ssr2_kd;
+    float pid_i_limit_pct;  // Integral term bound, both SSRs (control/pid.h)
+    float pid_d_filter_s;   // Derivative low-pass
+    float pid_slew_pct_s;   // Output slew limit, %/s, 0 = none
     float t1_offset;
     float t2_offset;
+    float model_gain;    // FOPDT plant model (control/feedforward.h), 0 = none
+    float model_tau_s;
+    float model_dead_s;
+    int zone_mode;       // ZoneMode (control/zone_control.h)
+    float zone_ratio;
+    float zone_split_pct;
+    float zone_trim_pct;
 } SystemConfig;
 
 #endif // PROJECT_DEFS_H
@@ -0,0 +1,75 @@
+// Host test for the hardware over-temperature latch (control/hw_alert.h):
+// the ISR, alert task and acknowledgement steps in the orders they can
+// come in on the target.
+//
+// Checks:
+//   - ARMED -> TRIPPED -> LATCHED -> ARMED, SSRs held off throughout
+//   - acknowledgement refused before the fault is latched and while an
+//     alert output is asserted
+//   - a second trip (other sensor, or after a refused acknowledgement)
+//     is not lost
+//   - cutoff and latch latencies, across the us timer wrap
+//
+// The closed loop (alert pins from the MCP9600 model, ISR, STATE_FAULT)
+// runs in oven_sim --t1-offset.
+//
+// Usage: alert_check
+
+#include "hw_alert.h"
+#include <stdio.h>
+#include "check.h"
+
+static void check_state(const HwAlert* a, HwAlertState want, const char* what) {
+    char line[112];
+    HwAlertState got = hw_alert_state(a);
+    snprintf(line, sizeof(line), "%s: %s, SSRs %s", what, hw_alert_state_name(got),
+             hw_alert_tripped(a) ? "held off" : "free");
+    check(got == want && hw_alert_tripped(a) == (want != HW_ALERT_ARMED), line);
+}
+
+int main() {
+    HwAlert a;
+    hw_alert_reset(&a);
+    check_state(&a, HW_ALERT_ARMED, "reset");
+    check(hw_alert_clear(&a, false) && !hw_alert_pending(&a), "software fault acknowledged with nothing tripped");
+
+    // T1 trips, the alert task has not run yet
+    hw_alert_trip(&a, 1, 1000, 1003);
+    check_state(&a, HW_ALERT_TRIPPED, "T1 alert ISR");
+    check(hw_alert_pending(&a) && a.sources == HW_ALERT_T1 && a.last_cutoff_us == 3, "T1 trip pending, cutoff 3 us");
+    check(!hw_alert_clear(&a, false), "acknowledgement before the latch refused");
+    check_state(&a, HW_ALERT_TRIPPED, "after the refusal");
+
+    // T2 follows before the task runs: one fault, both sources
+    hw_alert_trip(&a, 2, 1200, 1207);
+    check(a.sources == (HW_ALERT_T1 | HW_ALERT_T2) && a.max_cutoff_us == 7, "T2 trip joins it, max cutoff 7 us");
+
+    hw_alert_latch(&a, 1650);
+    check_state(&a, HW_ALERT_LATCHED, "alert task latch");
+    check(!hw_alert_pending(&a) && a.last_latch_us == 450, "latched 450 us after the last edge");
+
+    // Still above limit - hysteresis
+    check(!hw_alert_clear(&a, true), "acknowledgement refused while asserted");
+    check_state(&a, HW_ALERT_LATCHED, "after the refusal");
+
+    // A new edge between a refused acknowledgement and the next one
+    hw_alert_trip(&a, 1, 50000, 50002);
+    check_state(&a, HW_ALERT_TRIPPED, "new edge while latched");
+    check(!hw_alert_clear(&a, false), "acknowledgement refused until it is latched");
+    hw_alert_latch(&a, 50900);
+    check(a.max_latch_us == 900, "max latch 900 us");
+
+    check(hw_alert_clear(&a, false), "acknowledged once released");
+    check_state(&a, HW_ALERT_ARMED, "cleared");
+    check(a.sources == 0 && a.trips == 3 && a.latched == 3 && a.cleared == 3, "3 trips counted, sources cleared");
+
+    // Microsecond timer wrap (every 71 min on the RP2040)
+    hw_alert_trip(&a, 2, 0xFFFFFFF0u, 0x00000010u);
+    hw_alert_latch(&a, 0x00000100u);
+    char line[96];
+    snprintf(line, sizeof(line), "timer wrap: cutoff %lu us, latch %lu us",
+             (unsigned long)a.last_cutoff_us, (unsigned long)a.last_latch_us);
+    check(a.last_cutoff_us == 0x20 && a.last_latch_us == 0x110, line);
+
+    return check_summary();
+}
@@ -0,0 +1,25 @@
+#ifndef SIM_CHECK_H
+#define SIM_CHECK_H
+
+#include <stdio.h>
+
+// Pass/fail lines of the host check programs, one per check, and the
+// summary whose value is the exit status. Included by the program's main
+// file only.
+
+static int checks = 0;
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    checks++;
+    if (!ok) failures++;
+    printf("%s %s\n", ok ? "  ok  " : "  FAIL", what);
+}
+
+// 0 when every check passed
+static int check_summary(void) {
+    printf("\n%d checks, %d failed\n", checks, failures);
+    return failures ? 1 : 0;
+}
+
+#endif // SIM_CHECK_H
@@ -0,0 +1,24 @@
+#ifndef DISP_BUS_MOCK_H
+#define DISP_BUS_MOCK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Host-side stand-in for ui/disp_bus_rp2040.cpp. Pixel transfers are
+// "clocked" on a worker thread at the modelled SPI rate and completion is
+// reported from that thread, the same way the DMA IRQ does on target.
+
+typedef struct {
+    uint32_t transfers;
+    uint64_t bytes;
+    uint64_t bus_busy_us;   // Time the modelled bus spent clocking pixels
+    uint64_t cpu_spin_us;   // Caller clocking bytes itself (CPU burnt on the bus)
+    uint64_t cpu_sleep_us;  // Caller blocked in acquire/wait_idle (CPU free for other tasks on target)
+} DispBusMockStats;
+
+// blocking = true reproduces the old spi_write_blocking() path
+void disp_bus_mock_configure(uint32_t spi_hz, bool blocking);
+void disp_bus_mock_reset_stats(void);
+DispBusMockStats disp_bus_mock_get_stats(void);
+
+#endif // DISP_BUS_MOCK_H
@@ -0,0 +1,129 @@
+// Host benchmark for the ST7796 flush pipeline (ui/ui_display.cpp).
+// Renders a dashboard-like screen through the mock SPI/DMA backend and
+// compares the old blocking single-buffer path with the DMA double-buffer one.
+//
+// Host rendering is far faster than the M0+, so each band also burns
+// render_us of CPU to stand in for the target's software renderer.
+//
+// Usage: flush_bench [frames] [spi_hz] [render_us]
+
+#include "lvgl.h"
+#include "ui_display.h"
+#include "disp_bus.h"
+#include "disp_bus_mock.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+
+using Clock = std::chrono::steady_clock;
+
+static Clock::time_point t_boot;
+
+static uint32_t bench_tick(void) {
+    return (uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - t_boot).count();
+}
+
+static uint32_t render_us = 3000;
+
+static lv_obj_t* chart;
+static lv_chart_series_t* ser_temp;
+static lv_chart_series_t* ser_target;
+static lv_obj_t* lbl_current;
+static lv_obj_t* lbl_target;
+
+// Runs once per rendered band
+static void emulate_render_cost(lv_event_t* e) {
+    (void)e;
+    Clock::time_point until = Clock::now() + std::chrono::microseconds(render_us);
+    while (Clock::now() < until) {}
+}
+
+static void create_scene(void) {
+    lv_obj_t* scr = lv_screen_active();
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x111111), 0);
+    lv_obj_add_event_cb(scr, emulate_render_cost, LV_EVENT_DRAW_MAIN_END, NULL);
+
+    chart = lv_chart_create(scr);
+    lv_obj_set_size(chart, 440, 200);
+    lv_obj_align(chart, LV_ALIGN_CENTER, 0, 20);
+    lv_chart_set_type(chart, LV_CHART_TYPE_LINE);
+    lv_chart_set_range(chart, LV_CHART_AXIS_PRIMARY_Y, 0, 300);
+    lv_chart_set_point_count(chart, 100);
+    lv_chart_set_div_line_count(chart, 5, 7);
+    ser_temp = lv_chart_add_series(chart, lv_color_hex(0xFF4444), LV_CHART_AXIS_PRIMARY_Y);
+    ser_target = lv_chart_add_series(chart, lv_color_hex(0x44FF44), LV_CHART_AXIS_PRIMARY_Y);
+
+    lbl_current = lv_label_create(scr);
+    lv_obj_set_style_text_font(lbl_current, &lv_font_montserrat_20, 0);
+    lv_obj_align(lbl_current, LV_ALIGN_BOTTOM_LEFT, 20, -10);
+
+    lbl_target = lv_label_create(scr);
+    lv_obj_set_style_text_font(lbl_target, &lv_font_montserrat_20, 0);
+    lv_obj_align(lbl_target, LV_ALIGN_BOTTOM_RIGHT, -20, -10);
+}
+
+static void update_scene(int frame) {
+    for (int i = 0; i < 100; i++) {
+        lv_chart_set_value_by_id(chart, ser_target, i, (int32_t)(25 + (i * 220) / 99));
+        lv_chart_set_value_by_id(chart, ser_temp, i, (int32_t)(25 + ((i + frame) % 100) * 2));
+    }
+    lv_label_set_text_fmt(lbl_current, "T: %d.%d C", 100 + frame % 150, frame % 10);
+    lv_label_set_text_fmt(lbl_target, "Set: %d C", 150 + frame % 100);
+    lv_obj_invalidate(lv_screen_active()); // Worst case: full-screen redraw
+}
+
+static void run(const char* name, lv_display_t* disp, int frames) {
+    disp_bus_mock_reset_stats();
+    Clock::time_point t0 = Clock::now();
+    for (int f = 0; f < frames; f++) {
+        update_scene(f);
+        lv_refr_now(disp);
+    }
+    disp_bus_wait_idle();
+    uint64_t total_us = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - t0).count();
+
+    DispBusMockStats s = disp_bus_mock_get_stats();
+    double frame_ms = total_us / 1000.0 / frames;
+    double busy_ms = s.bus_busy_us / 1000.0 / frames;
+    double spin_ms = s.cpu_spin_us / 1000.0 / frames;
+    double sleep_ms = s.cpu_sleep_us / 1000.0 / frames;
+    // Share of bus time during which the CPU was rendering the next band
+    uint64_t idle_cpu_us = s.cpu_spin_us + s.cpu_sleep_us;
+    double overlap = (s.bus_busy_us > idle_cpu_us) ? 100.0 * (s.bus_busy_us - idle_cpu_us) / s.bus_busy_us : 0.0;
+
+    printf("%-20s frame %7.2f ms | bus %6.2f ms | cpu on bus %6.2f ms | task blocked %6.2f ms | overlap %5.1f %% | %u xfers\n",
+           name, frame_ms, busy_ms, spin_ms, sleep_ms, overlap, s.transfers);
+}
+
+int main(int argc, char** argv) {
+    int frames = (argc > 1) ? atoi(argv[1]) : 50;
+    uint32_t spi_hz = (argc > 2) ? (uint32_t)atoi(argv[2]) : 40000000;
+    if (argc > 3) render_us = (uint32_t)atoi(argv[3]);
+    if (frames <= 0) frames = 50;
+
+    t_boot = Clock::now();
+    lv_init();
+    lv_tick_set_cb(bench_tick);
+
+    disp_bus_mock_configure(spi_hz, false);
+    lv_display_t* disp = ui_display_init();
+    create_scene();
+
+    printf("flush_bench: %d frames, %ux%u, %u lines/buffer, SPI %.1f MHz, render %u us/band\n",
+           frames, UI_DISP_HOR_RES, UI_DISP_VER_RES, UI_DISP_BUF_LINES, spi_hz / 1e6, render_us);
+
+    // Baseline: one buffer, CPU-clocked transfer (pre-DMA behaviour)
+    static uint8_t single_buf[UI_DISP_HOR_RES * UI_DISP_BUF_LINES * 2];
+    lv_display_set_buffers(disp, single_buf, NULL, sizeof(single_buf), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    disp_bus_mock_configure(spi_hz, true);
+    run("blocking, 1 buffer", disp, frames);
+
+    // New path: DMA with two buffers (ui_display_init() default)
+    lv_display_delete(disp);
+    disp_bus_mock_configure(spi_hz, false);
+    disp = ui_display_init();
+    create_scene();
+    run("DMA, 2 buffers", disp, frames);
+
+    return 0;
+}
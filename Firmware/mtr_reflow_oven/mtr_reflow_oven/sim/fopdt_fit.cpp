@@ -0,0 +1,131 @@
+// Fits the feed-forward plant model (control/feedforward.h) to a binary
+// run log (/logs/run_NNNN.bin from the SD card, or oven_sim --log) and
+// prints it as the "model" section of system.json.
+//
+// Usage: fopdt_fit run.bin
+//
+// The input is the mean of the two SSR commands (SSR1 alone if SSR2 never
+// switched on): the feed-forward adds the same power to both. Ambient is
+// the first T1 reading, so start the run from a cold oven. For each dead
+// time and time constant on a grid, the unit-gain response to the logged
+// commands is simulated and the gain solved by least squares; the best
+// fit is kept.
+
+#include "feedforward.h"
+#include "run_log.h"
+#include <cmath>
+#include <cstring>
+#include <stdio.h>
+#include <vector>
+
+struct Sample {
+    double t_s;
+    float t1;
+    float u;
+};
+
+static std::vector<Sample> samples;
+
+// Unit-gain response to the logged commands, ambient at 0
+static void unit_response(float tau_s, float dead_s, std::vector<float>* y) {
+    FopdtModel unit = { 1.0f, tau_s, dead_s };
+    y->assign(samples.size(), 0.0f);
+    size_t delayed = 0;
+    for (size_t i = 1; i < samples.size(); i++) {
+        double t_delayed = samples[i - 1].t_s - dead_s;
+        while (delayed + 1 < samples.size() && samples[delayed + 1].t_s <= t_delayed) delayed++;
+        float u = (samples[delayed].t_s <= t_delayed) ? samples[delayed].u : 0.0f;
+        float dt = (float)(samples[i].t_s - samples[i - 1].t_s);
+        (*y)[i] = fopdt_step(&unit, (*y)[i - 1], u, 0.0f, dt);
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: fopdt_fit run.bin\n");
+        return 1;
+    }
+    FILE* f = fopen(argv[1], "rb");
+    if (!f) {
+        fprintf(stderr, "fopdt_fit: cannot open %s\n", argv[1]);
+        return 1;
+    }
+    RunLogHeader header;
+    if (fread(&header, sizeof(header), 1, f) != 1 || memcmp(header.magic, RUN_LOG_MAGIC, sizeof(RUN_LOG_MAGIC)) != 0 ||
+        header.version != RUN_LOG_VERSION || header.record_size != sizeof(RunLogRecord)) {
+        fprintf(stderr, "fopdt_fit: %s is not a run log\n", argv[1]);
+        fclose(f);
+        return 1;
+    }
+
+    // Same end-of-data rule as log2csv
+    std::vector<RunLogRecord> records;
+    RunLogRecord r;
+    bool ssr2 = false;
+    while (fread(&r, sizeof(r), 1, f) == 1) {
+        if (header.record_count) {
+            if (records.size() >= header.record_count) break;
+        } else if (!records.empty() && r.t_ms <= records.back().t_ms) {
+            break;
+        }
+        if (r.out2) ssr2 = true;
+        records.push_back(r);
+    }
+    fclose(f);
+    if (records.size() < 100) {
+        fprintf(stderr, "fopdt_fit: %zu records, too short to fit\n", records.size());
+        return 1;
+    }
+
+    for (const RunLogRecord& rec : records) {
+        Sample s;
+        s.t_s = (rec.t_ms - header.start_ms) / 1000.0;
+        s.t1 = rec.t1 / RUN_LOG_TEMP_SCALE;
+        s.u = ssr2 ? (rec.out1 + rec.out2) / 2.0f : rec.out1;
+        samples.push_back(s);
+    }
+    float ambient = samples[0].t1;
+    printf("fopdt_fit: \"%.32s\", %zu records over %.0f s, ambient %.1f C, input %s\n", header.profile,
+           samples.size(), samples.back().t_s - samples[0].t_s, ambient, ssr2 ? "mean of SSR1/SSR2" : "SSR1");
+
+    // Grid search: dead 0..60 s by 0.5 s, tau 10..600 s by 2 s
+    float best_gain = 0, best_tau = 0, best_dead = 0;
+    double best_sse = INFINITY;
+    std::vector<float> y;
+    for (float dead = 0.0f; dead <= 60.0f; dead += 0.5f) {
+        for (float tau = 10.0f; tau <= 600.0f; tau += 2.0f) {
+            unit_response(tau, dead, &y);
+            double yy = 0, yt = 0;
+            for (size_t i = 0; i < samples.size(); i++) {
+                yy += (double)y[i] * y[i];
+                yt += (double)y[i] * (samples[i].t1 - ambient);
+            }
+            if (yy <= 0) continue;
+            double gain = yt / yy;
+            double sse = 0;
+            for (size_t i = 0; i < samples.size(); i++) {
+                double e = ambient + gain * y[i] - samples[i].t1;
+                sse += e * e;
+            }
+            if (sse < best_sse) {
+                best_sse = sse;
+                best_gain = (float)gain;
+                best_tau = tau;
+                best_dead = dead;
+            }
+        }
+    }
+    if (!(best_gain > 0)) {
+        fprintf(stderr, "fopdt_fit: no heating in the log, nothing to fit\n");
+        return 1;
+    }
+
+    printf("fit: K %.3f C/%%, tau %.0f s, dead time %.1f s, rms residual %.2f C\n",
+           best_gain, best_tau, best_dead, sqrt(best_sse / samples.size()));
+    printf("\n  \"model\": {\n");
+    printf("    \"gain_c_per_pct\": %.3f,\n", best_gain);
+    printf("    \"tau_s\": %.0f,\n", best_tau);
+    printf("    \"dead_time_s\": %.1f\n", best_dead);
+    printf("  }\n");
+    return 0;
+}
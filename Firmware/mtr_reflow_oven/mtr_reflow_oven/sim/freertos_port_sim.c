@@ -0,0 +1,35 @@
+// FreeRTOS POSIX port with a virtual tick for the host simulators.
+//
+// The stock port drives the tick from a thread that sends SIGALRM every
+// portTICK_RATE_MICROSECONDS of wall-clock time. Here that thread is kept
+// (the port expects it) but muted, and time is advanced by the idle task
+// instead (see FreeRTOSConfig.h and vApplicationIdleHook() below): whenever
+// every task is blocked the tick count jumps to the next wake-up. A run is
+// then as fast as the host can execute the tasks, and deterministic.
+
+#define _GNU_SOURCE // pthread_setname_np() in port.c
+#include <signal.h>
+#include <pthread.h>
+#include <unistd.h>
+
+static int sim_tick_thread_kill(pthread_t thread, int sig) {
+    if (sig == SIGALRM) return 0; // Wall-clock tick muted
+    return pthread_kill(thread, sig);
+}
+
+static int sim_tick_thread_sleep(useconds_t us) {
+    (void)us;
+    return usleep(100000); // Only the muted tick thread sleeps through here
+}
+
+#define pthread_kill sim_tick_thread_kill
+#define usleep sim_tick_thread_sleep
+#include "port.c"
+#undef usleep
+#undef pthread_kill
+
+// Single-tick idle periods are below configEXPECTED_IDLE_TIME_BEFORE_SLEEP
+// and never reach portSUPPRESS_TICKS_AND_SLEEP(): step those here.
+void vApplicationIdleHook(void) {
+    xTaskCatchUpTicks(1);
+}
@@ -0,0 +1,210 @@
+// Host test for the sensor fusion stage (control/sensor_fusion.h), on
+// synthetic MCP9600 sample streams (80 ms, 16-bit conversions).
+//
+// Checks:
+//   - calibration offsets applied to T1 and T2
+//   - 2 C/s ramp with 0.1 C reading noise: tracked without lag, less
+//     noise than the readings
+//   - +80 C spike dropped, a real 30 C jump accepted after
+//     FUSION_MAX_REJECTS samples
+//   - T1 lost: T2 plus the tracked offset stands in; without T2 the
+//     filter coasts FUSION_COAST_MS, then the sample is not fit for control
+//   - T1/T2 disagreement flagged (enable_sensor2_check only), and turned
+//     into SENSOR_CROSS_FAULT after FUSION_DISAGREE_FAULT_MS
+//
+// Usage: fusion_check
+
+#include "sensor_fusion.h"
+#include <cmath>
+#include <cstring>
+#include <stdio.h>
+#include <stdlib.h>
+#include "check.h"
+
+static const uint32_t PERIOD_US = 80000;
+static const float PERIOD_S = 0.08f;
+
+// Gaussian reading noise, fixed seed
+static float noise(float sigma) {
+    float u1 = (rand() + 1.0f) / (RAND_MAX + 2.0f);
+    float u2 = (rand() + 1.0f) / (RAND_MAX + 2.0f);
+    return sigma * sqrtf(-2.0f * logf(u1)) * cosf(6.2831853f * u2);
+}
+
+static SensorData sample(uint32_t n, float t1, bool t1_valid, float t2, bool t2_valid) {
+    SensorData d;
+    memset(&d, 0, sizeof(d));
+    d.timestamp_us = 1000000u + n * PERIOD_US;
+    d.seq = n;
+    d.t1 = t1_valid ? t1 : NAN;
+    d.t2 = t2_valid ? t2 : NAN;
+    if (t1_valid) d.flags |= SENSOR_T1_VALID;
+    else d.flags |= SENSOR_T1_BUS_ERR;
+    if (t2_valid) d.flags |= SENSOR_T2_VALID | SENSOR_T2_PRESENT;
+    return d;
+}
+
+static FusionConfig config(bool cross_check) {
+    FusionConfig c;
+    c.t1_offset = 0.0f;
+    c.t2_offset = 0.0f;
+    c.max_slope = 3.0f;
+    c.cross_check = cross_check;
+    return c;
+}
+
+static void test_offsets() {
+    SensorFusion f;
+    sensor_fusion_reset(&f);
+    FusionConfig c = config(false);
+    c.t1_offset = -1.5f;
+    c.t2_offset = 2.0f;
+    SensorData d = {};
+    for (uint32_t n = 0; n < 20; n++) {
+        d = sample(n, 100.0f, true, 100.0f, true);
+        sensor_fusion_step(&f, &c, &d);
+    }
+    char what[96];
+    snprintf(what, sizeof(what), "offsets: T1 100 -> %.2f C, T2 100 -> %.2f C", d.t1, d.t2);
+    check(fabsf(d.t1 - 98.5f) < 0.05f && fabsf(d.t2 - 102.0f) < 0.05f, what);
+}
+
+static void test_ramp() {
+    SensorFusion f;
+    sensor_fusion_reset(&f);
+    FusionConfig c = config(false);
+    srand(1);
+    double sq_raw = 0, sq_fused = 0, lag = 0;
+    uint32_t counted = 0, outliers = 0;
+    for (uint32_t n = 0; n < 1000; n++) {
+        float truth = 50.0f + 2.0f * PERIOD_S * n;
+        float reading = truth + noise(0.1f);
+        SensorData d = sample(n, reading, true, 0, false);
+        sensor_fusion_step(&f, &c, &d);
+        if (d.flags & SENSOR_T1_OUTLIER) outliers++;
+        if (n >= 100) {
+            sq_raw += (double)(reading - truth) * (reading - truth);
+            sq_fused += (double)(d.t1 - truth) * (d.t1 - truth);
+            lag += truth - d.t1;
+            counted++;
+        }
+    }
+    double rms_raw = sqrt(sq_raw / counted), rms_fused = sqrt(sq_fused / counted);
+    char what[128];
+    snprintf(what, sizeof(what), "2 C/s ramp: mean lag %.3f C, rms error %.3f C for %.3f C read, %u dropped",
+             lag / counted, rms_fused, rms_raw, outliers);
+    check(fabs(lag / counted) < 0.05 && rms_fused < rms_raw && outliers == 0, what);
+}
+
+static void test_spike_and_jump() {
+    SensorFusion f;
+    sensor_fusion_reset(&f);
+    FusionConfig c = config(false);
+    SensorData d = {};
+    uint32_t n = 0;
+    for (; n < 50; n++) {
+        d = sample(n, 150.0f, true, 0, false);
+        sensor_fusion_step(&f, &c, &d);
+    }
+    d = sample(n++, 230.0f, true, 0, false);
+    sensor_fusion_step(&f, &c, &d);
+    char what[96];
+    snprintf(what, sizeof(what), "+80 C spike dropped: fused %.2f C, confidence %.1f", d.t1, d.confidence);
+    check((d.flags & SENSOR_T1_OUTLIER) && fabsf(d.t1 - 150.0f) < 0.5f && (d.flags & SENSOR_FUSED_VALID), what);
+
+    d = sample(n++, 150.0f, true, 0, false); // Clears the reject count
+    sensor_fusion_step(&f, &c, &d);
+    uint32_t accepted_after = 0;
+    for (uint32_t k = 1; k <= 10; k++, n++) {
+        d = sample(n, 180.0f, true, 0, false);
+        sensor_fusion_step(&f, &c, &d);
+        if (!(d.flags & SENSOR_T1_OUTLIER)) {
+            accepted_after = k;
+            break;
+        }
+    }
+    snprintf(what, sizeof(what), "real 30 C jump accepted at its sample %u, fused %.2f C", accepted_after, d.t1);
+    check(accepted_after == FUSION_MAX_REJECTS + 1 && fabsf(d.t1 - 180.0f) < 0.1f, what);
+}
+
+static void test_stand_in_and_coast() {
+    SensorFusion f;
+    sensor_fusion_reset(&f);
+    FusionConfig c = config(false);
+    SensorData d = {};
+    uint32_t n = 0;
+    // T2 reads 5 C under T1, both rising 1 C/s
+    for (; n < 500; n++) {
+        float t = 100.0f + 1.0f * PERIOD_S * n;
+        d = sample(n, t, true, t - 5.0f, true);
+        sensor_fusion_step(&f, &c, &d);
+    }
+    float truth = 100.0f + 1.0f * PERIOD_S * n;
+    d = sample(n++, 0, false, truth - 5.0f, true);
+    sensor_fusion_step(&f, &c, &d);
+    char what[112];
+    snprintf(what, sizeof(what), "T1 lost, T2 stands in: %.2f C for %.2f C, confidence %.1f", d.t1, truth, d.confidence);
+    check((d.flags & SENSOR_T1_FROM_T2) && (d.flags & SENSOR_FUSED_VALID) && fabsf(d.t1 - truth) < 0.3f, what);
+
+    // Both lost: coast on the prediction
+    uint32_t valid_for = 0;
+    float first_err = 0;
+    for (uint32_t k = 0; k < 30; k++, n++) {
+        d = sample(n, 0, false, 0, false);
+        sensor_fusion_step(&f, &c, &d);
+        if (!(d.flags & SENSOR_FUSED_VALID)) break;
+        if (k == 0) first_err = d.t1 - (100.0f + 1.0f * PERIOD_S * n);
+        valid_for++;
+    }
+    snprintf(what, sizeof(what), "no sensor: coasts %u ms (error %.2f C at first), then not fit for control",
+             valid_for * (PERIOD_US / 1000), first_err);
+    check(valid_for * (PERIOD_US / 1000) <= FUSION_COAST_MS && valid_for > 0 && fabsf(first_err) < 0.3f &&
+          d.confidence == 0.0f, what);
+
+    // Back: restarts from the reading
+    truth = 100.0f + 1.0f * PERIOD_S * n;
+    d = sample(n++, truth, true, truth - 5.0f, true);
+    sensor_fusion_step(&f, &c, &d);
+    snprintf(what, sizeof(what), "T1 back: %.2f C for %.2f C", d.t1, truth);
+    check(!(d.flags & SENSOR_T1_OUTLIER) && fabsf(d.t1 - truth) < 0.1f, what);
+}
+
+static void test_disagree() {
+    SensorFusion f;
+    SensorData d = {};
+    uint32_t flagged = 0, fault_at = 0;
+    char what[112];
+
+    FusionConfig off = config(false);
+    sensor_fusion_reset(&f);
+    for (uint32_t n = 0; n < 300; n++) {
+        d = sample(n, 200.0f, true, 180.0f, true);
+        sensor_fusion_step(&f, &off, &d);
+        if (d.flags & (SENSOR_DISAGREE | SENSOR_CROSS_FAULT)) flagged++;
+    }
+    snprintf(what, sizeof(what), "20 C T1/T2 gap ignored without enable_sensor2_check (%u flagged)", flagged);
+    check(flagged == 0, what);
+
+    FusionConfig on = config(true);
+    sensor_fusion_reset(&f);
+    flagged = 0;
+    for (uint32_t n = 0; n < 300; n++) {
+        d = sample(n, 200.0f, true, 180.0f, true);
+        sensor_fusion_step(&f, &on, &d);
+        if (d.flags & SENSOR_DISAGREE) flagged++;
+        if ((d.flags & SENSOR_CROSS_FAULT) && !fault_at) fault_at = n * (PERIOD_US / 1000);
+    }
+    snprintf(what, sizeof(what), "with it: %u/300 samples flagged, confidence %.1f, cross fault after %u ms",
+             flagged, d.confidence, fault_at);
+    check(flagged >= 299 && d.confidence == 0.5f && fault_at >= FUSION_DISAGREE_FAULT_MS &&
+          fault_at <= FUSION_DISAGREE_FAULT_MS + 200, what);
+}
+
+int main() {
+    test_offsets();
+    test_ramp();
+    test_spike_and_jump();
+    test_stand_in_and_coast();
+    test_disagree();
+    return check_summary();
+}
@@ -0,0 +1,203 @@
+#include "i2c_bus.h"
+#include "sim_hal.h"
+#include "../board_config.h"
+#include <cmath>
+
+// Host side of control/i2c_bus.h: transactions complete at once against
+// an MCP9600 register model fed by the plant. The model converts
+// continuously at the rate set by its ADC resolution and raises
+// STATUS.TH_UPDATE at the end of each conversion, like the part. Its four
+// alerts are comparators updated at each conversion (interrupt mode is not
+// modelled); alert 1 drives the GPIO_Tn_ALT1 pin (sim_mcp9600_alert_pin).
+
+typedef struct {
+    uint8_t addr;
+    int channel;
+    uint8_t pointer;
+    uint8_t sensor_cfg;
+    uint8_t device_cfg;
+    TickType_t cleared_tick;  // Last write to STATUS
+    uint8_t alert_cfg[4];
+    uint8_t alert_hyst[4];
+    int16_t alert_limit[4];   // Raw, 0.0625 degC/LSB
+    uint8_t alerts;           // Comparator outputs, STATUS [3:0]
+    TickType_t alert_conv;    // Conversion they were last updated at
+} SimMcp9600;
+
+static SimMcp9600 sim_sensors[2] = {
+    { I2C_ADDR_MCP9600_T1, 1, 0, 0, 0, 0, {0}, {0}, {0}, 0, 0 },
+    { I2C_ADDR_MCP9600_T2, 2, 0, 0, 0, 0, {0}, {0}, {0}, 0, 0 },
+};
+
+static uint32_t completed = 0;
+static uint32_t errors = 0;
+
+// Fault injection (sim_i2c_glitches)
+static uint32_t glitch_every = 0;
+static uint32_t t1_th_reads = 0;
+static uint32_t t1_xfers = 0;
+
+void sim_i2c_glitches(uint32_t every_n) {
+    glitch_every = every_n;
+}
+
+static SimMcp9600* sim_sensor(uint8_t addr) {
+    for (int i = 0; i < 2; i++) {
+        if (sim_sensors[i].addr == addr) return &sim_sensors[i];
+    }
+    return NULL; // NACK
+}
+
+static TickType_t conversion_ticks(const SimMcp9600* dev) {
+    static const uint32_t conv_ms[4] = { 320, 80, 20, 5 }; // 18/16/14/12 bits
+    return pdMS_TO_TICKS(conv_ms[(dev->device_cfg >> 5) & 3]);
+}
+
+static bool th_updated(const SimMcp9600* dev) {
+    TickType_t conv = conversion_ticks(dev);
+    return xTaskGetTickCount() / conv > dev->cleared_tick / conv;
+}
+
+static void put_temp(uint8_t* dst, float c) {
+    int16_t raw = (int16_t)lroundf(c / 0.0625f);
+    dst[0] = (uint8_t)((uint16_t)raw >> 8);
+    dst[1] = (uint8_t)raw;
+}
+
+// Comparators against the converted temperatures, once per conversion
+static void alerts_update(SimMcp9600* dev) {
+    TickType_t conv = xTaskGetTickCount() / conversion_ticks(dev);
+    if (conv == dev->alert_conv) return;
+    dev->alert_conv = conv;
+
+    const PlantModel* plant = sim_hal_plant();
+    for (int n = 0; n < 4; n++) {
+        uint8_t cfg = dev->alert_cfg[n];
+        uint8_t bit = (uint8_t)(1u << n);
+        if (!(cfg & 0x01)) {
+            dev->alerts &= (uint8_t)~bit;
+            continue;
+        }
+        float t = (cfg & 0x10) ? plant->params.ambient_c : plant_read_tc(plant, dev->channel);
+        float limit = (dev->alert_limit[n] & ~3) * 0.0625f;
+        float hyst = dev->alert_hyst[n];
+        bool on = (dev->alerts & bit) != 0;
+        if (cfg & 0x08) on = on ? (t > limit - hyst) : (t >= limit);     // Rising
+        else            on = on ? (t < limit + hyst) : (t <= limit);     // Falling
+        if (on) dev->alerts |= bit;
+        else dev->alerts &= (uint8_t)~bit;
+    }
+}
+
+static void model_write(SimMcp9600* dev, const uint8_t* src, size_t len) {
+    dev->pointer = src[0];
+    if (len < 2) return;
+    uint8_t reg = dev->pointer;
+    if (reg == 0x04) dev->cleared_tick = xTaskGetTickCount();
+    if (reg == 0x05) dev->sensor_cfg = src[1];
+    if (reg == 0x06) dev->device_cfg = src[1];
+    if (reg >= 0x08 && reg <= 0x0B) {
+        dev->alert_cfg[reg - 0x08] = src[1] & 0x1F; // Interrupt clear reads back 0
+        dev->alert_conv = (TickType_t)-1;
+    }
+    if (reg >= 0x0C && reg <= 0x0F) dev->alert_hyst[reg - 0x0C] = src[1];
+    if (reg >= 0x10 && reg <= 0x13 && len >= 3) dev->alert_limit[reg - 0x10] = (int16_t)((src[1] << 8) | src[2]);
+}
+
+static void model_read(SimMcp9600* dev, uint8_t* dst, size_t len) {
+    const PlantModel* plant = sim_hal_plant();
+
+    // Register file image from TH on: TH, TD, TC, raw ADC, status
+    uint8_t regs[10];
+    float hot = plant_read_tc(plant, dev->channel);
+    if (glitch_every && dev->channel == 1 && dev->pointer == 0x00 && ++t1_th_reads % glitch_every == 0) {
+        hot += 80.0f;
+    }
+    float cold = plant->params.ambient_c;
+    put_temp(&regs[0], hot);
+    put_temp(&regs[2], hot - cold);
+    put_temp(&regs[4], cold);
+    regs[6] = regs[7] = regs[8] = 0;
+    alerts_update(dev);
+    regs[9] = (uint8_t)((th_updated(dev) ? 0x40 : 0x00) | dev->alerts);
+
+    switch (dev->pointer) {
+        case 0x00: case 0x01: case 0x02: {
+            size_t off = (size_t)dev->pointer * 2;
+            for (size_t i = 0; i < len; i++) dst[i] = (off + i < sizeof(regs)) ? regs[off + i] : 0;
+            break;
+        }
+        case 0x04: dst[0] = regs[9]; break;
+        case 0x05: dst[0] = dev->sensor_cfg; break;
+        case 0x06: dst[0] = dev->device_cfg; break;
+        case 0x08: case 0x09: case 0x0A: case 0x0B: dst[0] = dev->alert_cfg[dev->pointer - 0x08]; break;
+        case 0x0C: case 0x0D: case 0x0E: case 0x0F: dst[0] = dev->alert_hyst[dev->pointer - 0x0C]; break;
+        case 0x10: case 0x11: case 0x12: case 0x13: {
+            uint16_t raw = (uint16_t)dev->alert_limit[dev->pointer - 0x10];
+            dst[0] = (uint8_t)(raw >> 8);
+            if (len > 1) dst[1] = (uint8_t)raw;
+            break;
+        }
+        case 0x20:
+            dst[0] = 0x40; // MCP9600
+            if (len > 1) dst[1] = 0x14;
+            break;
+        default:
+            for (size_t i = 0; i < len; i++) dst[i] = 0;
+            break;
+    }
+}
+
+uint32_t sim_mcp9600_conversion_ms(int channel) {
+    return conversion_ticks(&sim_sensors[(channel == 2) ? 1 : 0]) * portTICK_PERIOD_MS;
+}
+
+bool sim_mcp9600_alert_pin(int channel) {
+    SimMcp9600* dev = &sim_sensors[(channel == 2) ? 1 : 0];
+    alerts_update(dev);
+    bool active_high = (dev->alert_cfg[0] & 0x04) != 0;
+    return (dev->alerts & 0x01) ? active_high : !active_high; // Pulled up when released
+}
+
+void i2c_bus_init(void) {
+}
+
+bool i2c_bus_submit(I2cTransaction* t) {
+    if (t->tx_len + t->rx_len == 0 || t->tx_len + t->rx_len > I2C_BUS_MAX_XFER) return false;
+
+    SimMcp9600* dev = sim_sensor(t->addr);
+    if (dev && glitch_every && dev->channel == 1 && ++t1_xfers % glitch_every == glitch_every / 2) {
+        dev = NULL;
+    }
+    if (!dev) {
+        t->result = I2C_BUS_ERR_NACK;
+        errors++;
+    } else {
+        if (t->tx_len) model_write(dev, t->tx, t->tx_len);
+        if (t->rx_len) model_read(dev, t->rx, t->rx_len);
+        t->result = t->tx_len + t->rx_len;
+        completed++;
+    }
+    t->done_us = i2c_bus_time_us();
+    if (t->notify) xTaskNotifyGive(t->notify);
+    return true;
+}
+
+int i2c_bus_transfer(I2cTransaction* t, uint32_t timeout_ms) {
+    (void)timeout_ms;
+    t->notify = NULL; // Completes synchronously
+    i2c_bus_submit(t);
+    return t->result;
+}
+
+uint32_t i2c_bus_completed(void) {
+    return completed;
+}
+
+uint32_t i2c_bus_errors(void) {
+    return errors;
+}
+
+uint32_t i2c_bus_time_us(void) {
+    return (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS * 1000u);
+}
@@ -0,0 +1,360 @@
+// Host benchmark for the streaming JSON parser (control/json_stream.cpp,
+// control/profile_parser.cpp) against the previous cJSON parser
+// (profile_parser_cjson.cpp) on the shipped documents.
+//
+// For each file: parse time, heap allocations and peak heap (malloc/free
+// are wrapped at link time, see CMakeLists.txt), stack used (painted
+// thread stack), and a field by field comparison of the two results.
+// A few broken documents then show the error reports.
+//
+// Usage: json_bench [iterations] [files...]
+//   defaults: 2000, ../doc/profiles/*.json ../doc/config/system.json
+
+#include "profile_parser.h"
+#include "profile_parser_cjson.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <dirent.h>
+#include <malloc.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+// --- Heap accounting (-Wl,--wrap=malloc,...) ---
+static bool heap_tracking = false;
+static size_t heap_allocs = 0;
+static size_t heap_now = 0;
+static size_t heap_peak = 0;
+
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t n, size_t size);
+void* __real_realloc(void* p, size_t size);
+void __real_free(void* p);
+
+static void heap_add(void* p) {
+    if (!heap_tracking || !p) return;
+    heap_allocs++;
+    heap_now += malloc_usable_size(p);
+    if (heap_now > heap_peak) heap_peak = heap_now;
+}
+
+static void heap_remove(void* p) {
+    if (heap_tracking && p) heap_now -= malloc_usable_size(p);
+}
+
+void* __wrap_malloc(size_t size) {
+    void* p = __real_malloc(size);
+    heap_add(p);
+    return p;
+}
+
+void* __wrap_calloc(size_t n, size_t size) {
+    void* p = __real_calloc(n, size);
+    heap_add(p);
+    return p;
+}
+
+void* __wrap_realloc(void* p, size_t size) {
+    heap_remove(p);
+    void* q = __real_realloc(p, size);
+    heap_add(q);
+    return q;
+}
+
+void __wrap_free(void* p) {
+    heap_remove(p);
+    __real_free(p);
+}
+}
+
+// --- Documents ---
+struct Doc {
+    std::string path;
+    std::string text;
+    bool is_config;
+};
+
+static bool read_file(const std::string& path, std::string* out) {
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) return false;
+    char buf[512];
+    size_t n;
+    out->clear();
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) out->append(buf, n);
+    fclose(f);
+    return true;
+}
+
+static void add_doc(std::vector<Doc>* docs, const std::string& path) {
+    Doc d;
+    d.path = path;
+    d.is_config = path.find("system.json") != std::string::npos;
+    if (read_file(path, &d.text)) docs->push_back(d);
+    else printf("Cannot read %s\n", path.c_str());
+}
+
+static void add_profiles(std::vector<Doc>* docs, const char* dir) {
+    DIR* d = opendir(dir);
+    if (!d) return;
+    std::vector<std::string> names;
+    while (struct dirent* e = readdir(d)) {
+        size_t len = strlen(e->d_name);
+        if (len > 5 && strcmp(e->d_name + len - 5, ".json") == 0) names.push_back(e->d_name);
+    }
+    closedir(d);
+    std::sort(names.begin(), names.end());
+    for (auto& n : names) add_doc(docs, std::string(dir) + "/" + n);
+}
+
+// --- One parse, either parser ---
+struct Parsed {
+    CjsonProfile profile;
+    SystemConfig cfg;
+    bool ok;
+};
+
+// Stream parser segments into the same fixed array as the cJSON parser
+static bool store_segment(void* ctx, uint32_t index, const ProfileSegment* seg) {
+    CjsonProfile* p = (CjsonProfile*)ctx;
+    if (index >= CJSON_MAX_SEGMENTS) return false;
+    p->segments[index] = *seg;
+    p->segment_count = (uint8_t)(index + 1);
+    return true;
+}
+
+static bool stream_profile(const char* text, CjsonProfile* out) {
+    ReflowProfile summary;
+    if (!profile_parse_json(text, &summary, store_segment, out)) return false;
+    memcpy(out->name, summary.name, sizeof(out->name));
+    return true;
+}
+
+static SystemConfig config_defaults(void) {
+    SystemConfig cfg;
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.ssr1_window_ms = 1000;
+    cfg.ssr2_window_ms = 1000;
+    cfg.tc_type = 'K';
+    cfg.adc_bits = 18;
+    return cfg;
+}
+
+static void parse_doc(const Doc& d, bool stream, Parsed* out) {
+    memset(&out->profile, 0, sizeof(out->profile));
+    out->cfg = config_defaults();
+    if (d.is_config) {
+        out->ok = stream ? system_config_parse_json(d.text.c_str(), &out->cfg)
+                         : cjson_system_config_parse_json(d.text.c_str(), &out->cfg);
+    } else {
+        out->ok = stream ? stream_profile(d.text.c_str(), &out->profile)
+                         : cjson_profile_parse_json(d.text.c_str(), &out->profile);
+    }
+}
+
+// --- Stack use: run the parse on a painted thread stack ---
+#define BENCH_STACK_SIZE (256 * 1024)
+#define STACK_PAINT      0xA5
+
+struct StackJob {
+    const Doc* doc;
+    bool stream;
+    Parsed* out;
+};
+
+static void* stack_job(void* arg) {
+    StackJob* job = (StackJob*)arg;
+    if (job->doc) parse_doc(*job->doc, job->stream, job->out);
+    return NULL;
+}
+
+// Bytes of stack touched by the job (doc NULL: thread start-up only)
+static size_t stack_high_mark(const Doc* d, bool stream, Parsed* out) {
+    static uint8_t stack[BENCH_STACK_SIZE] __attribute__((aligned(64)));
+    memset(stack, STACK_PAINT, sizeof(stack));
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstack(&attr, stack, sizeof(stack));
+    StackJob job = { d, stream, out };
+    pthread_t thread;
+    pthread_create(&thread, &attr, stack_job, &job);
+    pthread_join(thread, NULL);
+    pthread_attr_destroy(&attr);
+
+    // Stack grows down: the first modified byte from the bottom is the high mark
+    size_t untouched = 0;
+    while (untouched < sizeof(stack) && stack[untouched] == STACK_PAINT) untouched++;
+    return sizeof(stack) - untouched;
+}
+
+static size_t measure_stack(const Doc& d, bool stream, Parsed* out) {
+    static size_t baseline = stack_high_mark(NULL, false, NULL);
+    return stack_high_mark(&d, stream, out) - baseline;
+}
+
+// --- Result comparison ---
+static bool same_profile(const CjsonProfile& a, const CjsonProfile& b, char* why, size_t size) {
+    if (strcmp(a.name, b.name) != 0) {
+        snprintf(why, size, "name '%s' vs '%s'", a.name, b.name);
+        return false;
+    }
+    if (a.segment_count != b.segment_count) {
+        snprintf(why, size, "%u vs %u segments", a.segment_count, b.segment_count);
+        return false;
+    }
+    for (int i = 0; i < a.segment_count; i++) {
+        const ProfileSegment& x = a.segments[i];
+        const ProfileSegment& y = b.segments[i];
+        if (x.type != y.type || x.target_temp != y.target_temp || x.slope != y.slope ||
+            x.duration != y.duration || strcmp(x.note, y.note) != 0) {
+            snprintf(why, size, "segment %d: %.3f C %.3f C/s %us vs %.3f C %.3f C/s %us",
+                     i, x.target_temp, x.slope, x.duration, y.target_temp, y.slope, y.duration);
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool same_config(const SystemConfig& a, const SystemConfig& b_in, char* why, size_t size) {
+    // The plant model ("model") came after the cJSON parser
+    SystemConfig b = b_in;
+    b.model_gain = a.model_gain;
+    b.model_tau_s = a.model_tau_s;
+    b.model_dead_s = a.model_dead_s;
+    // ...and so did the PID controller settings
+    b.pid_i_limit_pct = a.pid_i_limit_pct;
+    b.pid_d_filter_s = a.pid_d_filter_s;
+    b.pid_slew_pct_s = a.pid_slew_pct_s;
+    // ...and the zone control
+    b.zone_mode = a.zone_mode;
+    b.zone_ratio = a.zone_ratio;
+    b.zone_split_pct = a.zone_split_pct;
+    b.zone_trim_pct = a.zone_trim_pct;
+    if (memcmp(&a, &b, sizeof(a)) != 0) {
+        snprintf(why, size, "kp %g/%g ki %g/%g kd %g/%g", a.pid_ssr1_kp, b.pid_ssr1_kp,
+                 a.pid_ssr1_ki, b.pid_ssr1_ki, a.pid_ssr1_kd, b.pid_ssr1_kd);
+        return false;
+    }
+    return true;
+}
+
+// --- Benchmark ---
+struct Stats {
+    double us_per_parse;
+    size_t allocs;
+    size_t peak_heap;
+    size_t stack;
+};
+
+static Stats bench(const Doc& d, bool stream, int iterations, Parsed* out) {
+    Stats s;
+
+    heap_allocs = heap_now = heap_peak = 0;
+    heap_tracking = true;
+    parse_doc(d, stream, out);
+    heap_tracking = false;
+    s.allocs = heap_allocs;
+    s.peak_heap = heap_peak;
+
+    Parsed scratch;
+    s.stack = measure_stack(d, stream, &scratch);
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) parse_doc(d, stream, &scratch);
+    auto t1 = std::chrono::steady_clock::now();
+    s.us_per_parse = std::chrono::duration<double, std::micro>(t1 - t0).count() / iterations;
+    return s;
+}
+
+static const char* basename_of(const std::string& path) {
+    size_t slash = path.find_last_of('/');
+    return path.c_str() + (slash == std::string::npos ? 0 : slash + 1);
+}
+
+// --- Error reports ---
+static const char* broken_docs[] = {
+    "{\"meta\": {\"name\": \"x\"}, \"segments\": [\n  {\"type\": \"ramp\", \"end_temp\": 150, \"slope\": 1.0},\n  {\"type\": \"soak\", \"duration_s\": 60}\n]}",
+    "{\"segments\": [\n  {\"type\": \"ramp\", \"end_temp\": 150 \"slope\": 1.0}\n]}",
+    "{\"segments\": [\n  {\"type\": \"hold\", \"end_temp\": 150}\n]}",
+    "{\"segments\": [\n  {\"type\": \"ramp\", \"end_temp\": \"150\", \"slope\": 1.0}\n]}",
+    "{\"segments\": [\n  {\"type\": \"step\", \"temp\": 950}\n]}",
+    "{\"meta\": {\"name\": \"truncated\"}, \"segments\": [\n  {\"type\": \"ramp\",",
+    "{\"hardware\": {\n  \"tc_type\": \"X\"\n}}",
+    "{\"pid_params\": {\"ssr1\": {\"kp\": 4.0, \"ki\": -0.5}}}",
+    "{\"hardware\": {\"adc_bits\": 16.5}}",
+};
+
+static void print_errors(void) {
+    printf("\n--- Error reports ---\n");
+    for (size_t i = 0; i < sizeof(broken_docs) / sizeof(broken_docs[0]); i++) {
+        const char* text = broken_docs[i];
+        JsonError err;
+        bool config = strstr(text, "\"segments\"") == NULL;
+        bool ok;
+        if (config) {
+            SystemConfig cfg = config_defaults();
+            ok = system_config_parse_json(text, &cfg, &err);
+        } else {
+            CjsonProfile profile;
+            ReflowProfile summary;
+            ok = profile_parse_json(text, &summary, store_segment, &profile, &err);
+        }
+        if (ok) printf("doc %zu: accepted (unexpected)\n", i + 1);
+        else printf("doc %zu: %lu:%lu: %s\n", i + 1, (unsigned long)err.line, (unsigned long)err.column, err.message);
+    }
+}
+
+int main(int argc, char** argv) {
+    int iterations = 2000;
+    std::vector<Doc> docs;
+    for (int i = 1; i < argc; i++) {
+        if (i == 1 && atoi(argv[i]) > 0) iterations = atoi(argv[i]);
+        else add_doc(&docs, argv[i]);
+    }
+    if (docs.empty()) {
+        add_profiles(&docs, "../doc/profiles");
+        add_doc(&docs, "../doc/config/system.json");
+    }
+    if (docs.empty()) {
+        printf("No documents\n");
+        return 1;
+    }
+
+    printf("json_bench: %zu documents, %d iterations each\n", docs.size(), iterations);
+    printf("stream parser state: JsonStream %zu bytes + %d byte chunk\n\n", sizeof(JsonStream), PROFILE_PARSE_CHUNK);
+    printf("%-18s %6s | %9s %7s %9s %7s | %9s %7s %9s %7s | %s\n", "document", "bytes",
+           "cJSON us", "allocs", "peak B", "stack", "stream us", "allocs", "peak B", "stack", "result");
+
+    int mismatches = 0;
+    double total_old = 0, total_new = 0;
+    for (const Doc& d : docs) {
+        Parsed old_out, new_out;
+        Stats o = bench(d, false, iterations, &old_out);
+        Stats n = bench(d, true, iterations, &new_out);
+        total_old += o.us_per_parse;
+        total_new += n.us_per_parse;
+
+        char why[128] = "";
+        bool same = (old_out.ok == new_out.ok);
+        if (!same) snprintf(why, sizeof(why), "ok %d vs %d", old_out.ok, new_out.ok);
+        else if (d.is_config) same = same_config(old_out.cfg, new_out.cfg, why, sizeof(why));
+        else same = same_profile(old_out.profile, new_out.profile, why, sizeof(why));
+        if (!same) mismatches++;
+
+        printf("%-18s %6zu | %9.2f %7zu %9zu %7zu | %9.2f %7zu %9zu %7zu | %s\n",
+               basename_of(d.path), d.text.size(),
+               o.us_per_parse, o.allocs, o.peak_heap, o.stack,
+               n.us_per_parse, n.allocs, n.peak_heap, n.stack,
+               same ? "same" : why);
+    }
+    printf("\ntotal: cJSON %.2f us, stream %.2f us (x%.2f), %d mismatch(es)\n",
+           total_old, total_new, total_new > 0 ? total_old / total_new : 0.0, mismatches);
+
+    print_errors();
+    return mismatches ? 1 : 0;
+}
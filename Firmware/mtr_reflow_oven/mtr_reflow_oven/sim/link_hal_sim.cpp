@@ -0,0 +1,67 @@
+#include "link_hal.h"
+#include "link_hal_sim.h"
+
+// Both ends are FreeRTOS tasks on the POSIX port, which runs one task at a
+// time: no locking needed.
+
+typedef struct {
+    uint8_t data[LINK_SIM_PIPE_SIZE];
+    uint32_t head;  // Written
+    uint32_t tail;  // Read
+} SimPipe;
+
+static SimPipe to_device;
+static SimPipe to_host;
+static int32_t corrupt_in = -1;
+
+static size_t pipe_read(SimPipe* p, uint8_t* buf, size_t max) {
+    size_t n = 0;
+    while (n < max && p->tail != p->head) {
+        buf[n++] = p->data[p->tail % LINK_SIM_PIPE_SIZE];
+        p->tail++;
+    }
+    return n;
+}
+
+static bool pipe_write(SimPipe* p, const uint8_t* data, size_t len) {
+    if (LINK_SIM_PIPE_SIZE - (p->head - p->tail) < len) return false;
+    for (size_t i = 0; i < len; i++) {
+        p->data[p->head % LINK_SIM_PIPE_SIZE] = data[i];
+        p->head++;
+    }
+    return true;
+}
+
+void link_hal_init(void (*rx_ready)(void)) {
+    (void)rx_ready; // Not an interrupt here: the link task polls
+}
+
+size_t link_hal_read(uint8_t* buf, size_t max) {
+    return pipe_read(&to_device, buf, max);
+}
+
+bool link_hal_write(const uint8_t* data, size_t len) {
+    uint32_t start = to_host.head;
+    if (!pipe_write(&to_host, data, len)) return false;
+    if (corrupt_in >= 0) {
+        if ((uint32_t)corrupt_in < len) {
+            to_host.data[(start + corrupt_in) % LINK_SIM_PIPE_SIZE] ^= 0x01;
+            corrupt_in = -1;
+        } else {
+            corrupt_in -= (int32_t)len;
+        }
+    }
+    return true;
+}
+
+size_t link_sim_host_read(uint8_t* buf, size_t max) {
+    return pipe_read(&to_host, buf, max);
+}
+
+void link_sim_host_write(const uint8_t* data, size_t len) {
+    pipe_write(&to_device, data, len);
+}
+
+void link_sim_corrupt_tx(uint32_t after_bytes) {
+    corrupt_in = (int32_t)after_bytes;
+}
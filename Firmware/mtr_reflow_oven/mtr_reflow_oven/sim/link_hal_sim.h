@@ -0,0 +1,24 @@
+#ifndef LINK_HAL_SIM_H
+#define LINK_HAL_SIM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// Host implementation of comm/link_hal.h: an in-memory loopback standing in
+// for the USB CDC port. The "host" end below is driven by a FreeRTOS task
+// of the harness (sim/link_loopback.cpp), so both ends run in virtual time.
+// Each direction is a LINK_SIM_PIPE_SIZE byte pipe; a device write that
+// does not fit is refused like output to a closed port.
+
+#define LINK_SIM_PIPE_SIZE  4096
+
+// --- Host end ---
+size_t link_sim_host_read(uint8_t* buf, size_t max);
+void link_sim_host_write(const uint8_t* data, size_t len);
+
+// Fault injection: flip bit 0 of the device -> host byte that is
+// after_bytes from the next one written
+void link_sim_corrupt_tx(uint32_t after_bytes);
+
+#endif // LINK_HAL_SIM_H
@@ -0,0 +1,68 @@
+#include "link_host.h"
+#include <cstring>
+
+void link_host_init(LinkHost* host) {
+    memset(host, 0, sizeof(*host));
+    link_decoder_init(&host->dec);
+}
+
+size_t link_host_command(LinkHost* host, uint8_t cmd, const void* body, size_t len, uint8_t* wire, uint8_t* seq) {
+    uint8_t s = host->tx_seq;
+    size_t n = link_frame_encode(wire, cmd, s, body, len);
+    if (!n) return 0;
+    host->tx_seq++;
+    if (seq) *seq = s;
+    return n;
+}
+
+void link_host_feed(LinkHost* host, const uint8_t* data, size_t len, link_host_frame_cb on_frame, void* ctx) {
+    for (size_t i = 0; i < len; i++) {
+        LinkFrame frame;
+        if (!link_decoder_push(&host->dec, data[i], &frame)) continue;
+        if (host->have_rx_seq) host->rx_seq_gaps += (uint8_t)(frame.seq - host->rx_seq - 1);
+        host->have_rx_seq = true;
+        host->rx_seq = frame.seq;
+        if (on_frame) on_frame(&frame, ctx);
+    }
+}
+
+template <typename T>
+static bool body_as(const LinkFrame* frame, uint8_t type, T* out) {
+    if (frame->type != type || frame->len < sizeof(T)) return false;
+    memcpy(out, frame->body, sizeof(T));
+    return true;
+}
+
+bool link_host_telemetry(const LinkFrame* frame, RunLogRecord* out) {
+    return body_as(frame, LINK_MSG_TELEMETRY, out);
+}
+
+bool link_host_ack(const LinkFrame* frame, LinkAck* out) {
+    return body_as(frame, LINK_MSG_ACK, out);
+}
+
+bool link_host_pong(const LinkFrame* frame, LinkPong* out) {
+    return body_as(frame, LINK_MSG_PONG, out);
+}
+
+const char* link_host_status_name(uint8_t status) {
+    static const char* names[] = { "OK", "UNKNOWN", "LENGTH", "STATE", "RANGE", "BUSY", "IO" };
+    return (status < sizeof(names) / sizeof(names[0])) ? names[status] : "?";
+}
+
+static const char* state_name(uint8_t s) {
+    static const char* names[] = { "INIT", "IDLE", "PRE_CHECK", "RUNNING", "MANUAL", "COOLDOWN", "FAULT", "AUTOTUNE" };
+    return (s < sizeof(names) / sizeof(names[0])) ? names[s] : "?";
+}
+
+void link_host_print_csv_header(FILE* out) {
+    fprintf(out, "t_s,t1,t2,setpoint,out1,out2,state,segment,t2_valid,fault\n");
+}
+
+void link_host_print_csv(FILE* out, const RunLogRecord* r) {
+    fprintf(out, "%.3f,%.4f,%.4f,%.4f,%u,%u,%s,%u,%d,%d\n",
+            r->t_ms / 1000.0,
+            r->t1 / RUN_LOG_TEMP_SCALE, r->t2 / RUN_LOG_TEMP_SCALE, r->setpoint / RUN_LOG_TEMP_SCALE,
+            r->out1, r->out2, state_name(r->state), r->segment,
+            (r->flags & RUN_LOG_FLAG_T2) ? 1 : 0, (r->flags & RUN_LOG_FLAG_FAULT) ? 1 : 0);
+}
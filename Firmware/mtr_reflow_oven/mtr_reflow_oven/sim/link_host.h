@@ -0,0 +1,46 @@
+#ifndef LINK_HOST_H
+#define LINK_HOST_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include "link_frame.h"
+#include "link_proto.h"
+#include "run_log.h"
+
+// Host side of the USB link (comm/link_service.h): command encoding,
+// stream decoding and typed access to the device messages. Plain C++, no
+// FreeRTOS: used by the loopback harness (link_loopback) and by link_dump
+// on a real /dev/ttyACM port.
+
+typedef struct {
+    LinkDecoder dec;
+    uint8_t tx_seq;
+    bool have_rx_seq;
+    uint8_t rx_seq;
+    uint32_t rx_seq_gaps;       // Device frames lost (sum of seq gaps)
+} LinkHost;
+
+typedef void (*link_host_frame_cb)(const LinkFrame* frame, void* ctx);
+
+void link_host_init(LinkHost* host);
+
+// Command frame into wire (LINK_WIRE_MAX bytes). Returns the wire length
+// (0 if the body is too long) and the seq the ACK will carry in *seq.
+size_t link_host_command(LinkHost* host, uint8_t cmd, const void* body, size_t len, uint8_t* wire, uint8_t* seq);
+
+// Received bytes: on_frame for each valid frame, in order
+void link_host_feed(LinkHost* host, const uint8_t* data, size_t len, link_host_frame_cb on_frame, void* ctx);
+
+// --- Typed bodies (false if the frame is another type or too short) ---
+bool link_host_telemetry(const LinkFrame* frame, RunLogRecord* out);
+bool link_host_ack(const LinkFrame* frame, LinkAck* out);
+bool link_host_pong(const LinkFrame* frame, LinkPong* out);
+
+const char* link_host_status_name(uint8_t status);
+
+// Telemetry as CSV, same columns as log2csv (t_s from the device clock)
+void link_host_print_csv_header(FILE* out);
+void link_host_print_csv(FILE* out, const RunLogRecord* r);
+
+#endif // LINK_HOST_H
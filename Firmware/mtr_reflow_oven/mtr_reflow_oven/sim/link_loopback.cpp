@@ -0,0 +1,474 @@
+// Loopback test of the USB link: the firmware's link service
+// (comm/link_service.cpp) on the FreeRTOS POSIX port, talking through the
+// in-memory transport (link_hal_sim.cpp) to the host library
+// (link_host.cpp), in virtual time.
+//
+// Covers every command, telemetry streaming and decimation, corrupted
+// frames in both directions, printf text on the port, a host that stops
+// reading and a burst larger than the TX pool. The command handler is a
+// stand-in for comm/link_commands.cpp (no oven, no SD card) that applies
+// the same argument checks.
+//
+// Usage: link_loopback [profile.json]
+//   default doc/profiles/sac305.json of the source tree (uploaded, then compared)
+// Exit status 0 when every check passes.
+
+#include "link_service.h"
+#include "link_hal_sim.h"
+#include "link_host.h"
+#include "oven_hal.h"
+#include <cmath>
+#include <cstring>
+#include <stdio.h>
+#include <stdlib.h>
+#include <strings.h>
+#include "check.h"
+
+static const char* profile_path = SIM_DOC_DIR "/profiles/sac305.json";
+
+uint32_t millis() {
+    return (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+}
+
+// --- Device Side ---
+
+// What the stand-in handler saw
+struct SimDevice {
+    uint32_t start_stop;
+    char profile[64];
+    float setpoint;
+    LinkPidCmd pid[2];
+    uint8_t upload[LINK_UPLOAD_MAX_SIZE];
+    uint32_t upload_size;
+    uint32_t upload_received;
+    bool upload_open;
+    bool upload_done;
+};
+static SimDevice device;
+
+static bool upload_name_ok(const char* name) {
+    size_t len = strlen(name);
+    if (len <= 5 || name[0] == '.' || strcasecmp(name + len - 5, ".json") != 0) return false;
+    return strspn(name, "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789._-") == len;
+}
+
+static bool pid_gain_ok(float gain) {
+    return std::isfinite(gain) && gain >= 0.0f && gain <= 1000.0f;
+}
+
+static uint8_t sim_handler(const LinkFrame* f) {
+    switch (f->type) {
+        case LINK_CMD_START_STOP:
+            device.start_stop++;
+            return LINK_OK;
+        case LINK_CMD_LOAD_PROFILE:
+            if (f->len == 0 || f->len >= sizeof(device.profile)) return LINK_ERR_LENGTH;
+            memcpy(device.profile, f->body, f->len);
+            device.profile[f->len] = 0;
+            return LINK_OK;
+        case LINK_CMD_SET_SETPOINT: {
+            LinkSetpointCmd cmd;
+            if (f->len != sizeof(cmd)) return LINK_ERR_LENGTH;
+            memcpy(&cmd, f->body, sizeof(cmd));
+            if (!std::isfinite(cmd.target_c) || cmd.target_c < 0.0f || cmd.target_c > 260.0f) return LINK_ERR_RANGE;
+            device.setpoint = cmd.target_c;
+            return LINK_OK;
+        }
+        case LINK_CMD_SET_PID: {
+            LinkPidCmd cmd;
+            if (f->len != sizeof(cmd)) return LINK_ERR_LENGTH;
+            memcpy(&cmd, f->body, sizeof(cmd));
+            if (cmd.channel != 1 && cmd.channel != 2) return LINK_ERR_RANGE;
+            if (!pid_gain_ok(cmd.kp) || !pid_gain_ok(cmd.ki) || !pid_gain_ok(cmd.kd)) return LINK_ERR_RANGE;
+            device.pid[cmd.channel - 1] = cmd;
+            return LINK_OK;
+        }
+        case LINK_CMD_UPLOAD_BEGIN: {
+            LinkUploadBegin cmd;
+            if (f->len != sizeof(cmd)) return LINK_ERR_LENGTH;
+            memcpy(&cmd, f->body, sizeof(cmd));
+            cmd.name[sizeof(cmd.name) - 1] = 0;
+            if (!upload_name_ok(cmd.name)) return LINK_ERR_RANGE;
+            if (cmd.size == 0 || cmd.size > LINK_UPLOAD_MAX_SIZE) return LINK_ERR_RANGE;
+            device.upload_open = true;
+            device.upload_done = false;
+            device.upload_size = cmd.size;
+            device.upload_received = 0;
+            return LINK_OK;
+        }
+        case LINK_CMD_UPLOAD_DATA: {
+            LinkUploadData hdr;
+            if (!device.upload_open) return LINK_ERR_STATE;
+            if (f->len <= sizeof(hdr)) return LINK_ERR_LENGTH;
+            memcpy(&hdr, f->body, sizeof(hdr));
+            uint32_t len = f->len - sizeof(hdr);
+            if (hdr.offset != device.upload_received) return LINK_ERR_STATE;
+            if (device.upload_received + len > device.upload_size) return LINK_ERR_RANGE;
+            memcpy(device.upload + device.upload_received, f->body + sizeof(hdr), len);
+            device.upload_received += len;
+            return LINK_OK;
+        }
+        case LINK_CMD_UPLOAD_END:
+            if (!device.upload_open) return LINK_ERR_STATE;
+            if (device.upload_received != device.upload_size) return LINK_ERR_LENGTH;
+            device.upload_open = false;
+            device.upload_done = true;
+            return LINK_OK;
+        default:
+            return LINK_ERR_UNKNOWN;
+    }
+}
+
+// Stands in for vPIDLoopTask: one sample every 80 ms (12.5 Hz). t1 counts
+// samples in 1/16 degC steps so the host can check for gaps.
+static volatile uint32_t produced = 0;
+static volatile uint32_t burst_request = 0;
+static uint32_t producer_max_late_ms = 0;
+
+static void vProducerTask(void *pvParameters) {
+    (void)pvParameters;
+    TickType_t xLastWakeTime = xTaskGetTickCount();
+    for (;;) {
+        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(80));
+        uint32_t late = (uint32_t)(xTaskGetTickCount() - xLastWakeTime);
+        if (late > producer_max_late_ms) producer_max_late_ms = late;
+
+        // Several messages without yielding (link task has a lower priority)
+        uint32_t count = burst_request ? burst_request : 1;
+        burst_request = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t n = produced++;
+            OvenTemps temps = {};
+            temps.t1 = (n % 30000) / RUN_LOG_TEMP_SCALE;
+            temps.t2 = NAN;
+            temps.amb = 25.0f;
+            OvenMode mode = {};
+            mode.state = STATE_RUNNING;
+            mode.target_temp = 150.0f;
+            mode.current_segment_index = (uint8_t)n;
+            OvenOutputs out = { 50.0f, 0.0f };
+            link_send_telemetry(millis(), &temps, &mode, &out, 0);
+        }
+    }
+}
+
+// --- Host Side ---
+
+static LinkHost host;
+static bool host_reading = true;
+
+struct HostRx {
+    uint32_t telemetry;
+    uint32_t telemetry_gaps;    // Missing samples between consecutive records
+    bool have_t1;
+    int16_t last_t1;
+    uint32_t pongs;
+    LinkPong pong;
+    LinkAck acks[16];
+    uint32_t ack_count;
+};
+static HostRx rx;
+
+static void on_frame(const LinkFrame* f, void* ctx) {
+    (void)ctx;
+    RunLogRecord r;
+    LinkAck ack;
+    if (link_host_telemetry(f, &r)) {
+        if (rx.have_t1 && r.t1 != (int16_t)(rx.last_t1 + 1)) rx.telemetry_gaps++;
+        rx.have_t1 = true;
+        rx.last_t1 = r.t1;
+        rx.telemetry++;
+    } else if (link_host_ack(f, &ack)) {
+        if (rx.ack_count < 16) rx.acks[rx.ack_count++] = ack;
+    } else if (link_host_pong(f, &rx.pong)) {
+        rx.pongs++;
+    }
+}
+
+static void pump() {
+    if (!host_reading) return;
+    uint8_t buf[256];
+    size_t n;
+    while ((n = link_sim_host_read(buf, sizeof(buf))) > 0) link_host_feed(&host, buf, n, on_frame, NULL);
+}
+
+static void run_for(uint32_t ms) {
+    TickType_t end = xTaskGetTickCount() + pdMS_TO_TICKS(ms);
+    while (xTaskGetTickCount() < end) {
+        pump();
+        vTaskDelay(1);
+    }
+    pump();
+}
+
+static uint32_t ack_max_ms = 0;
+
+// Send a command, wait for its ACK. Returns the status, -1 on timeout.
+static int command(uint8_t cmd, const void* body, size_t len, uint32_t timeout_ms = 200) {
+    uint8_t wire[LINK_WIRE_MAX];
+    uint8_t seq;
+    size_t n = link_host_command(&host, cmd, body, len, wire, &seq);
+    rx.ack_count = 0;
+    TickType_t sent = xTaskGetTickCount();
+    link_sim_host_write(wire, n);
+
+    while (xTaskGetTickCount() - sent < pdMS_TO_TICKS(timeout_ms)) {
+        vTaskDelay(1);
+        pump();
+        for (uint32_t i = 0; i < rx.ack_count; i++) {
+            if (rx.acks[i].cmd == cmd && rx.acks[i].seq == seq) {
+                uint32_t ms = (uint32_t)(xTaskGetTickCount() - sent);
+                if (ms > ack_max_ms) ack_max_ms = ms;
+                return rx.acks[i].status;
+            }
+        }
+    }
+    return -1;
+}
+
+static void check_status(int status, int expected, const char* what) {
+    char line[128];
+    snprintf(line, sizeof(line), "%s -> %s", what, status < 0 ? "timeout" : link_host_status_name((uint8_t)status));
+    check(status == expected, line);
+}
+
+static void stream(uint8_t enable, uint8_t decimate) {
+    LinkStreamCmd cmd = { enable, decimate };
+    check_status(command(LINK_CMD_STREAM, &cmd, sizeof(cmd)), LINK_OK, enable ? "STREAM on" : "STREAM off");
+    run_for(100); // Samples already queued
+    rx.telemetry = 0;
+    rx.telemetry_gaps = 0;
+    rx.have_t1 = false;
+}
+
+static char* read_file(const char* path, long* len) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    *len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char* buffer = (char*)malloc(*len + 1);
+    if (buffer) *len = (long)fread(buffer, 1, *len, f);
+    fclose(f);
+    return buffer;
+}
+
+static void test_ping() {
+    printf("PING\n");
+    uint8_t wire[LINK_WIRE_MAX];
+    size_t n = link_host_command(&host, LINK_CMD_PING, NULL, 0, wire, NULL);
+    link_sim_host_write(wire, n);
+    run_for(50);
+    check(rx.pongs == 1 && rx.pong.version == LINK_PROTO_VERSION && rx.pong.max_body == LINK_MAX_BODY,
+          "PONG with protocol version and max body");
+}
+
+static void test_telemetry() {
+    printf("Telemetry\n");
+    stream(1, 1);
+    run_for(4000);
+    char line[96];
+    snprintf(line, sizeof(line), "12.5 Hz for 4 s -> %u samples, %u gaps", (unsigned)rx.telemetry, (unsigned)rx.telemetry_gaps);
+    check(rx.telemetry >= 49 && rx.telemetry <= 51 && rx.telemetry_gaps == 0, line);
+
+    stream(1, 5);
+    run_for(4000);
+    snprintf(line, sizeof(line), "decimate 5 for 4 s -> %u samples", (unsigned)rx.telemetry);
+    check(rx.telemetry >= 9 && rx.telemetry <= 11, line);
+
+    stream(0, 0);
+    run_for(1000);
+    check(rx.telemetry == 0, "STREAM off -> no samples");
+}
+
+static void test_commands() {
+    printf("Commands\n");
+    check_status(command(LINK_CMD_START_STOP, NULL, 0), LINK_OK, "START_STOP");
+    check(device.start_stop == 1, "START_STOP reached the handler once");
+
+    const char* path = "/profiles/sac305.json";
+    check_status(command(LINK_CMD_LOAD_PROFILE, path, strlen(path)), LINK_OK, "LOAD_PROFILE");
+    check(strcmp(device.profile, path) == 0, "LOAD_PROFILE path intact");
+
+    LinkSetpointCmd sp = { 150.0f };
+    check_status(command(LINK_CMD_SET_SETPOINT, &sp, sizeof(sp)), LINK_OK, "SET_SETPOINT 150");
+    check(device.setpoint == 150.0f, "setpoint applied");
+    sp.target_c = 300.0f;
+    check_status(command(LINK_CMD_SET_SETPOINT, &sp, sizeof(sp)), LINK_ERR_RANGE, "SET_SETPOINT 300");
+    check_status(command(LINK_CMD_SET_SETPOINT, &sp, 2), LINK_ERR_LENGTH, "SET_SETPOINT short body");
+
+    LinkPidCmd pid = { 1, 0, { 0, 0 }, 2.5f, 0.015f, 42.0f };
+    check_status(command(LINK_CMD_SET_PID, &pid, sizeof(pid)), LINK_OK, "SET_PID SSR1");
+    check(memcmp(&device.pid[0], &pid, sizeof(pid)) == 0, "gains intact");
+    pid.channel = 3;
+    check_status(command(LINK_CMD_SET_PID, &pid, sizeof(pid)), LINK_ERR_RANGE, "SET_PID SSR3");
+    LinkPidCmd pi = { 2, 0, { 0, 0 }, 2.5f, 0.015f, 0.0f };
+    check_status(command(LINK_CMD_SET_PID, &pi, sizeof(pi)), LINK_OK, "SET_PID kd 0 (PI only)");
+    LinkPidCmd high = { 2, 0, { 0, 0 }, 1001.0f, 0.015f, 42.0f };
+    check_status(command(LINK_CMD_SET_PID, &high, sizeof(high)), LINK_ERR_RANGE, "SET_PID kp 1001");
+    check(memcmp(&device.pid[1], &pi, sizeof(pi)) == 0, "rejected gains not applied");
+
+    check_status(command(0x9F, NULL, 0), LINK_ERR_UNKNOWN, "unknown command 0x9F");
+}
+
+static uint32_t upload_bytes = 0;
+static uint32_t upload_ms = 0;
+
+static void test_upload() {
+    printf("Upload (%s)\n", profile_path);
+    long size = 0;
+    char* text = read_file(profile_path, &size);
+    if (!text) {
+        check(false, "profile file readable");
+        return;
+    }
+
+    TickType_t start = xTaskGetTickCount();
+    LinkUploadBegin begin = {};
+    begin.size = (uint32_t)size;
+    snprintf(begin.name, sizeof(begin.name), "uploaded.json");
+    check_status(command(LINK_CMD_UPLOAD_BEGIN, &begin, sizeof(begin)), LINK_OK, "UPLOAD_BEGIN");
+
+    uint8_t chunk[LINK_MAX_BODY];
+    bool chunks_ok = true;
+    for (long off = 0; off < size; off += LINK_UPLOAD_CHUNK) {
+        size_t n = (size - off < (long)LINK_UPLOAD_CHUNK) ? (size_t)(size - off) : LINK_UPLOAD_CHUNK;
+        LinkUploadData hdr = { (uint32_t)off };
+        memcpy(chunk, &hdr, sizeof(hdr));
+        memcpy(chunk + sizeof(hdr), text + off, n);
+        if (command(LINK_CMD_UPLOAD_DATA, chunk, sizeof(hdr) + n) != LINK_OK) chunks_ok = false;
+    }
+    check(chunks_ok, "UPLOAD_DATA chunks");
+    check_status(command(LINK_CMD_UPLOAD_END, NULL, 0), LINK_OK, "UPLOAD_END");
+    upload_ms = (uint32_t)(xTaskGetTickCount() - start);
+    upload_bytes = (uint32_t)size;
+    check(device.upload_done && device.upload_received == (uint32_t)size &&
+          memcmp(device.upload, text, size) == 0, "uploaded bytes identical");
+
+    // A chunk at the wrong offset is refused, not written
+    check_status(command(LINK_CMD_UPLOAD_BEGIN, &begin, sizeof(begin)), LINK_OK, "UPLOAD_BEGIN again");
+    LinkUploadData hdr = { 100 };
+    memcpy(chunk, &hdr, sizeof(hdr));
+    check_status(command(LINK_CMD_UPLOAD_DATA, chunk, sizeof(hdr) + 10), LINK_ERR_STATE, "UPLOAD_DATA out of order");
+    check_status(command(LINK_CMD_UPLOAD_END, NULL, 0), LINK_ERR_LENGTH, "UPLOAD_END incomplete");
+
+    // Only .json names are listed, and the temporary file is not a target
+    snprintf(begin.name, sizeof(begin.name), "upload.tmp");
+    check_status(command(LINK_CMD_UPLOAD_BEGIN, &begin, sizeof(begin)), LINK_ERR_RANGE, "UPLOAD_BEGIN upload.tmp");
+    snprintf(begin.name, sizeof(begin.name), "../config.json");
+    check_status(command(LINK_CMD_UPLOAD_BEGIN, &begin, sizeof(begin)), LINK_ERR_RANGE, "UPLOAD_BEGIN ../config.json");
+    snprintf(begin.name, sizeof(begin.name), "SAC305.JSON");
+    check_status(command(LINK_CMD_UPLOAD_BEGIN, &begin, sizeof(begin)), LINK_OK, "UPLOAD_BEGIN SAC305.JSON");
+    free(text);
+}
+
+static void test_corruption() {
+    printf("Corruption\n");
+
+    // printf text from the device echoed back by a terminal, then a command
+    LinkStats before = link_stats();
+    const char* text = "[Sensors] T1: 24.50 C, T2: nan C, CJ: 23.12 C\r\n";
+    link_sim_host_write((const uint8_t*)text, strlen(text));
+    check_status(command(LINK_CMD_START_STOP, NULL, 0), LINK_OK, "command after text noise");
+    check(link_stats().rx_framing_errors == before.rx_framing_errors + 1, "text counted as one bad frame");
+
+    // Bit flip inside a command: dropped (no ACK), the retry goes through
+    uint8_t wire[LINK_WIRE_MAX];
+    LinkSetpointCmd sp = { 100.0f };
+    uint8_t seq;
+    size_t n = link_host_command(&host, LINK_CMD_SET_SETPOINT, &sp, sizeof(sp), wire, &seq);
+    wire[n / 2] ^= 0x10;
+    before = link_stats();
+    rx.ack_count = 0;
+    link_sim_host_write(wire, n);
+    run_for(100);
+    LinkStats after = link_stats();
+    check(rx.ack_count == 0 && device.setpoint != 100.0f, "corrupted command not executed");
+    check(after.rx_crc_errors + after.rx_framing_errors == before.rx_crc_errors + before.rx_framing_errors + 1,
+          "corrupted command counted");
+    check_status(command(LINK_CMD_SET_SETPOINT, &sp, sizeof(sp)), LINK_OK, "retry");
+
+    // Bit flip on the way back: the host drops the frame and sees the gap
+    stream(1, 1);
+    uint32_t crc_before = host.dec.crc_errors + host.dec.framing_errors;
+    uint32_t gaps_before = host.rx_seq_gaps;
+    link_sim_corrupt_tx(100);
+    run_for(2000);
+    check(host.dec.crc_errors + host.dec.framing_errors == crc_before + 1, "corrupted telemetry dropped by the host");
+    check(rx.telemetry_gaps == 1 && host.rx_seq_gaps == gaps_before + 1, "one sample missing, seen as a seq gap");
+    stream(0, 0);
+}
+
+static void test_backpressure() {
+    printf("Back-pressure\n");
+    stream(1, 1);
+
+    // Host stops reading: the port fills, the device keeps sampling on time
+    LinkStats before = link_stats();
+    host_reading = false;
+    uint32_t produced_before = produced;
+    producer_max_late_ms = 0;
+    run_for(30000);
+    host_reading = true;
+    LinkStats after = link_stats();
+    char line[128];
+    snprintf(line, sizeof(line), "host stalled 30 s: %u samples produced, %u refused by the port, producer late max %u ms",
+             (unsigned)(produced - produced_before), (unsigned)(after.tx_failed - before.tx_failed),
+             (unsigned)producer_max_late_ms);
+    check(after.tx_failed > before.tx_failed && producer_max_late_ms <= 1, line);
+
+    // Reads again: back in sync
+    run_for(500);
+    rx.telemetry = 0;
+    rx.telemetry_gaps = 0;
+    rx.have_t1 = false;
+    run_for(2000);
+    check(rx.telemetry >= 24 && rx.telemetry_gaps == 0, "stream resumes without gaps");
+
+    // More messages at once than TX buffers: the extra ones are dropped
+    before = link_stats();
+    burst_request = 20;
+    run_for(500);
+    after = link_stats();
+    snprintf(line, sizeof(line), "burst of 20 with %d buffers -> %u dropped", LINK_TX_BUFFERS,
+             (unsigned)(after.tx_dropped - before.tx_dropped));
+    check(after.tx_dropped - before.tx_dropped == 20 - LINK_TX_BUFFERS, line);
+    stream(0, 0);
+}
+
+static void vHostTask(void *pvParameters) {
+    (void)pvParameters;
+    link_host_init(&host);
+    vTaskDelay(pdMS_TO_TICKS(10));
+
+    test_ping();
+    test_telemetry();
+    test_commands();
+    test_upload();
+    test_corruption();
+    test_backpressure();
+
+    LinkStats s = link_stats();
+    printf("Link: rx %u frames (%u CRC, %u framing errors), tx %u frames %u bytes, %u dropped, %u refused\n",
+           (unsigned)s.rx_frames, (unsigned)s.rx_crc_errors, (unsigned)s.rx_framing_errors,
+           (unsigned)s.tx_frames, (unsigned)s.tx_bytes, (unsigned)s.tx_dropped, (unsigned)s.tx_failed);
+    printf("Telemetry frame: %u bytes on the wire for a %u-byte sample (%.0f B/s at 12.5 Hz)\n",
+           (unsigned)(sizeof(RunLogRecord) + LINK_WIRE_MAX - LINK_MAX_BODY), (unsigned)sizeof(RunLogRecord),
+           (sizeof(RunLogRecord) + LINK_WIRE_MAX - LINK_MAX_BODY) * 12.5);
+    printf("Command round trip max %u ms (link task polled every %d ms), upload %u bytes in %u ms\n",
+           (unsigned)ack_max_ms, LINK_POLL_MS, (unsigned)upload_bytes, (unsigned)upload_ms);
+    int status = check_summary();
+    fflush(stdout);
+    exit(status);
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1) profile_path = argv[1];
+
+    link_service_start_task(sim_handler);
+    xTaskCreate(vProducerTask, "PID", 1024, NULL, 3, NULL);
+    xTaskCreate(vHostTask, "Host", 4096, NULL, 1, NULL);
+
+    vTaskStartScheduler();
+    return 1;
+}
@@ -0,0 +1,66 @@
+// Converts a binary run log (control/run_log.h, /logs/run_NNNN.bin on the
+// SD card or oven_sim --log) to CSV on stdout.
+//
+// Usage: log2csv run.bin > run.csv
+//
+// A file that was not closed cleanly (record_count == 0, e.g. power lost
+// during a run) still holds its pre-allocated length: records are read
+// until the timestamps stop increasing.
+
+#include "run_log.h"
+#include <cstring>
+#include <stdio.h>
+
+static const char* state_name(uint8_t s) {
+    static const char* names[] = { "INIT", "IDLE", "PRE_CHECK", "RUNNING", "MANUAL", "COOLDOWN", "FAULT", "AUTOTUNE" };
+    return (s < sizeof(names) / sizeof(names[0])) ? names[s] : "?";
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: log2csv run.bin > run.csv\n");
+        return 1;
+    }
+    FILE* f = fopen(argv[1], "rb");
+    if (!f) {
+        fprintf(stderr, "log2csv: cannot open %s\n", argv[1]);
+        return 1;
+    }
+
+    RunLogHeader header;
+    if (fread(&header, sizeof(header), 1, f) != 1 || memcmp(header.magic, RUN_LOG_MAGIC, sizeof(RUN_LOG_MAGIC)) != 0) {
+        fprintf(stderr, "log2csv: %s is not a run log\n", argv[1]);
+        fclose(f);
+        return 1;
+    }
+    if (header.version != RUN_LOG_VERSION || header.record_size != sizeof(RunLogRecord)) {
+        fprintf(stderr, "log2csv: unsupported version %u (record %u bytes)\n", header.version, header.record_size);
+        fclose(f);
+        return 1;
+    }
+
+    fprintf(stderr, "log2csv: profile \"%.32s\", %u records%s, %u dropped\n", header.profile,
+            header.record_count, header.record_count ? "" : " (not closed, scanning)", header.dropped);
+
+    printf("t_s,t1,t2,setpoint,out1,out2,state,segment,t2_valid,fault,t1_subst,disagree\n");
+    RunLogRecord r;
+    uint32_t n = 0;
+    uint32_t last_ms = 0;
+    while (fread(&r, sizeof(r), 1, f) == 1) {
+        if (header.record_count) {
+            if (n >= header.record_count) break;
+        } else if (n > 0 && r.t_ms <= last_ms) {
+            break; // End of the data actually written
+        }
+        last_ms = r.t_ms;
+        n++;
+        printf("%.3f,%.4f,%.4f,%.4f,%u,%u,%s,%u,%d,%d,%d,%d\n",
+               (r.t_ms - header.start_ms) / 1000.0,
+               r.t1 / RUN_LOG_TEMP_SCALE, r.t2 / RUN_LOG_TEMP_SCALE, r.setpoint / RUN_LOG_TEMP_SCALE,
+               r.out1, r.out2, state_name(r.state), r.segment,
+               (r.flags & RUN_LOG_FLAG_T2) ? 1 : 0, (r.flags & RUN_LOG_FLAG_FAULT) ? 1 : 0,
+               (r.flags & RUN_LOG_FLAG_T1_SUBST) ? 1 : 0, (r.flags & RUN_LOG_FLAG_DISAGREE) ? 1 : 0);
+    }
+    fclose(f);
+    return 0;
+}
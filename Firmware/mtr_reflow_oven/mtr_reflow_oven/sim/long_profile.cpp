@@ -0,0 +1,234 @@
+// Host test for profiles longer than RAM would hold: a 1000-segment JSON
+// profile (thermal cycling) is written out, compiled and streamed back
+// through the cursor window (control/profile_timeline.h), exactly as the
+// firmware does from the SD card (profile_file_sim.cpp in place of FatFs).
+//
+// Checks, against a reference timeline held entirely in memory:
+//   - state machine walk: 100 ms steps with oven_profile_prefetch()-style
+//     prefetch, no window load left inside the locked eval
+//   - chart sweep: 100 points over the whole profile
+//   - rewinds and random access
+//   - compile errors: card read/write failures flagged as I/O (retried by
+//     profile_store), a bad document not
+// then leaves the generated profile on disk for a closed-loop run:
+//   oven_sim long_profile.json
+//
+// Usage: long_profile [segments] [out.json]   (defaults: 1000, long_profile.json)
+
+#include "profile_file_sim.h"
+#include "profile_parser.h"
+#include "profile_timeline.h"
+#include "profile_binary.h"
+#include <cstring>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include "check.h"
+
+// Cycles of 4 segments: ramp up, hold, zero-length step, ramp down by slope
+static std::string make_profile(int segments) {
+    std::string s = "{\n  \"meta\": { \"name\": \"Cycling x" + std::to_string(segments) + "\", \"alloy\": \"test\" },\n";
+    s += "  \"segments\": [\n";
+    char line[128];
+    for (int i = 0; i < segments; i++) {
+        int cycle = i / 4;
+        float high = 150.0f + (float)(cycle % 5) * 5.0f;
+        switch (i % 4) {
+            case 0: snprintf(line, sizeof(line), "    { \"type\": \"ramp\", \"end_temp\": %.1f, \"duration_s\": 4 }", high); break;
+            case 1: snprintf(line, sizeof(line), "    { \"type\": \"hold\", \"duration_s\": 3, \"note\": \"c%d\" }", cycle); break;
+            case 2: snprintf(line, sizeof(line), "    { \"type\": \"step\", \"temp\": %.1f, \"duration_s\": 0 }", high - 10.0f); break;
+            default: snprintf(line, sizeof(line), "    { \"type\": \"ramp\", \"end_temp\": 130.0, \"slope\": 5.0 }"); break;
+        }
+        s += line;
+        s += (i + 1 < segments) ? ",\n" : "\n";
+    }
+    s += "  ]\n}\n";
+    return s;
+}
+
+// --- Reference: every segment in RAM, linear search ---
+struct Reference {
+    std::vector<TimelineSegment> segments;
+    TimelineBuilder builder;
+};
+
+static bool reference_segment(void* ctx, uint32_t index, const ProfileSegment* seg) {
+    Reference* r = (Reference*)ctx;
+    TimelineSegment ts;
+    timeline_builder_add(&r->builder, seg, &ts);
+    r->segments.push_back(ts);
+    return index + 1 == r->segments.size();
+}
+
+static int reference_eval(const Reference& r, uint32_t t_ms, float* target) {
+    for (size_t i = 0; i < r.segments.size(); i++) {
+        const TimelineSegment& s = r.segments[i];
+        if (t_ms >= s.start_ms && t_ms < s.end_ms) {
+            *target = s.start_temp + s.rate_c_per_ms * (float)(t_ms - s.start_ms);
+            return (int)i;
+        }
+    }
+    *target = r.builder.temp;
+    return TIMELINE_END;
+}
+
+// Compile sources and sinks that fail after a budget of bytes or writes
+struct FailingSource {
+    const char* p;
+    size_t left;
+    size_t fail_after;
+};
+
+static int failing_read(void* src, char* buf, size_t max) {
+    FailingSource* s = (FailingSource*)src;
+    if (s->left == 0) return 0;
+    if (s->fail_after == 0) return -1;
+    size_t n = s->left < max ? s->left : max;
+    if (n > s->fail_after) n = s->fail_after;
+    memcpy(buf, s->p, n);
+    s->p += n;
+    s->left -= n;
+    s->fail_after -= n;
+    return (int)n;
+}
+
+static bool failing_write(void* file, uint32_t offset, const void* data, uint32_t len) {
+    (void)offset; (void)data; (void)len;
+    int* writes_left = (int*)file;
+    return (*writes_left)-- > 0;
+}
+
+static JsonError compile_with(const std::string& json, size_t read_budget, int write_budget, bool* ok) {
+    FailingSource src = { json.c_str(), json.size(), read_budget };
+    ProfileBinHeader header;
+    JsonError err;
+    memset(&err, 0, sizeof(err));
+    *ok = profile_bin_compile(failing_read, &src, failing_write, &write_budget, &header, &err);
+    return err;
+}
+
+static bool same_eval(TimelineCursor* c, const Reference& r, uint32_t t_ms) {
+    float a = 0, b = 0;
+    int ia = timeline_cursor_eval(c, t_ms, &a);
+    int ib = reference_eval(r, t_ms, &b);
+    return ia == ib && a == b;
+}
+
+int main(int argc, char** argv) {
+    int segments = (argc > 1) ? atoi(argv[1]) : 1000;
+    const char* path = (argc > 2) ? argv[2] : "long_profile.json";
+    if (segments < 4) segments = 4;
+
+    std::string json = make_profile(segments);
+    FILE* f = fopen(path, "wb");
+    if (!f || fwrite(json.data(), 1, json.size(), f) != json.size()) {
+        printf("Cannot write %s\n", path);
+        return 1;
+    }
+    fclose(f);
+    printf("long_profile: %d segments, %zu bytes of JSON in %s\n", segments, json.size(), path);
+
+    // Reference straight from the parser
+    Reference ref;
+    timeline_builder_init(&ref.builder);
+    ReflowProfile ref_summary;
+    JsonError err;
+    check(profile_parse_json(json.c_str(), &ref_summary, reference_segment, &ref, &err), "reference parse");
+
+    // Compiled file + window
+    ReflowProfile profile;
+    ProfileTimeline timeline;
+    memset(&timeline, 0, sizeof(timeline));
+    check(sim_profile_load(path, &profile, &timeline), "compile and open");
+    check(profile.segment_count == (uint32_t)segments && timeline.segment_count == (uint32_t)segments,
+          "segment count kept (no truncation)");
+    check(timeline.total_ms == ref.builder.t_ms && timeline.peak_temp == ref.builder.peak_temp,
+          "total time and peak from the header");
+    printf("        %s: %.0f s, peak %.1f C\n", profile.name, timeline.total_ms / 1000.0, timeline.peak_temp);
+
+    // State machine: 100 ms steps, prefetch outside the "lock", then eval
+    TimelineCursor run;
+    timeline_cursor_reset(&run, &timeline);
+    uint32_t mismatches = 0, loads_in_eval = 0, last_seg = 0, steps = 0;
+    for (uint32_t t = 0; t <= timeline.total_ms + 1000; t += 100, steps++) {
+        timeline_cursor_prefetch(&run);
+        uint32_t before = run.loads;
+        float target = 0, expect = 0;
+        int seg = timeline_cursor_eval(&run, t, &target);
+        loads_in_eval += run.loads - before;
+        int ref_seg = reference_eval(ref, t, &expect);
+        if (seg != ref_seg || target != expect) mismatches++;
+        if (seg >= 0) last_seg = (uint32_t)seg;
+    }
+    char what[128];
+    snprintf(what, sizeof(what), "walk: %u steps, %u mismatches, last segment %u", steps, mismatches, last_seg);
+    check(mismatches == 0 && last_seg == (uint32_t)segments - 1, what);
+    snprintf(what, sizeof(what), "walk: %u window loads, %u of them inside eval", run.loads, loads_in_eval);
+    check(loads_in_eval == 0, what);
+
+    // Dashboard chart: 100 points over the whole profile
+    TimelineCursor chart;
+    timeline_cursor_reset(&chart, &timeline);
+    uint32_t duration = timeline.total_ms / 1000;
+    mismatches = 0;
+    for (int i = 0; i < 100; i++) {
+        if (!same_eval(&chart, ref, (duration * i) / 99 * 1000)) mismatches++;
+    }
+    snprintf(what, sizeof(what), "chart: 100 points, %u mismatches, %u window loads", mismatches, chart.loads);
+    check(mismatches == 0, what);
+
+    // Rewinds and jumps
+    TimelineCursor jump;
+    timeline_cursor_reset(&jump, &timeline);
+    mismatches = 0;
+    uint32_t seed = 12345;
+    for (int i = 0; i < 2000; i++) {
+        seed = seed * 1103515245u + 12345u;
+        uint32_t t = (seed >> 8) % (timeline.total_ms + 2000);
+        if (!same_eval(&jump, ref, t)) mismatches++;
+        if (i % 10 == 0 && t > 500 && !same_eval(&jump, ref, t - 500)) mismatches++; // Step back
+    }
+    snprintf(what, sizeof(what), "random access: %u mismatches", mismatches);
+    check(mismatches == 0, what);
+
+    // Replaced profile: cursors reload instead of serving a stale window
+    ProfileTimeline current = timeline;
+    TimelineCursor swap;
+    timeline_cursor_reset(&swap, &current);
+    float before = 0, after = 0;
+    timeline_cursor_eval(&swap, 60000, &before);
+    static TimelineSegment one[1];
+    ProfileSegment hold = { SEG_HOLD, 42.0f, 0.0f, 3600, "" };
+    TimelineBuilder b;
+    timeline_builder_init(&b);
+    timeline_builder_add(&b, &hold, &one[0]);
+    ProfileTimeline small;
+    profile_timeline_from_array(&small, one, 1);
+    profile_timeline_replace(&current, &small);
+    int seg = timeline_cursor_eval(&swap, 60000, &after);
+    check(seg == 0 && after == 42.0f && before != after, "profile replaced under a cursor");
+
+    // Compile errors: I/O or document
+    bool ok;
+    JsonError e = compile_with(json, json.size() / 2, 1000000, &ok);
+    check(!ok && e.io, "compile: card read failure flagged as I/O");
+    e = compile_with(json, json.size(), 2, &ok);
+    check(!ok && e.io, "compile: segment write failure flagged as I/O");
+    int all_segment_writes = (segments + PROFILE_WINDOW_SEGMENTS - 1) / PROFILE_WINDOW_SEGMENTS;
+    e = compile_with(json, json.size(), all_segment_writes, &ok);
+    check(!ok && e.io, "compile: header write failure flagged as I/O");
+    std::string bad = json;
+    bad.replace(bad.find("\"ramp\""), 6, "\"warp\"");
+    e = compile_with(bad, bad.size(), 1000000, &ok);
+    check(!ok && !e.io, "compile: invalid document not flagged as I/O");
+    e = compile_with(json, json.size(), 1000000, &ok);
+    check(ok, "compile: clean run");
+
+    printf("\nRAM: ProfileTimeline %zu bytes, TimelineCursor %zu bytes (%d-segment window);"
+           " %d segments in RAM would take %zu bytes\n",
+           sizeof(ProfileTimeline), sizeof(TimelineCursor), PROFILE_WINDOW_SEGMENTS,
+           segments, segments * sizeof(TimelineSegment));
+    printf("file reads: %u\n", sim_profile_reads());
+    return check_summary();
+}
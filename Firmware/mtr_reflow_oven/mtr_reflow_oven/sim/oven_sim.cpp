@@ -0,0 +1,382 @@
+// Closed-loop oven simulator: the control tasks (control/oven_control.cpp)
+// running on the FreeRTOS POSIX port against the plant model, in virtual
+// time. A full profile runs in a fraction of a second of wall time.
+//
+// Usage: oven_sim [profile.json] [system.json] [--csv] [--log run.bin]
+//                 [--control pid|feedforward] [--autotune 1|2]
+//                 [--two-zone] [--zones MODE] [--glitch N] [--t1-offset C]
+//                 [--alert-race]
+//   defaults: ../doc/profiles/sac305.json ../doc/config/system.json
+//   --help, or an unknown option: this usage, exit code 1
+//   --csv     one line per second: t, target, T1, oven, P1, P2, state
+//   --log     binary run log as written to /logs on the SD card (log2csv,
+//             fopdt_fit)
+//   --control overrides the profile's "control" mode, to compare both on
+//             the same profile (feedforward needs "model" in system.json)
+//   --autotune relay auto-tune of SSR 1 or 2 first (control/autotune.h),
+//             then the profile on the gains found; exit code 3 if the
+//             tune does not converge
+//   --two-zone each element heats its own half of the chamber
+//             (plant_two_zone_params), T1 over zone 1, T2 over zone 2
+//   --zones   overrides "zones.mode" of system.json (control/zone_control.h)
+//   --glitch  every N-th T1 read a +80 C spike, one T1 transfer in N lost
+//             (control/sensor_fusion.h has to ride through them)
+//   --t1-offset overrides "calibration.t1_offset": a negative one makes
+//             the controller overheat the oven, for the MCP9600 hardware
+//             cutoff (control/hw_alert.h) to trip. The fault is then
+//             acknowledged every 5 s until it clears; exit code 2
+//   --alert-race the alert IRQ lands between an SSR slot's check and its
+//             write (sim_hal_alert_race), with --t1-offset; exit code 4
+//             if an SSR was on while the cutoff held
+
+#include "oven_control.h"
+#include "oven_hal.h"
+#include "profile_parser.h"
+#include "profile_file_sim.h"
+#include "run_log.h"
+#include "ssr_output.h"
+#include "i2c_bus.h"
+#include "mcp9600.h"
+#include "zone_control.h"
+#include "sim_hal.h"
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <stdio.h>
+#include <stdlib.h>
+
+static const float SIM_LIQUIDUS_C = 217.0f;        // SAC305
+static const uint32_t SIM_TIMEOUT_MS = 60 * 60 * 1000; // Give up after an hour of oven time
+
+static bool csv_output = false;
+static FILE* log_file = NULL;
+static RunLogSector log_sector;
+static uint32_t log_fill = 0;
+static std::chrono::steady_clock::time_point wall_start;
+
+// --- Run Metrics (RUNNING state only) ---
+struct SimMetrics {
+    uint32_t samples;
+    float max_abs_error;    // |target - T1|
+    double sum_sq_error;
+    float peak_target;
+    float peak_oven;
+    double ramp_error;      // Sum of target - T1 while the target rises...
+    double ramp_rise;       // ...and of the target rise: their ratio is the lag
+    uint32_t above_liquidus_ms;
+    uint32_t run_ms;
+    double sum_p1;          // Commanded SSR1 power, every 100 ms
+    uint32_t p_samples;
+    float max_spread;       // |zone 1 - zone 2| (two-zone plant)
+    double sum_sq_spread;
+};
+static SimMetrics metrics;
+
+static bool two_zone = false;
+static uint8_t autotune_ssr = 0;
+static bool tuned = false;
+static AutotuneResult tune_result;
+static uint32_t tune_ms;
+static uint32_t tune_cycles;
+
+static bool load_config(const char* path, SystemConfig* out) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    JsonError err;
+    bool ok = system_config_parse_stream(sim_json_read, f, out, &err);
+    fclose(f);
+    if (!ok) printf("%s:%lu:%lu: %s\n", path, (unsigned long)err.line, (unsigned long)err.column, err.message);
+    return ok;
+}
+
+static void print_summary(void) {
+    double wall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wall_start).count();
+    double rms = metrics.samples ? sqrt(metrics.sum_sq_error / metrics.samples) : 0.0;
+
+    printf("\n=== oven_sim: %s ===\n", currentProfile.name);
+    printf("profile run      : %.1f s (virtual)\n", metrics.run_ms / 1000.0);
+    printf("total simulated  : %.1f s in %.1f ms wall (x%.0f)\n",
+           millis() / 1000.0, wall_ms, wall_ms > 0 ? millis() / wall_ms : 0.0);
+    printf("tracking error   : max %.2f C, rms %.2f C\n", metrics.max_abs_error, rms);
+    printf("peak             : oven %.2f C for setpoint %.2f C (overshoot %+.2f C)\n",
+           metrics.peak_oven, metrics.peak_target, metrics.peak_oven - metrics.peak_target);
+    if (tuned) {
+        printf("auto-tune SSR%u  : %u cycles, %.1f s; Ku %.2f, Tu %.1f s -> Kp %.2f, Ki %.4f, Kd %.1f\n",
+               tune_result.ssr, tune_cycles, tune_ms / 1000.0, tune_result.ku, tune_result.tu_s,
+               tune_result.kp, tune_result.ki, tune_result.kd);
+    }
+    printf("above liquidus   : %.1f s (> %.0f C)\n", metrics.above_liquidus_ms / 1000.0, SIM_LIQUIDUS_C);
+    if (two_zone) {
+        printf("zone spread      : max %.2f C, rms %.2f C (%s)\n", metrics.max_spread,
+               metrics.samples ? sqrt(metrics.sum_sq_spread / metrics.samples) : 0.0,
+               zone_mode_name((ZoneMode)sysConfig.zone_mode));
+    }
+    printf("ramp lag         : %.1f s behind the setpoint while it rises (%s)\n",
+           metrics.ramp_rise > 0 ? metrics.ramp_error * 0.1 / metrics.ramp_rise : 0.0,
+           currentProfile.control_mode == CONTROL_FEEDFORWARD ? "feed-forward" : "PID");
+    uint32_t slots = ssr_output_slots(1);
+    printf("SSR1 duty        : %.2f %% delivered for %.2f %% commanded (%u slots of %.0f ms)\n",
+           slots ? 100.0 * ssr_output_on_slots(1) / slots : 0.0,
+           metrics.p_samples ? metrics.sum_p1 / metrics.p_samples : 0.0,
+           slots, ssr_output_slot_us(1) / 1000.0);
+    printf("sensor bus       : %u transactions (%.1f/s), %u errors\n", i2c_bus_completed(),
+           i2c_bus_completed() * 1000.0 / millis(), i2c_bus_errors());
+    PidLoopStats pid = oven_pid_stats();
+    printf("PID loop         : %u samples, %u missed, %u late, %u timeouts, dt max %.1f ms\n",
+           pid.samples, pid.missed, pid.late, pid.timeouts, pid.max_dt_ms);
+    SensorFusion fusion = oven_sensor_fusion();
+    printf("sensor fusion    : %u T1 / %u T2 outliers dropped, %u T2 stand-ins, %u coasts\n",
+           fusion.outliers1, fusion.outliers2, fusion.stand_ins, fusion.coasts);
+    HwAlert alert = oven_hw_alert();
+    printf("hardware alert   : %s, %u trips (T1%s T2%s), cutoff max %u us, latch max %u us, SSR on %u ms after it\n",
+           hw_alert_state_name(hw_alert_state(&alert)), alert.trips, (alert.sources & HW_ALERT_T1) ? "!" : "-",
+           (alert.sources & HW_ALERT_T2) ? "!" : "-", alert.max_cutoff_us, alert.max_latch_us,
+           sim_hal_ssr_on_tripped_ms());
+}
+
+// Stands in for storage/run_logger.cpp: same ring, same sector batching,
+// stdio instead of FatFs. The whole simulation is one run.
+static void vSimLoggerTask(void *pvParameters) {
+    (void)pvParameters;
+    static RunLogHeader header;
+
+    run_log_make_header(&header, millis(), mcp9600_conversion_ms((uint8_t)sysConfig.adc_bits), currentProfile.name);
+    fwrite(&header, sizeof(header), 1, log_file);
+
+    for (;;) {
+        while (run_log_fill_sector(&log_sector, &log_fill)) {
+            fwrite(&log_sector, sizeof(log_sector), 1, log_file);
+            log_fill = 0;
+        }
+        vTaskDelay(pdMS_TO_TICKS(500));
+    }
+}
+
+static void close_log(void) {
+    if (!log_file) return;
+    uint32_t count;
+    long data_end;
+    while (run_log_fill_sector(&log_sector, &log_fill)) {
+        fwrite(&log_sector, sizeof(log_sector), 1, log_file);
+        log_fill = 0;
+    }
+    fwrite(&log_sector, sizeof(RunLogRecord), log_fill, log_file);
+    data_end = ftell(log_file);
+    count = (uint32_t)((data_end - (long)sizeof(RunLogHeader)) / sizeof(RunLogRecord));
+
+    RunLogHeader header;
+    memset(&header, 0, sizeof(header));
+    fseek(log_file, 0, SEEK_SET);
+    if (fread(&header, sizeof(header), 1, log_file) == 1) {
+        header.record_count = count;
+        header.dropped = run_log_dropped();
+        fseek(log_file, 0, SEEK_SET);
+        fwrite(&header, sizeof(header), 1, log_file);
+    }
+    fclose(log_file);
+    log_file = NULL;
+    printf("run log          : %u records, %u dropped\n", count, header.dropped);
+}
+
+// Stands in for vAppLogicTask: same start-up sequence, START pressed once
+// the oven is idle, then the 10 Hz state machine.
+static void vSimOperatorTask(void *pvParameters) {
+    (void)pvParameters;
+    TickType_t xLastWakeTime = xTaskGetTickCount();
+    bool started = false;
+    bool tuning = false;
+    bool was_running = false;
+    uint32_t last_csv_ms = 0;
+    float last_target = 0;
+    uint32_t hw_fault_ms = 0;
+    uint32_t last_ack_ms = 0;
+
+    vTaskDelay(pdMS_TO_TICKS(1000));
+    if (xSemaphoreTake(mtx_OvenState, pdMS_TO_TICKS(100)) == pdTRUE) {
+        OvenMode mode = oven_state_mode();
+        mode.state = STATE_IDLE;
+        oven_state_publish_mode(&mode);
+        xSemaphoreGive(mtx_OvenState);
+    }
+
+    if (csv_output) printf("t_s,target,t1,oven,p1,p2,state\n");
+
+    for (;;) {
+        oven_profile_prefetch();
+        if (xSemaphoreTake(mtx_OvenState, pdMS_TO_TICKS(50)) == pdTRUE) {
+            if (!started && oven_state_mode().state == STATE_IDLE) {
+                if (autotune_ssr && !tuning) {
+                    tuning = oven_cmd_autotune(autotune_ssr);
+                    if (!tuning) {
+                        printf("oven_sim: auto-tune of SSR%u refused\n", autotune_ssr);
+                        exit(3);
+                    }
+                } else if (!autotune_ssr || tuned) {
+                    oven_cmd_start_stop();
+                    started = true;
+                }
+            }
+            // Hardware trip: START/STOP every 5 s until the fault clears
+            if (hw_fault_ms && millis() - last_ack_ms >= 5000) {
+                last_ack_ms = millis();
+                oven_cmd_start_stop();
+            }
+            oven_logic_step();
+            // As vAppLogicTask does, without the UI lock
+            if (oven_autotune_result_pending() && oven_autotune_take_result(&tune_result)) {
+                Autotune t = oven_autotune_status();
+                tune_ms = millis();
+                tune_cycles = t.cycles;
+                oven_autotune_apply(&tune_result);
+                tuned = true;
+            } else if (tuning && !tuned && oven_state_mode().state != STATE_AUTOTUNE) {
+                Autotune t = oven_autotune_status();
+                printf("oven_sim: auto-tune failed after %u cycles (%s)\n", t.cycles, t.error ? t.error : "?");
+                exit(3);
+            }
+            xSemaphoreGive(mtx_OvenState);
+
+            OvenState s;
+            oven_state_read(&s);
+
+            const PlantModel* plant = sim_hal_plant();
+            uint32_t now = millis();
+
+            if (s.state == STATE_RUNNING) {
+                float err = s.target_temp - s.current_temp_t1;
+                metrics.samples++;
+                metrics.sum_sq_error += (double)err * err;
+                if (fabsf(err) > metrics.max_abs_error) metrics.max_abs_error = fabsf(err);
+                if (s.target_temp > metrics.peak_target) metrics.peak_target = s.target_temp;
+                if (was_running && s.target_temp > last_target) {
+                    metrics.ramp_error += err;
+                    metrics.ramp_rise += s.target_temp - last_target;
+                }
+                last_target = s.target_temp;
+                float spread = plant->zone1_c - plant->zone2_c;
+                metrics.sum_sq_spread += (double)spread * spread;
+                if (fabsf(spread) > metrics.max_spread) metrics.max_spread = fabsf(spread);
+                metrics.run_ms += 100;
+                was_running = true;
+            }
+            if (plant->oven_c > metrics.peak_oven) metrics.peak_oven = plant->oven_c;
+            metrics.sum_p1 += s.power_output_1;
+            metrics.p_samples++;
+            if (plant->oven_c > SIM_LIQUIDUS_C) metrics.above_liquidus_ms += 100;
+
+            if (csv_output && now - last_csv_ms >= 1000) {
+                last_csv_ms = now;
+                printf("%.1f,%.2f,%.2f,%.2f,%.0f,%.0f,%d\n", now / 1000.0, s.target_temp, s.current_temp_t1,
+                       plant->oven_c, s.power_output_1, s.power_output_2, (int)s.state);
+            }
+
+            if (s.state == STATE_FAULT && oven_alert_tripped() && !hw_fault_ms) {
+                hw_fault_ms = last_ack_ms = now;
+                printf("oven_sim: hardware FAULT at %.1f s (oven %.1f C), acknowledging every 5 s\n",
+                       now / 1000.0, plant->oven_c);
+            }
+            if (hw_fault_ms && s.state == STATE_IDLE) {
+                printf("oven_sim: fault cleared at %.1f s, %.1f s after the trip (oven %.1f C)\n",
+                       now / 1000.0, (now - hw_fault_ms) / 1000.0, plant->oven_c);
+                print_summary();
+                close_log();
+                fflush(stdout);
+                exit(sim_hal_ssr_on_tripped_ms() ? 4 : 2);
+            }
+
+            bool done = was_running && s.state == STATE_IDLE;
+            if (done || (s.state == STATE_FAULT && !hw_fault_ms) || now > SIM_TIMEOUT_MS) {
+                if (s.state == STATE_FAULT) printf("oven_sim: FAULT at %.1f s\n", now / 1000.0);
+                if (now > SIM_TIMEOUT_MS) printf("oven_sim: timeout\n");
+                print_summary();
+                close_log();
+                fflush(stdout);
+                exit(sim_hal_ssr_on_tripped_ms() ? 4 : (s.state == STATE_FAULT ? 2 : 0));
+            }
+        }
+
+        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(100)); // 10Hz logic
+    }
+}
+
+static void print_usage(void) {
+    printf("Usage: oven_sim [profile.json] [system.json] [--csv] [--log run.bin]\n"
+           "                [--control pid|feedforward] [--autotune 1|2]\n"
+           "                [--two-zone] [--zones MODE] [--glitch N] [--t1-offset C]\n"
+           "                [--alert-race]\n");
+}
+
+int main(int argc, char** argv) {
+    const char* profile_path = "../doc/profiles/sac305.json";
+    const char* config_path = "../doc/config/system.json";
+    const char* control = NULL;
+    const char* zones = NULL;
+    const char* t1_offset = NULL;
+    int positional = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--csv") == 0) csv_output = true;
+        else if (strcmp(argv[i], "--log") == 0 && i + 1 < argc) {
+            log_file = fopen(argv[++i], "w+b");
+            if (!log_file) printf("Cannot create %s\n", argv[i]);
+        }
+        else if (strcmp(argv[i], "--control") == 0 && i + 1 < argc) control = argv[++i];
+        else if (strcmp(argv[i], "--autotune") == 0 && i + 1 < argc) autotune_ssr = (uint8_t)atoi(argv[++i]);
+        else if (strcmp(argv[i], "--two-zone") == 0) two_zone = true;
+        else if (strcmp(argv[i], "--zones") == 0 && i + 1 < argc) zones = argv[++i];
+        else if (strcmp(argv[i], "--glitch") == 0 && i + 1 < argc) sim_i2c_glitches((uint32_t)atoi(argv[++i]));
+        else if (strcmp(argv[i], "--t1-offset") == 0 && i + 1 < argc) t1_offset = argv[++i];
+        else if (strcmp(argv[i], "--alert-race") == 0) sim_hal_alert_race(true);
+        else if (strncmp(argv[i], "--", 2) == 0) {
+            // Unknown, or its value missing: not a file name
+            if (strcmp(argv[i], "--help") != 0) printf("Unknown option %s\n", argv[i]);
+            print_usage();
+            return 1;
+        }
+        else if (positional == 0) { profile_path = argv[i]; positional++; }
+        else if (positional == 1) { config_path = argv[i]; positional++; }
+    }
+
+    oven_control_init();
+
+    SystemConfig cfg = sysConfig;
+    if (load_config(config_path, &cfg)) {
+        sysConfig = cfg;
+        printf("Config Loaded: %s\n", config_path);
+    } else {
+        printf("Config not loaded (%s), using defaults\n", config_path);
+    }
+    if (t1_offset) sysConfig.t1_offset = (float)atof(t1_offset);
+    if (zones) {
+        ZoneMode zm;
+        if (!zone_mode_parse(zones, &zm)) {
+            printf("Unknown zone mode '%s'\n", zones);
+            return 1;
+        }
+        sysConfig.zone_mode = zm;
+    }
+
+    // Compiled and streamed from a file, as from the SD card
+    ReflowProfile profile;
+    ProfileTimeline timeline;
+    if (sim_profile_load(profile_path, &profile, &timeline)) {
+        currentProfile = profile;
+        profile_timeline_replace(&currentTimeline, &timeline);
+    } else {
+        printf("Profile not loaded (%s), using built-in\n", profile_path);
+        init_test_profile();
+    }
+    if (control) {
+        currentProfile.control_mode = (strcmp(control, "feedforward") == 0) ? CONTROL_FEEDFORWARD : CONTROL_PID;
+    }
+
+    PlantParams params = two_zone ? plant_two_zone_params() : plant_default_params();
+    sim_hal_init(&params);
+
+    oven_control_start_tasks();
+    xTaskCreate(vSimOperatorTask, "AppLogic", 2048, NULL, 3, NULL);
+    if (log_file) xTaskCreate(vSimLoggerTask, "Disk_Logger", 1024, NULL, 1, NULL);
+
+    wall_start = std::chrono::steady_clock::now();
+    vTaskStartScheduler();
+    return 1;
+}
@@ -0,0 +1,250 @@
+// Host unit test for the PID controller (control/pid.h), against the
+// two PID blocks it replaced in vPIDLoopTask (reproduced below as
+// legacy_pid_update).
+//
+// Plant: the FOPDT model of doc/config/system.json (3.53 C/%, tau 122 s,
+// dead time 17.5 s), 25 C ambient, 200 ms samples. Gains from the
+// Ziegler-Nichols rule on that model (Kp 1.2 tau / K L, Ti 2 L, Td L / 2)
+// rounded, in system.json units: the firmware fallbacks (kp 4) are
+// tuned for the real oven and limit-cycle on this model.
+//
+// Checks:
+//   - setpoint step: no derivative kick, bounded overshoot after the
+//     long saturated climb (anti-windup), no steady-state offset where
+//     the legacy +/-2500 clamp (25 % at ki 0.01) cannot hold 150 C
+//   - integral term within i_limit, frozen while saturated
+//   - bumpless hand-over from a fixed output (auto-tune relay, MANUAL)
+//   - slew limit
+//   - same response at 100 ms and 200 ms samples
+// Recorded step responses (every 20 s) are printed for both loops.
+//
+// Usage: pid_step [--csv]   (--csv: every sample, both loops)
+
+#include "pid.h"
+#include <cmath>
+#include <cstring>
+#include <stdio.h>
+#include <stdlib.h>
+#include "check.h"
+
+static const float REF_PERIOD_S = 0.2f;     // PID_REF_PERIOD_S
+static const float AMBIENT_C = 25.0f;
+static const float STEP_C = 150.0f;
+static const float RUN_S = 900.0f;
+
+// --- Plant: first order plus dead time ---
+#define PLANT_DELAY_MAX 512
+struct Plant {
+    float gain, tau_s, dead_s;
+    float temp;
+    float delay[PLANT_DELAY_MAX];   // Power history, one slot per sample
+    int delay_len, head;
+};
+
+static void plant_init(Plant* p, float dt_s) {
+    memset(p, 0, sizeof(*p));
+    p->gain = 3.53f;
+    p->tau_s = 122.0f;
+    p->dead_s = 17.5f;
+    p->temp = AMBIENT_C;
+    p->delay_len = (int)lroundf(p->dead_s / dt_s);
+    if (p->delay_len < 1) p->delay_len = 1;
+    if (p->delay_len > PLANT_DELAY_MAX) p->delay_len = PLANT_DELAY_MAX;
+}
+
+static void plant_step(Plant* p, float power, float dt_s) {
+    float delayed = p->delay[p->head];
+    p->delay[p->head] = power;
+    p->head = (p->head + 1) % p->delay_len;
+    float target = AMBIENT_C + p->gain * delayed;
+    p->temp += (target - p->temp) * dt_s / p->tau_s;
+}
+
+// --- Legacy: the inline PID of vPIDLoopTask before control/pid.h ---
+struct LegacyPid {
+    float integral, last_error;
+};
+
+static float legacy_pid_update(LegacyPid* s, const PidParams* p, float setpoint, float input, float dt_s) {
+    float step = dt_s / REF_PERIOD_S;
+    float error = setpoint - input;
+    s->integral += error * step;
+    if (s->integral > 2500.0f) s->integral = 2500.0f;
+    if (s->integral < -2500.0f) s->integral = -2500.0f;
+    float derivative = (error - s->last_error) / step;
+    s->last_error = error;
+    float out = (p->kp * error) + (p->ki * s->integral) + (p->kd * derivative);
+    if (out > 100.0f) out = 100.0f;
+    if (out < 0.0f) out = 0.0f;
+    return out;
+}
+
+static PidParams default_params() {
+    PidParams p;
+    p.kp = 2.0f;
+    p.ki = 0.01f;
+    p.kd = 80.0f;
+    p.ref_period_s = REF_PERIOD_S;
+    p.out_min = 0.0f;
+    p.out_max = 100.0f;
+    p.i_limit = 50.0f;      // PID_DEFAULT_I_LIMIT_PCT
+    p.d_filter_s = 1.0f;    // PID_DEFAULT_D_FILTER_S
+    p.slew_per_s = 0.0f;
+    return p;
+}
+
+// --- Step response: ambient -> STEP_C at t = 0 ---
+struct StepResult {
+    float overshoot_c;      // Peak above STEP_C
+    float rise_s;           // First time within 2 C of STEP_C
+    float settle_s;         // Last time outside +/-2 C
+    float final_c;
+    float max_abs_i_term;   // control/pid.h only
+    bool i_grew_saturated;  // Integral grew while the output sat at 100 %
+    float temp_at[(int)(RUN_S / 20.0f) + 1];
+    float out_at[(int)(RUN_S / 20.0f) + 1];
+};
+
+static void step_response(bool legacy, float dt_s, StepResult* r, FILE* csv) {
+    memset(r, 0, sizeof(*r));
+    r->rise_s = -1.0f;
+    PidParams p = default_params();
+    Plant plant;
+    plant_init(&plant, dt_s);
+    Pid pid;
+    pid_reset(&pid);
+    LegacyPid lp = { 0, 0 };
+
+    int samples = (int)lroundf(RUN_S / dt_s);
+    int record_every = (int)lroundf(20.0f / dt_s);
+    float peak = 0.0f;
+    for (int i = 0; i <= samples; i++) {
+        float t = (float)i * dt_s;
+        float input = plant.temp;
+        float prev_i = pid.i_term;
+        float out = legacy ? legacy_pid_update(&lp, &p, STEP_C, input, dt_s)
+                           : pid_update(&pid, &p, STEP_C, input, 0.0f, dt_s);
+        if (!legacy) {
+            if (fabsf(pid.i_term) > r->max_abs_i_term) r->max_abs_i_term = fabsf(pid.i_term);
+            if (out >= p.out_max && pid.i_term > prev_i) r->i_grew_saturated = true;
+        }
+        if (input > peak) peak = input;
+        if (r->rise_s < 0.0f && input >= STEP_C - 2.0f) r->rise_s = t;
+        if (fabsf(input - STEP_C) > 2.0f) r->settle_s = t;
+        if (i % record_every == 0) {
+            r->temp_at[i / record_every] = input;
+            r->out_at[i / record_every] = out;
+        }
+        if (csv) fprintf(csv, "%s,%.1f,%.2f,%.2f\n", legacy ? "legacy" : "pid", t, input, out);
+        plant_step(&plant, out, dt_s);
+    }
+    r->overshoot_c = peak - STEP_C;
+    r->final_c = plant.temp;
+}
+
+static void print_responses(const StepResult& a, const StepResult& b) {
+    printf("\n  step %.0f -> %.0f C, 200 ms samples (legacy | pid.h)\n", AMBIENT_C, STEP_C);
+    printf("     t      T1   out  |     T1   out\n");
+    for (int k = 0; k <= (int)(RUN_S / 20.0f); k++) {
+        printf("  %4d  %6.1f %5.1f  | %6.1f %5.1f\n", k * 20,
+               a.temp_at[k], a.out_at[k], b.temp_at[k], b.out_at[k]);
+    }
+    printf("  overshoot %+.1f C | %+.1f C, rise %.0f s | %.0f s, settled %.0f s | %.0f s\n\n",
+           a.overshoot_c, b.overshoot_c, a.rise_s, b.rise_s, a.settle_s, b.settle_s);
+}
+
+// --- Setpoint step on a settled loop: no derivative kick ---
+static void test_no_kick() {
+    PidParams p = default_params();
+    p.ki = 0.0f;
+    Pid pid;
+    pid_reset(&pid);
+    for (int i = 0; i < 50; i++) pid_update(&pid, &p, 100.0f, 100.0f, 0.0f, REF_PERIOD_S);
+    float out = pid_update(&pid, &p, 110.0f, 100.0f, 0.0f, REF_PERIOD_S);
+    char what[96];
+    snprintf(what, sizeof(what), "10 C setpoint step: output %.1f = kp * error, no kd kick", out);
+    check(fabsf(out - p.kp * 10.0f) < 0.01f, what);
+
+    LegacyPid lp = { 0, 0 };
+    for (int i = 0; i < 50; i++) legacy_pid_update(&lp, &p, 100.0f, 100.0f, REF_PERIOD_S);
+    float legacy_out = legacy_pid_update(&lp, &p, 110.0f, 100.0f, REF_PERIOD_S);
+    snprintf(what, sizeof(what), "legacy loop kicks to %.0f %% on the same step", legacy_out);
+    check(legacy_out >= 100.0f, what);
+}
+
+// --- Hand-over from a fixed output ---
+static void test_bumpless() {
+    PidParams p = default_params();
+    Pid pid;
+    pid_reset(&pid);
+    pid_bumpless(&pid, &p, 150.0f, 145.0f, 0.0f, 37.0f);
+    float out = pid_update(&pid, &p, 150.0f, 145.0f, 0.0f, REF_PERIOD_S);
+    char what[96];
+    snprintf(what, sizeof(what), "bumpless from 37 %%: first output %.2f %%", out);
+    check(fabsf(out - 37.0f) < 0.5f, what);
+
+    pid_reset(&pid);
+    pid_bumpless(&pid, &p, 150.0f, 145.0f, 12.0f, 37.0f);
+    out = pid_update(&pid, &p, 150.0f, 145.0f, 12.0f, REF_PERIOD_S);
+    snprintf(what, sizeof(what), "bumpless with 12 %% feed-forward: first output %.2f %%", out);
+    check(fabsf(out - 37.0f) < 0.5f, what);
+
+    // From an SSR that was off: nothing to take over, no negative integral
+    pid_reset(&pid);
+    pid_bumpless(&pid, &p, 150.0f, 25.0f, 0.0f, 0.0f);
+    check(pid.i_term == 0.0f, "bumpless from off: integral starts at 0");
+}
+
+// --- Output slew limit ---
+static void test_slew() {
+    PidParams p = default_params();
+    p.slew_per_s = 10.0f;
+    Pid pid;
+    pid_reset(&pid);
+    float last = 0.0f;
+    float max_delta = 0.0f;
+    for (int i = 0; i < 100; i++) {
+        float out = pid_update(&pid, &p, 150.0f, 25.0f, 0.0f, REF_PERIOD_S);
+        if (fabsf(out - last) > max_delta) max_delta = fabsf(out - last);
+        last = out;
+    }
+    char what[96];
+    snprintf(what, sizeof(what), "slew 10 %%/s: largest step %.2f %% per 200 ms, reaches %.0f %%", max_delta, last);
+    check(max_delta <= 2.0f + 1e-4f && last >= 100.0f, what);
+    check(pid.i_term <= p.i_limit, "integral bounded while slew-limited");
+}
+
+int main(int argc, char** argv) {
+    FILE* csv = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--csv") == 0) csv = stdout;
+    }
+    if (csv) fprintf(csv, "loop,t_s,t1_c,output_pct\n");
+
+    StepResult legacy, pid, pid_fast;
+    step_response(true, REF_PERIOD_S, &legacy, csv);
+    step_response(false, REF_PERIOD_S, &pid, csv);
+    step_response(false, 0.1f, &pid_fast, NULL);
+    if (csv) return 0;
+
+    print_responses(legacy, pid);
+
+    char what[128];
+    snprintf(what, sizeof(what), "overshoot %+.1f C after %.0f s at 100 %%", pid.overshoot_c, pid.rise_s);
+    check(pid.overshoot_c < 8.0f, what);
+    snprintf(what, sizeof(what), "settles within 2 C: %.0f s, ends at %.1f C (legacy %.1f C)",
+             pid.settle_s, pid.final_c, legacy.final_c);
+    check(pid.settle_s < RUN_S - 60.0f && fabsf(pid.final_c - STEP_C) < 0.5f, what);
+    snprintf(what, sizeof(what), "integral term peak %.1f %% within i_limit %.0f %%", pid.max_abs_i_term, default_params().i_limit);
+    check(pid.max_abs_i_term <= default_params().i_limit, what);
+    check(!pid.i_grew_saturated, "integral frozen while the output is at 100 %");
+    snprintf(what, sizeof(what), "100 ms samples: overshoot %+.1f C, rise %.0f s (200 ms: %+.1f C, %.0f s)",
+             pid_fast.overshoot_c, pid_fast.rise_s, pid.overshoot_c, pid.rise_s);
+    check(fabsf(pid_fast.overshoot_c - pid.overshoot_c) < 1.0f && fabsf(pid_fast.rise_s - pid.rise_s) < 5.0f, what);
+
+    test_no_kick();
+    test_bumpless();
+    test_slew();
+
+    return check_summary();
+}
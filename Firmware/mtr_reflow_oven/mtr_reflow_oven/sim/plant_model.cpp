@@ -0,0 +1,73 @@
+#include "plant_model.h"
+#include <cmath>
+
+// Explicit Euler is stable well past this; the lags are all >= 1 s
+static const float PLANT_MAX_STEP_S = 0.01f;
+
+PlantParams plant_default_params(void) {
+    PlantParams p;
+    p.heater1_w = 800.0f;
+    p.heater2_w = 600.0f;
+    p.heater_tau_s = 20.0f;
+    p.thermal_mass_j_c = 450.0f;
+    p.loss_w_c = 4.0f;
+    p.ambient_c = 25.0f;
+    p.tc1_tau_s = 2.0f;
+    p.tc2_tau_s = 3.0f;
+    p.zone_coupling_w_c = 0.0f;
+    return p;
+}
+
+PlantParams plant_two_zone_params(void) {
+    PlantParams p = plant_default_params();
+    p.zone_coupling_w_c = 6.0f;
+    return p;
+}
+
+void plant_init(PlantModel* plant, const PlantParams* params) {
+    plant->params = *params;
+    plant->p1_w = 0.0f;
+    plant->p2_w = 0.0f;
+    plant->oven_c = params->ambient_c;
+    plant->zone1_c = params->ambient_c;
+    plant->zone2_c = params->ambient_c;
+    plant->tc1_c = params->ambient_c;
+    plant->tc2_c = params->ambient_c;
+}
+
+void plant_step(PlantModel* plant, bool heat1, bool heat2, float dt_s) {
+    const PlantParams* p = &plant->params;
+    float target1 = heat1 ? p->heater1_w : 0.0f;
+    float target2 = heat2 ? p->heater2_w : 0.0f;
+
+    while (dt_s > 0.0f) {
+        float h = (dt_s < PLANT_MAX_STEP_S) ? dt_s : PLANT_MAX_STEP_S;
+        dt_s -= h;
+
+        plant->p1_w += (target1 - plant->p1_w) * h / p->heater_tau_s;
+        plant->p2_w += (target2 - plant->p2_w) * h / p->heater_tau_s;
+
+        if (p->zone_coupling_w_c > 0.0f) {
+            float half_mass = 0.5f * p->thermal_mass_j_c;
+            float exchange = p->zone_coupling_w_c * (plant->zone1_c - plant->zone2_c);
+            float loss1 = 0.5f * p->loss_w_c * (plant->zone1_c - p->ambient_c);
+            float loss2 = 0.5f * p->loss_w_c * (plant->zone2_c - p->ambient_c);
+            plant->zone1_c += (plant->p1_w - loss1 - exchange) * h / half_mass;
+            plant->zone2_c += (plant->p2_w - loss2 + exchange) * h / half_mass;
+            plant->oven_c = 0.5f * (plant->zone1_c + plant->zone2_c);
+        } else {
+            float loss = p->loss_w_c * (plant->oven_c - p->ambient_c);
+            plant->oven_c += (plant->p1_w + plant->p2_w - loss) * h / p->thermal_mass_j_c;
+            plant->zone1_c = plant->oven_c;
+            plant->zone2_c = plant->oven_c;
+        }
+
+        plant->tc1_c += (plant->zone1_c - plant->tc1_c) * h / p->tc1_tau_s;
+        plant->tc2_c += (plant->zone2_c - plant->tc2_c) * h / p->tc2_tau_s;
+    }
+}
+
+float plant_read_tc(const PlantModel* plant, int channel) {
+    float t = (channel == 2) ? plant->tc2_c : plant->tc1_c;
+    return floorf(t / 0.0625f) * 0.0625f;
+}
@@ -0,0 +1,51 @@
+#ifndef PLANT_MODEL_H
+#define PLANT_MODEL_H
+
+#include <stdbool.h>
+
+// Lumped thermal model of the oven used by the host simulator.
+//
+//   element power  p_i' = (P_i * on_i - p_i) / heater_tau   (element warm-up lag)
+//   chamber        C * T' = p_1 + p_2 - k * (T - T_amb)
+//   thermocouples  tc'    = (T - tc) / tc_tau                (probe lag)
+//
+// Two-zone variant (zone_coupling_w_c > 0): the chamber is split in two
+// halves, each with half the mass and half the loss. Element 1 heats
+// zone 1 (under T1), element 2 zone 2 (under T2), and the halves
+// exchange k_z * (T_1 - T_2). The board sees their mean (oven_c).
+
+typedef struct {
+    float heater1_w;        // SSR1 element power
+    float heater2_w;        // SSR2 element power
+    float heater_tau_s;     // Element lag
+    float thermal_mass_j_c; // Chamber + load heat capacity (J/degC)
+    float loss_w_c;         // Loss to ambient (W/degC)
+    float ambient_c;
+    float tc1_tau_s;        // T1 probe lag
+    float tc2_tau_s;        // T2 probe lag
+    float zone_coupling_w_c; // Heat exchange between the two zones, 0 = one chamber
+} PlantParams;
+
+typedef struct {
+    PlantParams params;
+    float p1_w, p2_w;       // Power currently delivered by each element
+    float oven_c;           // True chamber temperature (mean of the zones)
+    float zone1_c, zone2_c; // Two-zone variant, = oven_c otherwise
+    float tc1_c, tc2_c;     // Temperature seen by each probe
+} PlantModel;
+
+// Small benchtop oven, 800 W + 600 W
+PlantParams plant_default_params(void);
+
+// Same oven, elements in two loosely coupled zones (oven_sim --two-zone)
+PlantParams plant_two_zone_params(void);
+
+void plant_init(PlantModel* plant, const PlantParams* params);
+
+// Integrates dt_s seconds with both SSR states held constant
+void plant_step(PlantModel* plant, bool heat1, bool heat2, float dt_s);
+
+// Probe reading at the MCP9600 resolution (0.0625 degC)
+float plant_read_tc(const PlantModel* plant, int channel);
+
+#endif // PLANT_MODEL_H
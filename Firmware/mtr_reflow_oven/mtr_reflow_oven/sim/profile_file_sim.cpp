@@ -0,0 +1,54 @@
+#include "profile_file_sim.h"
+#include <stdio.h>
+
+static FILE* bin_file = NULL;
+static ProfileBinSource bin_source;
+static uint32_t bin_reads = 0;
+
+int sim_json_read(void* file, char* buf, size_t max) {
+    FILE* f = (FILE*)file;
+    size_t n = fread(buf, 1, max, f);
+    return ferror(f) ? -1 : (int)n;
+}
+
+static bool bin_read(void* file, uint32_t offset, void* data, uint32_t len) {
+    FILE* f = (FILE*)file;
+    bin_reads++;
+    return fseek(f, (long)offset, SEEK_SET) == 0 && fread(data, 1, len, f) == len;
+}
+
+static bool bin_write(void* file, uint32_t offset, const void* data, uint32_t len) {
+    FILE* f = (FILE*)file;
+    return fseek(f, (long)offset, SEEK_SET) == 0 && fwrite(data, 1, len, f) == len;
+}
+
+bool sim_profile_load(const char* json_path, ReflowProfile* profile, ProfileTimeline* timeline) {
+    FILE* json = fopen(json_path, "rb");
+    if (!json) return false;
+
+    if (bin_file) fclose(bin_file);
+    bin_file = tmpfile();
+    if (!bin_file) {
+        fclose(json);
+        return false;
+    }
+
+    ProfileBinHeader header;
+    JsonError err;
+    bool ok = profile_bin_compile(sim_json_read, json, bin_write, bin_file, &header, &err);
+    fclose(json);
+    if (!ok) {
+        printf("%s:%lu:%lu: %s\n", json_path, (unsigned long)err.line, (unsigned long)err.column, err.message);
+        return false;
+    }
+
+    bin_source.read = bin_read;
+    bin_source.file = bin_file;
+    if (fflush(bin_file) != 0 || !profile_bin_open(&bin_source, &header, timeline)) return false;
+    profile_bin_summary(&header, profile);
+    return true;
+}
+
+uint32_t sim_profile_reads() {
+    return bin_reads;
+}
@@ -0,0 +1,24 @@
+#ifndef PROFILE_FILE_SIM_H
+#define PROFILE_FILE_SIM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "profile_binary.h"
+
+// Host stand-in for storage/profile_store.cpp: JSON profiles are compiled
+// (control/profile_binary.h) into a temporary file through stdio, and the
+// timeline streams its segments from it like the firmware does from the
+// SD card. One compiled profile at a time.
+
+// json_read_fn over a FILE*
+int sim_json_read(void* file, char* buf, size_t max);
+
+// Compile json_path and open it: *profile and *timeline then describe it,
+// ready for profile_timeline_replace(). Errors are printed as path:line:col.
+bool sim_profile_load(const char* json_path, ReflowProfile* profile, ProfileTimeline* timeline);
+
+// Segment reads from the compiled file so far (window loads)
+uint32_t sim_profile_reads();
+
+#endif // PROFILE_FILE_SIM_H
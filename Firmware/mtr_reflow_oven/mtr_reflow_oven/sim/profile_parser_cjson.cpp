@@ -0,0 +1,153 @@
+// Same code as control/profile_parser.cpp before the streaming parser,
+// logs removed (see profile_parser_cjson.h).
+
+#include <cmath>
+#include <cstring>
+#include "profile_parser_cjson.h"
+#include "profile_timeline.h"
+#include "cJSON.h"
+
+// Number member of obj, or fallback if missing
+static double json_number(cJSON* obj, const char* key, double fallback) {
+    cJSON* item = cJSON_GetObjectItem(obj, key);
+    return (item && cJSON_IsNumber(item)) ? item->valuedouble : fallback;
+}
+
+bool cjson_system_config_parse_json(const char* text, SystemConfig* cfg) {
+    cJSON *json = cJSON_Parse(text);
+    if (!json) return false;
+
+    // Parse Hardware
+    cJSON *hw = cJSON_GetObjectItem(json, "hardware");
+    if (hw) {
+        cJSON *item = cJSON_GetObjectItem(hw, "enable_sensor2_check");
+        if (item) cfg->enable_sensor2_check = cJSON_IsTrue(item);
+        
+        item = cJSON_GetObjectItem(hw, "screen_orientation");
+        if (item) cfg->screen_orientation = item->valueint;
+
+        item = cJSON_GetObjectItem(hw, "ssr2_is_present");
+        if (item) cfg->ssr2_is_present = item->valueint;
+
+        item = cJSON_GetObjectItem(hw, "buzzer_volume");
+        if (item) cfg->buzzer_volume = item->valueint;
+
+        item = cJSON_GetObjectItem(hw, "ssr1_window_ms");
+        if (item) cfg->ssr1_window_ms = item->valueint;
+
+        item = cJSON_GetObjectItem(hw, "ssr2_window_ms");
+        if (item) cfg->ssr2_window_ms = item->valueint;
+
+        item = cJSON_GetObjectItem(hw, "mains_hz");
+        if (item) cfg->mains_hz = item->valueint;
+
+        item = cJSON_GetObjectItem(hw, "tc_type");
+        if (item && cJSON_IsString(item) && item->valuestring[0]) cfg->tc_type = item->valuestring[0];
+
+        item = cJSON_GetObjectItem(hw, "tc_filter");
+        if (item) cfg->tc_filter = item->valueint;
+
+        item = cJSON_GetObjectItem(hw, "adc_bits");
+        if (item) cfg->adc_bits = item->valueint;
+    }
+    
+    // Parse PID
+    cJSON *pid = cJSON_GetObjectItem(json, "pid_params");
+    if (pid) {
+        cJSON *s1 = cJSON_GetObjectItem(pid, "ssr1");
+        if (s1) {
+            cfg->pid_ssr1_kp = json_number(s1, "kp", cfg->pid_ssr1_kp);
+            cfg->pid_ssr1_ki = json_number(s1, "ki", cfg->pid_ssr1_ki);
+            cfg->pid_ssr1_kd = json_number(s1, "kd", cfg->pid_ssr1_kd);
+        }
+        cJSON *s2 = cJSON_GetObjectItem(pid, "ssr2");
+        if (s2) {
+            cfg->pid_ssr2_kp = json_number(s2, "kp", cfg->pid_ssr2_kp);
+            cfg->pid_ssr2_ki = json_number(s2, "ki", cfg->pid_ssr2_ki);
+            cfg->pid_ssr2_kd = json_number(s2, "kd", cfg->pid_ssr2_kd);
+        }
+    }
+    
+    // Calibration
+    cJSON *cal = cJSON_GetObjectItem(json, "calibration");
+    if (cal) {
+        cfg->t1_offset = json_number(cal, "t1_offset", cfg->t1_offset);
+        cfg->t2_offset = json_number(cal, "t2_offset", cfg->t2_offset);
+    }
+
+    cJSON_Delete(json);
+    return true;
+}
+
+bool cjson_profile_parse_json(const char* text, CjsonProfile* profile) {
+    cJSON *json = cJSON_Parse(text);
+    if (!json) return false;
+
+    // Meta
+    cJSON *meta = cJSON_GetObjectItem(json, "meta");
+    if (meta) {
+        cJSON *nm = cJSON_GetObjectItem(meta, "name");
+        if (nm && nm->valuestring) {
+            strncpy(profile->name, nm->valuestring, 31);
+            profile->name[31] = 0; // Ensure null term
+        } else {
+            strncpy(profile->name, "Unknown", 31);
+        }
+    } else {
+        strncpy(profile->name, "No Meta", 31);
+    }
+    
+    // Segments
+    cJSON *segs = cJSON_GetObjectItem(json, "segments");
+    int count = cJSON_GetArraySize(segs);
+    if (count > CJSON_MAX_SEGMENTS) count = CJSON_MAX_SEGMENTS;
+    
+    profile->segment_count = count;
+    float last_temp = PROFILE_START_TEMP_C; // Assumed start
+    
+    for (int i=0; i<count; i++) {
+        cJSON *s = cJSON_GetArrayItem(segs, i);
+        cJSON *type = cJSON_GetObjectItem(s, "type");
+        ProfileSegment *seg = &profile->segments[i];
+        memset(seg, 0, sizeof(*seg));
+        
+        if (type && type->valuestring && strcmp(type->valuestring, "ramp") == 0) seg->type = SEG_RAMP;
+        else if (type && type->valuestring && strcmp(type->valuestring, "hold") == 0) seg->type = SEG_HOLD;
+        else seg->type = SEG_STEP;
+        
+        // Target Temp
+        if (cJSON_GetObjectItem(s, "end_temp") != NULL) 
+            seg->target_temp = cJSON_GetObjectItem(s, "end_temp")->valuedouble;
+        else if (cJSON_GetObjectItem(s, "temp") != NULL)
+            seg->target_temp = cJSON_GetObjectItem(s, "temp")->valuedouble;
+        else
+            seg->target_temp = last_temp;
+            
+        // Duration or Slope
+        if (cJSON_GetObjectItem(s, "duration") != NULL)
+             seg->duration = cJSON_GetObjectItem(s, "duration")->valueint;
+        else if (cJSON_GetObjectItem(s, "duration_s") != NULL)
+             seg->duration = cJSON_GetObjectItem(s, "duration_s")->valueint;
+        else if (cJSON_GetObjectItem(s, "slope") != NULL) {
+            // Calculate Duration from Slope
+            float slope = cJSON_GetObjectItem(s, "slope")->valuedouble;
+            seg->slope = slope;
+            if (slope != 0) {
+                float diff = fabsf(seg->target_temp - last_temp);
+                seg->duration = (uint32_t)(diff / fabsf(slope));
+            } else {
+                seg->duration = 0;
+            }
+        }
+
+        cJSON *note = cJSON_GetObjectItem(s, "note");
+        if (note && note->valuestring) {
+            strncpy(seg->note, note->valuestring, sizeof(seg->note) - 1);
+        }
+        
+        last_temp = seg->target_temp;
+    }
+    
+    cJSON_Delete(json);
+    return true;
+}
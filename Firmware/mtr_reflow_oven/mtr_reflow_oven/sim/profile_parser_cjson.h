@@ -0,0 +1,20 @@
+#ifndef PROFILE_PARSER_CJSON_H
+#define PROFILE_PARSER_CJSON_H
+
+#include "../project_defs.h"
+
+// Previous profile/config parser (cJSON tree, whole file in RAM), kept for
+// json_bench. Profiles were parsed into a fixed array of segments.
+
+#define CJSON_MAX_SEGMENTS 20
+
+typedef struct {
+    char name[32];
+    ProfileSegment segments[CJSON_MAX_SEGMENTS];
+    uint8_t segment_count;
+} CjsonProfile;
+
+bool cjson_profile_parse_json(const char* text, CjsonProfile* profile);
+bool cjson_system_config_parse_json(const char* text, SystemConfig* cfg);
+
+#endif // PROFILE_PARSER_CJSON_H
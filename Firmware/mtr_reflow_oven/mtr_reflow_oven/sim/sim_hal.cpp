@@ -0,0 +1,141 @@
+#include "sim_hal.h"
+#include "oven_hal.h"
+#include "oven_control.h"
+#include "../board_config.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+// Only called from tasks, and the simulated tasks never preempt each
+// other outside FreeRTOS calls: no locking needed around the plant.
+static PlantModel plant;
+static TickType_t plant_tick = 0;
+static bool ssr1_on = false;
+static bool ssr2_on = false;
+static TickType_t on_tripped_ticks = 0;
+
+static void plant_catch_up(void) {
+    TickType_t now = xTaskGetTickCount();
+    if (now != plant_tick) {
+        if ((ssr1_on || ssr2_on) && oven_alert_tripped()) on_tripped_ticks += now - plant_tick;
+        plant_step(&plant, ssr1_on, ssr2_on, (float)(now - plant_tick) * portTICK_PERIOD_MS / 1000.0f);
+        plant_tick = now;
+    }
+}
+
+void sim_hal_init(const PlantParams* params) {
+    plant_init(&plant, params);
+    plant_tick = xTaskGetTickCount();
+    ssr1_on = false;
+    ssr2_on = false;
+    on_tripped_ticks = 0;
+}
+
+uint32_t sim_hal_ssr_on_tripped_ms(void) {
+    plant_catch_up();
+    return (uint32_t)(on_tripped_ticks * portTICK_PERIOD_MS);
+}
+
+const PlantModel* sim_hal_plant(void) {
+    plant_catch_up();
+    return &plant;
+}
+
+bool sim_hal_ssr(int channel) {
+    return (channel == 2) ? ssr2_on : ssr1_on;
+}
+
+// --- oven_hal.h ---
+
+uint32_t millis() {
+    return (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+}
+
+uint32_t hal_time_us() {
+    return (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS * 1000u);
+}
+
+void hal_ssr_init() {
+    plant_catch_up();
+    ssr1_on = false;
+    ssr2_on = false;
+}
+
+static void alert_pins_sample(void);
+static bool alert_race = false;
+
+void sim_hal_alert_race(bool on) {
+    alert_race = on;
+}
+
+void hal_ssr_set(int channel, bool on) {
+    if (on && alert_race) alert_pins_sample(); // IRQ between the check and the write
+    plant_catch_up();
+    if (channel == 2) ssr2_on = on;
+    else ssr1_on = on;
+}
+
+// The hardware alarm becomes a top-priority task per channel. Slot lengths
+// are kept in us and the remainder carried, so 60 Hz cycles do not drift.
+typedef struct {
+    int channel;
+    uint32_t first_us;
+    hal_ssr_slot_cb_t cb;
+} SimSlotTimer;
+
+static SimSlotTimer slot_timers[2];
+
+static void vSimSlotTimerTask(void *pvParameters) {
+    SimSlotTimer* t = (SimSlotTimer*)pvParameters;
+    TickType_t last_wake = xTaskGetTickCount();
+    uint64_t due_us = t->first_us;
+    uint64_t elapsed_us = 0;
+    for (;;) {
+        uint64_t target_ticks = due_us / (1000000ull / configTICK_RATE_HZ);
+        uint64_t now_ticks = elapsed_us / (1000000ull / configTICK_RATE_HZ);
+        if (target_ticks > now_ticks) vTaskDelayUntil(&last_wake, (TickType_t)(target_ticks - now_ticks));
+        elapsed_us = target_ticks * (1000000ull / configTICK_RATE_HZ);
+        due_us += t->cb(t->channel);
+    }
+}
+
+void hal_ssr_timer_start(int channel, uint32_t first_us, hal_ssr_slot_cb_t cb) {
+    SimSlotTimer* t = &slot_timers[(channel == 2) ? 1 : 0];
+    t->channel = channel;
+    t->first_us = first_us;
+    t->cb = cb;
+    xTaskCreate(vSimSlotTimerTask, (channel == 2) ? "SSR2_Alarm" : "SSR1_Alarm", 512, t, configMAX_PRIORITIES - 1, NULL);
+}
+
+// The GPIO bank interrupt becomes a top-priority task sampling both pins
+// at each conversion end and calling back on a falling edge
+static hal_alert_cb_t alert_cb = NULL;
+static bool alert_level[2] = { true, true };
+
+static void alert_pins_sample(void) {
+    if (!alert_cb) return;
+    for (int ch = 1; ch <= 2; ch++) {
+        bool high = sim_mcp9600_alert_pin(ch);
+        if (alert_level[ch - 1] && !high) alert_cb(ch, hal_time_us());
+        alert_level[ch - 1] = high;
+    }
+}
+
+static void vSimAlertPinTask(void *pvParameters) {
+    (void)pvParameters;
+    for (;;) {
+        alert_pins_sample();
+        // Both sensors share the configuration: T1's conversions pace it
+        TickType_t conv = pdMS_TO_TICKS(sim_mcp9600_conversion_ms(1));
+        TickType_t late = alert_race ? conv / 2 : 0;
+        vTaskDelay(conv - (xTaskGetTickCount() + conv - late) % conv);
+    }
+}
+
+void hal_alert_irq_start(hal_alert_cb_t cb) {
+    alert_cb = cb;
+    xTaskCreate(vSimAlertPinTask, "ALT_IRQ", 512, NULL, configMAX_PRIORITIES - 1, NULL);
+}
+
+bool hal_alert_asserted(int channel) {
+    return !sim_mcp9600_alert_pin(channel);
+}
@@ -0,0 +1,40 @@
+#ifndef SIM_HAL_H
+#define SIM_HAL_H
+
+#include <stdint.h>
+#include "plant_model.h"
+
+// Host implementation of control/oven_hal.h on top of the plant model.
+// The plant is integrated lazily up to the current tick each time the
+// control code touches the SSRs or the sensors, the SSR states being
+// constant in between.
+
+void sim_hal_init(const PlantParams* params);
+
+// Plant brought up to date with the current tick
+const PlantModel* sim_hal_plant(void);
+
+// Current SSR states
+bool sim_hal_ssr(int channel);
+
+// Sensor fault injection (i2c_bus_sim.cpp), 0 = none: every n-th T1
+// temperature read is a +80 C spike, and one T1 transaction in n, half
+// way between, is not acknowledged
+void sim_i2c_glitches(uint32_t every_n);
+
+// Alert IRQ race injection (oven_sim --alert-race): a new alert edge is
+// taken inside an SSR slot, after its oven_alert_tripped() check and just
+// before its "on" write lands. The pins are sampled half a conversion late
+// so that a slot usually gets there first.
+void sim_hal_alert_race(bool on);
+
+// Time an SSR spent on while oven_alert_tripped(), ms
+uint32_t sim_hal_ssr_on_tripped_ms(void);
+
+// Level of an MCP9600 alert 1 pin (GPIO_Tn_ALT1) from the register model
+// (i2c_bus_sim.cpp): false = low. It changes at the end of a conversion,
+// hal_alert_irq_start() samples it there.
+bool sim_mcp9600_alert_pin(int channel);
+uint32_t sim_mcp9600_conversion_ms(int channel);
+
+#endif // SIM_HAL_H
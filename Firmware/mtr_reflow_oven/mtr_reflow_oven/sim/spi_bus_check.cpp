@@ -0,0 +1,321 @@
+// Host test for the SPI0 arbiter (system/spi_bus.h) on the FreeRTOS
+// simulator (virtual time, 1 ms tick).
+//
+// Checks:
+//   - queued claims granted by device priority, FIFO within one priority
+//   - clock and mode switched to the owner's on every device change, and
+//     only then
+//   - a claim that times out leaves the queue clean
+//   - a release from the DMA-complete IRQ hands the bus on
+//   - 10 s of back-to-back display bands with SD sector writes and profile
+//     reads: one owner at a time, an SD claim waits for one band at most
+//
+// The same load on a binary semaphore (the previous mtx_SPI0) runs first
+// for comparison: waiters are then served by task priority, and the run
+// logger, below the UI task, starves.
+//
+// Usage: spi_bus_check
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "spi_bus.h"
+#include "spi_bus_sim.h"
+#include "check.h"
+
+// Same descriptors as the firmware (ui/disp_bus_rp2040.cpp, main())
+static const SpiDevice disp_dev = { "display", 40000000, 0, 0, 21, 25, 1 };
+static const SpiDevice sd_dev = { "sd", 12500000, 0, 0, 22, SPI_BUS_NO_PIN, 2 };
+
+#define BAND_MS     5       // 480 x 20 px RGB565 at 31.25 MHz: 4.9 ms
+#define RENDER_MS   3       // Next band drawn while the last one is on the wire
+#define LOG_MS      80      // Run logger: one sector (2 ms with the card busy)
+#define PROFILE_MS  100     // Profile window read (1 ms)
+#define MIX_MS      10000
+
+static const SpiDevice* descriptor(SpiDeviceId id) {
+    return (id == SPI_DEV_SD) ? &sd_dev : &disp_dev;
+}
+
+// --- Priority order, reclocking, timeout, ISR release ---
+
+typedef struct {
+    SpiDeviceId id;
+    char tag;
+    uint32_t timeout_ms;
+    bool got;
+} Claim;
+
+static char grant_order[16];
+static int grant_count = 0;
+static int wrong_clock = 0;
+
+static void vClaimTask(void *pvParameters) {
+    Claim* c = (Claim*)pvParameters;
+    c->got = spi_bus_acquire(c->id, c->timeout_ms);
+    if (c->got) {
+        grant_order[grant_count++] = c->tag;
+        if (sim_spi_bus_configured() != descriptor(c->id)) wrong_clock++;
+        vTaskDelay(pdMS_TO_TICKS(1));
+        spi_bus_release(c->id);
+    }
+    vTaskSuspend(NULL);
+}
+
+// Claims one tick apart: they queue in that order
+static void claim_later(Claim* c) {
+    xTaskCreate(vClaimTask, "Claim", 1024, c, 2, NULL);
+    vTaskDelay(pdMS_TO_TICKS(1));
+}
+
+static void test_order() {
+    SpiBusStats before, after;
+    spi_bus_get_stats(&before);
+
+    check(spi_bus_acquire(SPI_DEV_DISPLAY, 0), "free bus granted at once");
+    char line[112];
+    snprintf(line, sizeof(line), "display owns the bus at %.2f MHz (40 requested)", sim_spi_bus_hz() / 1e6);
+    check(sim_spi_bus_configured() == &disp_dev && sim_spi_bus_hz() == 31250000, line);
+
+    // Two display and two SD claims, interleaved, while the display holds it
+    static Claim c[4] = {
+        { SPI_DEV_DISPLAY, 'a', 1000, false },
+        { SPI_DEV_SD, 'b', 1000, false },
+        { SPI_DEV_SD, 'c', 1000, false },
+        { SPI_DEV_DISPLAY, 'd', 1000, false },
+    };
+    for (int i = 0; i < 4; i++) claim_later(&c[i]);
+    spi_bus_release(SPI_DEV_DISPLAY);
+    vTaskDelay(pdMS_TO_TICKS(20));
+
+    grant_order[grant_count] = 0;
+    snprintf(line, sizeof(line), "claims a(lcd) b(sd) c(sd) d(lcd) granted %s", grant_order);
+    check(grant_count == 4 && grant_order[0] == 'b' && grant_order[1] == 'c' &&
+          grant_order[2] == 'a' && grant_order[3] == 'd', line);
+    check(wrong_clock == 0, "every owner found its own clock and mode");
+
+    spi_bus_get_stats(&after);
+    snprintf(line, sizeof(line), "%u reclocks for lcd, sd, sd, lcd, lcd", (unsigned)(after.reclocks - before.reclocks));
+    check(after.reclocks - before.reclocks == 3, line);
+    check(after.dev[SPI_DEV_SD].actual_hz == 12500000, "SD card at 12.50 MHz");
+    uint32_t sd_queued = after.dev[SPI_DEV_SD].queued - before.dev[SPI_DEV_SD].queued;
+    uint32_t lcd_queued = after.dev[SPI_DEV_DISPLAY].queued - before.dev[SPI_DEV_DISPLAY].queued;
+    snprintf(line, sizeof(line), "queued claims counted: lcd %u, sd %u; max wait lcd %u us, sd %u us",
+             (unsigned)lcd_queued, (unsigned)sd_queued,
+             (unsigned)after.dev[SPI_DEV_DISPLAY].max_wait_us, (unsigned)after.dev[SPI_DEV_SD].max_wait_us);
+    check(lcd_queued == 2 && sd_queued == 2 &&
+          after.dev[SPI_DEV_SD].max_wait_us < after.dev[SPI_DEV_DISPLAY].max_wait_us, line);
+}
+
+static void test_timeout() {
+    SpiBusStats before, after;
+    spi_bus_get_stats(&before);
+
+    spi_bus_acquire(SPI_DEV_SD, 0);
+    static Claim t = { SPI_DEV_DISPLAY, 't', 5, false };
+    claim_later(&t);
+    vTaskDelay(pdMS_TO_TICKS(10));
+    spi_bus_get_stats(&after);
+    check(!t.got && after.dev[SPI_DEV_DISPLAY].timeouts - before.dev[SPI_DEV_DISPLAY].timeouts == 1,
+          "display claim gives up after 5 ms");
+
+    spi_bus_release(SPI_DEV_SD);
+    bool free = spi_bus_acquire(SPI_DEV_DISPLAY, 0);
+    check(free, "bus free after the release: no stale waiter left");
+    if (free) spi_bus_release(SPI_DEV_DISPLAY);
+}
+
+static void test_isr_release() {
+    spi_bus_acquire(SPI_DEV_DISPLAY, 0);
+    static Claim s = { SPI_DEV_SD, 's', 1000, false };
+    claim_later(&s);
+
+    // DMA-complete IRQ at the end of a band
+    BaseType_t woken = pdFALSE;
+    spi_bus_release_from_isr(SPI_DEV_DISPLAY, &woken);
+    vTaskDelay(pdMS_TO_TICKS(5));
+    check(s.got && grant_order[grant_count - 1] == 's',
+          "release from the DMA IRQ grants the waiting SD claim");
+}
+
+// --- Display + SD load ---
+
+typedef struct {
+    uint32_t claims;
+    uint32_t timeouts;
+    uint32_t max_wait_ms;
+    uint32_t wrong_clock;   // Transaction on the other device's clock
+} ClientStats;
+
+static bool use_semaphore = false;
+static SemaphoreHandle_t sem_SPI0 = NULL;   // The previous scheme
+static volatile bool mixing = false;
+static int on_bus = 0;
+static int max_on_bus = 0;
+static SpiDeviceId last_dev = SPI_BUS_DEVICES;
+static uint32_t switches = 0;
+static TaskHandle_t dma_task = NULL;
+static ClientStats ui_stats, log_stats, profile_stats;
+
+static bool bus_take(SpiDeviceId id, uint32_t timeout_ms, ClientStats* cs) {
+    TickType_t t0 = xTaskGetTickCount();
+    bool ok = use_semaphore ? xSemaphoreTake(sem_SPI0, pdMS_TO_TICKS(timeout_ms)) == pdTRUE
+                            : spi_bus_acquire(id, timeout_ms);
+    uint32_t waited = (uint32_t)(xTaskGetTickCount() - t0) * portTICK_PERIOD_MS;
+    cs->claims++;
+    if (!ok) {
+        cs->timeouts++;
+        return false;
+    }
+    if (waited > cs->max_wait_ms) cs->max_wait_ms = waited;
+    if (sim_spi_bus_configured() != descriptor(id)) cs->wrong_clock++;
+    if (++on_bus > max_on_bus) max_on_bus = on_bus;
+    if (id != last_dev) switches++;
+    last_dev = id;
+    return true;
+}
+
+static void bus_give(SpiDeviceId id, bool from_isr) {
+    on_bus--;
+    BaseType_t woken = pdFALSE;
+    if (use_semaphore) {
+        if (from_isr) xSemaphoreGiveFromISR(sem_SPI0, &woken);
+        else xSemaphoreGive(sem_SPI0);
+    } else {
+        if (from_isr) spi_bus_release_from_isr(id, &woken);
+        else spi_bus_release(id);
+    }
+}
+
+// Plays the DMA engine + DMA-complete IRQ
+static void vDmaTask(void *pvParameters) {
+    (void)pvParameters;
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        vTaskDelay(pdMS_TO_TICKS(BAND_MS));
+        bus_give(SPI_DEV_DISPLAY, true);
+    }
+}
+
+// LVGL redrawing flat out: the next band is rendered while the last one
+// is on the wire, then queued behind it
+static void vUiTask(void *pvParameters) {
+    (void)pvParameters;
+    while (mixing) {
+        vTaskDelay(pdMS_TO_TICKS(RENDER_MS));
+        if (bus_take(SPI_DEV_DISPLAY, 100, &ui_stats)) xTaskNotifyGive(dma_task);
+    }
+    vTaskSuspend(NULL);
+}
+
+static void vSdTask(void *pvParameters) {
+    bool logger = pvParameters != NULL;
+    ClientStats* cs = logger ? &log_stats : &profile_stats;
+    while (mixing) {
+        vTaskDelay(pdMS_TO_TICKS(logger ? LOG_MS : PROFILE_MS));
+        if (bus_take(SPI_DEV_SD, 100, cs)) {
+            vTaskDelay(pdMS_TO_TICKS(logger ? 2 : 1));
+            bus_give(SPI_DEV_SD, false);
+        }
+    }
+    vTaskSuspend(NULL);
+}
+
+static void run_mix(bool semaphore, SpiBusStats* before, SpiBusStats* after) {
+    use_semaphore = semaphore;
+    ui_stats = ClientStats();
+    log_stats = ClientStats();
+    profile_stats = ClientStats();
+    max_on_bus = 0;
+    switches = 0;
+    last_dev = SPI_BUS_DEVICES;
+
+    spi_bus_get_stats(before);
+    mixing = true;
+    // Firmware priorities: UI 2 (core 1), run logger 1, profile reads from
+    // the control side 3
+    xTaskCreate(vUiTask, "UI", 1024, NULL, 2, NULL);
+    xTaskCreate(vSdTask, "Logger", 1024, (void*)1, 1, NULL);
+    xTaskCreate(vSdTask, "Profile", 1024, NULL, 3, NULL);
+    vTaskDelay(pdMS_TO_TICKS(MIX_MS));
+    mixing = false;
+    vTaskDelay(pdMS_TO_TICKS(300)); // Last transactions drain
+    spi_bus_get_stats(after);
+}
+
+static void print_client(const char* name, const ClientStats* cs) {
+    printf("    %-8s %5u claims, %3u timed out, max wait %3u ms, %u on the wrong clock\n", name,
+           (unsigned)cs->claims, (unsigned)cs->timeouts, (unsigned)cs->max_wait_ms, (unsigned)cs->wrong_clock);
+}
+
+static void test_mix() {
+    SpiBusStats before, after;
+    char line[128];
+
+    // Previous scheme: one binary semaphore, no reclocking
+    run_mix(true, &before, &after);
+    printf("binary semaphore (previous mtx_SPI0), %d s:\n", MIX_MS / 1000);
+    print_client("UI", &ui_stats);
+    print_client("logger", &log_stats);
+    print_client("profile", &profile_stats);
+    ClientStats old_log = log_stats;
+
+    run_mix(false, &before, &after);
+    printf("arbiter, %d s:\n", MIX_MS / 1000);
+    print_client("UI", &ui_stats);
+    print_client("logger", &log_stats);
+    print_client("profile", &profile_stats);
+
+    float elapsed = (float)(after.now_us - before.now_us);
+    float lcd_pct = 100.0f * (float)(after.dev[SPI_DEV_DISPLAY].busy_us - before.dev[SPI_DEV_DISPLAY].busy_us) / elapsed;
+    float sd_pct = 100.0f * (float)(after.dev[SPI_DEV_SD].busy_us - before.dev[SPI_DEV_SD].busy_us) / elapsed;
+    uint32_t sd_claims = log_stats.claims + profile_stats.claims;
+    uint32_t sd_queued = after.dev[SPI_DEV_SD].queued - before.dev[SPI_DEV_SD].queued;
+    printf("    bus busy: lcd %.1f %%, sd %.1f %%; %u of %u SD claims queued, avg wait %.1f ms; %u reclocks\n",
+           lcd_pct, sd_pct, (unsigned)sd_queued, (unsigned)sd_claims,
+           sd_queued ? (after.dev[SPI_DEV_SD].wait_us - before.dev[SPI_DEV_SD].wait_us) / 1000.0 / sd_queued : 0.0,
+           (unsigned)(after.reclocks - before.reclocks));
+
+    check(max_on_bus == 1, "one owner at a time");
+    snprintf(line, sizeof(line), "semaphore: logger below the UI task, %u of %u claims time out",
+             (unsigned)old_log.timeouts, (unsigned)old_log.claims);
+    check(old_log.timeouts > old_log.claims / 2, line);
+    check(log_stats.timeouts == 0 && profile_stats.timeouts == 0 && ui_stats.timeouts == 0, "arbiter: no claim times out");
+    uint32_t sd_max = (log_stats.max_wait_ms > profile_stats.max_wait_ms) ? log_stats.max_wait_ms : profile_stats.max_wait_ms;
+    snprintf(line, sizeof(line), "arbiter: SD wait max %u ms, one %d ms band + the other SD client", (unsigned)sd_max, BAND_MS);
+    check(sd_max <= BAND_MS + 2, line);
+    check(ui_stats.wrong_clock == 0 && log_stats.wrong_clock == 0 && profile_stats.wrong_clock == 0,
+          "arbiter: every transaction on its device's clock");
+    snprintf(line, sizeof(line), "reclocks %u = device switches %u", (unsigned)(after.reclocks - before.reclocks),
+             (unsigned)switches);
+    check(after.reclocks - before.reclocks == switches, line);
+    snprintf(line, sizeof(line), "display keeps %.1f %% of the bus", lcd_pct);
+    check(lcd_pct > 80.0f && lcd_pct + sd_pct <= 100.0f, line);
+}
+
+static void vMainTask(void *pvParameters) {
+    (void)pvParameters;
+    test_order();
+    test_timeout();
+    test_isr_release();
+    test_mix();
+
+    int status = check_summary();
+    fflush(stdout);
+    exit(status);
+}
+
+int main() {
+    spi_bus_init();
+    spi_bus_register(SPI_DEV_DISPLAY, &disp_dev);
+    spi_bus_register(SPI_DEV_SD, &sd_dev);
+    sem_SPI0 = xSemaphoreCreateBinary();
+    xSemaphoreGive(sem_SPI0);
+
+    xTaskCreate(vDmaTask, "DMA_IRQ", 1024, NULL, 4, &dma_task);
+    xTaskCreate(vMainTask, "Main", 4096, NULL, 3, NULL);
+    vTaskStartScheduler();
+    return 1;
+}
@@ -0,0 +1,33 @@
+#include "spi_bus_sim.h"
+
+static const SpiDevice* configured = NULL;
+static uint32_t port_hz = 0;
+
+void spi_bus_hw_init(void) {
+    configured = NULL;
+    port_hz = 1000 * 1000;
+}
+
+void spi_bus_hw_init_device(const SpiDevice* dev) {
+    (void)dev;
+}
+
+uint32_t spi_bus_hw_configure(const SpiDevice* dev) {
+    uint32_t div = 2;
+    while (SIM_SPI_CLK_PERI_HZ / div > dev->baud_hz) div += 2;
+    configured = dev;
+    port_hz = SIM_SPI_CLK_PERI_HZ / div;
+    return port_hz;
+}
+
+uint32_t spi_bus_time_us(void) {
+    return (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS * 1000u);
+}
+
+const SpiDevice* sim_spi_bus_configured(void) {
+    return configured;
+}
+
+uint32_t sim_spi_bus_hz(void) {
+    return port_hz;
+}
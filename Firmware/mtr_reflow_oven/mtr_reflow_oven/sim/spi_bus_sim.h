@@ -0,0 +1,17 @@
+#ifndef SPI_BUS_SIM_H
+#define SPI_BUS_SIM_H
+
+#include <stdint.h>
+#include "spi_bus.h"
+
+// Host hardware side of system/spi_bus.h: the port only records what it
+// was last configured for, with the RP2040 clock divider (125 MHz / even
+// divisor). Time is the FreeRTOS virtual tick.
+
+#define SIM_SPI_CLK_PERI_HZ 125000000u
+
+// Descriptor the port was last configured for, NULL before the first claim
+const SpiDevice* sim_spi_bus_configured(void);
+uint32_t sim_spi_bus_hz(void);
+
+#endif // SPI_BUS_SIM_H
@@ -0,0 +1,177 @@
+// Host contention benchmark for the oven state publication (control/oven_state.cpp).
+//
+// Three writer threads (sensor, PID, state machine) publish as fast as they
+// can while N reader threads take full snapshots. The same load is run
+// against the previous scheme: one OvenState behind a mutex (mtx_OvenState).
+// Every write stores the same counter in all fields of its channel, so a
+// reader can detect a torn copy.
+//
+// Usage: state_bench [seconds] [readers]
+
+#include "oven_state.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+
+using Clock = std::chrono::steady_clock;
+
+static std::atomic<bool> running;
+static std::mutex mode_writers; // Stands in for mtx_OvenState on the mode channel
+
+// --- Previous scheme: one struct, one mutex ---
+static std::mutex mtx_state;
+static OvenState locked_state;
+
+struct ReaderResult {
+    uint64_t reads;
+    uint64_t torn;
+    uint64_t blocked;   // Had to wait for another thread to release the lock
+    std::vector<uint32_t> latency_ns; // Sampled
+};
+
+static bool consistent(const OvenState& s) {
+    return s.current_temp_t1 == s.current_temp_t2 && s.current_temp_t1 == s.current_temp_amb &&
+           s.power_output_1 == s.power_output_2 &&
+           s.target_temp == (float)s.profile_start_time;
+}
+
+// --- Writers ---
+template <bool LOCKED>
+static void writer_temps() {
+    for (uint32_t n = 1; running.load(std::memory_order_relaxed); n++) {
+        float v = (float)(n & 0xFFFFF);
+        if (LOCKED) {
+            std::lock_guard<std::mutex> lock(mtx_state);
+            locked_state.current_temp_t1 = v;
+            locked_state.current_temp_t2 = v;
+            locked_state.current_temp_amb = v;
+        } else {
+            OvenTemps t = {};
+            t.t1 = t.t2 = t.amb = v;
+            t.t2_connected = true;
+            oven_state_publish_temps(&t);
+        }
+    }
+}
+
+template <bool LOCKED>
+static void writer_outputs() {
+    for (uint32_t n = 1; running.load(std::memory_order_relaxed); n++) {
+        float v = (float)(n & 0xFFFFF);
+        if (LOCKED) {
+            std::lock_guard<std::mutex> lock(mtx_state);
+            locked_state.power_output_1 = v;
+            locked_state.power_output_2 = v;
+        } else {
+            OvenOutputs o = { v, v };
+            oven_state_publish_outputs(&o);
+        }
+    }
+}
+
+template <bool LOCKED>
+static void writer_mode() {
+    for (uint32_t n = 1; running.load(std::memory_order_relaxed); n++) {
+        uint32_t v = n & 0xFFFFF;
+        if (LOCKED) {
+            std::lock_guard<std::mutex> lock(mtx_state);
+            locked_state.target_temp = (float)v;
+            locked_state.profile_start_time = v;
+        } else {
+            std::lock_guard<std::mutex> lock(mode_writers);
+            OvenMode m = oven_state_mode();
+            m.state = STATE_RUNNING;
+            m.target_temp = (float)v;
+            m.profile_start_time = v;
+            oven_state_publish_mode(&m);
+        }
+    }
+}
+
+// --- Readers ---
+template <bool LOCKED>
+static void reader(ReaderResult* r) {
+    r->reads = 0;
+    r->torn = 0;
+    r->blocked = 0;
+    r->latency_ns.reserve(1 << 20);
+    while (running.load(std::memory_order_relaxed)) {
+        OvenState s;
+        Clock::time_point t0 = Clock::now();
+        if (LOCKED) {
+            if (!mtx_state.try_lock()) {
+                r->blocked++;
+                mtx_state.lock();
+            }
+            s = locked_state;
+            mtx_state.unlock();
+        } else {
+            oven_state_read(&s);
+        }
+        Clock::time_point t1 = Clock::now();
+
+        if (!consistent(s)) r->torn++;
+        if ((r->reads & 15) == 0 && r->latency_ns.size() < r->latency_ns.capacity()) {
+            r->latency_ns.push_back((uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+        }
+        r->reads++;
+    }
+}
+
+template <bool LOCKED>
+static void run(const char* name, double seconds, int readers) {
+    oven_state_init();
+    locked_state = OvenState();
+    uint32_t retries_before = oven_state_read_retries();
+
+    std::vector<ReaderResult> results(readers);
+    std::vector<std::thread> threads;
+    running = true;
+    threads.emplace_back(writer_temps<LOCKED>);
+    threads.emplace_back(writer_outputs<LOCKED>);
+    threads.emplace_back(writer_mode<LOCKED>);
+    for (int i = 0; i < readers; i++) threads.emplace_back(reader<LOCKED>, &results[i]);
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    running = false;
+    for (auto& t : threads) t.join();
+
+    uint64_t reads = 0, torn = 0, blocked = 0;
+    std::vector<uint32_t> lat;
+    for (auto& r : results) {
+        reads += r.reads;
+        torn += r.torn;
+        blocked += r.blocked;
+        lat.insert(lat.end(), r.latency_ns.begin(), r.latency_ns.end());
+    }
+    std::sort(lat.begin(), lat.end());
+    double mean = 0;
+    for (uint32_t v : lat) mean += v;
+    mean = lat.empty() ? 0 : mean / lat.size();
+    uint32_t p99 = lat.empty() ? 0 : lat[(lat.size() * 99) / 100];
+    uint32_t p999 = lat.empty() ? 0 : lat[(lat.size() * 999) / 1000];
+    uint32_t max = lat.empty() ? 0 : lat.back();
+
+    printf("%-16s %6.2f M reads/s | mean %5.0f ns p99 %6u ns p99.9 %8u ns max %9u ns | torn %llu | ",
+           name, reads / seconds / 1e6, mean, p99, p999, max, (unsigned long long)torn);
+    if (LOCKED) printf("blocked %llu (%.3f %%)\n", (unsigned long long)blocked, reads ? 100.0 * blocked / reads : 0.0);
+    else printf("retries %u, never blocked\n", oven_state_read_retries() - retries_before);
+}
+
+int main(int argc, char** argv) {
+    double seconds = (argc > 1) ? atof(argv[1]) : 1.0;
+    int readers = (argc > 2) ? atoi(argv[2]) : 4;
+    if (seconds <= 0) seconds = 1.0;
+    if (readers <= 0) readers = 4;
+
+    printf("state_bench: %.1f s, 3 writers flat out, %d readers, %u host threads\n",
+           seconds, readers, std::thread::hardware_concurrency());
+    run<true>("mutex + copy", seconds, readers);
+    run<false>("latch channels", seconds, readers);
+    return 0;
+}
@@ -0,0 +1,218 @@
+// Host benchmark for the change-driven UI binding (ui/ui_model.cpp).
+// Replays a reflow ramp through a dashboard-like screen at the UI task's
+// 5 ms loop, once with the old per-loop updates (every label set, chart
+// refreshed on each loop) and once with the labels bound to the model
+// subjects, and counts the frames and dirty pixels sent to the display.
+//
+// The control loop publishes at 10 Hz, so most UI loops see the same
+// state. Each loop runs lv_timer_handler() like ui_tick(): the refresh
+// timer (LV_DEF_REFR_PERIOD) caps the frame rate as on target. Bus time
+// is modelled from the flushed pixels (RGB565).
+//
+// Usage: ui_bind_bench [seconds] [spi_hz]
+
+#include "lvgl.h"
+#include "ui_model.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#define HOR_RES      480
+#define VER_RES      320
+#define BUF_LINES    20
+#define UI_LOOP_MS   5
+#define CONTROL_MS   100
+#define DURATION_S   300    // Profile length on the chart's X axis
+
+using Clock = std::chrono::steady_clock;
+
+ReflowProfile currentProfile; // ui_model.cpp reads the name
+
+static uint32_t now_ms = 0;
+static uint32_t bench_tick(void) { return now_ms; }
+
+static uint64_t flushed_px = 0;
+static uint32_t flushes = 0;
+
+static void count_flush(lv_display_t* disp, const lv_area_t* area, uint8_t* px_map) {
+    (void)px_map;
+    flushed_px += (uint64_t)lv_area_get_width(area) * lv_area_get_height(area);
+    flushes++;
+    lv_display_flush_ready(disp);
+}
+
+static lv_obj_t* chart;
+static lv_chart_series_t* ser_temp;
+static lv_chart_series_t* ser_target;
+static lv_obj_t* lbl_status;
+static lv_obj_t* lbl_current;
+static lv_obj_t* lbl_target;
+
+static const char* state_name(int32_t state) {
+    switch (state) {
+        case STATE_IDLE:     return "IDLE";
+        case STATE_RUNNING:  return "RUNNING";
+        case STATE_COOLDOWN: return "COOLING";
+        default:             return "UNKNOWN";
+    }
+}
+
+static void status_cb(lv_observer_t* observer, lv_subject_t* subject) {
+    (void)subject;
+    lv_label_set_text_fmt(lv_observer_get_target_obj(observer), "%s - %s",
+                          lv_subject_get_string(&ui_subject_profile),
+                          state_name(lv_subject_get_int(&ui_subject_state)));
+}
+
+static void create_scene(bool bound) {
+    lv_obj_t* scr = lv_obj_create(NULL);
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x111111), 0);
+
+    lv_obj_t* top_bar = lv_obj_create(scr);
+    lv_obj_set_size(top_bar, 480, 50);
+    lv_obj_align(top_bar, LV_ALIGN_TOP_MID, 0, 0);
+    lbl_status = lv_label_create(top_bar);
+    lv_obj_center(lbl_status);
+
+    chart = lv_chart_create(scr);
+    lv_obj_set_size(chart, 440, 200);
+    lv_obj_align(chart, LV_ALIGN_CENTER, 0, 20);
+    lv_chart_set_type(chart, LV_CHART_TYPE_LINE);
+    lv_chart_set_range(chart, LV_CHART_AXIS_PRIMARY_Y, 0, 300);
+    lv_chart_set_point_count(chart, 100);
+    lv_chart_set_div_line_count(chart, 5, 7);
+    ser_temp = lv_chart_add_series(chart, lv_color_hex(0xFF4444), LV_CHART_AXIS_PRIMARY_Y);
+    ser_target = lv_chart_add_series(chart, lv_color_hex(0x44FF44), LV_CHART_AXIS_PRIMARY_Y);
+    for (int i = 0; i < 100; i++) {
+        lv_chart_set_value_by_id(chart, ser_target, i, (int32_t)(25 + (i * 220) / 99));
+        lv_chart_set_value_by_id(chart, ser_temp, i, LV_CHART_POINT_NONE);
+    }
+
+    lbl_current = lv_label_create(scr);
+    lv_obj_set_style_text_font(lbl_current, &lv_font_montserrat_20, 0);
+    lv_obj_align(lbl_current, LV_ALIGN_BOTTOM_LEFT, 20, -10);
+
+    lbl_target = lv_label_create(scr);
+    lv_obj_set_style_text_font(lbl_target, &lv_font_montserrat_20, 0);
+    lv_obj_align(lbl_target, LV_ALIGN_BOTTOM_RIGHT, -20, -10);
+
+    if (bound) {
+        ui_model_bind_tenths(lbl_current, &ui_subject_temp, "T: %.1f C");
+        lv_label_bind_text(lbl_target, &ui_subject_setpoint, "Set: %d C");
+        lv_subject_add_observer_obj(&ui_subject_state, status_cb, lbl_status, NULL);
+        lv_subject_add_observer_obj(&ui_subject_profile, status_cb, lbl_status, NULL);
+    }
+
+    lv_obj_t* old = lv_screen_active();
+    lv_screen_load(scr);
+    lv_obj_delete(old); // Observers of the previous run go with it
+}
+
+// Oven published by the control loop: 2 s idle, then a 1 C/s ramp that
+// T1 follows with a lag and +-0.15 C of sensor noise
+static uint32_t rng = 1;
+
+static void oven_step(OvenState* st, uint32_t t_ms) {
+    rng = rng * 1103515245u + 12345u;
+    float noise = ((float)((rng >> 16) & 0x7FFF) / 32767.0f - 0.5f) * 0.3f;
+    bool running = t_ms >= 2000;
+    float run_s = running ? (t_ms - 2000) / 1000.0f : 0.0f;
+
+    st->state = running ? STATE_RUNNING : STATE_IDLE;
+    st->target_temp = running ? fminf(25.0f + run_s, 245.0f) : 0.0f;
+    float goal = running ? st->target_temp : 25.0f;
+    st->current_temp_amb += (goal - st->current_temp_amb) * (CONTROL_MS / 8000.0f); // Plant, lagged
+    st->current_temp_t1 = st->current_temp_amb + noise;
+    float p = running ? 20.0f + 8.0f * (st->target_temp - st->current_temp_t1) : 0.0f;
+    st->power_output_1 = fminf(fmaxf(p, 0.0f), 100.0f);
+    st->power_output_2 = st->power_output_1;
+    st->profile_start_time = 2000;
+}
+
+static int chart_index(const OvenState* st) {
+    uint32_t elapsed = (now_ms - st->profile_start_time) / 1000;
+    if (elapsed > DURATION_S) elapsed = DURATION_S;
+    return (int)((elapsed * 99) / DURATION_S);
+}
+
+// Before: the old ui_screen_dashboard_update(), on every loop
+static void update_polled(const OvenState* st) {
+    lv_label_set_text_fmt(lbl_current, "T: %.1f C", st->current_temp_t1);
+    lv_label_set_text_fmt(lbl_target, "Set: %.0f C", st->target_temp);
+    lv_label_set_text_fmt(lbl_status, "%s - %s", currentProfile.name, state_name(st->state));
+    if (st->state == STATE_RUNNING) {
+        lv_chart_set_value_by_id(chart, ser_temp, chart_index(st), (int32_t)st->current_temp_t1);
+        lv_chart_refresh(chart);
+    }
+}
+
+// After: subjects, and the red line only on a new index or degree
+static int plotted_idx = -1;
+static int32_t plotted_temp;
+
+static void update_bound(const OvenState* st) {
+    ui_model_update(st);
+    if (st->state == STATE_RUNNING) {
+        int idx = chart_index(st);
+        int32_t temp = (int32_t)st->current_temp_t1;
+        if (idx != plotted_idx || temp != plotted_temp) {
+            lv_chart_set_value_by_id(chart, ser_temp, idx, temp);
+            plotted_idx = idx;
+            plotted_temp = temp;
+        }
+    }
+}
+
+static void run(const char* name, lv_display_t* disp, bool bound, uint32_t seconds, uint32_t spi_hz) {
+    create_scene(bound);
+    now_ms = 0;
+    rng = 1;
+    plotted_idx = -1;
+    OvenState st = {};
+    st.current_temp_amb = 25.0f;
+    lv_refr_now(disp); // First full frame, not counted
+    flushed_px = 0;
+    flushes = 0;
+
+    uint32_t frames = 0;
+    uint32_t loops = seconds * 1000 / UI_LOOP_MS;
+    Clock::time_point t0 = Clock::now();
+    for (uint32_t i = 0; i < loops; i++) {
+        now_ms = i * UI_LOOP_MS;
+        if (now_ms % CONTROL_MS == 0) oven_step(&st, now_ms);
+        if (bound) update_bound(&st); else update_polled(&st);
+        uint32_t before = flushes;
+        lv_timer_handler();
+        if (flushes != before) frames++;
+    }
+    double cpu_ms = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - t0).count() / 1000.0;
+
+    double bus_ms = flushed_px * 16.0 * 1000.0 / spi_hz;
+    printf("%-22s %6u frames (%5.1f /s) | %8.1f kpx/s | %6.0f px/frame | bus %6.1f ms/s (%4.1f %%) | host cpu %7.1f ms\n",
+           name, frames, (double)frames / seconds, flushed_px / 1000.0 / seconds,
+           frames ? (double)flushed_px / frames : 0.0, bus_ms / seconds, bus_ms / seconds / 10.0, cpu_ms);
+}
+
+int main(int argc, char** argv) {
+    uint32_t seconds = (argc > 1) ? (uint32_t)atoi(argv[1]) : 60;
+    uint32_t spi_hz = (argc > 2) ? (uint32_t)atoi(argv[2]) : 40000000;
+    if (seconds == 0) seconds = 60;
+
+    lv_init();
+    lv_tick_set_cb(bench_tick);
+    lv_display_t* disp = lv_display_create(HOR_RES, VER_RES);
+    static uint8_t buf1[HOR_RES * BUF_LINES * 2];
+    static uint8_t buf2[HOR_RES * BUF_LINES * 2];
+    lv_display_set_buffers(disp, buf1, buf2, sizeof(buf1), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(disp, count_flush);
+
+    ui_model_init();
+    snprintf(currentProfile.name, sizeof(currentProfile.name), "Sn63Pb37");
+
+    printf("ui_bind_bench: %u s of oven time, UI loop %u ms, control %u ms, SPI %.1f MHz\n",
+           seconds, UI_LOOP_MS, CONTROL_MS, spi_hz / 1e6);
+    run("per-loop set_text", disp, false, seconds, spi_hz);
+    run("subjects (ui_model)", disp, true, seconds, spi_hz);
+    return 0;
+}
@@ -0,0 +1,500 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <cstring>
+#include <cstddef>
+#include "profile_store.h"
+#include "spi_bus.h"
+
+#define PROFILE_INDEX_PATH  PROFILE_STORE_DIR "/index.bin"
+#define PROFILE_INDEX_TMP   PROFILE_STORE_DIR "/index.tmp"
+#define PROFILE_HANDLES     2   // Current profile and the one being loaded
+#define STALE_BLOBS_MAX     8   // Deleted per refresh, the rest on the next one
+
+// Index file: header and entries[count], read and written in one transfer
+typedef struct {
+    char magic[8];          // PROFILE_INDEX_MAGIC
+    uint16_t version;
+    uint16_t entry_size;    // sizeof(ProfileIndexEntry)
+    uint32_t count;
+    ProfileIndexEntry entries[PROFILE_INDEX_MAX];
+} ProfileIndexFile;
+
+#define INDEX_HEADER_SIZE   offsetof(ProfileIndexFile, entries)
+
+typedef struct {
+    FIL file;
+    bool open;
+    uint32_t blob_id;
+    ProfileBinSource source;
+} BlobHandle;
+
+enum {
+    COMPILE_OK,
+    COMPILE_INVALID,    // Rejected by the parser: indexed as such
+    COMPILE_IO          // Card error: retried on the next refresh
+};
+
+static ProfileIndexFile index_file;
+static bool index_loaded = false;
+static WORD volume_id = 0;          // FatFs mount the index belongs to
+static uint32_t generation = 0;
+static volatile bool stale = false;
+static bool full_reported = false;
+
+static BlobHandle handles[PROFILE_HANDLES];
+static FIL work_file;               // Index and blob being written
+
+static bool take_bus() {
+    return spi_bus_acquire(SPI_DEV_SD, 500);
+}
+
+static void give_bus() {
+    spi_bus_release(SPI_DEV_SD);
+}
+
+// --- JSON Source ---
+
+bool sd_json_open(SdJsonFile* f, const char* path) {
+    if (!take_bus()) return false;
+    bool ok = (f_open(&f->file, path, FA_READ) == FR_OK);
+    give_bus();
+    return ok;
+}
+
+int sd_json_read(void* f, char* buf, size_t max) {
+    SdJsonFile* s = (SdJsonFile*)f;
+    if (!take_bus()) return -1;
+    UINT read_bytes = 0;
+    FRESULT fr = f_read(&s->file, buf, (UINT)max, &read_bytes);
+    give_bus();
+    return (fr == FR_OK) ? (int)read_bytes : -1;
+}
+
+void sd_json_close(SdJsonFile* f) {
+    if (!take_bus()) return;
+    f_close(&f->file);
+    give_bus();
+}
+
+// --- Blob Files ---
+
+static bool file_read(void* file, uint32_t offset, void* data, uint32_t len) {
+    if (!take_bus()) return false;
+    UINT n = 0;
+    FRESULT fr = f_lseek((FIL*)file, offset);
+    if (fr == FR_OK) fr = f_read((FIL*)file, data, len, &n);
+    give_bus();
+    return fr == FR_OK && n == len;
+}
+
+static bool file_write(void* file, uint32_t offset, const void* data, uint32_t len) {
+    if (!take_bus()) return false;
+    UINT n = 0;
+    FRESULT fr = f_lseek((FIL*)file, offset);
+    if (fr == FR_OK) fr = f_write((FIL*)file, data, len, &n);
+    give_bus();
+    return fr == FR_OK && n == len;
+}
+
+static void blob_path(uint32_t id, char* path, size_t size) {
+    snprintf(path, size, PROFILE_STORE_DIR "/%08lx.bin", (unsigned long)id);
+}
+
+// FNV-1a over the cache key: same name, size and mtime, same blob
+static uint32_t blob_id_of(const FILINFO* fno) {
+    uint32_t h = 2166136261u;
+    for (const char* c = fno->fname; *c; c++) h = (h ^ (uint8_t)*c) * 16777619u;
+    uint32_t key[3] = { (uint32_t)fno->fsize, fno->fdate, fno->ftime };
+    const uint8_t* b = (const uint8_t*)key;
+    for (size_t i = 0; i < sizeof(key); i++) h = (h ^ b[i]) * 16777619u;
+    return h ? h : 1; // 0: no blob
+}
+
+static bool ends_with(const char* s, const char* suffix) {
+    size_t n = strlen(s), m = strlen(suffix);
+    if (n <= m) return false;
+    s += n - m;
+    for (size_t i = 0; i < m; i++) {
+        char c = s[i];
+        if (c >= 'A' && c <= 'Z') c += 'a' - 'A';
+        if (c != suffix[i]) return false;
+    }
+    return true;
+}
+
+// A blob left by an earlier index (lost or rebuilt), complete and current
+static bool blob_reuse(uint32_t id, ProfileBinHeader* header) {
+    char path[32];
+    blob_path(id, path, sizeof(path));
+    if (!take_bus()) return false;
+    bool ok = (f_open(&work_file, path, FA_READ) == FR_OK);
+    give_bus();
+    if (!ok) return false;
+
+    ProfileBinSource src = { file_read, &work_file };
+    ProfileTimeline timeline;
+    ok = profile_bin_open(&src, header, &timeline) &&
+         f_size(&work_file) >= sizeof(ProfileBinHeader) + header->segment_count * sizeof(TimelineSegment);
+    if (take_bus()) {
+        f_close(&work_file);
+        give_bus();
+    }
+    return ok;
+}
+
+static int blob_compile(const char* json_path, uint32_t id, ProfileBinHeader* header) {
+    static SdJsonFile json;
+    if (!sd_json_open(&json, json_path)) return COMPILE_IO;
+
+    char path[32];
+    blob_path(id, path, sizeof(path));
+    FRESULT fr = FR_TIMEOUT;
+    if (take_bus()) {
+        f_mkdir(PROFILE_STORE_DIR); // FR_EXIST once created
+        fr = f_open(&work_file, path, FA_READ | FA_WRITE | FA_CREATE_ALWAYS);
+        give_bus();
+    }
+    if (fr != FR_OK) {
+        printf("[Profile] Cannot create %s (%d)\n", path, fr);
+        sd_json_close(&json);
+        return COMPILE_IO;
+    }
+
+    JsonError err;
+    bool ok = profile_bin_compile(sd_json_read, &json, file_write, &work_file, header, &err);
+    sd_json_close(&json);
+    fr = FR_TIMEOUT;
+    if (take_bus()) {
+        fr = f_close(&work_file);
+        if (!ok || fr != FR_OK) f_unlink(path);
+        give_bus();
+    }
+    if (!ok) {
+        printf("%s:%lu:%lu: %s\n", json_path, (unsigned long)err.line, (unsigned long)err.column, err.message);
+        return err.io ? COMPILE_IO : COMPILE_INVALID;
+    }
+    return (fr == FR_OK) ? COMPILE_OK : COMPILE_IO;
+}
+
+static bool blob_referenced(uint32_t id) {
+    for (uint32_t i = 0; i < index_file.count; i++) {
+        const ProfileIndexEntry* e = &index_file.entries[i];
+        if (e->status == PROFILE_ENTRY_OK && e->blob_id == id) return true;
+    }
+    for (int i = 0; i < PROFILE_HANDLES; i++) {
+        if (handles[i].open && handles[i].blob_id == id) return true;
+    }
+    return false;
+}
+
+// Blobs of edited or removed profiles, except one a timeline still reads
+static void remove_stale_blobs() {
+    static DIR dir;
+    static FILINFO fno;
+    uint32_t ids[STALE_BLOBS_MAX];
+    uint32_t count = 0;
+
+    if (!take_bus()) return;
+    FRESULT fr = f_opendir(&dir, PROFILE_STORE_DIR);
+    give_bus();
+    if (fr != FR_OK) return;
+
+    while (count < STALE_BLOBS_MAX) {
+        if (!take_bus()) break;
+        fr = f_readdir(&dir, &fno);
+        give_bus();
+        if (fr != FR_OK || fno.fname[0] == 0) break;
+
+        char* end;
+        uint32_t id = (uint32_t)strtoul(fno.fname, &end, 16);
+        if (end != fno.fname + 8 || strlen(fno.fname) != 12 || !ends_with(fno.fname, ".bin")) continue; // index.bin
+        if (!blob_referenced(id)) ids[count++] = id;
+    }
+
+    if (!take_bus()) return;
+    f_closedir(&dir);
+    for (uint32_t i = 0; i < count; i++) {
+        char path[32];
+        blob_path(ids[i], path, sizeof(path));
+        f_unlink(path);
+    }
+    give_bus();
+}
+
+// --- Index ---
+
+static void index_read() {
+    index_file.count = 0;
+    if (!take_bus()) return;
+    UINT n = 0;
+    FRESULT fr = f_open(&work_file, PROFILE_INDEX_PATH, FA_READ);
+    if (fr == FR_OK) {
+        fr = f_read(&work_file, &index_file, sizeof(index_file), &n);
+        f_close(&work_file);
+    }
+    give_bus();
+
+    bool ok = fr == FR_OK && n >= INDEX_HEADER_SIZE &&
+              memcmp(index_file.magic, PROFILE_INDEX_MAGIC, sizeof(PROFILE_INDEX_MAGIC)) == 0 &&
+              index_file.version == PROFILE_INDEX_VERSION &&
+              index_file.entry_size == sizeof(ProfileIndexEntry) &&
+              index_file.count <= PROFILE_INDEX_MAX &&
+              n == INDEX_HEADER_SIZE + index_file.count * sizeof(ProfileIndexEntry);
+    if (!ok) index_file.count = 0; // Rebuilt from the blobs still on the card
+    for (uint32_t i = 0; i < index_file.count; i++) {
+        ProfileIndexEntry* e = &index_file.entries[i];
+        e->file[sizeof(e->file) - 1] = 0;
+        e->name[sizeof(e->name) - 1] = 0;
+        e->alloy[sizeof(e->alloy) - 1] = 0;
+    }
+}
+
+// Written aside and renamed: a power loss leaves the previous index or none
+static void index_write() {
+    memset(index_file.magic, 0, sizeof(index_file.magic));
+    memcpy(index_file.magic, PROFILE_INDEX_MAGIC, sizeof(PROFILE_INDEX_MAGIC));
+    index_file.version = PROFILE_INDEX_VERSION;
+    index_file.entry_size = sizeof(ProfileIndexEntry);
+    UINT len = INDEX_HEADER_SIZE + index_file.count * sizeof(ProfileIndexEntry);
+
+    if (!take_bus()) return;
+    f_mkdir(PROFILE_STORE_DIR);
+    UINT n = 0;
+    FRESULT fr = f_open(&work_file, PROFILE_INDEX_TMP, FA_WRITE | FA_CREATE_ALWAYS);
+    if (fr == FR_OK) {
+        fr = f_write(&work_file, &index_file, len, &n);
+        FRESULT fc = f_close(&work_file);
+        if (fr == FR_OK && n != len) fr = FR_DENIED; // Card full
+        if (fr == FR_OK) fr = fc;
+    }
+    if (fr == FR_OK) {
+        f_unlink(PROFILE_INDEX_PATH); // FR_NO_FILE the first time
+        fr = f_rename(PROFILE_INDEX_TMP, PROFILE_INDEX_PATH);
+    }
+    give_bus();
+    if (fr != FR_OK) printf("[Profile] Cannot write " PROFILE_INDEX_PATH " (%d)\n", fr);
+}
+
+static ProfileIndexEntry* index_find(const char* file) {
+    for (uint32_t i = 0; i < index_file.count; i++) {
+        if (strcmp(index_file.entries[i].file, file) == 0) return &index_file.entries[i];
+    }
+    return NULL;
+}
+
+static bool entry_current(const ProfileIndexEntry* e, const FILINFO* fno) {
+    return e->size == (uint32_t)fno->fsize && e->fdate == fno->fdate && e->ftime == fno->ftime;
+}
+
+// Entry of PROFILE_DIR/<fno->fname>, compiled first if the file changed.
+// NULL after a card error, or when the name or the index is too long.
+static ProfileIndexEntry* index_update(const FILINFO* fno, bool* changed) {
+    ProfileIndexEntry* e = index_find(fno->fname);
+    if (e && entry_current(e, fno)) return e;
+    if (strlen(fno->fname) >= PROFILE_FILE_MAX) return NULL;
+    if (!e && index_file.count >= PROFILE_INDEX_MAX) {
+        if (!full_reported) printf("[Profile] Index full (%d), %s not listed\n", PROFILE_INDEX_MAX, fno->fname);
+        full_reported = true;
+        return NULL;
+    }
+
+    char json_path[sizeof(PROFILE_DIR) + PROFILE_FILE_MAX];
+    snprintf(json_path, sizeof(json_path), PROFILE_DIR "/%.*s", PROFILE_FILE_MAX - 1, fno->fname);
+    uint32_t id = blob_id_of(fno);
+    ProfileBinHeader header;
+    int result = blob_reuse(id, &header) ? COMPILE_OK : blob_compile(json_path, id, &header);
+    if (result == COMPILE_IO) return NULL;
+
+    if (!e) e = &index_file.entries[index_file.count++];
+    memset(e, 0, sizeof(*e));
+    strncpy(e->file, fno->fname, sizeof(e->file) - 1);
+    e->size = (uint32_t)fno->fsize;
+    e->fdate = fno->fdate;
+    e->ftime = fno->ftime;
+    if (result == COMPILE_OK) {
+        e->status = PROFILE_ENTRY_OK;
+        e->blob_id = id;
+        memcpy(e->name, header.name, sizeof(e->name));
+        memcpy(e->alloy, header.alloy, sizeof(e->alloy));
+        e->peak_temp = header.peak_temp;
+        e->duration_s = (header.total_ms + 500) / 1000;
+        e->segment_count = header.segment_count;
+    } else {
+        e->status = PROFILE_ENTRY_INVALID;
+        strncpy(e->name, fno->fname, sizeof(e->name) - 1);
+    }
+    *changed = true;
+    return e;
+}
+
+static void index_changed() {
+    index_write();
+    remove_stale_blobs();
+    generation++;
+}
+
+// --- Refresh ---
+
+ProfileStoreScan profile_store_refresh() {
+    static DIR dir;
+    static FILINFO fno;
+    static bool seen[PROFILE_INDEX_MAX];
+    stale = false;
+
+    if (!take_bus()) {
+        stale = true; // Next poll
+        return PROFILE_STORE_UNCHANGED;
+    }
+    FRESULT fr = f_opendir(&dir, PROFILE_DIR);
+    if (fr == FR_NO_PATH && f_mkdir(PROFILE_DIR) == FR_OK) fr = f_opendir(&dir, PROFILE_DIR);
+    give_bus();
+    if (fr != FR_OK) return PROFILE_STORE_NO_CARD;
+
+    // Every mount gets a new id: after a card swap the index, and the
+    // files the handles had open, belong to the previous card
+    bool new_volume = !index_loaded || dir.obj.id != volume_id;
+    if (new_volume) {
+        for (int i = 0; i < PROFILE_HANDLES; i++) handles[i].open = false;
+        index_read();
+        index_loaded = true;
+        volume_id = dir.obj.id;
+        full_reported = false;
+    }
+
+    memset(seen, 0, sizeof(seen));
+    bool changed = false;
+    bool card_error = false;
+    for (;;) {
+        if (!take_bus()) break;
+        fr = f_readdir(&dir, &fno);
+        give_bus();
+        if (fr != FR_OK) card_error = true;
+        if (fr != FR_OK || fno.fname[0] == 0) break;
+        if ((fno.fattrib & AM_DIR) || !ends_with(fno.fname, ".json")) continue;
+
+        ProfileIndexEntry* e = index_update(&fno, &changed);
+        if (e) seen[e - index_file.entries] = true;
+    }
+    if (take_bus()) {
+        f_closedir(&dir);
+        give_bus();
+    }
+    if (card_error) return PROFILE_STORE_NO_CARD;
+
+    // Removed profiles (and ones that failed to compile this time)
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < index_file.count; i++) {
+        if (seen[i]) index_file.entries[kept++] = index_file.entries[i];
+    }
+    if (kept != index_file.count) changed = true;
+    index_file.count = kept;
+
+    if (changed) {
+        index_changed();
+        printf("[Profile] Index: %lu profiles\n", (unsigned long)index_file.count);
+    } else if (new_volume) {
+        generation++;
+    }
+    if (new_volume) return PROFILE_STORE_NEW_VOLUME;
+    return changed ? PROFILE_STORE_UPDATED : PROFILE_STORE_UNCHANGED;
+}
+
+void profile_store_forget() {
+    index_loaded = false;
+    index_file.count = 0;
+    for (int i = 0; i < PROFILE_HANDLES; i++) handles[i].open = false;
+    generation++;
+}
+
+void profile_store_invalidate() {
+    stale = true;
+}
+
+bool profile_store_stale() {
+    return stale;
+}
+
+uint32_t profile_store_generation() {
+    return generation;
+}
+
+uint32_t profile_store_count() {
+    return index_file.count;
+}
+
+const ProfileIndexEntry* profile_store_entry(uint32_t i) {
+    return (i < index_file.count) ? &index_file.entries[i] : NULL;
+}
+
+// --- Loading ---
+
+static void handle_close(BlobHandle* h) {
+    if (!h->open || !take_bus()) return;
+    f_close(&h->file);
+    h->open = false;
+    give_bus();
+}
+
+// Opens the blob and checks its header: false if it is missing or was
+// compiled by another firmware version
+static bool handle_open(BlobHandle* h, uint32_t id, ProfileBinHeader* header, ProfileTimeline* timeline) {
+    char path[32];
+    blob_path(id, path, sizeof(path));
+    if (!take_bus()) return false;
+    h->open = (f_open(&h->file, path, FA_READ) == FR_OK);
+    give_bus();
+    h->blob_id = id;
+    h->source.read = file_read;
+    h->source.file = &h->file;
+    if (h->open && !profile_bin_open(&h->source, header, timeline)) handle_close(h);
+    return h->open;
+}
+
+bool profile_store_load(const char* json_path, const ProfileTimeline* current,
+                        ReflowProfile* profile, ProfileTimeline* timeline) {
+    static FILINFO fno;
+    const char* file = json_path + strlen(PROFILE_DIR "/");
+    if (strncmp(json_path, PROFILE_DIR "/", strlen(PROFILE_DIR "/")) != 0 || strchr(file, '/')) {
+        printf("[Profile] %s: not in " PROFILE_DIR "\n", json_path);
+        return false;
+    }
+    if (!index_loaded && profile_store_refresh() == PROFILE_STORE_NO_CARD) return false;
+
+    if (!take_bus()) return false;
+    FRESULT fr = f_stat(json_path, &fno);
+    give_bus();
+    if (fr != FR_OK) {
+        printf("[Profile] %s not found (%d)\n", json_path, fr);
+        return false;
+    }
+
+    // The handle behind current keeps serving it until the caller swaps
+    BlobHandle* h = &handles[(current->src == &handles[0].source) ? 1 : 0];
+    handle_close(h);
+
+    bool changed = false;
+    ProfileBinHeader header;
+    ProfileIndexEntry* e = index_update(&fno, &changed);
+    if (e && e->status == PROFILE_ENTRY_OK && !handle_open(h, e->blob_id, &header, timeline)) {
+        // Blob deleted behind the index (cache cleared) or from an older
+        // firmware: compile it again
+        e->size = 0xFFFFFFFFu;
+        e = index_update(&fno, &changed);
+        if (e && e->status == PROFILE_ENTRY_OK) handle_open(h, e->blob_id, &header, timeline);
+    }
+    if (changed) index_changed();
+    if (!e) return false;
+    if (e->status != PROFILE_ENTRY_OK) {
+        printf("[Profile] %s: invalid profile\n", json_path);
+        return false;
+    }
+    if (!h->open) {
+        printf("[Profile] %s: compiled profile unreadable\n", json_path);
+        return false;
+    }
+
+    profile_bin_summary(&header, profile);
+    printf("[Profile] %s: %lu segments, %lu s\n", json_path,
+           (unsigned long)header.segment_count, (unsigned long)(header.total_ms / 1000));
+    return true;
+}
@@ -0,0 +1,88 @@
+#ifndef PROFILE_STORE_H
+#define PROFILE_STORE_H
+
+#include <stddef.h>
+#include "ff.h"
+#include "../project_defs.h"
+#include "../control/profile_binary.h"
+
+// SD card side of the profiles. Each /profiles/*.json is compiled once
+// (control/profile_binary.h) into /cache/<id>.bin, the id being a hash of
+// the file name, size and modification time: an edited profile gets a new
+// blob, the one an open timeline reads from is never rewritten. The index
+// (/cache/index.bin) holds what the PROFILE screen lists, so listing is
+// one read at mount and loading is a stat plus a header read.
+//
+// profile_store_refresh() and profile_store_load() compile and rewrite the
+// index: caller holds mtx_LVGL, which also guards the index for the
+// readers. FatFs calls are made with the SD card claim on SPI0
+// (system/spi_bus.h), taken per call: a long compile never holds off a
+// display flush for long.
+
+#define PROFILE_DIR             "/profiles"
+#define PROFILE_STORE_DIR       "/cache"
+#define PROFILE_INDEX_MAX       32
+#define PROFILE_FILE_MAX        48  // Longer file names are not indexed
+#define PROFILE_INDEX_MAGIC     "MTRIDX"
+#define PROFILE_INDEX_VERSION   1
+
+// ProfileIndexEntry.status
+#define PROFILE_ENTRY_OK        0
+#define PROFILE_ENTRY_INVALID   1   // JSON rejected, not parsed again until the file changes
+
+typedef struct {
+    char file[PROFILE_FILE_MAX];    // Name in PROFILE_DIR
+    uint32_t size;          // Cache key, with fdate/ftime (FILINFO)
+    uint16_t fdate;
+    uint16_t ftime;
+    uint32_t blob_id;       // PROFILE_STORE_DIR/<blob_id>.bin
+    uint32_t status;
+    char name[32];
+    char alloy[24];
+    float peak_temp;
+    uint32_t duration_s;
+    uint32_t segment_count;
+} ProfileIndexEntry;
+
+typedef enum {
+    PROFILE_STORE_NO_CARD,      // PROFILE_DIR unreadable: card removed or not mounted
+    PROFILE_STORE_UNCHANGED,
+    PROFILE_STORE_UPDATED,      // Profiles added, edited or removed
+    PROFILE_STORE_NEW_VOLUME    // Card (re)mounted: files opened before are gone
+} ProfileStoreScan;
+
+// FatFs file as a json_read_fn source (profile_parser.h)
+typedef struct {
+    FIL file;
+} SdJsonFile;
+
+bool sd_json_open(SdJsonFile* f, const char* path);
+int sd_json_read(void* f, char* buf, size_t max);
+void sd_json_close(SdJsonFile* f);
+
+// Brings the index in step with PROFILE_DIR: new and edited profiles are
+// compiled, removed ones dropped with their blobs. The index file is read
+// on the first call after a mount, and written only when it changed.
+ProfileStoreScan profile_store_refresh();
+
+// Card gone: empties the index until the next refresh
+void profile_store_forget();
+
+// A profile was written behind the store's back (USB upload): the next
+// poll refreshes right away. Any task, no lock.
+void profile_store_invalidate();
+bool profile_store_stale();
+
+// Bumped on every index change, for the PROFILE screen list
+uint32_t profile_store_generation();
+uint32_t profile_store_count();
+const ProfileIndexEntry* profile_store_entry(uint32_t i);
+
+// Opens the compiled profile behind PROFILE_DIR/<file>, compiling it first
+// if the JSON changed since it was indexed, in the handle current does not
+// read from: *profile and *timeline then describe it, ready for
+// profile_timeline_replace(). Errors are printed as path:line:col.
+bool profile_store_load(const char* json_path, const ProfileTimeline* current,
+                        ReflowProfile* profile, ProfileTimeline* timeline);
+
+#endif // PROFILE_STORE_H
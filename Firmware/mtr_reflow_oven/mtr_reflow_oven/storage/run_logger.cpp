@@ -0,0 +1,212 @@
+#include <stdio.h>
+#include <cstring>
+#include <cstdlib>
+#include "run_logger.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "ff.h"
+#include "spi_bus.h"
+#include "../control/oven_control.h"
+#include "../control/oven_hal.h"
+#include "../control/run_log.h"
+#include "../control/mcp9600.h"
+
+extern bool sd_mounted;
+
+#define RUN_LOGGER_POLL_MS      500
+
+static FIL log_file;
+static bool file_open = false;
+static uint32_t next_index = 0;     // 0 = not scanned yet
+static RunLogHeader header;
+static RunLogSector sector;
+static uint32_t sector_fill = 0;
+static uint32_t sectors_written = 0;
+static uint32_t dropped_at_start = 0;
+
+static bool take_bus() {
+    return spi_bus_acquire(SPI_DEV_SD, 100);
+}
+
+static void give_bus() {
+    spi_bus_release(SPI_DEV_SD);
+}
+
+// Highest run_NNNN.bin in /logs + 1 (bus held)
+static uint32_t scan_next_index() {
+    DIR dir;
+    FILINFO fno;
+    uint32_t max_index = 0;
+    if (f_opendir(&dir, RUN_LOGGER_DIR) == FR_OK) {
+        while (f_readdir(&dir, &fno) == FR_OK && fno.fname[0]) {
+            unsigned idx;
+            if (sscanf(fno.fname, "run_%u.bin", &idx) == 1 && idx > max_index) max_index = idx;
+        }
+        f_closedir(&dir);
+    }
+    return max_index + 1;
+}
+
+// Bus held. The file no longer takes writes where the run stands: keep
+// the records written up to good_end, close it, and let the next poll
+// start a new run file.
+static void fail_run(FSIZE_t good_end, uint32_t records) {
+    UINT bw = 0;
+    f_lseek(&log_file, good_end);
+    f_truncate(&log_file);
+    header.record_count = records;
+    header.dropped = run_log_dropped() - dropped_at_start;
+    f_lseek(&log_file, 0);
+    f_write(&log_file, &header, sizeof(header), &bw);
+    f_close(&log_file);
+
+    file_open = false;
+    sector_fill = 0;
+    printf("[Logger] Run closed after a write failure: %u records\n", (unsigned)header.record_count);
+}
+
+static void open_run() {
+    // currentProfile is swapped under mtx_OvenState (load_profile(), other core)
+    char profile[sizeof(header.profile)] = "";
+    if (xSemaphoreTake(mtx_OvenState, pdMS_TO_TICKS(50)) == pdTRUE) {
+        strncpy(profile, currentProfile.name, sizeof(profile) - 1);
+        xSemaphoreGive(mtx_OvenState);
+    }
+    
+    if (!take_bus()) return; // Retried on the next poll
+
+    f_mkdir(RUN_LOGGER_DIR); // FR_EXIST after the first run
+    if (next_index == 0) next_index = scan_next_index();
+
+    char path[32];
+    snprintf(path, sizeof(path), RUN_LOGGER_DIR "/run_%04u.bin", (unsigned)next_index);
+    FRESULT fr = f_open(&log_file, path, FA_WRITE | FA_CREATE_ALWAYS);
+    if (fr != FR_OK) {
+        give_bus();
+        printf("[Logger] Cannot create %s (%d)\n", path, fr);
+        return;
+    }
+    next_index++;
+
+    // Reserve the clusters now: seeking past EOF on a writable file makes
+    // FatFs allocate the chain, so sector writes during the run do not
+    // have to walk the FAT.
+    // One record per sensor sample (vPIDLoopTask)
+    const uint32_t period_ms = mcp9600_conversion_ms((uint8_t)sysConfig.adc_bits);
+    const uint32_t records = RUN_LOGGER_PREALLOC_S * 1000 / period_ms;
+    const FSIZE_t prealloc = (FSIZE_t)(1 + (records + RUN_LOG_RECORDS_PER_SECTOR - 1) / RUN_LOG_RECORDS_PER_SECTOR) * RUN_LOG_SECTOR_SIZE;
+    if (f_lseek(&log_file, prealloc) != FR_OK || f_tell(&log_file) != prealloc) {
+        printf("[Logger] Pre-allocation short (card full?), logging anyway\n");
+    }
+
+    run_log_make_header(&header, millis(), period_ms, profile);
+    sector_fill = 0;
+    sectors_written = 0;
+    dropped_at_start = run_log_dropped();
+    UINT bw = 0;
+    fr = f_lseek(&log_file, 0);
+    if (fr == FR_OK) fr = f_write(&log_file, &header, sizeof(header), &bw);
+    if (fr == FR_OK && bw == sizeof(header)) fr = f_sync(&log_file);
+    if (fr != FR_OK || bw != sizeof(header)) {
+        printf("[Logger] Header write failed (%d, %u of %u bytes)\n", fr, (unsigned)bw, (unsigned)sizeof(header));
+        fail_run(0, 0);
+        f_unlink(path); // Nothing recorded in it
+        give_bus();
+        return;
+    }
+    give_bus();
+
+    file_open = true;
+    printf("[Logger] Recording %s\n", path);
+}
+
+// Full sector at a sector-aligned offset: FatFs sends it straight to the card
+static bool write_sector(uint32_t bytes) {
+    if (!take_bus()) return false;
+    FSIZE_t at = f_tell(&log_file);
+    UINT bw = 0;
+    FRESULT fr = f_write(&log_file, &sector, bytes, &bw);
+    bool ok = (fr == FR_OK && bw == bytes);
+    if (ok) {
+        if (++sectors_written % RUN_LOGGER_SYNC_SECTORS == 0) f_sync(&log_file);
+    } else {
+        printf("[Logger] Write failed (%d, %u of %u bytes)\n", fr, (unsigned)bw, (unsigned)bytes);
+        // A short write has moved the file pointer: the retry must start
+        // from the same offset, or every later record lands off by bw
+        if (f_lseek(&log_file, at) != FR_OK || f_tell(&log_file) != at) {
+            fail_run(at, sectors_written * RUN_LOG_RECORDS_PER_SECTOR);
+        }
+    }
+    give_bus();
+    return ok;
+}
+
+static void close_run() {
+    // Last, partial sector
+    run_log_fill_sector(&sector, &sector_fill);
+    if (!take_bus()) return; // Retried on the next poll
+    UINT bw = 0;
+    uint32_t count = sectors_written * RUN_LOG_RECORDS_PER_SECTOR;
+    if (sector_fill > 0) {
+        FSIZE_t at = f_tell(&log_file);
+        UINT bytes = sector_fill * sizeof(RunLogRecord);
+        FRESULT fr = f_write(&log_file, &sector, bytes, &bw);
+        if (fr != FR_OK || bw != bytes) {
+            printf("[Logger] Write failed (%d, %u of %u bytes)\n", fr, (unsigned)bw, (unsigned)bytes);
+            fail_run(at, count);
+            give_bus();
+            return;
+        }
+        count += sector_fill;
+    }
+    FSIZE_t end = f_tell(&log_file);
+
+    // Give back the unused part of the reservation and complete the header
+    f_truncate(&log_file);
+    header.record_count = count;
+    header.dropped = run_log_dropped() - dropped_at_start;
+    FRESULT fr = f_lseek(&log_file, 0);
+    if (fr == FR_OK) fr = f_write(&log_file, &header, sizeof(header), &bw);
+    if (fr != FR_OK || bw != sizeof(header)) {
+        printf("[Logger] Header write failed (%d, %u of %u bytes)\n", fr, (unsigned)bw, (unsigned)sizeof(header));
+        fail_run(end, count); // One more try at the header
+        give_bus();
+        return;
+    }
+    f_close(&log_file);
+    give_bus();
+
+    file_open = false;
+    sector_fill = 0;
+    printf("[Logger] Run closed: %u records, %u dropped\n", (unsigned)count, (unsigned)header.dropped);
+}
+
+static void vDiskLoggerTask(void *pvParameters) {
+    (void)pvParameters;
+    for (;;) {
+        OvenStateEnum state = oven_state_mode().state;
+        bool active = (state != STATE_INIT && state != STATE_IDLE);
+
+        if (active && !file_open && sd_mounted) open_run();
+
+        if (file_open) {
+            while (run_log_fill_sector(&sector, &sector_fill)) {
+                if (!write_sector(sizeof(sector))) break; // Sector kept, retried next poll
+                sector_fill = 0;
+            }
+            if (file_open && !active) close_run();
+        } else {
+            RunLogRecord r;
+            while (run_log_pop(&r)) {} // Nothing to record outside a run
+        }
+
+        vTaskDelay(pdMS_TO_TICKS(RUN_LOGGER_POLL_MS));
+    }
+}
+
+TaskHandle_t run_logger_start_task() {
+    TaskHandle_t task = NULL;
+    xTaskCreate(vDiskLoggerTask, "Disk_Logger", 1024, NULL, 1, &task);
+    return task;
+}
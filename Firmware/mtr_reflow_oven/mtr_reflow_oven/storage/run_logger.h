@@ -0,0 +1,25 @@
+#ifndef RUN_LOGGER_H
+#define RUN_LOGGER_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+// Disk_Logger task: drains the run log ring (control/run_log.h) to
+// /logs/run_NNNN.bin on the SD card, one file per run (PRE_CHECK/RUNNING/
+// MANUAL until back to IDLE).
+//
+// Files are pre-allocated for an hour of samples when the run starts, data
+// is written a full 512-byte sector at a time at sector-aligned offsets, and
+// the file is truncated to its real length and its header completed at the
+// end. All FatFs calls are made with the SD card claim on SPI0
+// (system/spi_bus.h, shared with the display).
+
+#define RUN_LOGGER_DIR          "/logs"
+#define RUN_LOGGER_PREALLOC_S   3600  // Seconds of samples reserved per file
+#define RUN_LOGGER_SYNC_SECTORS 4     // f_sync() every N sectors (~10 s at 12.5 Hz)
+
+// Priority 1, after the SD card is mounted (sd_mounted). Returns the task
+// so main() can pin it.
+TaskHandle_t run_logger_start_task();
+
+#endif // RUN_LOGGER_H
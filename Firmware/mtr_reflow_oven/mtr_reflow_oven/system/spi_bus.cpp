@@ -0,0 +1,154 @@
+#include <cstring>
+#include "spi_bus.h"
+
+// Claim waiting for the bus, on the claiming task's stack
+typedef struct SpiWaiter {
+    SpiDeviceId id;
+    uint8_t priority;
+    TaskHandle_t task;
+    uint32_t claim_us;
+    volatile bool granted;      // Set last by the releasing side
+    struct SpiWaiter* next;
+} SpiWaiter;
+
+static const SpiDevice* devices[SPI_BUS_DEVICES];
+static SpiDeviceStats stats[SPI_BUS_DEVICES];
+static uint32_t reclocks = 0;
+
+// Guarded by the critical section
+static bool held = false;
+static SpiDeviceId owner = SPI_BUS_DEVICES;
+static uint32_t grant_us = 0;
+static SpiWaiter* waiters = NULL;   // Highest priority first, FIFO within one
+
+// Owner only
+static SpiDeviceId clocked = SPI_BUS_DEVICES;  // Settings on the wire
+
+static void enqueue(SpiWaiter* w) {
+    SpiWaiter** p = &waiters;
+    while (*p && (*p)->priority >= w->priority) p = &(*p)->next;
+    w->next = *p;
+    *p = w;
+}
+
+static void unlink_waiter(SpiWaiter* w) {
+    for (SpiWaiter** p = &waiters; *p; p = &(*p)->next) {
+        if (*p == w) {
+            *p = w->next;
+            return;
+        }
+    }
+}
+
+// In the critical section: close the owner's transaction and pass the bus
+// on. Returns the task to notify, NULL if the bus is now free.
+static TaskHandle_t hand_over(SpiDeviceId id) {
+    configASSERT(held && owner == id);
+    uint32_t now = spi_bus_time_us();
+    uint32_t hold = now - grant_us;
+    SpiDeviceStats* s = &stats[id];
+    s->busy_us += hold;
+    if (hold > s->max_hold_us) s->max_hold_us = hold;
+
+    SpiWaiter* w = waiters;
+    if (!w) {
+        held = false;
+        return NULL;
+    }
+    waiters = w->next;
+    owner = w->id;
+    grant_us = now;
+    TaskHandle_t task = w->task;
+    w->granted = true; // The waiter may return (and its frame go) from here
+    return task;
+}
+
+void spi_bus_init(void) {
+    spi_bus_hw_init();
+}
+
+void spi_bus_register(SpiDeviceId id, const SpiDevice* dev) {
+    devices[id] = dev;
+    spi_bus_hw_init_device(dev);
+}
+
+bool spi_bus_acquire(SpiDeviceId id, uint32_t timeout_ms) {
+    SpiWaiter w;
+    w.id = id;
+    w.priority = devices[id]->priority;
+    w.task = xTaskGetCurrentTaskHandle();
+    w.claim_us = spi_bus_time_us();
+    w.granted = false;
+    w.next = NULL;
+
+    bool queued = false;
+    taskENTER_CRITICAL();
+    if (!held) {
+        held = true;
+        owner = id;
+        grant_us = w.claim_us;
+        w.granted = true;
+    } else {
+        enqueue(&w);
+        queued = true;
+    }
+    taskEXIT_CRITICAL();
+
+    if (queued) {
+        TickType_t start = xTaskGetTickCount();
+        TickType_t limit = pdMS_TO_TICKS(timeout_ms);
+        while (!w.granted) {
+            TickType_t waited = xTaskGetTickCount() - start;
+            if (waited >= limit) break;
+            ulTaskNotifyTake(pdTRUE, limit - waited);
+        }
+        if (!w.granted) {
+            taskENTER_CRITICAL();
+            bool granted = w.granted; // Handed over since the last check?
+            if (!granted) {
+                unlink_waiter(&w);
+                stats[id].timeouts++;
+            }
+            taskEXIT_CRITICAL();
+            if (!granted) return false;
+        }
+    }
+
+    // Owner from here
+    SpiDeviceStats* s = &stats[id];
+    s->grants++;
+    if (queued) {
+        uint32_t wait = grant_us - w.claim_us;
+        s->queued++;
+        s->wait_us += wait;
+        if (wait > s->max_wait_us) s->max_wait_us = wait;
+    }
+    if (clocked != id) {
+        s->actual_hz = spi_bus_hw_configure(devices[id]);
+        clocked = id;
+        reclocks++;
+    }
+    return true;
+}
+
+void spi_bus_release(SpiDeviceId id) {
+    taskENTER_CRITICAL();
+    TaskHandle_t next = hand_over(id);
+    taskEXIT_CRITICAL();
+    if (next) xTaskNotifyGive(next);
+}
+
+void spi_bus_release_from_isr(SpiDeviceId id, BaseType_t* pxHigherPriorityTaskWoken) {
+    UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+    TaskHandle_t next = hand_over(id);
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+    if (next) vTaskNotifyGiveFromISR(next, pxHigherPriorityTaskWoken);
+}
+
+void spi_bus_get_stats(SpiBusStats* out) {
+    taskENTER_CRITICAL();
+    memcpy(out->dev, stats, sizeof(stats));
+    out->reclocks = reclocks;
+    out->now_us = spi_bus_time_us();
+    taskEXIT_CRITICAL();
+}
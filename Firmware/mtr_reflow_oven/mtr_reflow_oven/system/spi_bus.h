@@ -0,0 +1,87 @@
+#ifndef SPI_BUS_H
+#define SPI_BUS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+// SPI0 arbiter: the ST7796 display and the SD card share the bus.
+//
+// Each device registers a descriptor (clock, mode, CS, DC, priority). A
+// task claims the bus for one transaction - a display flush band, one
+// FatFs call - and the bus is switched to the new owner's clock and mode
+// whenever the previous transaction was for the other device. Waiting
+// claims are granted by device priority, FIFO within one priority: an SD
+// access waits for one display band at most, whatever the UI is drawing.
+//
+// A release hands the bus straight to the next waiter: granted flag, then
+// xTaskNotifyGive on its default notification slot. The wait loop
+// re-checks the flag, so a stale notification (disp_bus_wait_idle() uses
+// the same slot) is harmless. The display DMA-complete IRQ releases with
+// spi_bus_release_from_isr().
+//
+// Core: spi_bus.cpp (FreeRTOS only). Hardware side (port, clock, CS lines):
+// spi_bus_rp2040.cpp on target, sim/spi_bus_sim.cpp for sim/spi_bus_check.
+
+#define SPI_BUS_NO_PIN  (-1)
+
+typedef enum {
+    SPI_DEV_DISPLAY,
+    SPI_DEV_SD,
+    SPI_BUS_DEVICES
+} SpiDeviceId;
+
+typedef struct {
+    const char* name;
+    uint32_t baud_hz;       // Requested clock, the divider gives at most this
+    uint8_t cpol, cpha;     // SPI mode
+    int8_t cs_gpio;         // Driven high (deselected) from registration on
+    int8_t dc_gpio;         // Data/command line, SPI_BUS_NO_PIN if none
+    uint8_t priority;       // Higher is granted first
+} SpiDevice;
+
+typedef struct {
+    uint32_t grants;        // Transactions
+    uint32_t queued;        // ...that found the bus taken
+    uint32_t timeouts;      // Claims given up
+    uint64_t wait_us;       // Claim to grant, summed over the queued ones
+    uint32_t max_wait_us;
+    uint64_t busy_us;       // Grant to release (the owner's share of the bus)
+    uint32_t max_hold_us;
+    uint32_t actual_hz;     // Clock set at the last switch, 0 = never owned
+} SpiDeviceStats;
+
+typedef struct {
+    SpiDeviceStats dev[SPI_BUS_DEVICES];
+    uint32_t reclocks;      // Device switches (clock and mode reprogrammed)
+    uint32_t now_us;        // Snapshot time: utilisation = busy_us delta / now_us delta
+} SpiBusStats;
+
+// Port and pins, before any device is registered or the card is mounted
+void spi_bus_init(void);
+
+// Descriptor kept by pointer. CS (and DC) lines set up, CS high.
+void spi_bus_register(SpiDeviceId id, const SpiDevice* dev);
+
+// Claim the bus for one transaction. The clock and mode are the device's
+// on return. false after timeout_ms, nothing held. Must be called from a
+// task; before the scheduler starts the bus is used without claims.
+bool spi_bus_acquire(SpiDeviceId id, uint32_t timeout_ms);
+
+// End of the transaction: the bus goes to the next waiter, if any
+void spi_bus_release(SpiDeviceId id);
+void spi_bus_release_from_isr(SpiDeviceId id, BaseType_t* pxHigherPriorityTaskWoken);
+
+// Counters since boot. The busy time of a transaction still in progress is
+// counted at its release.
+void spi_bus_get_stats(SpiBusStats* out);
+
+// --- Hardware side ---
+void spi_bus_hw_init(void);
+void spi_bus_hw_init_device(const SpiDevice* dev);
+// Clock and mode for dev, all CS lines high. Returns the actual clock.
+uint32_t spi_bus_hw_configure(const SpiDevice* dev);
+uint32_t spi_bus_time_us(void);
+
+#endif // SPI_BUS_H
@@ -0,0 +1,45 @@
+#include "spi_bus.h"
+#include "board_config.h"
+#include "hardware/spi.h"
+#include "hardware/gpio.h"
+#include "pico/time.h"
+
+// CS lines of the registered devices, all raised before a clock change
+static int8_t cs_lines[SPI_BUS_DEVICES];
+static int cs_count = 0;
+
+void spi_bus_hw_init(void) {
+    // Placeholder clock: the first owner sets its own. The FatFs driver
+    // runs spi_init() again on its first card init (inside an SD claim),
+    // the next display claim reprograms the port after it.
+    spi_init(SPI_PORT, 1000 * 1000);
+    gpio_set_function(GPIO_SPI_SCK, GPIO_FUNC_SPI);
+    gpio_set_function(GPIO_SPI_MOSI, GPIO_FUNC_SPI);
+    gpio_set_function(GPIO_SPI_MISO, GPIO_FUNC_SPI);
+}
+
+void spi_bus_hw_init_device(const SpiDevice* dev) {
+    if (dev->cs_gpio != SPI_BUS_NO_PIN) {
+        gpio_init(dev->cs_gpio);
+        gpio_put(dev->cs_gpio, 1);
+        gpio_set_dir(dev->cs_gpio, GPIO_OUT);
+        if (cs_count < SPI_BUS_DEVICES) cs_lines[cs_count++] = dev->cs_gpio;
+    }
+    if (dev->dc_gpio != SPI_BUS_NO_PIN) {
+        gpio_init(dev->dc_gpio);
+        gpio_set_dir(dev->dc_gpio, GPIO_OUT);
+    }
+}
+
+uint32_t spi_bus_hw_configure(const SpiDevice* dev) {
+    // Between transactions every CS is already high; make sure no device
+    // sees the clock change
+    for (int i = 0; i < cs_count; i++) gpio_put(cs_lines[i], 1);
+    uint32_t actual = spi_set_baudrate(SPI_PORT, dev->baud_hz);
+    spi_set_format(SPI_PORT, 8, (spi_cpol_t)dev->cpol, (spi_cpha_t)dev->cpha, SPI_MSB_FIRST);
+    return actual;
+}
+
+uint32_t spi_bus_time_us(void) {
+    return time_us_32();
+}
@@ -0,0 +1,156 @@
+#include <stdio.h>
+#include <cstring>
+#include "sys_stats.h"
+#include "semphr.h"
+#include "lvgl.h"
+
+extern SemaphoreHandle_t mtx_LVGL; // lv_mem_monitor() walks the LVGL heap
+
+static SemaphoreHandle_t mtx_Stats = NULL;
+static SysStats latest;
+
+// Run time of each task at the previous sample, matched by xTaskNumber
+static TaskStatus_t status[SYS_STATS_MAX_TASKS];
+static UBaseType_t prev_number[SYS_STATS_MAX_TASKS];
+static configRUN_TIME_COUNTER_TYPE prev_runtime[SYS_STATS_MAX_TASKS];
+static UBaseType_t prev_count = 0;
+static uint64_t prev_us = 0;
+static uint32_t sample_seq = 0;
+static SpiBusStats prev_spi;
+
+static configRUN_TIME_COUNTER_TYPE previous_runtime(UBaseType_t number) {
+    for (UBaseType_t i = 0; i < prev_count; i++) {
+        if (prev_number[i] == number) return prev_runtime[i];
+    }
+    return 0; // Created since the last sample
+}
+
+static bool is_idle_task(TaskHandle_t task) {
+    for (BaseType_t core = 0; core < configNUMBER_OF_CORES; core++) {
+        if (task == xTaskGetIdleTaskHandleForCore(core)) return true;
+    }
+    return false;
+}
+
+static void sample_tasks(SysStats* out) {
+    UBaseType_t count = uxTaskGetSystemState(status, SYS_STATS_MAX_TASKS, NULL);
+    uint64_t now_us = portGET_RUN_TIME_COUNTER_VALUE();
+    uint64_t elapsed_us = now_us - prev_us;
+    out->interval_ms = (uint32_t)(elapsed_us / 1000);
+    out->uptime_ms = (uint32_t)(now_us / 1000);
+
+    for (UBaseType_t i = 0; i < count; i++) {
+        const TaskStatus_t* t = &status[i];
+        SysTaskStats* e = &out->tasks[i];
+        strncpy(e->name, t->pcTaskName, sizeof(e->name) - 1);
+        e->priority = t->uxCurrentPriority;
+        e->core_mask = t->uxCoreAffinityMask;
+        e->stack_free = t->usStackHighWaterMark;
+        uint64_t ran_us = t->ulRunTimeCounter - previous_runtime(t->xTaskNumber);
+        e->cpu_pct = elapsed_us ? 100.0f * (float)ran_us / (float)elapsed_us : 0.0f;
+
+        bool pinned = false;
+        for (int core = 0; core < configNUMBER_OF_CORES; core++) {
+            if (t->uxCoreAffinityMask == (1u << core)) {
+                out->core_pct[core] += e->cpu_pct;
+                pinned = true;
+            }
+        }
+        if (!pinned && !is_idle_task(t->xHandle)) out->unpinned_pct += e->cpu_pct;
+
+        prev_number[i] = t->xTaskNumber;
+        prev_runtime[i] = t->ulRunTimeCounter;
+    }
+    out->task_count = count;
+    prev_count = count;
+    prev_us = now_us;
+}
+
+static void sample_memory(SysStats* out) {
+    out->heap_free = (uint32_t)xPortGetFreeHeapSize();
+    out->heap_min_free = (uint32_t)xPortGetMinimumEverFreeHeapSize();
+
+    // Skipped (zeros) if the UI holds LVGL for long, next sample catches up
+    if (xSemaphoreTake(mtx_LVGL, pdMS_TO_TICKS(20)) == pdTRUE) {
+        lv_mem_monitor_t mon;
+        lv_mem_monitor(&mon);
+        xSemaphoreGive(mtx_LVGL);
+        out->lv_total = (uint32_t)mon.total_size;
+        out->lv_used = (uint32_t)(mon.total_size - mon.free_size);
+        out->lv_max_used = (uint32_t)mon.max_used;
+        out->lv_frag_pct = mon.frag_pct;
+    }
+}
+
+static void sample_spi(SysStats* out) {
+    SpiBusStats spi;
+    spi_bus_get_stats(&spi);
+    uint32_t elapsed_us = spi.now_us - prev_spi.now_us;
+    for (int d = 0; d < SPI_BUS_DEVICES; d++) {
+        const SpiDeviceStats* s = &spi.dev[d];
+        const SpiDeviceStats* p = &prev_spi.dev[d];
+        uint32_t queued = s->queued - p->queued;
+        out->spi_busy_pct[d] = elapsed_us ? 100.0f * (float)(s->busy_us - p->busy_us) / (float)elapsed_us : 0.0f;
+        out->spi_wait_avg_us[d] = queued ? (uint32_t)((s->wait_us - p->wait_us) / queued) : 0;
+        out->spi_wait_max_us[d] = s->max_wait_us;
+    }
+    out->spi_reclocks = spi.reclocks - prev_spi.reclocks;
+    prev_spi = spi;
+}
+
+void sys_stats_get(SysStats* out) {
+    if (mtx_Stats && xSemaphoreTake(mtx_Stats, pdMS_TO_TICKS(50)) == pdTRUE) {
+        *out = latest;
+        xSemaphoreGive(mtx_Stats);
+    } else {
+        memset(out, 0, sizeof(*out));
+    }
+}
+
+void sys_stats_dump(const SysStats* s) {
+    printf("{\"sys\":{\"seq\":%u,\"uptime_ms\":%u,\"interval_ms\":%u,\"cpu\":[%.1f,%.1f],\"unpinned\":%.1f,"
+           "\"heap_free\":%u,\"heap_min\":%u,\"lv_total\":%u,\"lv_used\":%u,\"lv_max\":%u,\"lv_frag\":%u},",
+           (unsigned)s->seq, (unsigned)s->uptime_ms, (unsigned)s->interval_ms,
+           s->core_pct[0], s->core_pct[1], s->unpinned_pct,
+           (unsigned)s->heap_free, (unsigned)s->heap_min_free,
+           (unsigned)s->lv_total, (unsigned)s->lv_used, (unsigned)s->lv_max_used, (unsigned)s->lv_frag_pct);
+    printf("\"spi\":{\"busy\":[%.1f,%.1f],\"wait_avg\":[%u,%u],\"wait_max\":[%u,%u],\"reclocks\":%u},\"tasks\":[",
+           s->spi_busy_pct[SPI_DEV_DISPLAY], s->spi_busy_pct[SPI_DEV_SD],
+           (unsigned)s->spi_wait_avg_us[SPI_DEV_DISPLAY], (unsigned)s->spi_wait_avg_us[SPI_DEV_SD],
+           (unsigned)s->spi_wait_max_us[SPI_DEV_DISPLAY], (unsigned)s->spi_wait_max_us[SPI_DEV_SD],
+           (unsigned)s->spi_reclocks);
+    for (uint32_t i = 0; i < s->task_count; i++) {
+        const SysTaskStats* e = &s->tasks[i];
+        int core = (e->core_mask == 1u) ? 0 : (e->core_mask == 2u) ? 1 : -1;
+        printf("%s{\"name\":\"%s\",\"prio\":%u,\"core\":%d,\"cpu\":%.1f,\"stack_free\":%u}",
+               i ? "," : "", e->name, (unsigned)e->priority, core, e->cpu_pct, (unsigned)e->stack_free);
+    }
+    printf("]}\n");
+}
+
+static void vStatsTask(void *pvParameters) {
+    (void)pvParameters;
+    static SysStats sample; // Too big for this task's stack
+    memset(&sample, 0, sizeof(sample));
+    sample_tasks(&sample); // Baseline, the first interval starts here
+    sample_spi(&sample);
+
+    for (;;) {
+        vTaskDelay(pdMS_TO_TICKS(SYS_STATS_PERIOD_MS));
+        memset(&sample, 0, sizeof(sample));
+        sample.seq = ++sample_seq;
+        sample_tasks(&sample);
+        sample_memory(&sample);
+        sample_spi(&sample);
+        if (xSemaphoreTake(mtx_Stats, pdMS_TO_TICKS(50)) == pdTRUE) {
+            latest = sample;
+            xSemaphoreGive(mtx_Stats);
+        }
+        if (sample.seq % SYS_STATS_DUMP_EVERY == 0) sys_stats_dump(&sample);
+    }
+}
+
+void sys_stats_start_task() {
+    mtx_Stats = xSemaphoreCreateMutex();
+    xTaskCreate(vStatsTask, "Stats", 512, NULL, 1, NULL);
+}
@@ -0,0 +1,61 @@
+#ifndef SYS_STATS_H
+#define SYS_STATS_H
+
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "spi_bus.h"
+
+// System telemetry: CPU load and stack headroom per task, FreeRTOS heap
+// (heap_4), LVGL heap (lv_mem) and SPI0 bus share (spi_bus.h). Shown on the SYS INFO screen and dumped
+// as one JSON line over USB serial.
+//
+// CPU load comes from the FreeRTOS run time counter (us, FreeRTOSConfig.h).
+// Each sample covers the interval since the previous one, so it shows the
+// current load rather than the average since boot. Loads are in % of one
+// core: a task pinned to a core can reach 100 %, the whole chip 200 %.
+
+#define SYS_STATS_MAX_TASKS     16
+#define SYS_STATS_PERIOD_MS     1000    // Sample interval
+#define SYS_STATS_DUMP_EVERY    5       // USB dump every N samples
+#define SYS_STATS_STACK_LOW     64      // Words of headroom flagged as low
+
+typedef struct {
+    char name[configMAX_TASK_NAME_LEN];
+    UBaseType_t priority;
+    UBaseType_t core_mask;      // Affinity, tskNO_AFFINITY = either core
+    float cpu_pct;
+    uint32_t stack_free;        // High-water mark: fewest words ever left
+} SysTaskStats;
+
+typedef struct {
+    uint32_t seq;               // +1 per sample, 0 = none yet
+    uint32_t uptime_ms;
+    uint32_t interval_ms;
+    uint32_t task_count;
+    SysTaskStats tasks[SYS_STATS_MAX_TASKS];
+    float core_pct[configNUMBER_OF_CORES];  // Sum of the tasks pinned to each core
+    float unpinned_pct;                     // Unpinned tasks, idle excluded
+    uint32_t heap_free;                     // FreeRTOS heap_4
+    uint32_t heap_min_free;                 // Lowest since boot
+    uint32_t lv_total;                      // LVGL heap (LV_MEM_SIZE)
+    uint32_t lv_used;
+    uint32_t lv_max_used;
+    uint8_t lv_frag_pct;
+    // SPI0, per device (SpiDeviceId) over the interval, max wait since boot
+    float spi_busy_pct[SPI_BUS_DEVICES];
+    uint32_t spi_wait_avg_us[SPI_BUS_DEVICES];  // Claims that found the bus taken
+    uint32_t spi_wait_max_us[SPI_BUS_DEVICES];
+    uint32_t spi_reclocks;
+} SysStats;
+
+// Copy of the latest sample
+void sys_stats_get(SysStats* out);
+
+// Sample as one JSON line ({"sys":...,"spi":...,"tasks":[...]}) on USB serial
+void sys_stats_dump(const SysStats* stats);
+
+// "Stats" task, priority 1: samples every SYS_STATS_PERIOD_MS
+void sys_stats_start_task();
+
+#endif // SYS_STATS_H
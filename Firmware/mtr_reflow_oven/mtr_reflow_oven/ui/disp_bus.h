@@ -0,0 +1,46 @@
+#ifndef DISP_BUS_H
+#define DISP_BUS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Display transport used by the LVGL flush pipeline (ui_display.cpp).
+// Target: disp_bus_rp2040.cpp (SPI0 + DMA). Host: sim/disp_bus_mock.cpp.
+
+// Called once the pixel transfer has fully left the bus.
+// On target this runs in the DMA IRQ, so keep it ISR-safe.
+typedef void (*disp_bus_done_cb_t)(void* user);
+
+// Display on the shared bus, control pins, DMA channel and panel hardware
+// reset. Before the first disp_bus_acquire().
+void disp_bus_init(void);
+
+// Claim the shared bus for one flush (CASET/RASET/RAMWR + pixels).
+// The bus is released by the transport when the pixel transfer completes.
+bool disp_bus_acquire(uint32_t timeout_ms);
+
+// Release without a pixel transfer (init sequence, error paths)
+void disp_bus_release(void);
+
+// Short CPU-driven command + parameter write. Bus must be held.
+void disp_bus_write_cmd(uint8_t cmd, const uint8_t* data, size_t len);
+
+// Start the pixel transfer and return immediately. Bus must be held.
+void disp_bus_write_pixels_async(const uint8_t* px, size_t len, disp_bus_done_cb_t cb, void* user);
+
+// Block the calling task until the in-flight pixel transfer has completed
+void disp_bus_wait_idle(void);
+
+void disp_bus_delay_ms(uint32_t ms);
+void disp_bus_set_backlight(bool on);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DISP_BUS_H
@@ -0,0 +1,125 @@
+#include "disp_bus.h"
+#include "spi_bus.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "hardware/spi.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/gpio.h"
+#include "pico/stdlib.h"
+
+// --- Hardware Config ---
+#define ST7796_DC   25
+#define ST7796_CS   21
+#define ST7796_RST  24
+#define ST7796_BL   23
+
+#define DISP_SPI        spi0
+#define DISP_SPI_HZ     40000000
+#define DISP_DMA_IRQ    DMA_IRQ_1 // DMA_IRQ_0 belongs to the FatFs SPI driver
+
+// Shared with the SD card (system/spi_bus.h). Below the SD card: a card
+// access waits for the band on the wire, never for a whole screen.
+static const SpiDevice disp_spi_dev = {
+    "display", DISP_SPI_HZ, 0, 0, ST7796_CS, ST7796_DC, 1
+};
+
+static int dma_chan = -1;
+static volatile bool dma_busy = false;
+static disp_bus_done_cb_t done_cb = NULL;
+static void* done_user = NULL;
+static TaskHandle_t waiting_task = NULL;
+
+static void __isr disp_bus_dma_isr(void) {
+    if (!dma_channel_get_irq1_status(dma_chan)) return; // Shared line
+    dma_channel_acknowledge_irq1(dma_chan);
+
+    // DMA done only means the FIFO is loaded; wait for the last bits to shift out
+    while (spi_is_busy(DISP_SPI)) tight_loop_contents();
+
+    // TX-only transfer: drop what RX collected so the SD driver starts clean
+    while (spi_is_readable(DISP_SPI)) (void)spi_get_hw(DISP_SPI)->dr;
+    spi_get_hw(DISP_SPI)->icr = SPI_SSPICR_RORIC_BITS;
+
+    gpio_put(ST7796_CS, 1);
+    dma_busy = false;
+
+    if (done_cb) done_cb(done_user);
+
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    spi_bus_release_from_isr(SPI_DEV_DISPLAY, &xHigherPriorityTaskWoken);
+    if (waiting_task) vTaskNotifyGiveFromISR(waiting_task, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+void disp_bus_init(void) {
+    // Port and pins: spi_bus_init() in main(). CS, DC and the clock come
+    // with the bus claim.
+    spi_bus_register(SPI_DEV_DISPLAY, &disp_spi_dev);
+    gpio_init(ST7796_RST); gpio_set_dir(ST7796_RST, GPIO_OUT);
+    gpio_init(ST7796_BL); gpio_set_dir(ST7796_BL, GPIO_OUT);
+
+    // Pixel DMA: memory -> SPI TX FIFO, paced by the SPI DREQ
+    dma_chan = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(dma_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_dreq(&c, spi_get_dreq(DISP_SPI, true));
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    dma_channel_configure(dma_chan, &c, &spi_get_hw(DISP_SPI)->dr, NULL, 0, false);
+
+    dma_channel_set_irq1_enabled(dma_chan, true);
+    irq_add_shared_handler(DISP_DMA_IRQ, disp_bus_dma_isr, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DISP_DMA_IRQ, true);
+
+    // Reset
+    gpio_put(ST7796_RST, 0); sleep_ms(100);
+    gpio_put(ST7796_RST, 1); sleep_ms(100);
+}
+
+bool disp_bus_acquire(uint32_t timeout_ms) {
+    return spi_bus_acquire(SPI_DEV_DISPLAY, timeout_ms);
+}
+
+void disp_bus_release(void) {
+    spi_bus_release(SPI_DEV_DISPLAY);
+}
+
+void disp_bus_write_cmd(uint8_t cmd, const uint8_t* data, size_t len) {
+    gpio_put(ST7796_CS, 0);
+    gpio_put(ST7796_DC, 0); // Command
+    spi_write_blocking(DISP_SPI, &cmd, 1);
+    if (len > 0) {
+        gpio_put(ST7796_DC, 1); // Data
+        spi_write_blocking(DISP_SPI, data, len);
+    }
+    gpio_put(ST7796_CS, 1);
+}
+
+void disp_bus_write_pixels_async(const uint8_t* px, size_t len, disp_bus_done_cb_t cb, void* user) {
+    done_cb = cb;
+    done_user = user;
+    dma_busy = true;
+
+    gpio_put(ST7796_DC, 1); // Data
+    gpio_put(ST7796_CS, 0); // Raised again by the DMA IRQ
+    dma_channel_transfer_from_buffer_now(dma_chan, px, len);
+}
+
+void disp_bus_wait_idle(void) {
+    waiting_task = xTaskGetCurrentTaskHandle();
+    // A completion that races the check leaves a stale notification;
+    // the loop simply re-checks the flag.
+    while (dma_busy) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(50));
+    }
+    waiting_task = NULL;
+}
+
+void disp_bus_delay_ms(uint32_t ms) {
+    sleep_ms(ms);
+}
+
+void disp_bus_set_backlight(bool on) {
+    gpio_put(ST7796_BL, on);
+}
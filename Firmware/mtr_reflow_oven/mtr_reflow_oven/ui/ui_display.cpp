@@ -0,0 +1,81 @@
+#include "ui_display.h"
+#include "disp_bus.h"
+#include <stdio.h>
+
+// Two draw buffers: LVGL renders into one while DMA sends the other
+#define UI_DISP_BUF_BYTES (UI_DISP_HOR_RES * UI_DISP_BUF_LINES * 2) // RGB565
+
+LV_ATTRIBUTE_MEM_ALIGN static uint8_t buf1[UI_DISP_BUF_BYTES];
+LV_ATTRIBUTE_MEM_ALIGN static uint8_t buf2[UI_DISP_BUF_BYTES];
+
+// --- Display Driver ---
+
+static void init_st7796() {
+    disp_bus_set_backlight(true);
+
+    // Init Sequence (Standard ST7796)
+    disp_bus_write_cmd(0x01, NULL, 0); disp_bus_delay_ms(150); // SWRESET
+    uint8_t d = 0x28; // BGR | MV (Landscape)
+    disp_bus_write_cmd(0x36, &d, 1); // MADCTL
+    d = 0x55; // 16-bit
+    disp_bus_write_cmd(0x3A, &d, 1); // COLMOD
+
+    disp_bus_write_cmd(0x11, NULL, 0); disp_bus_delay_ms(50); // SLPOUT
+    disp_bus_write_cmd(0x29, NULL, 0); disp_bus_delay_ms(10); // DISPON
+}
+
+static void disp_flush_done(void* user) {
+    // DMA IRQ context on target
+    lv_display_flush_ready((lv_display_t*)user);
+}
+
+static void disp_flush(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map) {
+    if (!disp_bus_acquire(100)) {
+        lv_display_flush_ready(disp); // Drop the band rather than stall LVGL
+        return;
+    }
+
+    uint16_t x1 = area->x1;
+    uint16_t x2 = area->x2;
+    uint16_t y1 = area->y1;
+    uint16_t y2 = area->y2;
+
+    uint8_t data[4];
+
+    data[0] = x1 >> 8; data[1] = x1 & 0xFF;
+    data[2] = x2 >> 8; data[3] = x2 & 0xFF;
+    disp_bus_write_cmd(0x2A, data, 4); // CASET
+
+    data[0] = y1 >> 8; data[1] = y1 & 0xFF;
+    data[2] = y2 >> 8; data[3] = y2 & 0xFF;
+    disp_bus_write_cmd(0x2B, data, 4); // RASET
+
+    disp_bus_write_cmd(0x2C, NULL, 0); // RAMWR
+
+    uint32_t size = lv_area_get_width(area) * lv_area_get_height(area) * 2;
+    // Returns immediately; flush_ready and the bus release come from the DMA IRQ
+    disp_bus_write_pixels_async(px_map, size, disp_flush_done, disp);
+}
+
+// Called by LVGL before it reuses a buffer: sleep instead of spinning on the flag
+static void disp_flush_wait(lv_display_t * disp) {
+    (void)disp;
+    disp_bus_wait_idle();
+}
+
+lv_display_t* ui_display_init(void) {
+    disp_bus_init(); // Registers the display on the shared bus: before any claim
+    if (disp_bus_acquire(1000)) {
+        init_st7796();
+        disp_bus_release();
+    } else {
+        printf("[UI] Failed to init Display (Bus Timeout)\n");
+    }
+
+    lv_display_t * disp = lv_display_create(UI_DISP_HOR_RES, UI_DISP_VER_RES);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_RGB565);
+    lv_display_set_flush_cb(disp, disp_flush);
+    lv_display_set_flush_wait_cb(disp, disp_flush_wait);
+    lv_display_set_buffers(disp, buf1, buf2, sizeof(buf1), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    return disp;
+}
@@ -0,0 +1,22 @@
+#ifndef UI_DISPLAY_H
+#define UI_DISPLAY_H
+
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UI_DISP_HOR_RES   480
+#define UI_DISP_VER_RES   320
+#define UI_DISP_BUF_LINES 20 // Per draw buffer, two buffers
+
+// Init the ST7796 panel and create the LVGL display with the
+// double-buffered DMA flush pipeline. Caller holds no bus lock.
+lv_display_t* ui_display_init(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UI_DISPLAY_H
@@ -0,0 +1,45 @@
+#include "ui_model.h"
+#include <math.h>
+
+extern ReflowProfile currentProfile;
+
+lv_subject_t ui_subject_temp;
+lv_subject_t ui_subject_setpoint;
+lv_subject_t ui_subject_power1;
+lv_subject_t ui_subject_power2;
+lv_subject_t ui_subject_state;
+lv_subject_t ui_subject_profile;
+
+static char profile_buf[sizeof(currentProfile.name)];
+static char profile_prev[sizeof(currentProfile.name)];
+
+void ui_model_init(void) {
+    lv_subject_init_int(&ui_subject_temp, 0);
+    lv_subject_init_int(&ui_subject_setpoint, 0);
+    lv_subject_init_int(&ui_subject_power1, 0);
+    lv_subject_init_int(&ui_subject_power2, 0);
+    lv_subject_init_int(&ui_subject_state, STATE_INIT);
+    lv_subject_init_string(&ui_subject_profile, profile_buf, profile_prev, sizeof(profile_buf), "");
+}
+
+void ui_model_update(const OvenState* state) {
+    // Same value: no notification, no redraw
+    lv_subject_set_int(&ui_subject_temp, (int32_t)lroundf(state->current_temp_t1 * 10.0f));
+    lv_subject_set_int(&ui_subject_setpoint, (int32_t)lroundf(state->target_temp));
+    lv_subject_set_int(&ui_subject_power1, (int32_t)lroundf(state->power_output_1));
+    lv_subject_set_int(&ui_subject_power2, (int32_t)lroundf(state->power_output_2));
+    lv_subject_set_int(&ui_subject_state, (int32_t)state->state);
+
+    // load_profile() swaps it with mtx_LVGL held, as the caller holds it here
+    lv_subject_copy_string(&ui_subject_profile, currentProfile.name);
+}
+
+static void tenths_label_cb(lv_observer_t* observer, lv_subject_t* subject) {
+    lv_obj_t* label = lv_observer_get_target_obj(observer);
+    const char* fmt = (const char*)lv_observer_get_user_data(observer);
+    lv_label_set_text_fmt(label, fmt, lv_subject_get_int(subject) / 10.0);
+}
+
+lv_observer_t* ui_model_bind_tenths(lv_obj_t* label, lv_subject_t* subject, const char* fmt) {
+    return lv_subject_add_observer_obj(subject, tenths_label_cb, label, (void*)fmt);
+}
@@ -0,0 +1,40 @@
+#ifndef UI_MODEL_H
+#define UI_MODEL_H
+
+#include "../project_defs.h"
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Change-driven UI data: the oven values the screens show, as LVGL
+// subjects. ui_model_update() quantises each value to the resolution it is
+// displayed at and the subject notifies its observers only when that
+// changes, so a widget is redrawn (and flushed over SPI) only when its text
+// would change, not on every 5 ms UI loop.
+//
+// Integer subjects only: LV_USE_FLOAT is 0 in lv_conf.h. Widgets bind on
+// screen creation, the subjects outlive the screens. LVGL thread (mtx_LVGL).
+
+extern lv_subject_t ui_subject_temp;      // T1, 0.1 C
+extern lv_subject_t ui_subject_setpoint;  // Target, 1 C
+extern lv_subject_t ui_subject_power1;    // SSR1, 1 %
+extern lv_subject_t ui_subject_power2;    // SSR2, 1 %
+extern lv_subject_t ui_subject_state;     // OvenStateEnum
+extern lv_subject_t ui_subject_profile;   // currentProfile.name
+
+// Before the screens are created
+void ui_model_init(void);
+
+// Publish a state snapshot (and the loaded profile's name)
+void ui_model_update(const OvenState* state);
+
+// Label showing a 0.1 C subject, fmt takes one double ("T: %.1f C")
+lv_observer_t* ui_model_bind_tenths(lv_obj_t* label, lv_subject_t* subject, const char* fmt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UI_MODEL_H
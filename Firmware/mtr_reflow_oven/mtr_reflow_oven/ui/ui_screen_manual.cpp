@@ -1,6 +1,12 @@
 #include "ui_screens.h"
 #include "ui_shared.h"
+#include "ui_model.h"
 #include <stdio.h>
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "../control/oven_state.h"
+
+extern SemaphoreHandle_t mtx_OvenState;
 
 lv_obj_t* scr_manual;
 
@@ -14,7 +20,30 @@ static int manual_target_temp = 20; // Default 20C
 static bool heater_enabled = false;
 
 extern UIContext uiCtx;
-extern OvenState ovenState; 
+
+// Manual mode is a mode-channel writer like the state machine
+static void manual_set_mode(OvenStateEnum state, float target) {
+    if (xSemaphoreTake(mtx_OvenState, pdMS_TO_TICKS(50)) == pdTRUE) {
+        OvenMode mode = oven_state_mode();
+        mode.state = state;
+        mode.target_temp = target;
+        oven_state_publish_mode(&mode);
+        xSemaphoreGive(mtx_OvenState);
+    }
+}
+
+static void fault_stop(void) {
+    heater_enabled = false;
+    manual_target_temp = 20;
+    lv_label_set_text_fmt(lbl_target_val, "%d C", manual_target_temp);
+    lv_label_set_text(lbl_status_manual, "FAULT STOP");
+    lv_obj_set_style_text_color(lbl_status_manual, lv_color_hex(0xFF0000), 0);
+}
+
+static void state_cb(lv_observer_t* observer, lv_subject_t* subject) {
+    (void)observer;
+    if (lv_subject_get_int(subject) == STATE_FAULT) fault_stop();
+}
 
 void ui_create_manual(void) {
     scr_manual = lv_obj_create(NULL);
@@ -91,6 +120,12 @@ void ui_create_manual(void) {
     lv_obj_align(lbl_status_manual, LV_ALIGN_CENTER, 0, 0); // Flex align handles it
     lv_obj_set_style_text_font(lbl_status_manual, &lv_font_montserrat_20, 0);
     lv_obj_set_style_text_color(lbl_status_manual, lv_color_hex(0x888888), 0);
+
+    // Redrawn when the shown value changes (ui_model.h)
+    ui_model_bind_tenths(lbl_actual_val, &ui_subject_temp, "%.1f C");
+    lv_label_bind_text(lbl_p1_val, &ui_subject_power1, "SSR1: %d%%");
+    lv_label_bind_text(lbl_p2_val, &ui_subject_power2, "SSR2: %d%%");
+    lv_subject_add_observer_obj(&ui_subject_state, state_cb, scr_manual, NULL);
 }
 
 void ui_screen_manual_input(InputEvent evt) {
@@ -98,10 +133,7 @@ void ui_screen_manual_input(InputEvent evt) {
         // Exit
         heater_enabled = false;
         manual_target_temp = 20;
-        ovenState.state = STATE_IDLE; // Stop PID safely
-        ovenState.target_temp = 0;
-        ovenState.power_output_1 = 0;
-        ovenState.power_output_2 = 0;
+        manual_set_mode(STATE_IDLE, 0); // Stop PID safely
         
         uiCtx.current_screen = UI_SCREEN_MAIN_MENU;
         uiCtx.full_redraw = true;
@@ -112,7 +144,7 @@ void ui_screen_manual_input(InputEvent evt) {
         
         lv_label_set_text_fmt(lbl_target_val, "%d C", manual_target_temp);
         
-        if (heater_enabled) ovenState.target_temp = (float)manual_target_temp;
+        if (heater_enabled) manual_set_mode(STATE_MANUAL, (float)manual_target_temp);
     }
     else if (evt.type == EVT_ENC_CCW) {
         manual_target_temp -= 5;
@@ -120,7 +152,7 @@ void ui_screen_manual_input(InputEvent evt) {
 
         lv_label_set_text_fmt(lbl_target_val, "%d C", manual_target_temp);
         
-        if (heater_enabled) ovenState.target_temp = (float)manual_target_temp;
+        if (heater_enabled) manual_set_mode(STATE_MANUAL, (float)manual_target_temp);
     }
     else if (evt.type == EVT_BTN1_PRESS) {
         // Toggle Heater
@@ -129,32 +161,17 @@ void ui_screen_manual_input(InputEvent evt) {
             lv_label_set_text(lbl_status_manual, "HEATER: ON (PID)");
             lv_obj_set_style_text_color(lbl_status_manual, lv_color_hex(0xFF0000), 0); // Red
             
-            ovenState.state = STATE_MANUAL; 
-            ovenState.target_temp = (float)manual_target_temp;
+            manual_set_mode(STATE_MANUAL, (float)manual_target_temp);
         } else {
             lv_label_set_text(lbl_status_manual, "HEATER: OFF");
             lv_obj_set_style_text_color(lbl_status_manual, lv_color_hex(0x888888), 0); // Grey
-            ovenState.state = STATE_IDLE; // Stop PID
-            ovenState.target_temp = 0;
-            ovenState.power_output_1 = 0;
-            ovenState.power_output_2 = 0;
+            manual_set_mode(STATE_IDLE, 0); // Stop PID
         }
     }
 }
 
 void ui_screen_manual_update(OvenState* state) {
-    // Update Actuals
-    lv_label_set_text_fmt(lbl_actual_val, "%.1f C", state->current_temp_t1);
-    
-    // Update Power
-    lv_label_set_text_fmt(lbl_p1_val, "SSR1: %.0f%%", state->power_output_1);
-    lv_label_set_text_fmt(lbl_p2_val, "SSR2: %.0f%%", state->power_output_2);
-    
-    if (state->state == STATE_FAULT) {
-        heater_enabled = false;
-        manual_target_temp = 20;
-        lv_label_set_text_fmt(lbl_target_val, "%d C", manual_target_temp);
-        lv_label_set_text(lbl_status_manual, "FAULT STOP");
-        lv_obj_set_style_text_color(lbl_status_manual, lv_color_hex(0xFF0000), 0);
-    }
+    // Readouts are bound to the model subjects, entering FAULT to state_cb.
+    // A heater switched on while the fault is still latched is refused here.
+    if (state->state == STATE_FAULT && heater_enabled) fault_stop();
 }
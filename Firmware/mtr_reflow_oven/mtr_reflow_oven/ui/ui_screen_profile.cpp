@@ -1,20 +1,23 @@
 #include "ui_screens.h"
 #include "ui_shared.h"
-#include "ff.h" // FatFS
+#include "../storage/profile_store.h"
 #include <stdio.h>
 #include <string.h>
 
 lv_obj_t* scr_profile;
 static lv_obj_t* list;
 extern UIContext uiCtx;
+extern bool sd_mounted;
 
 // Helper to access load_profile from main (defined in mtr_reflow_oven.cpp)
-extern void load_profile(const char* path);
+extern bool load_profile(const char* path);
 
 // Navigation State
 static int profile_list_idx = 0;
-static lv_obj_t* profile_buttons[20]; // Max 20 profiles
+static lv_obj_t* profile_buttons[PROFILE_INDEX_MAX];
+static char profile_files[PROFILE_INDEX_MAX][PROFILE_FILE_MAX];
 static int profile_count = 0;
+static uint32_t list_generation; // profile_store_generation() the list shows
 
 static void update_profile_selection() {
     for (int i=0; i<profile_count; i++) {
@@ -29,24 +32,65 @@ static void update_profile_selection() {
 
 static void event_handler(lv_event_t * e) {
     lv_event_code_t code = lv_event_get_code(e);
-    lv_obj_t * obj = (lv_obj_t*)lv_event_get_target(e); // Cast required in v9
     if(code == LV_EVENT_CLICKED) {
-        // Assume first child is label
-        lv_obj_t * label = lv_obj_get_child(obj, 0);
-        if (label) {
-            const char* txt = lv_label_get_text(label);
-            printf("Clicked: %s\n", txt);
-            
-            char path[64];
-            snprintf(path, 64, "/profiles/%s", txt);
-            load_profile(path);
-            ui_refresh_dashboard_chart(); // Update the static chart
-            
-            // Go back to Dashboard
-            uiCtx.current_screen = UI_SCREEN_DASHBOARD;
-            uiCtx.full_redraw = true;
+        int idx = (int)(intptr_t)lv_event_get_user_data(e);
+        if (idx < 0 || idx >= profile_count) return;
+        printf("Clicked: %s\n", profile_files[idx]);
+
+        char path[sizeof(PROFILE_DIR) + PROFILE_FILE_MAX];
+        snprintf(path, sizeof(path), PROFILE_DIR "/%s", profile_files[idx]);
+        if (!load_profile(path)) return; // Stay on the list
+        ui_refresh_dashboard_chart(); // Update the static chart
+
+        // Go back to Dashboard
+        uiCtx.current_screen = UI_SCREEN_DASHBOARD;
+        uiCtx.full_redraw = true;
+    }
+}
+
+// One button per index entry (storage/profile_store.h): no SD access
+static void build_profile_list() {
+    lv_obj_clean(list);
+    profile_count = 0;
+    profile_list_idx = 0;
+    list_generation = profile_store_generation();
+
+    uint32_t count = profile_store_count();
+    if (count == 0) {
+        lv_list_add_text(list, sd_mounted ? "No profiles in " PROFILE_DIR : "No SD card");
+        return;
+    }
+    for (uint32_t i = 0; i < count && i < PROFILE_INDEX_MAX; i++) {
+        const ProfileIndexEntry* entry = profile_store_entry(i);
+
+        lv_obj_t * btn = lv_button_create(list);
+        lv_obj_set_width(btn, LV_PCT(100));
+        lv_obj_set_height(btn, LV_SIZE_CONTENT);
+        lv_obj_set_flex_flow(btn, LV_FLEX_FLOW_COLUMN);
+        // Styles for focus
+        lv_obj_set_style_bg_color(btn, lv_color_hex(0x444444), 0);
+        lv_obj_set_style_bg_color(btn, lv_color_hex(0x007ACC), LV_STATE_FOCUSED);
+
+        lv_obj_add_event_cb(btn, event_handler, LV_EVENT_CLICKED, (void*)(intptr_t)profile_count); // Keep touch logic
+
+        lv_obj_t * lab = lv_label_create(btn);
+        lv_label_set_text(lab, entry->name);
+
+        // Alloy, peak and duration straight from the index
+        lv_obj_t * info = lv_label_create(btn);
+        lv_obj_set_style_text_color(info, lv_color_hex(0xAAAAAA), 0);
+        if (entry->status == PROFILE_ENTRY_OK) {
+            lv_label_set_text_fmt(info, "%s  %.0f C  %lu:%02lu",
+                                  entry->alloy[0] ? entry->alloy : "-", entry->peak_temp,
+                                  (unsigned long)(entry->duration_s / 60), (unsigned long)(entry->duration_s % 60));
+        } else {
+            lv_label_set_text_fmt(info, "%s: invalid profile", entry->file);
         }
+
+        strncpy(profile_files[profile_count], entry->file, sizeof(profile_files[0]) - 1);
+        profile_buttons[profile_count++] = btn;
     }
+    update_profile_selection(); // Highlight first item
 }
 
 void ui_create_profile(void) {
@@ -61,45 +105,8 @@ void ui_create_profile(void) {
     lv_obj_set_style_pad_row(list, 5, 0); // Gap between buttons
     lv_obj_set_style_border_color(list, lv_color_hex(0x444444), 0);
     
-    profile_count = 0;
-    profile_list_idx = 0;
-
-    // List files from SD Card
-    DIR dir;
-    FILINFO fno;
-    FRESULT fr;
-    
-    fr = f_opendir(&dir, "/profiles");
-    if (fr == FR_OK) {
-        while (true) {
-            fr = f_readdir(&dir, &fno);
-            if (fr != FR_OK || fno.fname[0] == 0) break;
-            
-            // Filter .json files
-            if (strstr(fno.fname, ".json") == NULL) continue;
-
-            // Add custom list button
-            if (profile_count < 20) {
-                lv_obj_t * btn = lv_button_create(list);
-                lv_obj_set_width(btn, LV_PCT(100));
-                lv_obj_set_height(btn, LV_SIZE_CONTENT);
-                // Styles for focus
-                lv_obj_set_style_bg_color(btn, lv_color_hex(0x444444), 0);
-                lv_obj_set_style_bg_color(btn, lv_color_hex(0x007ACC), LV_STATE_FOCUSED);
-                
-                lv_obj_add_event_cb(btn, event_handler, LV_EVENT_CLICKED, NULL); // Keep touch logic
-                
-                lv_obj_t * lab = lv_label_create(btn);
-                lv_label_set_text(lab, fno.fname);
-                
-                profile_buttons[profile_count++] = btn;
-            }
-        }
-        f_closedir(&dir);
-        update_profile_selection(); // Highlight first item
-    } else {
-        lv_list_add_text(list, "SD Error / Empty");
-    }
+    // Filled from the profile index once the card is mounted
+    build_profile_list();
 }
 
 // Input is handled by LVGL Group usually, but our Input Task sends events manually.
@@ -145,4 +152,6 @@ void ui_screen_profile_input(InputEvent evt) {
 // Update
 void ui_screen_profile_update(OvenState* state) {
     (void)state;
+    // Card changed or a profile was added, edited or removed
+    if (list_generation != profile_store_generation()) build_profile_list();
 }
@@ -1,17 +1,28 @@
 #include "ui_screens.h"
 #include "ui_shared.h"
 #include <stdio.h>
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "../control/oven_control.h"
 
 lv_obj_t* scr_settings;
 extern UIContext uiCtx;
 extern SystemConfig sysConfig; // Defined in mtr_reflow_oven.cpp
 extern void save_system_config(); // Defined in mtr_reflow_oven.cpp
 
+#define SETTINGS_ITEMS 8     // 6 gains, then the two auto-tune actions
+#define TUNE_ROW_FIRST 6
+
 // Settings State
 static int selected_idx = 0;
 static bool edit_mode = false;
-static lv_obj_t* item_containers[6]; // Track containers for highlighting
-static lv_obj_t* value_labels[6];    // Track labels for updating text
+static lv_obj_t* item_containers[SETTINGS_ITEMS]; // Track containers for highlighting
+static lv_obj_t* value_labels[SETTINGS_ITEMS];    // Track labels for updating text
+static float shown_values[SETTINGS_ITEMS];        // Gains as last drawn (auto-tune writes them)
+static uint8_t tune_ssr = 0;        // SSR of the tune started from here, 0 = none
+static bool tune_shown_active = false;
+static TickType_t tune_drawn_at = 0;
+#define TUNE_DRAW_MS 500
 
 // Config References (Pointers to sysConfig vars)
 // 0: Kp, 1: Ki, 2: Kd, 3: Sound
@@ -25,7 +36,7 @@ typedef struct {
     const char* fmt;
 } SettingItem;
 
-static SettingItem items[6]; 
+static SettingItem items[SETTINGS_ITEMS]; 
 
 // Init items dynamically
 void init_settings_data() {
@@ -35,10 +46,62 @@ void init_settings_data() {
     items[3] = {"SSR2 Kp", &sysConfig.pid_ssr2_kp, 0.1f, "%.1f"};
     items[4] = {"SSR2 Ki", &sysConfig.pid_ssr2_ki, 0.001f, "%.3f"};
     items[5] = {"SSR2 Kd", &sysConfig.pid_ssr2_kd, 0.5f, "%.1f"};
+    items[6] = {"Auto-tune SSR1", NULL, 0, NULL};
+    items[7] = {"Auto-tune SSR2", NULL, 0, NULL};
+}
+
+static const char* tune_idle_text(uint8_t ssr) {
+    return (ssr == 2 && !sysConfig.ssr2_is_present) ? "n/a" : "START";
+}
+
+// Auto-tune row text from the tuner (caller holds mtx_LVGL; mtx_OvenState
+// taken here, after it)
+static void update_tune_rows(bool tuning) {
+    Autotune at;
+    if (xSemaphoreTake(mtx_OvenState, pdMS_TO_TICKS(10)) != pdTRUE) return;
+    at = oven_autotune_status();
+    xSemaphoreGive(mtx_OvenState);
+
+    for (uint8_t ssr = 1; ssr <= 2; ssr++) {
+        lv_obj_t* label = value_labels[TUNE_ROW_FIRST + ssr - 1];
+        if (ssr != tune_ssr) {
+            lv_label_set_text(label, tune_idle_text(ssr));
+        } else if (tuning && at.phase == AUTOTUNE_HEATING) {
+            lv_label_set_text_fmt(label, "HEATING %u%%", autotune_progress(&at));
+        } else if (tuning) {
+            lv_label_set_text_fmt(label, "CYCLE %lu %u%%", (unsigned long)at.cycles + 1, autotune_progress(&at));
+        } else if (at.phase == AUTOTUNE_DONE) {
+            lv_label_set_text_fmt(label, "Ku %.1f Tu %.0fs", at.ku, at.tu_s);
+        } else {
+            lv_label_set_text_fmt(label, "FAILED: %s", at.error ? at.error : "?");
+        }
+    }
+    tune_shown_active = tuning;
+}
+
+// Start a tune on the selected row, or stop the one running
+static void tune_row_pressed(uint8_t ssr) {
+    if (xSemaphoreTake(mtx_OvenState, pdMS_TO_TICKS(50)) != pdTRUE) return;
+    bool running = (oven_state_mode().state == STATE_AUTOTUNE);
+    bool started = false;
+    if (running) {
+        oven_cmd_start_stop(); // Shown as "FAILED: stopped" by the next update
+    } else {
+        started = oven_cmd_autotune(ssr);
+    }
+    xSemaphoreGive(mtx_OvenState);
+
+    if (started) {
+        tune_ssr = ssr;
+        update_tune_rows(true);
+    } else if (!running) {
+        // Profile running, manual heating, fault, or no SSR2
+        lv_label_set_text(value_labels[TUNE_ROW_FIRST + ssr - 1], "BUSY");
+    }
 }
 
 void update_settings_ui() {
-    for (int i=0; i<6; i++) {
+    for (int i=0; i<SETTINGS_ITEMS; i++) {
         // Highlight logic
         if (i == selected_idx) {
             lv_obj_set_style_bg_opa(item_containers[i], LV_OPA_COVER, 0);
@@ -53,6 +116,7 @@ void update_settings_ui() {
         // Update Text
         if (items[i].val_ptr) {
             lv_label_set_text_fmt(value_labels[i], items[i].fmt, *items[i].val_ptr);
+            shown_values[i] = *items[i].val_ptr;
         }
     }
 }
@@ -71,7 +135,7 @@ void ui_create_settings(void) {
     lv_obj_set_style_bg_color(cont, lv_color_hex(0x222222), 0);
     lv_obj_set_style_pad_gap(cont, 5, 0);
     
-    for (int i=0; i<6; i++) {
+    for (int i=0; i<SETTINGS_ITEMS; i++) {
         item_containers[i] = lv_obj_create(cont);
         lv_obj_set_width(item_containers[i], LV_PCT(100));
         lv_obj_set_height(item_containers[i], 40);
@@ -85,7 +149,7 @@ void ui_create_settings(void) {
         lv_obj_set_style_text_color(l1, lv_color_white(), 0);
         
         value_labels[i] = lv_label_create(item_containers[i]);
-        lv_label_set_text(value_labels[i], "---");
+        lv_label_set_text(value_labels[i], items[i].val_ptr ? "---" : tune_idle_text(i - TUNE_ROW_FIRST + 1));
         lv_obj_set_style_text_color(value_labels[i], lv_color_hex(0x00D0FF), 0);
     }
     
@@ -106,6 +170,10 @@ void ui_screen_settings_input(InputEvent evt) {
         }
     }
     else if (evt.type == EVT_ENC_BTN_PRESS) {
+        if (!items[selected_idx].val_ptr) {
+            tune_row_pressed((uint8_t)(selected_idx - TUNE_ROW_FIRST + 1));
+            return;
+        }
         edit_mode = !edit_mode;
         update_settings_ui();
     }
@@ -114,7 +182,7 @@ void ui_screen_settings_input(InputEvent evt) {
             *items[selected_idx].val_ptr += items[selected_idx].step;
         } else {
             selected_idx++;
-            if (selected_idx > 5) selected_idx = 0;
+            if (selected_idx >= SETTINGS_ITEMS) selected_idx = 0;
         }
         update_settings_ui();
     }
@@ -124,12 +192,27 @@ void ui_screen_settings_input(InputEvent evt) {
              if (*items[selected_idx].val_ptr < 0) *items[selected_idx].val_ptr = 0;
         } else {
             selected_idx--;
-            if (selected_idx < 0) selected_idx = 5;
+            if (selected_idx < 0) selected_idx = SETTINGS_ITEMS - 1;
         }
         update_settings_ui();
     }
 }
 
 void ui_screen_settings_update(OvenState* state) {
-    (void)state;
+    // Tune rows follow the tuner while it runs, and once more as it ends
+    bool tuning = (state->state == STATE_AUTOTUNE);
+    TickType_t now = xTaskGetTickCount();
+    if (tune_ssr && (tuning || tune_shown_active) &&
+        (!tuning || now - tune_drawn_at >= pdMS_TO_TICKS(TUNE_DRAW_MS))) {
+        tune_drawn_at = now;
+        update_tune_rows(tuning);
+    }
+
+    // Gains written by a finished tune
+    for (int i = 0; i < TUNE_ROW_FIRST; i++) {
+        if (*items[i].val_ptr != shown_values[i]) {
+            lv_label_set_text_fmt(value_labels[i], items[i].fmt, *items[i].val_ptr);
+            shown_values[i] = *items[i].val_ptr;
+        }
+    }
 }
@@ -0,0 +1,86 @@
+#include "ui_screens.h"
+#include "ui_shared.h"
+#include <stdio.h>
+#include "../system/sys_stats.h"
+
+lv_obj_t* scr_sysinfo;
+static lv_obj_t* lbl_summary;
+static lv_obj_t* table;
+static uint32_t shown_seq = 0;
+
+extern UIContext uiCtx;
+
+void ui_create_sysinfo(void) {
+    scr_sysinfo = lv_obj_create(NULL);
+    lv_obj_add_style(scr_sysinfo, &style_screen_bg, 0);
+    ui_create_header(scr_sysinfo, "SYS INFO");
+
+    lbl_summary = lv_label_create(scr_sysinfo);
+    lv_label_set_text(lbl_summary, "Waiting for stats...");
+    lv_obj_add_style(lbl_summary, &style_text_normal, 0);
+    lv_obj_align(lbl_summary, LV_ALIGN_TOP_LEFT, 20, 40);
+
+    // One row per task, scrolled with the encoder
+    table = lv_table_create(scr_sysinfo);
+    lv_obj_set_size(table, 440, 200);
+    lv_obj_align(table, LV_ALIGN_BOTTOM_MID, 0, -5);
+    lv_obj_set_style_bg_color(table, lv_color_hex(0x222222), 0);
+    lv_obj_set_style_bg_color(table, lv_color_hex(0x222222), LV_PART_ITEMS);
+    lv_obj_set_style_text_color(table, lv_color_white(), LV_PART_ITEMS);
+    lv_obj_set_style_pad_ver(table, 3, LV_PART_ITEMS);
+    lv_table_set_column_count(table, 5);
+    lv_table_set_column_width(table, 0, 130);
+    lv_table_set_column_width(table, 1, 60);
+    lv_table_set_column_width(table, 2, 60);
+    lv_table_set_column_width(table, 3, 80);
+    lv_table_set_column_width(table, 4, 100);
+    lv_table_set_cell_value(table, 0, 0, "Task");
+    lv_table_set_cell_value(table, 0, 1, "Core");
+    lv_table_set_cell_value(table, 0, 2, "Prio");
+    lv_table_set_cell_value(table, 0, 3, "CPU %");
+    lv_table_set_cell_value(table, 0, 4, "Stack free");
+}
+
+void ui_screen_sysinfo_update(OvenState* state) {
+    (void)state;
+    static SysStats stats; // Large, kept off the UI task stack
+    sys_stats_get(&stats);
+    if (stats.seq == shown_seq) return; // New sample once a second
+    shown_seq = stats.seq;
+
+    lv_label_set_text_fmt(lbl_summary,
+        "CPU core0 %.1f %%  core1 %.1f %%  other %.1f %%\n"
+        "Heap %u B free (min %u)  LVGL %u/%u kB (frag %u %%)\n"
+        "SPI0 LCD %.1f %%  SD %.1f %%  SD wait max %u us",
+        stats.core_pct[0], stats.core_pct[1], stats.unpinned_pct,
+        (unsigned)stats.heap_free, (unsigned)stats.heap_min_free,
+        (unsigned)(stats.lv_used / 1024), (unsigned)(stats.lv_total / 1024), (unsigned)stats.lv_frag_pct,
+        stats.spi_busy_pct[SPI_DEV_DISPLAY], stats.spi_busy_pct[SPI_DEV_SD],
+        (unsigned)stats.spi_wait_max_us[SPI_DEV_SD]);
+
+    lv_table_set_row_count(table, stats.task_count + 1);
+    for (uint32_t i = 0; i < stats.task_count; i++) {
+        const SysTaskStats* t = &stats.tasks[i];
+        uint32_t row = i + 1;
+        const char* core = (t->core_mask == 1u) ? "0" : (t->core_mask == 2u) ? "1" : "-";
+        lv_table_set_cell_value(table, row, 0, t->name);
+        lv_table_set_cell_value(table, row, 1, core);
+        lv_table_set_cell_value_fmt(table, row, 2, "%u", (unsigned)t->priority);
+        lv_table_set_cell_value_fmt(table, row, 3, "%.1f", t->cpu_pct);
+        lv_table_set_cell_value_fmt(table, row, 4, "%u%s", (unsigned)t->stack_free,
+                                    (t->stack_free < SYS_STATS_STACK_LOW) ? " LOW" : "");
+    }
+}
+
+void ui_screen_sysinfo_input(InputEvent evt) {
+    if (evt.type == EVT_BTN2_PRESS) {
+        uiCtx.current_screen = UI_SCREEN_MAIN_MENU;
+        uiCtx.full_redraw = true;
+    }
+    else if (evt.type == EVT_ENC_CW) {
+        lv_obj_scroll_by_bounded(table, 0, -40, LV_ANIM_OFF);
+    }
+    else if (evt.type == EVT_ENC_CCW) {
+        lv_obj_scroll_by_bounded(table, 0, 40, LV_ANIM_OFF);
+    }
+}
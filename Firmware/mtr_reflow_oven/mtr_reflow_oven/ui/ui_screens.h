@@ -14,6 +14,7 @@ extern lv_obj_t* scr_dashboard;
 extern lv_obj_t* scr_manual;
 extern lv_obj_t* scr_settings;
 extern lv_obj_t* scr_profile;
+extern lv_obj_t* scr_sysinfo;
 
 // Init Functions
 void ui_screens_init(void);
@@ -22,6 +23,7 @@ void ui_create_dashboard(void);
 void ui_create_manual(void);
 void ui_create_settings(void);
 void ui_create_profile(void);
+void ui_create_sysinfo(void);
 
 // Screen specific input handlers
 void ui_screen_menu_input(InputEvent evt);
@@ -30,12 +32,14 @@ void ui_screen_dashboard_input(InputEvent evt);
 void ui_screen_manual_input(InputEvent evt);
 void ui_screen_settings_input(InputEvent evt);
 void ui_screen_profile_input(InputEvent evt);
+void ui_screen_sysinfo_input(InputEvent evt);
 
 // Screen specific updaters
 void ui_screen_dashboard_update(OvenState* state);
 void ui_screen_manual_update(OvenState* state);
 void ui_screen_settings_update(OvenState* state);
 void ui_screen_profile_update(OvenState* state);
+void ui_screen_sysinfo_update(OvenState* state);
 
 void ui_refresh_dashboard_chart(void);
 